@@ -10,10 +10,11 @@
 
 #include "webrtc/api/datachannel.h"
 
-#include <memory>
 #include <string>
+#include <vector>
 
 #include "webrtc/api/sctputils.h"
+#include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/refcount.h"
 #include "webrtc/media/sctp/sctpdataengine.h"
@@ -66,15 +67,13 @@ bool SctpSidAllocator::IsSidAvailable(int sid) const {
 
 DataChannel::PacketQueue::PacketQueue() : byte_count_(0) {}
 
-DataChannel::PacketQueue::~PacketQueue() {
-  Clear();
-}
+DataChannel::PacketQueue::~PacketQueue() {}
 
 bool DataChannel::PacketQueue::Empty() const {
   return packets_.empty();
 }
 
-DataBuffer* DataChannel::PacketQueue::Front() {
+const DataBuffer& DataChannel::PacketQueue::Front() const {
   return packets_.front();
 }
 
@@ -83,20 +82,25 @@ void DataChannel::PacketQueue::Pop() {
     return;
   }
 
-  byte_count_ -= packets_.front()->size();
+  byte_count_ -= packets_.front().size();
   packets_.pop_front();
 }
 
-void DataChannel::PacketQueue::Push(DataBuffer* packet) {
-  byte_count_ += packet->size();
+void DataChannel::PacketQueue::Pop(size_t count) {
+  RTC_DCHECK_LE(count, packets_.size());
+  for (size_t i = 0; i < count; ++i) {
+    byte_count_ -= packets_[i].size();
+  }
+  packets_.erase(packets_.begin(), packets_.begin() + count);
+}
+
+void DataChannel::PacketQueue::Push(const DataBuffer& packet) {
+  byte_count_ += packet.size();
   packets_.push_back(packet);
 }
 
 void DataChannel::PacketQueue::Clear() {
-  while (!packets_.empty()) {
-    delete packets_.front();
-    packets_.pop_front();
-  }
+  packets_.clear();
   byte_count_ = 0;
 }
 
@@ -251,7 +255,7 @@ bool DataChannel::Send(const DataBuffer& buffer) {
     return true;
   }
 
-  bool success = SendDataMessage(buffer, true);
+  bool success = SendDataMessage(buffer);
   if (data_channel_type_ == cricket::DCT_RTP) {
     return success;
   }
@@ -365,9 +369,9 @@ void DataChannel::OnDataReceived(cricket::DataChannel* channel,
   }
 
   bool binary = (params.type == cricket::DMT_BINARY);
-  std::unique_ptr<DataBuffer> buffer(new DataBuffer(payload, binary));
+  DataBuffer buffer(payload, binary);
   if (state_ == kOpen && observer_) {
-    observer_->OnMessage(*buffer.get());
+    observer_->OnMessage(buffer);
   } else {
     if (queued_received_data_.byte_count() + payload.size() >
         kMaxQueuedReceivedDataBytes) {
@@ -380,7 +384,7 @@ void DataChannel::OnDataReceived(cricket::DataChannel* channel,
 
       return;
     }
-    queued_received_data_.Push(buffer.release());
+    queued_received_data_.Push(buffer);
   }
 }
 
@@ -497,8 +501,7 @@ void DataChannel::DeliverQueuedReceivedData() {
   }
 
   while (!queued_received_data_.Empty()) {
-    std::unique_ptr<DataBuffer> buffer(queued_received_data_.Front());
-    observer_->OnMessage(*buffer);
+    observer_->OnMessage(queued_received_data_.Front());
     queued_received_data_.Pop();
   }
 }
@@ -511,14 +514,25 @@ void DataChannel::SendQueuedDataMessages() {
   ASSERT(state_ == kOpen || state_ == kClosing);
 
   uint64_t start_buffered_amount = buffered_amount();
-  while (!queued_send_data_.Empty()) {
-    DataBuffer* buffer = queued_send_data_.Front();
-    if (!SendDataMessage(*buffer, false)) {
-      // Leave the message in the queue if sending is aborted.
-      break;
-    }
-    queued_send_data_.Pop();
-    delete buffer;
+  // Hand the whole queue to the transport at once, which costs a single hop to
+  // the worker thread instead of one per message. The payloads are shared,
+  // not copied.
+  std::vector<cricket::OutgoingDataMessage> messages;
+  messages.reserve(queued_send_data_.size());
+  for (size_t i = 0; i < queued_send_data_.size(); ++i) {
+    const DataBuffer& buffer = queued_send_data_.at(i);
+    messages.push_back(
+        cricket::OutgoingDataMessage(GetSendDataParams(buffer), buffer.data));
+  }
+
+  cricket::SendDataResult send_result = cricket::SDR_SUCCESS;
+  size_t sent = provider_->SendDataBatch(messages, &send_result);
+  // Leave the unsent messages in the queue.
+  queued_send_data_.Pop(sent);
+  if (sent < messages.size() && send_result != cricket::SDR_BLOCK) {
+    LOG(LS_ERROR) << "Closing the DataChannel due to a failure to send data, "
+                  << "send_result = " << send_result;
+    Close();
   }
 
   if (observer_ && buffered_amount() < start_buffered_amount) {
@@ -526,8 +540,8 @@ void DataChannel::SendQueuedDataMessages() {
   }
 }
 
-bool DataChannel::SendDataMessage(const DataBuffer& buffer,
-                                  bool queue_if_blocked) {
+cricket::SendDataParams DataChannel::GetSendDataParams(
+    const DataBuffer& buffer) const {
   cricket::SendDataParams send_params;
 
   if (data_channel_type_ == cricket::DCT_SCTP) {
@@ -546,9 +560,13 @@ bool DataChannel::SendDataMessage(const DataBuffer& buffer,
     send_params.ssrc = send_ssrc_;
   }
   send_params.type = buffer.binary ? cricket::DMT_BINARY : cricket::DMT_TEXT;
+  return send_params;
+}
 
+bool DataChannel::SendDataMessage(const DataBuffer& buffer) {
   cricket::SendDataResult send_result = cricket::SDR_SUCCESS;
-  bool success = provider_->SendData(send_params, buffer.data, &send_result);
+  bool success = provider_->SendData(GetSendDataParams(buffer), buffer.data,
+                                     &send_result);
 
   if (success) {
     return true;
@@ -559,7 +577,7 @@ bool DataChannel::SendDataMessage(const DataBuffer& buffer,
   }
 
   if (send_result == cricket::SDR_BLOCK) {
-    if (!queue_if_blocked || QueueSendDataMessage(buffer)) {
+    if (QueueSendDataMessage(buffer)) {
       return false;
     }
   }
@@ -578,7 +596,7 @@ bool DataChannel::QueueSendDataMessage(const DataBuffer& buffer) {
     LOG(LS_ERROR) << "Can't buffer any more data for the data channel.";
     return false;
   }
-  queued_send_data_.Push(new DataBuffer(buffer));
+  queued_send_data_.Push(buffer);
 
   // The buffer can have length zero, in which case there is no change.
   if (observer_ && buffered_amount() > start_buffered_amount) {
@@ -592,14 +610,13 @@ void DataChannel::SendQueuedControlMessages() {
   control_packets.Swap(&queued_control_data_);
 
   while (!control_packets.Empty()) {
-    std::unique_ptr<DataBuffer> buf(control_packets.Front());
-    SendControlMessage(buf->data);
+    SendControlMessage(control_packets.Front().data);
     control_packets.Pop();
   }
 }
 
 void DataChannel::QueueControlMessage(const rtc::CopyOnWriteBuffer& buffer) {
-  queued_control_data_.Push(new DataBuffer(buffer, true));
+  queued_control_data_.Push(DataBuffer(buffer, true));
 }
 
 bool DataChannel::SendControlMessage(const rtc::CopyOnWriteBuffer& buffer) {
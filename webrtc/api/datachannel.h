@@ -14,6 +14,7 @@
 #include <deque>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "webrtc/api/datachannelinterface.h"
 #include "webrtc/api/proxy.h"
@@ -33,6 +34,12 @@ class DataChannelProviderInterface {
   virtual bool SendData(const cricket::SendDataParams& params,
                         const rtc::CopyOnWriteBuffer& payload,
                         cricket::SendDataResult* result) = 0;
+  // Sends |messages| to the transport in order, stopping at the first one that
+  // fails. Returns the number of messages sent; if that is less than
+  // messages.size(), |result| describes the failure.
+  virtual size_t SendDataBatch(
+      const std::vector<cricket::OutgoingDataMessage>& messages,
+      cricket::SendDataResult* result) = 0;
   // Connects to the transport signals.
   virtual bool ConnectDataChannel(DataChannel* data_channel) = 0;
   // Disconnects from the transport signals.
@@ -188,8 +195,9 @@ class DataChannel : public DataChannelInterface,
   virtual ~DataChannel();
 
  private:
-  // A packet queue which tracks the total queued bytes. Queued packets are
-  // owned by this class.
+  // A packet queue which tracks the total queued bytes. Packets are stored by
+  // value; the payloads are reference counted, so queuing a packet neither
+  // copies the data nor allocates a DataBuffer on the heap.
   class PacketQueue {
    public:
     PacketQueue();
@@ -199,20 +207,27 @@ class DataChannel : public DataChannelInterface,
       return byte_count_;
     }
 
+    size_t size() const { return packets_.size(); }
+
     bool Empty() const;
 
-    DataBuffer* Front();
+    const DataBuffer& Front() const;
+
+    const DataBuffer& at(size_t index) const { return packets_[index]; }
 
     void Pop();
 
-    void Push(DataBuffer* packet);
+    // Pops the first |count| packets.
+    void Pop(size_t count);
+
+    void Push(const DataBuffer& packet);
 
     void Clear();
 
     void Swap(PacketQueue* other);
 
    private:
-    std::deque<DataBuffer*> packets_;
+    std::deque<DataBuffer> packets_;
     size_t byte_count_;
   };
 
@@ -234,7 +249,8 @@ class DataChannel : public DataChannelInterface,
   void DeliverQueuedReceivedData();
 
   void SendQueuedDataMessages();
-  bool SendDataMessage(const DataBuffer& buffer, bool queue_if_blocked);
+  cricket::SendDataParams GetSendDataParams(const DataBuffer& buffer) const;
+  bool SendDataMessage(const DataBuffer& buffer);
   bool QueueSendDataMessage(const DataBuffer& buffer);
 
   void SendQueuedControlMessages();
@@ -173,6 +173,25 @@ TEST_F(SctpDataChannelTest, QueuedDataSentWhenUnblocked) {
   EXPECT_EQ(2U, observer_->on_buffered_amount_change_count());
 }
 
+// Tests that all the queued data is handed to the transport in a single batch
+// when the channel is unblocked.
+TEST_F(SctpDataChannelTest, QueuedDataSentInOneBatch) {
+  AddObserver();
+  SetChannelReady();
+  webrtc::DataBuffer buffer("abcd");
+  provider_->set_send_blocked(true);
+  const int number_of_packets = 3;
+  for (int i = 0; i < number_of_packets; ++i) {
+    EXPECT_TRUE(webrtc_data_channel_->Send(buffer));
+  }
+  EXPECT_EQ(buffer.size() * number_of_packets,
+            webrtc_data_channel_->buffered_amount());
+
+  provider_->set_send_blocked(false);
+  EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(1, provider_->send_batch_count());
+}
+
 // Tests that no crash when the channel is blocked right away while trying to
 // send queued data.
 TEST_F(SctpDataChannelTest, BlockedWhenSendQueuedDataNoCrash) {
@@ -14,20 +14,28 @@
 #include "webrtc/api/mediacontroller.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/media/base/mediachannel.h"
+#include "webrtc/pc/channelmanager.h"
 
 namespace cricket {
 
 class FakeMediaController : public webrtc::MediaControllerInterface {
  public:
-  explicit FakeMediaController(cricket::ChannelManager* channel_manager,
-                               webrtc::Call* call)
-      : channel_manager_(channel_manager), call_(call) {
+  // If |worker_thread| is null, the channel manager's worker thread is used.
+  FakeMediaController(cricket::ChannelManager* channel_manager,
+                      webrtc::Call* call,
+                      rtc::Thread* worker_thread = nullptr)
+      : channel_manager_(channel_manager),
+        call_(call),
+        worker_thread_(worker_thread) {
     RTC_DCHECK(nullptr != channel_manager_);
     RTC_DCHECK(nullptr != call_);
   }
   ~FakeMediaController() override {}
   void Close() override {}
   webrtc::Call* call_w() override { return call_; }
+  rtc::Thread* worker_thread() const override {
+    return worker_thread_ ? worker_thread_ : channel_manager_->worker_thread();
+  }
   cricket::ChannelManager* channel_manager() const override {
     return channel_manager_;
   }
@@ -37,6 +45,7 @@ class FakeMediaController : public webrtc::MediaControllerInterface {
   const MediaConfig media_config_ = MediaConfig();
   cricket::ChannelManager* channel_manager_;
   webrtc::Call* call_;
+  rtc::Thread* const worker_thread_;
 };
 }  // namespace cricket
 #endif  // WEBRTC_API_FAKEMEDIACONTROLLER_H_
@@ -38,9 +38,6 @@ class MediaController : public webrtc::MediaControllerInterface,
         call_config_(event_log) {
     RTC_DCHECK(worker_thread);
     RTC_DCHECK(event_log);
-    worker_thread_->Invoke<void>(RTC_FROM_HERE,
-                                 rtc::Bind(&MediaController::Construct_w, this,
-                                           channel_manager_->media_engine()));
   }
   ~MediaController() override {
     Close();
@@ -54,10 +51,14 @@ class MediaController : public webrtc::MediaControllerInterface,
   webrtc::Call* call_w() override {
     RTC_DCHECK(worker_thread_->IsCurrent());
     if (!call_) {
+      // The Call is configured and created when the first channel needs it,
+      // so that creating a PeerConnection doesn't wait for the worker thread.
+      Construct_w(channel_manager_->media_engine());
       call_.reset(webrtc::Call::Create(call_config_));
     }
     return call_.get();
   }
+  rtc::Thread* worker_thread() const override { return worker_thread_; }
   cricket::ChannelManager* channel_manager() const override {
     return channel_manager_;
   }
@@ -67,10 +68,14 @@ class MediaController : public webrtc::MediaControllerInterface,
   void Construct_w(cricket::MediaEngineInterface* media_engine) {
     RTC_DCHECK(worker_thread_->IsCurrent());
     RTC_DCHECK(media_engine);
-    call_config_.audio_state = media_engine->GetAudioState();
+    // The voice engine is tied to the channel manager's worker thread, so a
+    // Call on any other carries video and data only.
+    if (worker_thread_ == channel_manager_->worker_thread())
+      call_config_.audio_state = media_engine->GetAudioState();
     call_config_.bitrate_config.min_bitrate_bps = kMinBandwidthBps;
     call_config_.bitrate_config.start_bitrate_bps = kStartBandwidthBps;
     call_config_.bitrate_config.max_bitrate_bps = kMaxBandwidthBps;
+    call_config_.aggregate_rtcp = media_config_.aggregate_rtcp;
   }
   void Close_w() {
     RTC_DCHECK(worker_thread_->IsCurrent());
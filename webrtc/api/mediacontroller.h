@@ -36,6 +36,8 @@ class MediaControllerInterface {
   virtual ~MediaControllerInterface() {}
   virtual void Close() = 0;
   virtual webrtc::Call* call_w() = 0;
+  // The thread the Call and the media channels using it run on.
+  virtual rtc::Thread* worker_thread() const = 0;
   virtual cricket::ChannelManager* channel_manager() const = 0;
   virtual const cricket::MediaConfig& config() const = 0;
 };
@@ -565,8 +565,12 @@ bool ParseIceServers(const PeerConnectionInterface::IceServers& servers,
   return true;
 }
 
-PeerConnection::PeerConnection(PeerConnectionFactory* factory)
+PeerConnection::PeerConnection(PeerConnectionFactory* factory,
+                               rtc::Thread* network_thread,
+                               rtc::Thread* worker_thread)
     : factory_(factory),
+      network_thread_(network_thread),
+      worker_thread_(worker_thread),
       observer_(NULL),
       uma_observer_(NULL),
       signaling_state_(kStable),
@@ -597,6 +601,7 @@ PeerConnection::~PeerConnection() {
   // port_allocator_ lives on the network thread and should be destroyed there.
   network_thread()->Invoke<void>(RTC_FROM_HERE,
                                  [this] { port_allocator_.reset(nullptr); });
+  factory_->ReleaseThreads(network_thread_, worker_thread_);
 }
 
 bool PeerConnection::Initialize(
@@ -617,21 +622,22 @@ bool PeerConnection::Initialize(
   // there.
   if (!network_thread()->Invoke<bool>(
           RTC_FROM_HERE, rtc::Bind(&PeerConnection::InitializePortAllocator_n,
-                                   this, configuration))) {
+                                   this, configuration,
+                                   factory_->options().network_ignore_mask))) {
     return false;
   }
 
   media_controller_.reset(factory_->CreateMediaController(
-      configuration.media_config, event_log_.get()));
+      configuration.media_config, event_log_.get(), worker_thread()));
 
   session_.reset(new WebRtcSession(
-      media_controller_.get(), factory_->network_thread(),
-      factory_->worker_thread(), factory_->signaling_thread(),
-      port_allocator_.get(),
+      media_controller_.get(), network_thread(), worker_thread(),
+      factory_->signaling_thread(), port_allocator_.get(),
       std::unique_ptr<cricket::TransportController>(
           factory_->CreateTransportController(
               port_allocator_.get(),
-              configuration.redetermine_role_on_ice_restart))));
+              configuration.redetermine_role_on_ice_restart,
+              network_thread()))));
 
   stats_.reset(new StatsCollector(this));
   stats_collector_ = RTCStatsCollector::Create(this);
@@ -1313,13 +1319,13 @@ void PeerConnection::RegisterUMAObserver(UMAObserver* observer) {
 
 bool PeerConnection::StartRtcEventLog(rtc::PlatformFile file,
                                       int64_t max_size_bytes) {
-  return factory_->worker_thread()->Invoke<bool>(
+  return worker_thread()->Invoke<bool>(
       RTC_FROM_HERE, rtc::Bind(&PeerConnection::StartRtcEventLog_w, this, file,
                                max_size_bytes));
 }
 
 void PeerConnection::StopRtcEventLog() {
-  factory_->worker_thread()->Invoke<void>(
+  worker_thread()->Invoke<void>(
       RTC_FROM_HERE, rtc::Bind(&PeerConnection::StopRtcEventLog_w, this));
 }
 
@@ -1425,7 +1431,7 @@ void PeerConnection::CreateVideoReceiver(MediaStreamInterface* stream,
   receivers_.push_back(
       RtpReceiverProxyWithInternal<RtpReceiverInternal>::Create(
           signaling_thread(),
-          new VideoRtpReceiver(stream, track_id, factory_->worker_thread(),
+          new VideoRtpReceiver(stream, track_id, worker_thread(),
                                ssrc, session_->video_channel())));
 }
 
@@ -2274,13 +2280,15 @@ DataChannel* PeerConnection::FindDataChannelBySid(int sid) const {
 }
 
 bool PeerConnection::InitializePortAllocator_n(
-    const RTCConfiguration& configuration) {
+    const RTCConfiguration& configuration,
+    int network_ignore_mask) {
   cricket::ServerAddresses stun_servers;
   std::vector<cricket::RelayServerConfig> turn_servers;
   if (!ParseIceServers(configuration.servers, &stun_servers, &turn_servers)) {
     return false;
   }
 
+  port_allocator_->SetNetworkIgnoreMask(network_ignore_mask);
   port_allocator_->Initialize();
 
   // To handle both internal and externally created port allocator, we will
@@ -66,7 +66,11 @@ class PeerConnection : public PeerConnectionInterface,
                        public rtc::MessageHandler,
                        public sigslot::has_slots<> {
  public:
-  explicit PeerConnection(PeerConnectionFactory* factory);
+  // |network_thread| and |worker_thread| are the ones of the factory's
+  // threads that this PeerConnection's transports and media run on.
+  PeerConnection(PeerConnectionFactory* factory,
+                 rtc::Thread* network_thread,
+                 rtc::Thread* worker_thread);
 
   bool Initialize(
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -212,7 +216,8 @@ class PeerConnection : public PeerConnectionInterface,
     return factory_->signaling_thread();
   }
 
-  rtc::Thread* network_thread() const { return factory_->network_thread(); }
+  rtc::Thread* network_thread() const { return network_thread_; }
+  rtc::Thread* worker_thread() const { return worker_thread_; }
 
   void PostSetSessionDescriptionFailure(SetSessionDescriptionObserver* observer,
                                         const std::string& error);
@@ -363,7 +368,8 @@ class PeerConnection : public PeerConnectionInterface,
   DataChannel* FindDataChannelBySid(int sid) const;
 
   // Called when first configuring the port allocator.
-  bool InitializePortAllocator_n(const RTCConfiguration& configuration);
+  bool InitializePortAllocator_n(const RTCConfiguration& configuration,
+                                 int network_ignore_mask);
   // Called when SetConfiguration is called. Only a subset of the configuration
   // is applied.
   bool ReconfigurePortAllocator_n(const RTCConfiguration& configuration);
@@ -382,6 +388,8 @@ class PeerConnection : public PeerConnectionInterface,
   // PeerConnectionFactoryInterface all instances created using the raw pointer
   // will refer to the same reference count.
   rtc::scoped_refptr<PeerConnectionFactory> factory_;
+  rtc::Thread* const network_thread_;
+  rtc::Thread* const worker_thread_;
   PeerConnectionObserver* observer_;
   UMAObserver* uma_observer_;
   SignalingState signaling_state_;
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <memory>
 
 #include "webrtc/api/test/peerconnectiontestwrapper.h"
@@ -23,6 +24,8 @@
 #include "webrtc/base/sslstreamadapter.h"
 #include "webrtc/base/stringencode.h"
 #include "webrtc/base/stringutils.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
 
 #define MAYBE_SKIP_TEST(feature)                    \
   if (!(feature())) {                               \
@@ -318,6 +321,47 @@ TEST_F(PeerConnectionEndToEndTest,
   EXPECT_EQ(1U, dc_2_observer->received_message_count());
 }
 
+// Measures how many messages per second one DataChannel can push through a
+// pair of loopback PeerConnections. The sender outruns the transport, so this
+// exercises the send queue as well as the receive path. It sends 20000
+// messages, so it is only run manually with --gtest_also_run_disabled_tests
+// --gtest_filter=PeerConnectionEndToEndTest.DISABLED_DataChannelMessageRate
+TEST_F(PeerConnectionEndToEndTest, DISABLED_DataChannelMessageRate) {
+  MAYBE_SKIP_TEST(rtc::SSLStreamAdapter::HaveDtlsSrtp);
+
+  const size_t kNumMessages = 20000;
+  const size_t kMessageSize = 100;
+
+  CreatePcs();
+
+  webrtc::DataChannelInit init;
+  rtc::scoped_refptr<DataChannelInterface> caller_dc(
+      caller_->CreateDataChannel("data", init));
+
+  Negotiate();
+  WaitForConnection();
+  WaitForDataChannelsToOpen(caller_dc, callee_signaled_data_channels_, 0);
+
+  webrtc::CountingDataChannelObserver observer(callee_signaled_data_channels_[0]);
+  webrtc::DataBuffer buffer(std::string(kMessageSize, 'a'));
+
+  int64_t start_ms = rtc::TimeMillis();
+  for (size_t i = 0; i < kNumMessages; ++i) {
+    ASSERT_TRUE(caller_dc->Send(buffer));
+  }
+  EXPECT_EQ_WAIT(kNumMessages, observer.received_message_count(), kMaxWait);
+  int64_t elapsed_ms = std::max<int64_t>(rtc::TimeMillis() - start_ms, 1);
+
+  webrtc::test::PrintResult("datachannel_message_rate", "", "loopback",
+                            1000.0 * observer.received_message_count() /
+                                elapsed_ms,
+                            "messages/s", true);
+  webrtc::test::PrintResult("datachannel_throughput", "", "loopback",
+                            8.0 * kMessageSize *
+                                observer.received_message_count() / elapsed_ms,
+                            "kbps", true);
+}
+
 #ifdef HAVE_QUIC
 // Test that QUIC data channels can be used and that messages go to the correct
 // remote data channel when both peers want to use QUIC. It is assumed that the
@@ -10,7 +10,10 @@
 
 #include "webrtc/api/peerconnectionfactory.h"
 
+#include <algorithm>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "webrtc/api/audiotrack.h"
 #include "webrtc/api/localaudiosource.h"
@@ -25,6 +28,9 @@
 #include "webrtc/api/videosourceproxy.h"
 #include "webrtc/api/videotrack.h"
 #include "webrtc/base/bind.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/media/engine/webrtcmediaengine.h"
 #include "webrtc/media/engine/webrtcvideodecoderfactory.h"
 #include "webrtc/media/engine/webrtcvideoencoderfactory.h"
@@ -35,6 +41,41 @@
 
 namespace webrtc {
 
+namespace {
+
+// Returns the index of the thread, out of the first |num_threads| of
+// |shards|, that a new PeerConnection is pinned to, as |policy| picks it or,
+// if null, the one with the fewest. Returns the size of |shards| if the
+// PeerConnection goes to a thread that hasn't been started yet.
+template <typename Shard>
+size_t SelectThread(ThreadPinningPolicy* policy,
+                    int num_threads,
+                    const std::vector<std::unique_ptr<Shard>>& shards) {
+  // Threads that have not been started yet have no PeerConnections.
+  std::vector<int> peer_connections(std::max(1, num_threads), 0);
+  for (size_t i = 0; i < peer_connections.size() && i < shards.size(); ++i)
+    peer_connections[i] = shards[i]->num_peer_connections;
+
+  size_t index = 0;
+  if (policy) {
+    index = policy->SelectThread(peer_connections);
+    if (index >= peer_connections.size()) {
+      LOG(LS_WARNING) << "Thread " << index << " selected out of "
+                      << peer_connections.size() << ", using the first.";
+      index = 0;
+    }
+  } else {
+    index = std::min_element(peer_connections.begin(),
+                             peer_connections.end()) -
+            peer_connections.begin();
+  }
+  // Start one thread at a time, whichever of the ones not yet started was
+  // selected.
+  return std::min(index, shards.size());
+}
+
+}  // namespace
+
 rtc::scoped_refptr<PeerConnectionFactoryInterface>
 CreatePeerConnectionFactory() {
   rtc::scoped_refptr<PeerConnectionFactory> pc_factory(
@@ -125,10 +166,10 @@ PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   channel_manager_.reset(nullptr);
 
-  // Make sure |worker_thread_| and |signaling_thread_| outlive
-  // |default_socket_factory_| and |default_network_manager_|.
-  default_socket_factory_ = nullptr;
-  default_network_manager_ = nullptr;
+  // Make sure |worker_thread_| and |signaling_thread_| outlive the network
+  // managers and socket factories, and stop the extra threads.
+  network_shards_.clear();
+  worker_shards_.clear();
 
   if (owns_ptrs_) {
     if (wraps_current_thread_)
@@ -142,16 +183,8 @@ bool PeerConnectionFactory::Initialize() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   rtc::InitRandom(rtc::Time32());
 
-  default_network_manager_.reset(new rtc::BasicNetworkManager());
-  if (!default_network_manager_) {
-    return false;
-  }
-
-  default_socket_factory_.reset(
-      new rtc::BasicPacketSocketFactory(network_thread_));
-  if (!default_socket_factory_) {
-    return false;
-  }
+  network_shards_.emplace_back(new NetworkShard(network_thread_));
+  worker_shards_.emplace_back(new WorkerShard(worker_thread_));
 
   // TODO:  Need to make sure only one VoE is created inside
   // WebRtcMediaEngine.
@@ -253,22 +286,31 @@ PeerConnectionFactory::CreatePeerConnection(
     PeerConnectionObserver* observer) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
 
+  // An injected allocator may be tied to |network_thread_|, so only
+  // PeerConnections using the default one are spread over network threads.
+  NetworkShard* shard =
+      allocator ? network_shards_[0].get() : SelectNetworkShard();
+  ++shard->num_peer_connections;
+  // The voice engine runs on |worker_thread_|, so only PeerConnections
+  // without audio are spread over worker threads.
+  WorkerShard* worker_shard = configuration.disable_audio
+                                  ? SelectWorkerShard()
+                                  : worker_shards_[0].get();
+  ++worker_shard->num_peer_connections;
+
   if (!cert_generator.get()) {
     // No certificate generator specified, use the default one.
     cert_generator.reset(
-        new rtc::RTCCertificateGenerator(signaling_thread_, network_thread_));
+        new rtc::RTCCertificateGenerator(signaling_thread_, shard->thread));
   }
 
   if (!allocator) {
     allocator.reset(new cricket::BasicPortAllocator(
-        default_network_manager_.get(), default_socket_factory_.get()));
+        shard->network_manager.get(), shard->socket_factory.get()));
   }
-  network_thread_->Invoke<void>(
-      RTC_FROM_HERE, rtc::Bind(&cricket::PortAllocator::SetNetworkIgnoreMask,
-                               allocator.get(), options_.network_ignore_mask));
-
   rtc::scoped_refptr<PeerConnection> pc(
-      new rtc::RefCountedObject<PeerConnection>(this));
+      new rtc::RefCountedObject<PeerConnection>(this, shard->thread,
+                                                worker_shard->thread));
 
   if (!pc->Initialize(configuration, std::move(allocator),
                       std::move(cert_generator), observer)) {
@@ -303,17 +345,38 @@ PeerConnectionFactory::CreateAudioTrack(const std::string& id,
 
 webrtc::MediaControllerInterface* PeerConnectionFactory::CreateMediaController(
     const cricket::MediaConfig& config,
-    webrtc::RtcEventLog* event_log) const {
+    webrtc::RtcEventLog* event_log,
+    rtc::Thread* worker_thread) const {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  return MediaControllerInterface::Create(config, worker_thread_,
+  return MediaControllerInterface::Create(config, worker_thread,
                                           channel_manager_.get(), event_log);
 }
 
+void PeerConnectionFactory::ReleaseThreads(rtc::Thread* network_thread,
+                                           rtc::Thread* worker_thread) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  for (const auto& shard : network_shards_) {
+    if (shard->thread == network_thread) {
+      RTC_DCHECK_GT(shard->num_peer_connections, 0);
+      --shard->num_peer_connections;
+      break;
+    }
+  }
+  for (const auto& shard : worker_shards_) {
+    if (shard->thread == worker_thread) {
+      RTC_DCHECK_GT(shard->num_peer_connections, 0);
+      --shard->num_peer_connections;
+      break;
+    }
+  }
+}
+
 cricket::TransportController* PeerConnectionFactory::CreateTransportController(
     cricket::PortAllocator* port_allocator,
-    bool redetermine_role_on_ice_restart) {
+    bool redetermine_role_on_ice_restart,
+    rtc::Thread* network_thread) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  return new cricket::TransportController(signaling_thread_, network_thread_,
+  return new cricket::TransportController(signaling_thread_, network_thread,
                                           port_allocator,
                                           redetermine_role_on_ice_restart);
 }
@@ -333,6 +396,69 @@ rtc::Thread* PeerConnectionFactory::network_thread() {
   return network_thread_;
 }
 
+PeerConnectionFactory::NetworkShard::NetworkShard(rtc::Thread* thread)
+    : thread(thread),
+      network_manager(new rtc::BasicNetworkManager()),
+      socket_factory(new rtc::BasicPacketSocketFactory(thread)) {}
+
+PeerConnectionFactory::NetworkShard::~NetworkShard() = default;
+
+PeerConnectionFactory::WorkerShard::WorkerShard(rtc::Thread* thread)
+    : thread(thread) {}
+
+PeerConnectionFactory::WorkerShard::~WorkerShard() = default;
+
+PeerConnectionFactory::NetworkShard*
+PeerConnectionFactory::SelectNetworkShard() {
+  const size_t index = SelectThread(options_.network_thread_policy.get(),
+                                    options_.num_network_threads,
+                                    network_shards_);
+  if (index == network_shards_.size()) {
+    std::unique_ptr<rtc::Thread> thread =
+        rtc::Thread::CreateWithSocketServer();
+    thread->SetName("network_thread " + std::to_string(index), nullptr);
+    thread->Start();
+    thread->Invoke<bool>(
+        RTC_FROM_HERE,
+        rtc::Bind(&rtc::Thread::SetAllowBlockingCalls, thread.get(), false));
+    network_shards_.emplace_back(new NetworkShard(thread.get()));
+    network_shards_.back()->owned_thread = std::move(thread);
+  }
+  return network_shards_[index].get();
+}
+
+PeerConnectionFactory::WorkerShard* PeerConnectionFactory::SelectWorkerShard() {
+  const size_t index =
+      SelectThread(options_.worker_thread_policy.get(),
+                   options_.num_worker_threads, worker_shards_);
+  if (index == worker_shards_.size()) {
+    std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+    thread->SetName("worker_thread " + std::to_string(index), nullptr);
+    thread->Start();
+    thread->Invoke<void>(
+        RTC_FROM_HERE,
+        rtc::Bind(&PeerConnectionFactory::ConfigureWorkerThread_w, this,
+                  index));
+    worker_shards_.emplace_back(new WorkerShard(thread.get()));
+    worker_shards_.back()->owned_thread = std::move(thread);
+  }
+  return worker_shards_[index].get();
+}
+
+void PeerConnectionFactory::ConfigureWorkerThread_w(size_t index) {
+  // |index| is at least 1, the factory's own worker thread being the first.
+  const std::vector<int>& cpus = options_.worker_thread_cpus;
+  if (!cpus.empty()) {
+    const int cpu = cpus[(index - 1) % cpus.size()];
+    if (!rtc::SetCurrentThreadAffinity(cpu))
+      LOG(LS_WARNING) << "Failed to restrict worker thread to CPU " << cpu;
+  }
+  if (options_.worker_thread_priority &&
+      !rtc::SetCurrentThreadPriority(*options_.worker_thread_priority)) {
+    LOG(LS_WARNING) << "Failed to set worker thread priority.";
+  }
+}
+
 cricket::MediaEngineInterface* PeerConnectionFactory::CreateMediaEngine_w() {
   ASSERT(worker_thread_ == rtc::Thread::Current());
   return cricket::WebRtcMediaEngineFactory::Create(
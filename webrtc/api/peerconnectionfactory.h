@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "webrtc/api/mediacontroller.h"
 #include "webrtc/api/mediastreaminterface.h"
@@ -92,15 +93,26 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
 
   virtual webrtc::MediaControllerInterface* CreateMediaController(
       const cricket::MediaConfig& config,
-      RtcEventLog* event_log) const;
+      RtcEventLog* event_log,
+      rtc::Thread* worker_thread) const;
   virtual cricket::TransportController* CreateTransportController(
       cricket::PortAllocator* port_allocator,
-      bool redetermine_role_on_ice_restart);
+      bool redetermine_role_on_ice_restart,
+      rtc::Thread* network_thread);
   virtual rtc::Thread* signaling_thread();
+  // The factory's own worker thread, which the voice engine runs on.
+  // PeerConnections may be pinned to others if Options::num_worker_threads is
+  // more than one.
   virtual rtc::Thread* worker_thread();
+  // The factory's own network thread. PeerConnections may be pinned to others
+  // if Options::num_network_threads is more than one.
   virtual rtc::Thread* network_thread();
   const Options& options() const { return options_; }
 
+  // Called by a PeerConnection that was pinned to |network_thread| and
+  // |worker_thread| when it no longer uses them.
+  void ReleaseThreads(rtc::Thread* network_thread, rtc::Thread* worker_thread);
+
  protected:
   PeerConnectionFactory();
   PeerConnectionFactory(
@@ -115,7 +127,40 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual ~PeerConnectionFactory();
 
  private:
+  // A network thread and the network manager and socket factory that the
+  // default port allocators of the PeerConnections pinned to it use.
+  struct NetworkShard {
+    explicit NetworkShard(rtc::Thread* thread);
+    ~NetworkShard();
+
+    // Set for the threads the factory starts beyond |network_thread_|.
+    std::unique_ptr<rtc::Thread> owned_thread;
+    rtc::Thread* thread;
+    std::unique_ptr<rtc::BasicNetworkManager> network_manager;
+    std::unique_ptr<rtc::BasicPacketSocketFactory> socket_factory;
+    int num_peer_connections = 0;
+  };
+
+  // A worker thread and the number of PeerConnections pinned to it.
+  struct WorkerShard {
+    explicit WorkerShard(rtc::Thread* thread);
+    ~WorkerShard();
+
+    // Set for the threads the factory starts beyond |worker_thread_|.
+    std::unique_ptr<rtc::Thread> owned_thread;
+    rtc::Thread* thread;
+    int num_peer_connections = 0;
+  };
+
   cricket::MediaEngineInterface* CreateMediaEngine_w();
+  // Pick the shards for a new PeerConnection, starting a thread for it if
+  // Options::num_network_threads or num_worker_threads allows more than there
+  // are.
+  NetworkShard* SelectNetworkShard();
+  WorkerShard* SelectWorkerShard();
+  // Applies the worker thread affinity and priority options to the |index|th
+  // worker thread. Runs on that thread.
+  void ConfigureWorkerThread_w(size_t index);
 
   bool owns_ptrs_;
   bool wraps_current_thread_;
@@ -133,8 +178,9 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   // External Video decoder factory. This can be NULL if the client has not
   // injected any. In that case, video engine will use the internal SW decoder.
   std::unique_ptr<cricket::WebRtcVideoDecoderFactory> video_decoder_factory_;
-  std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_;
-  std::unique_ptr<rtc::BasicPacketSocketFactory> default_socket_factory_;
+  // The first shards are on |network_thread_| and |worker_thread_|.
+  std::vector<std::unique_ptr<NetworkShard>> network_shards_;
+  std::vector<std::unique_ptr<WorkerShard>> worker_shards_;
 };
 
 }  // namespace webrtc
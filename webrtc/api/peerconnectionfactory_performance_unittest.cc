@@ -0,0 +1,351 @@
+/*
+ *  Copyright 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "webrtc/api/peerconnectioninterface.h"
+#include "webrtc/api/test/peerconnectiontestwrapper.h"
+// Notice that mockpeerconnectionobservers.h must be included after the above!
+#include "webrtc/api/test/mockpeerconnectionobservers.h"
+#ifdef WEBRTC_ANDROID
+#include "webrtc/api/test/androidtestinitializer.h"
+#endif
+#include "webrtc/api/test/fakeaudiocapturemodule.h"
+#include "webrtc/api/test/fakertccertificategenerator.h"
+#include "webrtc/base/gunit.h"
+#include "webrtc/base/sigslot.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/systeminfo.h"
+#include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/p2p/base/fakeportallocator.h"
+#include "webrtc/test/testsupport/benchmark.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+using webrtc::DataChannelInterface;
+using webrtc::MediaStreamInterface;
+using webrtc::PeerConnectionFactoryInterface;
+using webrtc::PeerConnectionInterface;
+using webrtc::PeerConnectionObserver;
+
+namespace {
+
+const int kNumPeerConnections = 200;
+const int kMaxWait = 10000;
+// Pairs of PeerConnections, as many as a small SFU has, spread over the
+// network or worker threads.
+const int kNumPeerConnectionPairs = 8;
+const int kMessagesPerPair = 100;
+const size_t kMessageSize = 1000;
+
+class NullPeerConnectionObserver : public PeerConnectionObserver {
+ public:
+  void OnSignalingChange(
+      PeerConnectionInterface::SignalingState new_state) override {}
+  void OnAddStream(rtc::scoped_refptr<MediaStreamInterface> stream) override {}
+  void OnRemoveStream(
+      rtc::scoped_refptr<MediaStreamInterface> stream) override {}
+  void OnDataChannel(
+      rtc::scoped_refptr<DataChannelInterface> data_channel) override {}
+  void OnRenegotiationNeeded() override {}
+  void OnIceConnectionChange(
+      PeerConnectionInterface::IceConnectionState new_state) override {}
+  void OnIceGatheringChange(
+      PeerConnectionInterface::IceGatheringState new_state) override {}
+  void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override {
+  }
+};
+
+// Pins each new PeerConnection to the next network thread in turn.
+class RoundRobinThreadPinningPolicy : public webrtc::ThreadPinningPolicy {
+ public:
+  size_t SelectThread(const std::vector<int>& peer_connections) override {
+    return next_thread_++ % peer_connections.size();
+  }
+
+ private:
+  size_t next_thread_ = 0;
+};
+
+// A caller and a callee, both created by the same factory, connected to each
+// other with a data channel from the caller to the callee.
+class PeerConnectionPair : public sigslot::has_slots<> {
+ public:
+  PeerConnectionPair(rtc::Thread* network_thread, rtc::Thread* worker_thread)
+      : caller_(new rtc::RefCountedObject<PeerConnectionTestWrapper>(
+            "caller", network_thread, worker_thread)),
+        callee_(new rtc::RefCountedObject<PeerConnectionTestWrapper>(
+            "callee", network_thread, worker_thread)) {}
+
+  void Connect(PeerConnectionFactoryInterface* factory,
+               const PeerConnectionInterface::RTCConfiguration& config) {
+    ASSERT_TRUE(caller_->CreatePc(config, factory));
+    ASSERT_TRUE(callee_->CreatePc(config, factory));
+    PeerConnectionTestWrapper::Connect(caller_.get(), callee_.get());
+    callee_->SignalOnDataChannel.connect(
+        this, &PeerConnectionPair::OnCalleeDataChannel);
+
+    caller_dc_ = caller_->CreateDataChannel("data", webrtc::DataChannelInit());
+    caller_->CreateOffer(nullptr);
+    caller_->WaitForConnection();
+    callee_->WaitForConnection();
+    EXPECT_TRUE_WAIT(caller_dc_->state() == DataChannelInterface::kOpen,
+                     kMaxWait);
+    EXPECT_TRUE_WAIT(callee_observer_ != nullptr, kMaxWait);
+  }
+
+  void Send(const webrtc::DataBuffer& buffer) {
+    EXPECT_TRUE(caller_dc_->Send(buffer));
+  }
+
+  size_t received_message_count() const {
+    return callee_observer_ ? callee_observer_->received_message_count() : 0;
+  }
+
+ private:
+  void OnCalleeDataChannel(DataChannelInterface* dc) {
+    callee_observer_.reset(new webrtc::CountingDataChannelObserver(dc));
+  }
+
+  rtc::scoped_refptr<PeerConnectionTestWrapper> caller_;
+  rtc::scoped_refptr<PeerConnectionTestWrapper> callee_;
+  rtc::scoped_refptr<DataChannelInterface> caller_dc_;
+  std::unique_ptr<webrtc::CountingDataChannelObserver> callee_observer_;
+};
+
+// Returns the |percentile| of the sorted |values|.
+int64_t Percentile(const std::vector<int64_t>& values, int percentile) {
+  return values[(values.size() - 1) * percentile / 100];
+}
+
+}  // namespace
+
+class PeerConnectionFactoryPerformanceTest : public testing::Test {
+ protected:
+  void SetUp() override {
+#ifdef WEBRTC_ANDROID
+    webrtc::InitializeAndroidObjects();
+#endif
+    network_thread_ = rtc::Thread::CreateWithSocketServer();
+    worker_thread_ = rtc::Thread::Create();
+    ASSERT_TRUE(network_thread_->Start());
+    ASSERT_TRUE(worker_thread_->Start());
+    factory_ = webrtc::CreatePeerConnectionFactory(
+        network_thread_.get(), worker_thread_.get(), rtc::Thread::Current(),
+        FakeAudioCaptureModule::Create(), nullptr, nullptr);
+    ASSERT_TRUE(factory_);
+  }
+
+  void TearDown() override {
+    factory_ = nullptr;
+    worker_thread_->Stop();
+    network_thread_->Stop();
+  }
+
+  // Creates |kNumPeerConnections| PeerConnections back to back, as a gateway
+  // accepting a burst of calls does, and reports the setup latency
+  // percentiles and the number of PeerConnections created per second. With
+  // |shared_certificate| set, all PeerConnections use the same pre-generated
+  // certificate instead of getting their own certificate generator.
+  void RunCreationTest(bool shared_certificate, const std::string& trace) {
+    PeerConnectionInterface::RTCConfiguration config;
+    if (shared_certificate)
+      config.certificates.push_back(
+          FakeRTCCertificateGenerator::GenerateCertificate());
+
+    std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+    std::vector<int64_t> latencies_us;
+    const int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumPeerConnections; ++i) {
+      const int64_t pc_start_us = rtc::TimeMicros();
+      std::unique_ptr<rtc::RTCCertificateGeneratorInterface> cert_generator;
+      if (!shared_certificate)
+        cert_generator.reset(new FakeRTCCertificateGenerator());
+      pcs.push_back(factory_->CreatePeerConnection(
+          config, std::unique_ptr<cricket::PortAllocator>(
+                      new cricket::FakePortAllocator(network_thread_.get(),
+                                                     nullptr)),
+          std::move(cert_generator), &observer_));
+      latencies_us.push_back(rtc::TimeMicros() - pc_start_us);
+      ASSERT_TRUE(pcs.back());
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+    const int64_t destroy_start_us = rtc::TimeMicros();
+    pcs.clear();
+    const int64_t destroy_us = rtc::TimeMicros() - destroy_start_us;
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    for (int percentile : {50, 90, 99}) {
+      webrtc::test::PrintResult(
+          "peerconnection_setup_time", "_p" + std::to_string(percentile),
+          trace, static_cast<size_t>(Percentile(latencies_us, percentile)),
+          "us", true);
+    }
+    webrtc::test::PrintResult(
+        "peerconnection_creation_rate", "", trace,
+        static_cast<size_t>(kNumPeerConnections * rtc::kNumMicrosecsPerSec /
+                            std::max<int64_t>(elapsed_us, 1)),
+        "pcs/s", true);
+    webrtc::test::PrintResult(
+        "peerconnection_teardown_time", "", trace,
+        static_cast<size_t>(destroy_us / kNumPeerConnections), "us", true);
+  }
+
+  // Spreads |kNumPeerConnectionPairs| pairs of PeerConnections over
+  // |num_network_threads| network threads of the factory, one PeerConnection
+  // per thread in turn, and measures how long it takes every pair to move
+  // |kMessagesPerPair| messages over its data channel. SCTP runs on the
+  // single worker thread, so only the DTLS, ICE and socket work is spread.
+  void RunNetworkThreadsTest(int num_network_threads) {
+    PeerConnectionFactoryInterface::Options options;
+    options.num_network_threads = num_network_threads;
+    options.network_thread_policy =
+        new rtc::RefCountedObject<RoundRobinThreadPinningPolicy>();
+    // The pairs connect over loopback when that is all there is.
+    options.network_ignore_mask = 0;
+    factory_->SetOptions(options);
+
+    RunDataChannelBenchmark(
+        PeerConnectionInterface::RTCConfiguration(),
+        "network_threads_datachannel_" +
+            std::to_string(kNumPeerConnectionPairs) + "_pairs_" +
+            std::to_string(num_network_threads) + "_threads");
+  }
+
+  // Like RunNetworkThreadsTest(), but spreads the pairs over
+  // |num_worker_threads| worker threads, each on a CPU of its own where there
+  // are enough and at high priority, while they share one network thread.
+  // The PeerConnections carry no audio, so that the factory may spread them,
+  // and SCTP runs on each one's worker thread.
+  void RunWorkerThreadsTest(int num_worker_threads) {
+    PeerConnectionFactoryInterface::Options options;
+    options.num_worker_threads = num_worker_threads;
+    options.worker_thread_policy =
+        new rtc::RefCountedObject<RoundRobinThreadPinningPolicy>();
+    // The factory's own worker thread stays where it is, so the ones it
+    // starts get the CPUs after the first.
+    const int num_cpus = rtc::SystemInfo::GetMaxCpus();
+    for (int cpu = 1; cpu < std::min(num_worker_threads, num_cpus); ++cpu)
+      options.worker_thread_cpus.push_back(cpu);
+    options.worker_thread_priority =
+        rtc::Optional<rtc::ThreadPriority>(rtc::kHighPriority);
+    options.network_ignore_mask = 0;
+    factory_->SetOptions(options);
+
+    PeerConnectionInterface::RTCConfiguration config;
+    config.disable_audio = true;
+    RunDataChannelBenchmark(
+        config, "worker_threads_datachannel_" +
+                    std::to_string(kNumPeerConnectionPairs) + "_pairs_" +
+                    std::to_string(num_worker_threads) + "_threads");
+  }
+
+  // Connects |kNumPeerConnectionPairs| pairs of PeerConnections created with
+  // |config| and reports, as |name|, how long it takes every pair to move
+  // |kMessagesPerPair| messages over its data channel.
+  void RunDataChannelBenchmark(
+      const PeerConnectionInterface::RTCConfiguration& config,
+      const std::string& name) {
+    // Data channels need DTLS.
+    if (!rtc::SSLStreamAdapter::HaveDtlsSrtp())
+      return;
+
+    std::vector<std::unique_ptr<PeerConnectionPair>> pairs;
+    for (int i = 0; i < kNumPeerConnectionPairs; ++i) {
+      pairs.emplace_back(
+          new PeerConnectionPair(network_thread_.get(), worker_thread_.get()));
+      pairs.back()->Connect(factory_, config);
+      if (HasFatalFailure())
+        return;
+    }
+
+    webrtc::test::BenchmarkOptions benchmark_options;
+    benchmark_options.warmup_iterations = 1;
+    benchmark_options.repetitions = 10;
+    benchmark_options.iterations = 1;
+    const webrtc::DataBuffer buffer(std::string(kMessageSize, 'a'));
+    size_t messages_per_pair = 0;
+    webrtc::test::BenchmarkResult result = webrtc::test::RunBenchmark(
+        name, benchmark_options, [&] {
+          for (const auto& pair : pairs) {
+            for (int i = 0; i < kMessagesPerPair; ++i)
+              pair->Send(buffer);
+          }
+          messages_per_pair += kMessagesPerPair;
+          EXPECT_TRUE_WAIT(
+              std::all_of(pairs.begin(), pairs.end(),
+                          [messages_per_pair](
+                              const std::unique_ptr<PeerConnectionPair>& pair) {
+                            return pair->received_message_count() ==
+                                   messages_per_pair;
+                          }),
+              kMaxWait);
+        });
+    const double messages = kNumPeerConnectionPairs * kMessagesPerPair;
+    result.counters.push_back({"messages", messages, "messages"});
+    result.counters.push_back({"bytes", messages * kMessageSize, "bytes"});
+    webrtc::test::ReportBenchmark(result);
+  }
+
+  std::unique_ptr<rtc::Thread> network_thread_;
+  std::unique_ptr<rtc::Thread> worker_thread_;
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> factory_;
+  NullPeerConnectionObserver observer_;
+};
+
+// These tests create hundreds of PeerConnections, so they are only run manually
+// with --gtest_also_run_disabled_tests
+// --gtest_filter=PeerConnectionFactoryPerformanceTest.*
+TEST_F(PeerConnectionFactoryPerformanceTest,
+       DISABLED_CreateWithCertificateGenerator) {
+  RunCreationTest(false, "certificate_generator");
+}
+
+TEST_F(PeerConnectionFactoryPerformanceTest,
+       DISABLED_CreateWithSharedCertificate) {
+  RunCreationTest(true, "shared_certificate");
+}
+
+// These tests connect pairs of PeerConnections through one factory with
+// Options::num_network_threads set, so they are only run manually with
+// --gtest_also_run_disabled_tests
+// --gtest_filter=PeerConnectionFactoryPerformanceTest.*NetworkThread*
+TEST_F(PeerConnectionFactoryPerformanceTest, DISABLED_OneNetworkThread) {
+  RunNetworkThreadsTest(1);
+}
+
+TEST_F(PeerConnectionFactoryPerformanceTest, DISABLED_TwoNetworkThreads) {
+  RunNetworkThreadsTest(2);
+}
+
+TEST_F(PeerConnectionFactoryPerformanceTest, DISABLED_FourNetworkThreads) {
+  RunNetworkThreadsTest(4);
+}
+
+// These tests connect pairs of audio-less PeerConnections through one factory
+// with Options::num_worker_threads set, so they are only run manually with
+// --gtest_also_run_disabled_tests
+// --gtest_filter=PeerConnectionFactoryPerformanceTest.*WorkerThread*
+TEST_F(PeerConnectionFactoryPerformanceTest, DISABLED_OneWorkerThread) {
+  RunWorkerThreadsTest(1);
+}
+
+TEST_F(PeerConnectionFactoryPerformanceTest, DISABLED_TwoWorkerThreads) {
+  RunWorkerThreadsTest(2);
+}
+
+TEST_F(PeerConnectionFactoryPerformanceTest, DISABLED_FourWorkerThreads) {
+  RunWorkerThreadsTest(4);
+}
@@ -8,9 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "webrtc/api/mediastreaminterface.h"
 #include "webrtc/api/peerconnectionfactory.h"
@@ -149,6 +151,96 @@ TEST(PeerConnectionFactoryTestInternal, CreatePCUsingInternalModules) {
   EXPECT_TRUE(pc.get() != nullptr);
 }
 
+// Records the load it is asked to pin PeerConnections by and pins each to the
+// least loaded thread.
+class RecordingThreadPinningPolicy : public webrtc::ThreadPinningPolicy {
+ public:
+  size_t SelectThread(const std::vector<int>& peer_connections) override {
+    loads.push_back(peer_connections);
+    return std::min_element(peer_connections.begin(),
+                            peer_connections.end()) -
+           peer_connections.begin();
+  }
+
+  std::vector<std::vector<int>> loads;
+};
+
+// Verify PeerConnections are spread over the network threads and that a
+// closed PeerConnection no longer counts against its thread.
+TEST(PeerConnectionFactoryTestInternal, SpreadsPCsOverNetworkThreads) {
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> factory(
+      webrtc::CreatePeerConnectionFactory());
+  rtc::scoped_refptr<RecordingThreadPinningPolicy> policy(
+      new rtc::RefCountedObject<RecordingThreadPinningPolicy>());
+  PeerConnectionFactoryInterface::Options options;
+  options.num_network_threads = 2;
+  options.network_thread_policy = policy;
+  factory->SetOptions(options);
+
+  NullPeerConnectionObserver observer;
+  webrtc::PeerConnectionInterface::RTCConfiguration config;
+  rtc::scoped_refptr<PeerConnectionInterface> pcs[3];
+  for (auto& pc : pcs) {
+    std::unique_ptr<FakeRTCCertificateGenerator> cert_generator(
+        new FakeRTCCertificateGenerator());
+    pc = factory->CreatePeerConnection(config, nullptr, nullptr,
+                                       std::move(cert_generator), &observer);
+    ASSERT_TRUE(pc.get() != nullptr);
+  }
+  pcs[1] = nullptr;
+  std::unique_ptr<FakeRTCCertificateGenerator> cert_generator(
+      new FakeRTCCertificateGenerator());
+  rtc::scoped_refptr<PeerConnectionInterface> pc(factory->CreatePeerConnection(
+      config, nullptr, nullptr, std::move(cert_generator), &observer));
+  EXPECT_TRUE(pc.get() != nullptr);
+
+  const std::vector<std::vector<int>> expected = {
+      {0, 0}, {1, 0}, {1, 1}, {2, 0}};
+  EXPECT_EQ(expected, policy->loads);
+}
+
+// Verify PeerConnections are spread over the worker threads the same way.
+TEST(PeerConnectionFactoryTestInternal, SpreadsPCsOverWorkerThreads) {
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> factory(
+      webrtc::CreatePeerConnectionFactory());
+  rtc::scoped_refptr<RecordingThreadPinningPolicy> policy(
+      new rtc::RefCountedObject<RecordingThreadPinningPolicy>());
+  PeerConnectionFactoryInterface::Options options;
+  options.num_worker_threads = 3;
+  options.worker_thread_policy = policy;
+  factory->SetOptions(options);
+
+  NullPeerConnectionObserver observer;
+  webrtc::PeerConnectionInterface::RTCConfiguration config;
+  config.disable_audio = true;
+  rtc::scoped_refptr<PeerConnectionInterface> pcs[4];
+  for (auto& pc : pcs) {
+    std::unique_ptr<FakeRTCCertificateGenerator> cert_generator(
+        new FakeRTCCertificateGenerator());
+    pc = factory->CreatePeerConnection(config, nullptr, nullptr,
+                                       std::move(cert_generator), &observer);
+    ASSERT_TRUE(pc.get() != nullptr);
+  }
+
+  // PeerConnections that may carry audio stay on the first worker thread,
+  // without asking the policy, but count against it.
+  std::unique_ptr<FakeRTCCertificateGenerator> cert_generator(
+      new FakeRTCCertificateGenerator());
+  webrtc::PeerConnectionInterface::RTCConfiguration audio_config;
+  rtc::scoped_refptr<PeerConnectionInterface> audio_pc(
+      factory->CreatePeerConnection(audio_config, nullptr, nullptr,
+                                    std::move(cert_generator), &observer));
+  ASSERT_TRUE(audio_pc.get() != nullptr);
+  cert_generator.reset(new FakeRTCCertificateGenerator());
+  rtc::scoped_refptr<PeerConnectionInterface> pc(factory->CreatePeerConnection(
+      config, nullptr, nullptr, std::move(cert_generator), &observer));
+  ASSERT_TRUE(pc.get() != nullptr);
+
+  const std::vector<std::vector<int>> expected = {
+      {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {1, 1, 1}, {3, 1, 1}};
+  EXPECT_EQ(expected, policy->loads);
+}
+
 // This test verifies creation of PeerConnection with valid STUN and TURN
 // configuration. Also verifies the URL's parsed correctly as expected.
 TEST_F(PeerConnectionFactoryTest, CreatePCUsingIceServers) {
@@ -67,6 +67,8 @@
 #include "webrtc/api/umametrics.h"
 #include "webrtc/base/fileutils.h"
 #include "webrtc/base/network.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/base/rtccertificate.h"
 #include "webrtc/base/rtccertificategenerator.h"
 #include "webrtc/base/socketaddress.h"
@@ -257,6 +259,11 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
     bool dscp() { return media_config.enable_dscp; }
     void set_dscp(bool enable) { media_config.enable_dscp = enable; }
 
+    bool aggregate_rtcp() { return media_config.aggregate_rtcp; }
+    void set_aggregate_rtcp(bool enable) {
+      media_config.aggregate_rtcp = enable;
+    }
+
     // TODO(nisse): The corresponding flag in MediaConfig and
     // elsewhere should be renamed enable_cpu_adaptation.
     bool cpu_adaptation() {
@@ -327,6 +334,13 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
     // If true, ICE role is redetermined when peerconnection sets a local
     // transport description that indicates an ICE restart.
     bool redetermine_role_on_ice_restart = true;
+    // If true, this PeerConnection carries no audio, so the factory may pin
+    // it to any of its worker threads. See
+    // PeerConnectionFactoryInterface::Options::num_worker_threads. Otherwise
+    // it is pinned to the worker thread that the voice engine runs on.
+    // SetLocalDescription and SetRemoteDescription fail for descriptions with
+    // an audio m-line that isn't rejected.
+    bool disable_audio = false;
   };
 
   struct RTCOfferAnswerOptions {
@@ -598,6 +612,18 @@ class PeerConnectionObserver {
   ~PeerConnectionObserver() {}
 };
 
+// Picks the thread, out of several a factory has of a kind, that a new
+// PeerConnection is pinned to for its lifetime.
+class ThreadPinningPolicy : public rtc::RefCountInterface {
+ public:
+  // |peer_connections| holds the number of live PeerConnections pinned to
+  // each of the threads. Returns the index of the thread for the new one.
+  virtual size_t SelectThread(const std::vector<int>& peer_connections) = 0;
+
+ protected:
+  ~ThreadPinningPolicy() override {}
+};
+
 // PeerConnectionFactoryInterface is the factory interface use for creating
 // PeerConnection, MediaStream and media tracks.
 // PeerConnectionFactoryInterface will create required libjingle threads,
@@ -617,7 +643,9 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
           disable_network_monitor(false),
           network_ignore_mask(rtc::kDefaultNetworkIgnoreMask),
           ssl_max_version(rtc::SSL_PROTOCOL_DTLS_12),
-          crypto_options(rtc::CryptoOptions::NoGcm()) {}
+          crypto_options(rtc::CryptoOptions::NoGcm()),
+          num_network_threads(1),
+          num_worker_threads(1) {}
     bool disable_encryption;
     bool disable_sctp_data_channels;
     bool disable_network_monitor;
@@ -634,6 +662,38 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
 
     // Sets crypto related options, e.g. enabled cipher suites.
     rtc::CryptoOptions crypto_options;
+
+    // Number of network threads to spread PeerConnections over. The factory
+    // starts the threads beyond its own network thread when needed. All of a
+    // PeerConnection's transports, sockets and the network side of its
+    // channels run on the thread it is pinned to. PeerConnections created
+    // with a PortAllocator of their own stay on the factory's network thread,
+    // which the allocator may be tied to.
+    int num_network_threads;
+
+    // Pins new PeerConnections to network threads. If null, each goes to the
+    // thread with the fewest.
+    rtc::scoped_refptr<ThreadPinningPolicy> network_thread_policy;
+
+    // Number of worker threads to spread PeerConnections over, each with its
+    // own Call and media channels. As with network threads, the factory
+    // starts the ones beyond its own when needed. The voice engine is tied to
+    // the factory's own worker thread, so only PeerConnections created with
+    // RTCConfiguration::disable_audio are spread. The others all stay on
+    // the factory's own worker thread, and count against its load.
+    int num_worker_threads;
+
+    // Pins new PeerConnections to worker threads. If null, each goes to the
+    // thread with the fewest.
+    rtc::scoped_refptr<ThreadPinningPolicy> worker_thread_policy;
+
+    // CPUs the worker threads the factory starts are restricted to, one CPU
+    // per thread in turn. Empty leaves them unrestricted. Linux and Android
+    // only.
+    std::vector<int> worker_thread_cpus;
+
+    // If set, the priority of the worker threads the factory starts.
+    rtc::Optional<rtc::ThreadPriority> worker_thread_priority;
   };
 
   virtual void SetOptions(const Options& options) = 0;
@@ -559,21 +559,24 @@ class PeerConnectionFactoryForTest : public webrtc::PeerConnectionFactory {
  public:
   webrtc::MediaControllerInterface* CreateMediaController(
       const cricket::MediaConfig& config,
-      webrtc::RtcEventLog* event_log) const override {
+      webrtc::RtcEventLog* event_log,
+      rtc::Thread* worker_thread) const override {
     create_media_controller_called_ = true;
     create_media_controller_config_ = config;
 
     webrtc::MediaControllerInterface* mc =
-        PeerConnectionFactory::CreateMediaController(config, event_log);
+        PeerConnectionFactory::CreateMediaController(config, event_log,
+                                                     worker_thread);
     EXPECT_TRUE(mc != nullptr);
     return mc;
   }
 
   cricket::TransportController* CreateTransportController(
       cricket::PortAllocator* port_allocator,
-      bool redetermine_role_on_ice_restart) override {
+      bool redetermine_role_on_ice_restart,
+      rtc::Thread* network_thread) override {
     transport_controller = new cricket::TransportController(
-        rtc::Thread::Current(), rtc::Thread::Current(), port_allocator,
+        rtc::Thread::Current(), network_thread, port_allocator,
         redetermine_role_on_ice_restart);
     return transport_controller;
   }
@@ -2671,6 +2674,7 @@ TEST_F(PeerConnectionMediaConfigTest, TestDefaults) {
   EXPECT_TRUE(media_config.video.enable_cpu_overuse_detection);
   EXPECT_FALSE(media_config.video.disable_prerenderer_smoothing);
   EXPECT_FALSE(media_config.video.suspend_below_min_bitrate);
+  EXPECT_FALSE(media_config.aggregate_rtcp);
 }
 
 // This test verifies the DSCP constraint is recognized and passed to
@@ -2700,6 +2704,19 @@ TEST_F(PeerConnectionMediaConfigTest, TestCpuOveruseConstraintFalse) {
   EXPECT_FALSE(media_config.video.enable_cpu_overuse_detection);
 }
 
+// This test verifies that the aggregate_rtcp flag is propagated from
+// RTCConfiguration to the CreateMediaController call.
+TEST_F(PeerConnectionMediaConfigTest, TestAggregateRtcpTrue) {
+  PeerConnectionInterface::RTCConfiguration config;
+  FakeConstraints constraints;
+
+  config.set_aggregate_rtcp(true);
+  const cricket::MediaConfig& media_config =
+      TestCreatePeerConnection(config, &constraints);
+
+  EXPECT_TRUE(media_config.aggregate_rtcp);
+}
+
 // This test verifies that the disable_prerenderer_smoothing flag is
 // propagated from RTCConfiguration to the CreateMediaController call.
 TEST_F(PeerConnectionMediaConfigTest, TestDisablePrerendererSmoothingTrue) {
@@ -19,7 +19,8 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
       : send_blocked_(false),
         transport_available_(false),
         ready_to_send_(false),
-        transport_error_(false) {}
+        transport_error_(false),
+        send_batch_count_(0) {}
   virtual ~FakeDataChannelProvider() {}
 
   bool SendData(const cricket::SendDataParams& params,
@@ -40,6 +41,20 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
     return true;
   }
 
+  size_t SendDataBatch(
+      const std::vector<cricket::OutgoingDataMessage>& messages,
+      cricket::SendDataResult* result) override {
+    ++send_batch_count_;
+    size_t sent = 0;
+    for (const cricket::OutgoingDataMessage& message : messages) {
+      if (!SendData(message.params, message.payload, result)) {
+        break;
+      }
+      ++sent;
+    }
+    return sent;
+  }
+
   bool ConnectDataChannel(webrtc::DataChannel* data_channel) override {
     ASSERT(connected_channels_.find(data_channel) == connected_channels_.end());
     if (!transport_available_) {
@@ -119,6 +134,8 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
     return last_send_data_params_;
   }
 
+  int send_batch_count() const { return send_batch_count_; }
+
   bool IsConnected(webrtc::DataChannel* data_channel) const {
     return connected_channels_.find(data_channel) != connected_channels_.end();
   }
@@ -137,6 +154,7 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
   bool transport_available_;
   bool ready_to_send_;
   bool transport_error_;
+  int send_batch_count_;
   std::set<webrtc::DataChannel*> connected_channels_;
   std::set<uint32_t> send_ssrcs_;
   std::set<uint32_t> recv_ssrcs_;
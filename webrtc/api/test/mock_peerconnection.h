@@ -26,11 +26,17 @@ class MockPeerConnection
     : public rtc::RefCountedObject<webrtc::PeerConnection> {
  public:
   MockPeerConnection()
-      : rtc::RefCountedObject<webrtc::PeerConnection>(
-            new FakePeerConnectionFactory()) {}
+      : MockPeerConnection(new FakePeerConnectionFactory()) {}
   MOCK_METHOD0(session, WebRtcSession*());
   MOCK_CONST_METHOD0(sctp_data_channels,
                      const std::vector<rtc::scoped_refptr<DataChannel>>&());
+
+ private:
+  explicit MockPeerConnection(FakePeerConnectionFactory* factory)
+      : rtc::RefCountedObject<webrtc::PeerConnection>(
+            factory,
+            factory->network_thread(),
+            factory->worker_thread()) {}
 };
 
 }  // namespace webrtc
@@ -103,6 +103,28 @@ class MockDataChannelObserver : public webrtc::DataChannelObserver {
   std::vector<std::string> messages_;
 };
 
+// Counts the received messages without keeping them around.
+class CountingDataChannelObserver : public webrtc::DataChannelObserver {
+ public:
+  explicit CountingDataChannelObserver(webrtc::DataChannelInterface* channel)
+      : channel_(channel), received_message_count_(0) {
+    channel_->RegisterObserver(this);
+  }
+  ~CountingDataChannelObserver() override { channel_->UnregisterObserver(); }
+
+  void OnStateChange() override {}
+  void OnBufferedAmountChange(uint64_t previous_amount) override {}
+  void OnMessage(const DataBuffer& buffer) override {
+    ++received_message_count_;
+  }
+
+  size_t received_message_count() const { return received_message_count_; }
+
+ private:
+  rtc::scoped_refptr<webrtc::DataChannelInterface> channel_;
+  size_t received_message_count_;
+};
+
 class MockStatsObserver : public webrtc::StatsObserver {
  public:
   MockStatsObserver() : called_(false), stats_() {}
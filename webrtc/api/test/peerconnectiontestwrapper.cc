@@ -85,6 +85,19 @@ bool PeerConnectionTestWrapper::CreatePc(
   return peer_connection_.get() != NULL;
 }
 
+bool PeerConnectionTestWrapper::CreatePc(
+    const webrtc::PeerConnectionInterface::RTCConfiguration& config,
+    webrtc::PeerConnectionFactoryInterface* factory) {
+  peer_connection_factory_ = factory;
+  std::unique_ptr<rtc::RTCCertificateGeneratorInterface> cert_generator(
+      rtc::SSLStreamAdapter::HaveDtlsSrtp() ? new FakeRTCCertificateGenerator()
+                                            : nullptr);
+  peer_connection_ = peer_connection_factory_->CreatePeerConnection(
+      config, nullptr, std::move(cert_generator), this);
+
+  return peer_connection_.get() != NULL;
+}
+
 rtc::scoped_refptr<webrtc::DataChannelInterface>
 PeerConnectionTestWrapper::CreateDataChannel(
     const std::string& label,
@@ -35,6 +35,12 @@ class PeerConnectionTestWrapper
   bool CreatePc(
       const webrtc::MediaConstraintsInterface* constraints,
       const webrtc::PeerConnectionInterface::RTCConfiguration& config);
+  // Creates the PeerConnection with |factory| instead of a factory of its own,
+  // and with the factory's default port allocator, so that it is pinned to one
+  // of the factory's network threads. WaitForAudio can't be used with it.
+  bool CreatePc(
+      const webrtc::PeerConnectionInterface::RTCConfiguration& config,
+      webrtc::PeerConnectionFactoryInterface* factory);
 
   rtc::scoped_refptr<webrtc::DataChannelInterface> CreateDataChannel(
       const std::string& label,
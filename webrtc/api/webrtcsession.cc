@@ -57,6 +57,9 @@ using cricket::PRFLX_PORT_TYPE;
 namespace webrtc {
 
 // Error messages
+const char kAudioDisabled[] =
+    "Audio is disabled for this PeerConnection by "
+    "RTCConfiguration::disable_audio; audio m-lines must be rejected.";
 const char kBundleWithoutRtcpMux[] = "RTCP-MUX must be enabled when BUNDLE "
                                      "is enabled.";
 const char kCreateChannelFailed[] = "Failed to create channels.";
@@ -231,6 +234,15 @@ static bool VerifyIceUfragPwdPresent(const SessionDescription* desc) {
   return true;
 }
 
+// Checks that every audio content is rejected.
+static bool VerifyNoActiveAudio(const SessionDescription* desc) {
+  for (const ContentInfo& content : desc->contents()) {
+    if (cricket::IsAudioContent(&content) && !content.rejected)
+      return false;
+  }
+  return true;
+}
+
 // Forces |sdesc->crypto_required| to the appropriate state based on the
 // current security policy, to ensure a failure occurs if there is an error
 // in crypto negotiation.
@@ -480,6 +492,7 @@ WebRtcSession::WebRtcSession(
       ice_connection_receiving_(true),
       older_version_remote_peer_(false),
       dtls_enabled_(false),
+      disable_audio_(false),
       data_channel_type_(cricket::DCT_NONE),
       metrics_observer_(NULL) {
   transport_controller_->SetIceRole(cricket::ICEROLE_CONTROLLED);
@@ -529,7 +542,15 @@ bool WebRtcSession::Initialize(
     const PeerConnectionInterface::RTCConfiguration& rtc_configuration) {
   bundle_policy_ = rtc_configuration.bundle_policy;
   rtcp_mux_policy_ = rtc_configuration.rtcp_mux_policy;
-  transport_controller_->SetSslMaxProtocolVersion(options.ssl_max_version);
+  disable_audio_ = rtc_configuration.disable_audio;
+
+  // Configure the transport controller with a single trip to the network
+  // thread; its methods run synchronously when called from there.
+  const cricket::IceConfig ice_config = ParseIceConfig(rtc_configuration);
+  network_thread()->Invoke<void>(RTC_FROM_HERE, [this, &options, &ice_config] {
+    transport_controller_->SetSslMaxProtocolVersion(options.ssl_max_version);
+    SetIceConfig(ice_config);
+  });
 
   // Obtain a certificate from RTCConfiguration if any were provided (optional).
   rtc::scoped_refptr<rtc::RTCCertificate> certificate;
@@ -540,8 +561,6 @@ bool WebRtcSession::Initialize(
     certificate = rtc_configuration.certificates[0];
   }
 
-  SetIceConfig(ParseIceConfig(rtc_configuration));
-
   if (options.disable_encryption) {
     dtls_enabled_ = false;
   } else {
@@ -1272,6 +1291,16 @@ bool WebRtcSession::SendData(const cricket::SendDataParams& params,
   return data_channel_->SendData(params, payload, result);
 }
 
+size_t WebRtcSession::SendDataBatch(
+    const std::vector<cricket::OutgoingDataMessage>& messages,
+    cricket::SendDataResult* result) {
+  if (!data_channel_) {
+    LOG(LS_ERROR) << "SendDataBatch called when data_channel_ is NULL.";
+    return 0;
+  }
+  return data_channel_->SendDataBatch(messages, result);
+}
+
 bool WebRtcSession::ConnectDataChannel(DataChannel* webrtc_data_channel) {
   if (!data_channel_) {
     // Don't log an error here, because DataChannels are expected to call
@@ -1719,8 +1748,8 @@ bool WebRtcSession::CreateDataChannel(const cricket::ContentInfo* content,
       rtcp_mux_policy_ == PeerConnectionInterface::kRtcpMuxPolicyRequire;
   bool create_rtcp_transport_channel = !sctp && !require_rtcp_mux;
   data_channel_.reset(channel_manager_->CreateDataChannel(
-      transport_controller_.get(), content->name, bundle_transport,
-      create_rtcp_transport_channel, data_channel_type_));
+      media_controller_, transport_controller_.get(), content->name,
+      bundle_transport, create_rtcp_transport_channel, data_channel_type_));
   if (!data_channel_) {
     return false;
   }
@@ -1839,6 +1868,12 @@ bool WebRtcSession::ValidateSessionDescription(
     return BadSdp(source, type, kBundleWithoutRtcpMux, err_desc);
   }
 
+  // A PeerConnection without audio may run on a worker thread other than the
+  // voice engine's, where no voice channel can be created.
+  if (disable_audio_ && !VerifyNoActiveAudio(sdesc->description())) {
+    return BadSdp(source, type, kAudioDisabled, err_desc);
+  }
+
   // TODO(skvlad): When the local rtcp-mux policy is Require, reject any
   // m-lines that do not rtcp-mux enabled.
 
@@ -55,6 +55,7 @@ class JsepIceCandidate;
 class MediaStreamSignaling;
 class WebRtcSessionDescriptionFactory;
 
+extern const char kAudioDisabled[];
 extern const char kBundleWithoutRtcpMux[];
 extern const char kCreateChannelFailed[];
 extern const char kInvalidCandidates[];
@@ -254,6 +255,9 @@ class WebRtcSession :
   bool SendData(const cricket::SendDataParams& params,
                 const rtc::CopyOnWriteBuffer& payload,
                 cricket::SendDataResult* result) override;
+  size_t SendDataBatch(
+      const std::vector<cricket::OutgoingDataMessage>& messages,
+      cricket::SendDataResult* result) override;
   bool ConnectDataChannel(DataChannel* webrtc_data_channel) override;
   void DisconnectDataChannel(DataChannel* webrtc_data_channel) override;
   void AddSctpDataStream(int sid) override;
@@ -489,6 +493,8 @@ class WebRtcSession :
   // If the remote peer is using a older version of implementation.
   bool older_version_remote_peer_;
   bool dtls_enabled_;
+  // RTCConfiguration::disable_audio. Descriptions with audio are refused.
+  bool disable_audio_;
   // Specifies which kind of data channel is allowed. This is controlled
   // by the chrome command-line flag and constraints:
   // 1. If chrome command-line switch 'enable-sctp-data-channels' is enabled,
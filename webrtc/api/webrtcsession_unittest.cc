@@ -73,6 +73,7 @@ using webrtc::SessionDescriptionInterface;
 using webrtc::SessionStats;
 using webrtc::StreamCollection;
 using webrtc::WebRtcSession;
+using webrtc::kAudioDisabled;
 using webrtc::kBundleWithoutRtcpMux;
 using webrtc::kCreateChannelFailed;
 using webrtc::kInvalidSdp;
@@ -2871,6 +2872,35 @@ TEST_F(WebRtcSessionTest, TestSetRemoteDescriptionWithoutIce) {
   SetRemoteDescriptionOfferExpectError(kSdpWithoutIceUfragPwd, modified_offer);
 }
 
+// This test verifies that a session created with
+// RTCConfiguration::disable_audio refuses local and remote descriptions with
+// audio, but takes video-only ones.
+TEST_F(WebRtcSessionTest, TestSetLocalDescriptionWithAudioWhenAudioDisabled) {
+  configuration_.disable_audio = true;
+  Init();
+  SendAudioVideoStream1();
+  SessionDescriptionInterface* offer = CreateOffer();
+  SetLocalDescriptionOfferExpectError(kAudioDisabled, offer);
+
+  SendVideoOnlyStream2();
+  offer = CreateOffer(RTCOfferAnswerOptions());
+  SetLocalDescriptionWithoutError(offer);
+}
+
+TEST_F(WebRtcSessionTest, TestSetRemoteDescriptionWithAudioWhenAudioDisabled) {
+  configuration_.disable_audio = true;
+  Init();
+  SendAudioVideoStream1();
+  SessionDescriptionInterface* offer = CreateRemoteOffer();
+  SetRemoteDescriptionOfferExpectError(kAudioDisabled, offer);
+
+  cricket::MediaSessionOptions options;
+  options.recv_audio = false;
+  options.recv_video = true;
+  offer = CreateRemoteOffer(options);
+  SetRemoteDescriptionWithoutError(offer);
+}
+
 // This test verifies that setLocalDescription fails if local offer has
 // too short ice ufrag and pwd strings.
 TEST_F(WebRtcSessionTest, TestSetLocalDescriptionInvalidIceCredentials) {
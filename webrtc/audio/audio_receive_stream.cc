@@ -269,7 +269,10 @@ bool AudioReceiveStream::DeliverRtp(const uint8_t* packet,
                                               header);
   }
 
-  return channel_proxy_->ReceivedRTPPacket(packet, length, packet_time);
+  // The channel has the same header extensions registered, so it can use the
+  // header parsed here rather than parse the packet again.
+  return channel_proxy_->ReceivedRTPPacket(packet, length, header,
+                                           packet_time);
 }
 
 VoiceEngine* AudioReceiveStream::voice_engine() const {
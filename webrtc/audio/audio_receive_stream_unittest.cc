@@ -297,6 +297,7 @@ TEST(AudioReceiveStreamTest, ReceiveRtpPacket) {
   EXPECT_CALL(*helper.channel_proxy(),
               ReceivedRTPPacket(&rtp_packet[0],
                                 rtp_packet.size(),
+                                _,
                                 _))
       .WillOnce(Return(true));
   EXPECT_TRUE(
@@ -10,6 +10,10 @@
 
 #include "webrtc/base/asyncsocket.h"
 
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+
 namespace rtc {
 
 AsyncSocket::AsyncSocket() {
@@ -18,6 +22,33 @@ AsyncSocket::AsyncSocket() {
 AsyncSocket::~AsyncSocket() {
 }
 
+int AsyncSocket::SendToSegmented(const void* pv,
+                                 size_t cb,
+                                 size_t segment_size,
+                                 const SocketAddress& addr) {
+  RTC_DCHECK_GT(segment_size, 0u);
+  const char* data = static_cast<const char*>(pv);
+  size_t sent = 0;
+  do {
+    const size_t size = std::min(segment_size, cb - sent);
+    int result = SendTo(data + sent, size, addr);
+    if (result < 0)
+      return sent > 0 ? static_cast<int>(sent) : result;
+    sent += size;
+  } while (sent < cb);
+  return static_cast<int>(sent);
+}
+
+int AsyncSocket::RecvFromSegmented(void* pv,
+                                   size_t cb,
+                                   SocketAddress* paddr,
+                                   int64_t* timestamp,
+                                   size_t* segment_size) {
+  int received = RecvFrom(pv, cb, paddr, timestamp);
+  *segment_size = received > 0 ? received : 0;
+  return received;
+}
+
 AsyncSocketAdapter::AsyncSocketAdapter(AsyncSocket* socket) : socket_(NULL) {
   Attach(socket);
 }
@@ -75,6 +106,21 @@ int AsyncSocketAdapter::RecvFrom(void* pv,
   return socket_->RecvFrom(pv, cb, paddr, timestamp);
 }
 
+int AsyncSocketAdapter::SendToSegmented(const void* pv,
+                                        size_t cb,
+                                        size_t segment_size,
+                                        const SocketAddress& addr) {
+  return socket_->SendToSegmented(pv, cb, segment_size, addr);
+}
+
+int AsyncSocketAdapter::RecvFromSegmented(void* pv,
+                                          size_t cb,
+                                          SocketAddress* paddr,
+                                          int64_t* timestamp,
+                                          size_t* segment_size) {
+  return socket_->RecvFromSegmented(pv, cb, paddr, timestamp, segment_size);
+}
+
 int AsyncSocketAdapter::Listen(int backlog) {
   return socket_->Listen(backlog);
 }
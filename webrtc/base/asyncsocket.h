@@ -27,6 +27,25 @@ class AsyncSocket : public Socket {
 
   AsyncSocket* Accept(SocketAddress* paddr) override = 0;
 
+  // Sends |cb| bytes holding datagrams of |segment_size| bytes each, except
+  // for the last one which may be shorter, to |addr|. Sockets that support
+  // UDP GSO hand them to the kernel in one call, the default sends them one
+  // by one. Returns the number of bytes sent, or a negative value if none
+  // were.
+  virtual int SendToSegmented(const void* pv,
+                              size_t cb,
+                              size_t segment_size,
+                              const SocketAddress& addr);
+
+  // Same as RecvFrom(), but with OPT_UDP_GRO set the read may hold several
+  // datagrams from |paddr|, each |*segment_size| bytes except for the last
+  // one which may be shorter. The default reads a single datagram.
+  virtual int RecvFromSegmented(void* pv,
+                                size_t cb,
+                                SocketAddress* paddr,
+                                int64_t* timestamp,
+                                size_t* segment_size);
+
   // SignalReadEvent and SignalWriteEvent use multi_threaded_local to allow
   // access concurrently from different thread.
   // For example SignalReadEvent::connect will be called in AsyncUDPSocket ctor
@@ -61,6 +80,15 @@ class AsyncSocketAdapter : public AsyncSocket, public sigslot::has_slots<> {
                size_t cb,
                SocketAddress* paddr,
                int64_t* timestamp) override;
+  int SendToSegmented(const void* pv,
+                      size_t cb,
+                      size_t segment_size,
+                      const SocketAddress& addr) override;
+  int RecvFromSegmented(void* pv,
+                        size_t cb,
+                        SocketAddress* paddr,
+                        int64_t* timestamp,
+                        size_t* segment_size) override;
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* paddr) override;
   int Close() override;
@@ -9,6 +9,9 @@
  */
 
 #include "webrtc/base/asyncudpsocket.h"
+
+#include <algorithm>
+
 #include "webrtc/base/logging.h"
 
 namespace rtc {
@@ -74,6 +77,17 @@ int AsyncUDPSocket::SendTo(const void *pv, size_t cb,
   return ret;
 }
 
+int AsyncUDPSocket::SendToSegmented(const void* pv,
+                                    size_t cb,
+                                    size_t segment_size,
+                                    const SocketAddress& addr,
+                                    const rtc::PacketOptions& options) {
+  rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis());
+  int ret = socket_->SendToSegmented(pv, cb, segment_size, addr);
+  SignalSentPacket(this, sent_packet);
+  return ret;
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -103,7 +117,9 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
 
   SocketAddress remote_addr;
   int64_t timestamp;
-  int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
+  size_t segment_size;
+  int len = socket_->RecvFromSegmented(buf_, size_, &remote_addr, &timestamp,
+                                       &segment_size);
   if (len < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
@@ -117,9 +133,19 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
 
   // TODO: Make sure that we got all of the packet.
   // If we did not, then we should resize our buffer to be large enough.
-  SignalReadPacket(
-      this, buf_, static_cast<size_t>(len), remote_addr,
-      (timestamp > -1 ? PacketTime(timestamp, 0) : CreatePacketTime(0)));
+  const PacketTime packet_time =
+      timestamp > -1 ? PacketTime(timestamp, 0) : CreatePacketTime(0);
+  const size_t length = static_cast<size_t>(len);
+  if (segment_size == 0 || segment_size >= length) {
+    SignalReadPacket(this, buf_, length, remote_addr, packet_time);
+    return;
+  }
+  // With OPT_UDP_GRO set, the read may hold several packets from the sender.
+  for (size_t offset = 0; offset < length; offset += segment_size) {
+    SignalReadPacket(this, buf_ + offset,
+                     std::min(segment_size, length - offset), remote_addr,
+                     packet_time);
+  }
 }
 
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
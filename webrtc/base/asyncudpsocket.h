@@ -43,6 +43,14 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  // Sends a burst of equally sized packets, laid out back to back in |pv|,
+  // with as few calls into the kernel as the socket allows. See
+  // AsyncSocket::SendToSegmented(). |options| apply to the whole burst.
+  int SendToSegmented(const void* pv,
+                      size_t cb,
+                      size_t segment_size,
+                      const SocketAddress& addr,
+                      const rtc::PacketOptions& options);
   int Close() override;
 
   State GetState() const override;
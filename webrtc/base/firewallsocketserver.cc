@@ -51,6 +51,20 @@ class FirewallSocket : public AsyncSocketAdapter {
     }
     return AsyncSocketAdapter::SendTo(pv, cb, addr);
   }
+  int SendToSegmented(const void* pv,
+                      size_t cb,
+                      size_t segment_size,
+                      const SocketAddress& addr) override {
+    if (type_ == SOCK_DGRAM) {
+      if (!server_->Check(FP_UDP, GetLocalAddress(), addr)) {
+        LOG(LS_VERBOSE) << "FirewallSocket outbound UDP packets from "
+                        << GetLocalAddress().ToSensitiveString() << " to "
+                        << addr.ToSensitiveString() << " dropped";
+        return static_cast<int>(cb);
+      }
+    }
+    return AsyncSocketAdapter::SendToSegmented(pv, cb, segment_size, addr);
+  }
   int Recv(void* pv, size_t cb, int64_t* timestamp) override {
     SocketAddress addr;
     return RecvFrom(pv, cb, &addr, timestamp);
@@ -73,6 +87,29 @@ class FirewallSocket : public AsyncSocketAdapter {
     }
     return AsyncSocketAdapter::RecvFrom(pv, cb, paddr, timestamp);
   }
+  // The datagrams of a coalesced read all come from the same sender, so they
+  // pass or are dropped together.
+  int RecvFromSegmented(void* pv,
+                        size_t cb,
+                        SocketAddress* paddr,
+                        int64_t* timestamp,
+                        size_t* segment_size) override {
+    if (type_ == SOCK_DGRAM) {
+      while (true) {
+        int res = AsyncSocketAdapter::RecvFromSegmented(
+            pv, cb, paddr, timestamp, segment_size);
+        if (res <= 0)
+          return res;
+        if (server_->Check(FP_UDP, *paddr, GetLocalAddress()))
+          return res;
+        LOG(LS_VERBOSE) << "FirewallSocket inbound UDP packets from "
+                        << paddr->ToSensitiveString() << " to "
+                        << GetLocalAddress().ToSensitiveString() << " dropped";
+      }
+    }
+    return AsyncSocketAdapter::RecvFromSegmented(pv, cb, paddr, timestamp,
+                                                 segment_size);
+  }
 
   int Listen(int backlog) override {
     if (!server_->tcp_listen_enabled()) {
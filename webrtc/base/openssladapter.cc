@@ -596,6 +596,22 @@ int OpenSSLAdapter::RecvFrom(void* pv,
   return SOCKET_ERROR;
 }
 
+int OpenSSLAdapter::SendToSegmented(const void* pv,
+                                    size_t cb,
+                                    size_t segment_size,
+                                    const SocketAddress& addr) {
+  return AsyncSocket::SendToSegmented(pv, cb, segment_size, addr);
+}
+
+int OpenSSLAdapter::RecvFromSegmented(void* pv,
+                                      size_t cb,
+                                      SocketAddress* paddr,
+                                      int64_t* timestamp,
+                                      size_t* segment_size) {
+  return AsyncSocket::RecvFromSegmented(pv, cb, paddr, timestamp,
+                                        segment_size);
+}
+
 int
 OpenSSLAdapter::Close() {
   Cleanup();
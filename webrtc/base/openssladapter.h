@@ -42,6 +42,16 @@ public:
                size_t cb,
                SocketAddress* paddr,
                int64_t* timestamp) override;
+  // The datagrams go through SSL one by one, as AsyncSocket does them.
+  int SendToSegmented(const void* pv,
+                      size_t cb,
+                      size_t segment_size,
+                      const SocketAddress& addr) override;
+  int RecvFromSegmented(void* pv,
+                        size_t cb,
+                        SocketAddress* paddr,
+                        int64_t* timestamp,
+                        size_t* segment_size) override;
   int Close() override;
 
   // Note that the socket returns ST_CONNECTING while SSL is being negotiated.
@@ -57,24 +57,96 @@ typedef void* SockOptArg;
 
 #endif  // WEBRTC_POSIX
 
+#if defined(WEBRTC_LINUX)
+// Until these are in the netinet/udp.h of all the toolchains we build with.
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
+
+namespace {
+// The kernel rejects sends of more segments than this.
+const size_t kMaxUdpSegments = 64;
+// Nor may a segmented send be bigger than a single datagram, with room left
+// for the IPv6 and UDP headers.
+const size_t kMaxUdpSegmentedSize = 0xFFFF - 40 - 8;
+// A coalesced UDP GRO read is at most this big, like a single datagram.
+const size_t kMaxUdpGroReadSize = 0xFFFF;
+}  // namespace
+#endif  // WEBRTC_LINUX
+
 #if defined(WEBRTC_POSIX) && !defined(WEBRTC_MAC) && !defined(__native_client__)
+// Receive timestamps are read from the control messages of recvmsg(), in the
+// same call that reads the packet.
+#define WEBRTC_USE_RECVMSG_TIMESTAMPS 1
 
-int64_t GetSocketRecvTimestamp(int socket) {
-  struct timeval tv_ioctl;
-  int ret = ioctl(socket, SIOCGSTAMP, &tv_ioctl);
-  if (ret != 0)
-    return -1;
-  int64_t timestamp =
-      rtc::kNumMicrosecsPerSec * static_cast<int64_t>(tv_ioctl.tv_sec) +
-      static_cast<int64_t>(tv_ioctl.tv_usec);
-  return timestamp;
-}
+namespace {
 
+#if defined(SO_TIMESTAMPNS)
+const int kRecvTimestampOption = SO_TIMESTAMPNS;
 #else
+const int kRecvTimestampOption = SO_TIMESTAMP;
+#endif
 
-int64_t GetSocketRecvTimestamp(int socket) {
-  return -1;
+// Room for a timestamp and a UDP GRO segment size control message.
+const size_t kRecvControlSize =
+    CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(int));
+
+// The kernel stamps packets with the wall clock, while PacketTime and the
+// receive side estimators use rtc::TimeMicros(). Maps a kernel timestamp to
+// the latter by how long ago the packet arrived.
+int64_t ToPacketTimeMicros(int64_t wall_clock_us) {
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  const int64_t now_us = rtc::kNumMicrosecsPerSec *
+                             static_cast<int64_t>(now.tv_sec) +
+                         static_cast<int64_t>(now.tv_usec);
+  return static_cast<int64_t>(rtc::TimeMicros()) -
+         std::max<int64_t>(now_us - wall_clock_us, 0);
+}
+
+// Sets |timestamp| to the receive timestamp in the control messages of |msg|,
+// if it is set and there is one, and |segment_size| to the UDP GRO segment
+// size, if it is set and there is one.
+void ReadControlMessages(struct msghdr* msg,
+                         int64_t* timestamp,
+                         size_t* segment_size) {
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+#if defined(WEBRTC_LINUX)
+    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int gso_size;
+      memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+      if (segment_size && gso_size > 0)
+        *segment_size = gso_size;
+      continue;
+    }
+#endif
+    if (cmsg->cmsg_level != SOL_SOCKET || !timestamp)
+      continue;
+#if defined(SCM_TIMESTAMPNS)
+    if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      struct timespec ts;
+      memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+      *timestamp = ToPacketTimeMicros(
+          rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts.tv_sec) +
+          static_cast<int64_t>(ts.tv_nsec) / rtc::kNumNanosecsPerMicrosec);
+    }
+#endif
+    if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+      struct timeval tv;
+      memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+      *timestamp = ToPacketTimeMicros(
+          rtc::kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+          static_cast<int64_t>(tv.tv_usec));
+    }
+  }
 }
+
+}  // namespace
+
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -124,7 +196,9 @@ static const int ICMP_PING_TIMEOUT_MILLIS = 10000u;
 PhysicalSocket::PhysicalSocket(PhysicalSocketServer* ss, SOCKET s)
   : ss_(ss), s_(s), enabled_events_(0), error_(0),
     state_((s == INVALID_SOCKET) ? CS_CLOSED : CS_CONNECTED),
-    resolver_(nullptr) {
+    resolver_(nullptr), udp_segment_supported_(false), udp_gro_(false),
+    pending_offset_(0), pending_end_(0), pending_segment_size_(0),
+    pending_timestamp_(-1) {
 #if defined(WEBRTC_WIN)
   // EnsureWinsockInit() ensures that winsock is initialized. The default
   // version of this function doesn't do anything because winsock is
@@ -154,6 +228,24 @@ bool PhysicalSocket::Create(int family, int type) {
   UpdateLastError();
   if (udp_)
     enabled_events_ = DE_READ | DE_WRITE;
+#if defined(WEBRTC_USE_RECVMSG_TIMESTAMPS)
+  if (udp_ && s_ != INVALID_SOCKET) {
+    // Have the kernel stamp each packet, rather than asking for the stamp of
+    // the last one with an extra ioctl() per packet.
+    int value = 1;
+    ::setsockopt(s_, SOL_SOCKET, kRecvTimestampOption, &value, sizeof(value));
+  }
+#endif
+#if defined(WEBRTC_LINUX)
+  if (udp_ && s_ != INVALID_SOCKET) {
+    // Kernels without UDP GSO don't know the option. Older ones would ignore
+    // the segment size of a send and send it all as one datagram.
+    int segment_size = 0;
+    socklen_t optlen = sizeof(segment_size);
+    udp_segment_supported_ = ::getsockopt(s_, IPPROTO_UDP, UDP_SEGMENT,
+                                          &segment_size, &optlen) == 0;
+  }
+#endif
   return s_ != INVALID_SOCKET;
 }
 
@@ -291,7 +383,11 @@ int PhysicalSocket::SetOption(Option opt, int value) {
     value = (value) ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
 #endif
   }
-  return ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+  int result =
+      ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
+  if (opt == OPT_UDP_GRO && result == 0)
+    udp_gro_ = (value != 0);
+  return result;
 }
 
 int PhysicalSocket::Send(const void* pv, size_t cb) {
@@ -344,9 +440,54 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToSegmented(const void* buffer,
+                                    size_t length,
+                                    size_t segment_size,
+                                    const SocketAddress& addr) {
+#if defined(WEBRTC_LINUX)
+  if (udp_segment_supported_ && length > segment_size &&
+      segment_size <= kMaxUdpSegmentedSize) {
+    const char* data = static_cast<const char*>(buffer);
+    const size_t max_size =
+        std::min(kMaxUdpSegments, kMaxUdpSegmentedSize / segment_size) *
+        segment_size;
+    size_t sent = 0;
+    while (sent < length) {
+      const size_t size = std::min(length - sent, max_size);
+      int result = DoSendToSegmented(data + sent, size, segment_size, addr);
+      UpdateLastError();
+      if (result < 0) {
+        int error = GetError();
+        if (IsBlockingError(error)) {
+          enabled_events_ |= DE_WRITE;
+          return sent > 0 ? static_cast<int>(sent) : result;
+        }
+        // EIO means the route's device can't checksum segmented sends, and
+        // it won't have learned to by the next send.
+        if (error == EIO) {
+          LOG(LS_INFO) << "UDP GSO not usable, sending datagrams one by one.";
+          udp_segment_supported_ = false;
+        }
+        break;
+      }
+      sent += size;
+    }
+    if (sent == length)
+      return static_cast<int>(sent);
+    int result = AsyncSocket::SendToSegmented(data + sent, length - sent,
+                                              segment_size, addr);
+    if (result < 0)
+      return sent > 0 ? static_cast<int>(sent) : result;
+    return static_cast<int>(sent) + result;
+  }
+#endif
+  return AsyncSocket::SendToSegmented(buffer, length, segment_size, addr);
+}
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
-  int received = ::recv(s_, static_cast<char*>(buffer),
-                        static_cast<int>(length), 0);
+  if (udp_gro_)
+    return RecvFrom(buffer, length, nullptr, timestamp);
+  int received = DoReadFromSocket(buffer, length, nullptr, timestamp, nullptr);
   if ((received == 0) && (length != 0)) {
     // Note: on graceful shutdown, recv can return 0.  In this case, we
     // pretend it is blocking, and then signal close, so that simplifying
@@ -358,9 +499,6 @@ int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
     SetError(EWOULDBLOCK);
     return SOCKET_ERROR;
   }
-  if (timestamp) {
-    *timestamp = GetSocketRecvTimestamp(s_);
-  }
   UpdateLastError();
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
@@ -377,17 +515,40 @@ int PhysicalSocket::RecvFrom(void* buffer,
                              size_t length,
                              SocketAddress* out_addr,
                              int64_t* timestamp) {
-  sockaddr_storage addr_storage;
-  socklen_t addr_len = sizeof(addr_storage);
-  sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
-  int received = ::recvfrom(s_, static_cast<char*>(buffer),
-                            static_cast<int>(length), 0, addr, &addr_len);
-  if (timestamp) {
-    *timestamp = GetSocketRecvTimestamp(s_);
+#if defined(WEBRTC_LINUX)
+  if (udp_gro_ || HasPendingDatagrams()) {
+    // The caller can't be told the segment size, so a coalesced read is
+    // split and handed out one datagram per call.
+    if (HasPendingDatagrams())
+      return ReadPendingDatagram(buffer, length, out_addr, timestamp);
+    pending_datagrams_.resize(kMaxUdpGroReadSize);
+    int received = RecvFromSegmented(
+        pending_datagrams_.data(), pending_datagrams_.size(), &pending_addr_,
+        &pending_timestamp_, &pending_segment_size_);
+    if (received <= 0)
+      return received;
+    pending_offset_ = 0;
+    pending_end_ = received;
+    return ReadPendingDatagram(buffer, length, out_addr, timestamp);
   }
+#endif
+  return RecvFromSegmented(buffer, length, out_addr, timestamp, nullptr);
+}
+
+int PhysicalSocket::RecvFromSegmented(void* buffer,
+                                      size_t length,
+                                      SocketAddress* out_addr,
+                                      int64_t* timestamp,
+                                      size_t* segment_size) {
+  if (HasPendingDatagrams()) {
+    int received = ReadPendingDatagram(buffer, length, out_addr, timestamp);
+    if (segment_size)
+      *segment_size = received;
+    return received;
+  }
+  int received =
+      DoReadFromSocket(buffer, length, out_addr, timestamp, segment_size);
   UpdateLastError();
-  if ((received >= 0) && (out_addr != nullptr))
-    SocketAddressFromSockAddrStorage(addr_storage, out_addr);
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
   if (udp_ || success) {
@@ -399,6 +560,80 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::DoReadFromSocket(void* buffer,
+                                     size_t length,
+                                     SocketAddress* out_addr,
+                                     int64_t* timestamp,
+                                     size_t* segment_size) {
+  sockaddr_storage addr_storage;
+  socklen_t addr_len = sizeof(addr_storage);
+  sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
+  if (timestamp)
+    *timestamp = -1;
+#if defined(WEBRTC_USE_RECVMSG_TIMESTAMPS)
+  int received = 0;
+  if (timestamp || segment_size) {
+    struct iovec iov = {buffer, length};
+    char control[kRecvControlSize];
+    struct msghdr msg = {nullptr};
+    msg.msg_name = out_addr ? addr : nullptr;
+    msg.msg_namelen = out_addr ? addr_len : 0;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    received = ::recvmsg(s_, &msg, 0);
+    ++read_calls_.recvmsg_calls;
+    if (segment_size)
+      *segment_size = received > 0 ? received : 0;
+    if (received >= 0)
+      ReadControlMessages(&msg, timestamp, segment_size);
+    // ToPacketTimeMicros() reads the wall clock once per timestamp.
+    if (timestamp && *timestamp != -1)
+      ++read_calls_.gettimeofday_calls;
+  } else if (out_addr) {
+    received = ::recvfrom(s_, static_cast<char*>(buffer),
+                          static_cast<int>(length), 0, addr, &addr_len);
+    ++read_calls_.recv_calls;
+  } else {
+    received = ::recv(s_, static_cast<char*>(buffer),
+                      static_cast<int>(length), 0);
+    ++read_calls_.recv_calls;
+  }
+#else
+  int received =
+      out_addr ? ::recvfrom(s_, static_cast<char*>(buffer),
+                            static_cast<int>(length), 0, addr, &addr_len)
+               : ::recv(s_, static_cast<char*>(buffer),
+                        static_cast<int>(length), 0);
+  ++read_calls_.recv_calls;
+  if (segment_size)
+    *segment_size = received > 0 ? received : 0;
+#endif
+  if ((received >= 0) && (out_addr != nullptr))
+    SocketAddressFromSockAddrStorage(addr_storage, out_addr);
+  return received;
+}
+
+int PhysicalSocket::ReadPendingDatagram(void* buffer,
+                                        size_t length,
+                                        SocketAddress* out_addr,
+                                        int64_t* timestamp) {
+  ASSERT(HasPendingDatagrams());
+  const size_t size =
+      std::min(pending_segment_size_, pending_end_ - pending_offset_);
+  // Like recvfrom(), truncates datagrams that don't fit.
+  const size_t copied = std::min(size, length);
+  memcpy(buffer, pending_datagrams_.data() + pending_offset_, copied);
+  pending_offset_ += size;
+  if (out_addr)
+    *out_addr = pending_addr_;
+  if (timestamp)
+    *timestamp = pending_timestamp_;
+  enabled_events_ |= DE_READ;
+  return static_cast<int>(copied);
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -437,6 +672,10 @@ int PhysicalSocket::Close() {
   s_ = INVALID_SOCKET;
   state_ = CS_CLOSED;
   enabled_events_ = 0;
+  udp_gro_ = false;
+  std::vector<char>().swap(pending_datagrams_);
+  pending_offset_ = 0;
+  pending_end_ = 0;
   if (resolver_) {
     resolver_->Destroy(false);
     resolver_ = nullptr;
@@ -527,6 +766,33 @@ int PhysicalSocket::DoSendTo(SOCKET socket,
   return ::sendto(socket, buf, len, flags, dest_addr, addrlen);
 }
 
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::DoSendToSegmented(const char* buf,
+                                      size_t len,
+                                      size_t segment_size,
+                                      const SocketAddress& addr) {
+  sockaddr_storage saddr;
+  size_t addr_len = addr.ToSockAddrStorage(&saddr);
+  struct iovec iov = {const_cast<char*>(buf), len};
+  char control[CMSG_SPACE(sizeof(uint16_t))] = {0};
+  struct msghdr msg = {nullptr};
+  msg.msg_name = &saddr;
+  msg.msg_namelen = static_cast<socklen_t>(addr_len);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = IPPROTO_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  const uint16_t gso_size = static_cast<uint16_t>(segment_size);
+  memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+  // Suppress SIGPIPE. See PhysicalSocket::Send() for explanation.
+  return ::sendmsg(s_, &msg, MSG_NOSIGNAL);
+}
+#endif
+
 void PhysicalSocket::OnResolveResult(AsyncResolverInterface* resolver) {
   if (resolver != resolver_) {
     return;
@@ -594,6 +860,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       return -1;
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_UDP_GRO:
+#if defined(WEBRTC_LINUX)
+      *slevel = IPPROTO_UDP;
+      *sopt = UDP_GRO;
+      break;
+#else
+      LOG(LS_WARNING) << "Socket::OPT_UDP_GRO not supported.";
+      return -1;
+#endif
     default:
       ASSERT(false);
       return -1;
@@ -789,6 +1064,13 @@ void SocketDispatcher::OnEvent(uint32_t ff, int err) {
   if ((ff & DE_READ) != 0) {
     enabled_events_ &= ~DE_READ;
     SignalReadEvent(this);
+    // The datagrams split off a coalesced read are out of the kernel's queue,
+    // so the socket won't become readable for them. Keep signalling for as
+    // long as the reader takes them.
+    while (HasPendingDatagrams() && (enabled_events_ & DE_READ) != 0) {
+      enabled_events_ &= ~DE_READ;
+      SignalReadEvent(this);
+    }
   }
   if ((ff & DE_WRITE) != 0) {
     enabled_events_ &= ~DE_WRITE;
@@ -142,12 +142,21 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  int SendToSegmented(const void* buffer,
+                      size_t length,
+                      size_t segment_size,
+                      const SocketAddress& addr) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  int RecvFromSegmented(void* buffer,
+                        size_t length,
+                        SocketAddress* out_addr,
+                        int64_t* timestamp,
+                        size_t* segment_size) override;
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -158,6 +167,20 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
   SocketServer* socketserver() { return ss_; }
 
+  // System calls made to read from the socket, for benchmarks to report
+  // per packet.
+  struct ReadCalls {
+    size_t recvmsg_calls = 0;
+    // recv() and recvfrom().
+    size_t recv_calls = 0;
+    // Receive timestamps come with recvmsg(), so the read path has no
+    // ioctl(SIOCGSTAMP) left to count.
+    size_t ioctl_calls = 0;
+    // Wall clock reads to map receive timestamps onto rtc::TimeMicros().
+    size_t gettimeofday_calls = 0;
+  };
+  const ReadCalls& read_calls() const { return read_calls_; }
+
  protected:
   int DoConnect(const SocketAddress& connect_addr);
 
@@ -171,6 +194,33 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   virtual int DoSendTo(SOCKET socket, const char* buf, int len, int flags,
                        const struct sockaddr* dest_addr, socklen_t addrlen);
 
+#if defined(WEBRTC_LINUX)
+  // Sends |len| bytes as datagrams of |segment_size| bytes with UDP GSO.
+  int DoSendToSegmented(const char* buf,
+                        size_t len,
+                        size_t segment_size,
+                        const SocketAddress& addr);
+#endif
+
+  // Reads one packet, or several coalesced by UDP GRO, and its receive
+  // timestamp if |timestamp| is set. Sets |out_addr| to the sender and
+  // |segment_size| to the size of the coalesced datagrams if they are set.
+  int DoReadFromSocket(void* buffer,
+                       size_t length,
+                       SocketAddress* out_addr,
+                       int64_t* timestamp,
+                       size_t* segment_size);
+
+  // Hands out the next of the datagrams split off a coalesced UDP GRO read
+  // by RecvFrom(), which returns one datagram at a time.
+  int ReadPendingDatagram(void* buffer,
+                          size_t length,
+                          SocketAddress* out_addr,
+                          int64_t* timestamp);
+  bool HasPendingDatagrams() const {
+    return pending_offset_ < pending_end_;
+  }
+
   void OnResolveResult(AsyncResolverInterface* resolver);
 
   void UpdateLastError();
@@ -186,6 +236,19 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int error_ GUARDED_BY(crit_);
   ConnState state_;
   AsyncResolver* resolver_;
+  // Whether the kernel supports sending UDP datagrams with GSO.
+  bool udp_segment_supported_;
+  // Whether OPT_UDP_GRO is set, so reads may coalesce datagrams.
+  bool udp_gro_;
+  // The last coalesced read by RecvFrom() or Recv(), which is handed out
+  // datagram by datagram from |pending_offset_| up to |pending_end_|.
+  std::vector<char> pending_datagrams_;
+  size_t pending_offset_;
+  size_t pending_end_;
+  size_t pending_segment_size_;
+  SocketAddress pending_addr_;
+  int64_t pending_timestamp_;
+  ReadCalls read_calls_;
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
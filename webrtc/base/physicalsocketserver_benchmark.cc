@@ -0,0 +1,162 @@
+/*
+ *  Copyright 2016 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/physicalsocketserver.h"
+#include "webrtc/base/socketaddress.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace rtc {
+
+namespace {
+
+// Fits in the default socket receive buffer.
+const int kPacketsPerIteration = 32;
+const size_t kPacketSize = 1200;
+
+// Adds the system calls |socket| made to read |packets| packets to |result|,
+// per thousand packets so that a coalesced read of many still shows up.
+void AddReadCallCounters(const PhysicalSocket& socket,
+                         size_t packets,
+                         webrtc::test::BenchmarkResult* result) {
+  const PhysicalSocket::ReadCalls& calls = socket.read_calls();
+  auto per_1000_packets = [packets](size_t count) {
+    return packets ? 1000.0 * count / packets : 0;
+  };
+  result->counters.push_back({"recvmsg_per_1000_packets",
+                              per_1000_packets(calls.recvmsg_calls), "calls"});
+  result->counters.push_back({"recv_per_1000_packets",
+                              per_1000_packets(calls.recv_calls), "calls"});
+  result->counters.push_back({"ioctl_per_1000_packets",
+                              per_1000_packets(calls.ioctl_calls), "calls"});
+  result->counters.push_back(
+      {"gettimeofday_per_1000_packets",
+       per_1000_packets(calls.gettimeofday_calls), "calls"});
+}
+
+// Sends a burst of RTP sized packets to a loopback UDP socket and reads them
+// back the way AsyncUDPSocket does, with or without receive timestamps. Each
+// packet costs one send and one receive call, plus whatever reading the
+// timestamp takes, and the calls made per packet are reported as counters.
+void RunUdpReceiveBenchmark(const std::string& name, bool with_timestamp) {
+  PhysicalSocketServer ss;
+  std::unique_ptr<PhysicalSocket> socket(static_cast<PhysicalSocket*>(
+      ss.CreateSocket(AF_INET, SOCK_DGRAM)));
+  ASSERT_EQ(0, socket->Bind(SocketAddress("127.0.0.1", 0)));
+  const SocketAddress address = socket->GetLocalAddress();
+
+  char packet[kPacketSize] = {0};
+  char buffer[kPacketSize];
+  SocketAddress remote_address;
+  int64_t timestamp = -1;
+  int received = 0;
+  size_t packets = 0;
+  webrtc::test::BenchmarkOptions options;
+  options.warmup_iterations = 10;
+  options.iterations = 100;
+  webrtc::test::BenchmarkResult result =
+      webrtc::test::RunBenchmark(name, options, [&] {
+        for (int i = 0; i < kPacketsPerIteration; ++i)
+          socket->SendTo(packet, sizeof(packet), address);
+        for (int i = 0; i < kPacketsPerIteration; ++i) {
+          int len = socket->RecvFrom(buffer, sizeof(buffer), &remote_address,
+                                     with_timestamp ? &timestamp : nullptr);
+          if (len > 0) {
+            received += len;
+            ++packets;
+          }
+        }
+      });
+  AddReadCallCounters(*socket, packets, &result);
+  webrtc::test::ReportBenchmark(result);
+  EXPECT_GT(received, 0);
+  if (with_timestamp)
+    EXPECT_GT(timestamp, -1);
+}
+
+// Sends the burst of a video frame's packets to a loopback UDP socket and
+// reads it back, a packet per call or with UDP GSO and GRO where the kernel
+// has them, and reports the CPU time it takes to move a Gbit that way and the
+// read calls made per packet.
+void RunUdpBurstBenchmark(const std::string& name, bool segmented) {
+  PhysicalSocketServer ss;
+  std::unique_ptr<PhysicalSocket> socket(static_cast<PhysicalSocket*>(
+      ss.CreateAsyncSocket(AF_INET, SOCK_DGRAM)));
+  ASSERT_EQ(0, socket->Bind(SocketAddress("127.0.0.1", 0)));
+  if (segmented)
+    socket->SetOption(Socket::OPT_UDP_GRO, 1);
+  const SocketAddress address = socket->GetLocalAddress();
+
+  std::vector<char> burst(kPacketsPerIteration * kPacketSize);
+  std::vector<char> buffer(64 * 1024);
+  SocketAddress remote_address;
+  int64_t timestamp;
+  size_t segment_size;
+  size_t received = 0;
+  webrtc::test::BenchmarkOptions options;
+  options.warmup_iterations = 10;
+  options.iterations = 100;
+  webrtc::test::BenchmarkResult result =
+      webrtc::test::RunBenchmark(name, options, [&] {
+        size_t burst_received = 0;
+        if (segmented) {
+          socket->SendToSegmented(burst.data(), burst.size(), kPacketSize,
+                                  address);
+        } else {
+          for (int i = 0; i < kPacketsPerIteration; ++i)
+            socket->SendTo(&burst[i * kPacketSize], kPacketSize, address);
+        }
+        while (burst_received < burst.size()) {
+          int len = socket->RecvFromSegmented(buffer.data(), buffer.size(),
+                                              &remote_address, &timestamp,
+                                              &segment_size);
+          if (len <= 0)
+            break;
+          burst_received += len;
+        }
+        received += burst_received;
+      });
+  AddReadCallCounters(*socket, received / kPacketSize, &result);
+  webrtc::test::ReportBenchmark(result);
+  // Each burst should have been read back whole.
+  EXPECT_GT(received, 0u);
+  EXPECT_EQ(0u, received % burst.size());
+  // CPU milliseconds per Gbit, or thousandths of a core to sustain 1 Gbps.
+  const double bits_per_iteration = 8.0 * burst.size();
+  webrtc::test::PrintResult(
+      name, "", "cpu_per_gbit",
+      static_cast<size_t>(1e3 * result.cpu_time_mean / bits_per_iteration),
+      "ms", true);
+}
+
+}  // namespace
+
+TEST(PhysicalSocketServerBenchmark, UdpBurst) {
+  RunUdpBurstBenchmark("udp_burst_32_packets", false);
+}
+
+TEST(PhysicalSocketServerBenchmark, UdpBurstSegmented) {
+  RunUdpBurstBenchmark("udp_burst_32_packets_segmented", true);
+}
+
+TEST(PhysicalSocketServerBenchmark, UdpReceive) {
+  RunUdpReceiveBenchmark("udp_send_receive_32_packets", false);
+}
+
+TEST(PhysicalSocketServerBenchmark, UdpReceiveWithTimestamp) {
+  RunUdpReceiveBenchmark("udp_send_receive_32_packets_with_timestamp", true);
+}
+
+}  // namespace rtc
@@ -11,7 +11,9 @@
 #include <memory>
 #include <signal.h>
 #include <stdarg.h>
+#include <vector>
 
+#include "webrtc/base/asyncudpsocket.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/physicalsocketserver.h"
@@ -105,6 +107,12 @@ class PhysicalSocketTest : public SocketTest {
 
   void ConnectInternalAcceptError(const IPAddress& loopback);
   void WritableAfterPartialWrite(const IPAddress& loopback);
+  void UdpSegmented(const IPAddress& loopback,
+                    bool enable_gro,
+                    bool through_adapter,
+                    size_t segment_size,
+                    size_t num_packets);
+  void UdpSegmentedRecvFrom(const IPAddress& loopback);
 
   std::unique_ptr<FakePhysicalSocketServer> server_;
   SocketServerScope scope_;
@@ -402,6 +410,164 @@ TEST_F(PhysicalSocketTest, TestGetSetOptionsIPv6) {
   SocketTest::TestGetSetOptionsIPv6();
 }
 
+// Records the sizes of the packets an AsyncUDPSocket reads.
+class PacketSizeRecorder : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    sizes_.push_back(size);
+    bytes_.insert(bytes_.end(), data, data + size);
+  }
+
+  std::vector<size_t> sizes_;
+  std::vector<char> bytes_;
+};
+
+// Fills a burst of |num_packets| packets of |segment_size| bytes, except for
+// the last one which is half that, each with its index as the payload.
+std::vector<char> CreateBurst(size_t segment_size, size_t num_packets) {
+  std::vector<char> burst((num_packets - 1) * segment_size + segment_size / 2);
+  for (size_t i = 0; i < burst.size(); ++i)
+    burst[i] = static_cast<char>(i / segment_size);
+  return burst;
+}
+
+std::vector<size_t> BurstSizes(size_t segment_size, size_t num_packets) {
+  std::vector<size_t> sizes(num_packets, segment_size);
+  sizes.back() = segment_size / 2;
+  return sizes;
+}
+
+// Sends a burst of packets with SendToSegmented() and reads it back through
+// an AsyncUDPSocket, with or without UDP GRO, and with or without an
+// AsyncSocketAdapter in between. Whether or not the kernel can segment and
+// coalesce, the same packets should come out.
+void PhysicalSocketTest::UdpSegmented(const IPAddress& loopback,
+                                      bool enable_gro,
+                                      bool through_adapter,
+                                      size_t segment_size,
+                                      size_t num_packets) {
+  AsyncSocket* socket =
+      server_->CreateAsyncSocket(loopback.family(), SOCK_DGRAM);
+  ASSERT_TRUE(socket);
+  if (through_adapter)
+    socket = new AsyncSocketAdapter(socket);
+  AsyncUDPSocket udp_socket(socket);
+  ASSERT_EQ(0, socket->Bind(SocketAddress(loopback, 0)));
+  if (enable_gro && udp_socket.SetOption(Socket::OPT_UDP_GRO, 1) != 0)
+    LOG(LS_INFO) << "No UDP GRO, reading packets one by one.";
+  PacketSizeRecorder recorder;
+  udp_socket.SignalReadPacket.connect(&recorder,
+                                      &PacketSizeRecorder::OnReadPacket);
+
+  const std::vector<char> burst = CreateBurst(segment_size, num_packets);
+  EXPECT_EQ(static_cast<int>(burst.size()),
+            udp_socket.SendToSegmented(burst.data(), burst.size(),
+                                       segment_size, socket->GetLocalAddress(),
+                                       PacketOptions()));
+
+  // Loopback delivers the packets by the time the send returns, so they can
+  // be read without waiting for the socket server.
+  for (size_t i = 0; i < num_packets && recorder.bytes_.size() < burst.size();
+       ++i) {
+    socket->SignalReadEvent(socket);
+  }
+  EXPECT_EQ(BurstSizes(segment_size, num_packets), recorder.sizes_);
+  EXPECT_EQ(burst, recorder.bytes_);
+}
+
+// Sends a burst with SendToSegmented() to a socket with UDP GRO and reads it
+// back with RecvFrom(), which has to return the packets one by one.
+void PhysicalSocketTest::UdpSegmentedRecvFrom(const IPAddress& loopback) {
+  std::unique_ptr<AsyncSocket> socket(
+      server_->CreateAsyncSocket(loopback.family(), SOCK_DGRAM));
+  ASSERT_TRUE(socket);
+  ASSERT_EQ(0, socket->Bind(SocketAddress(loopback, 0)));
+  if (socket->SetOption(Socket::OPT_UDP_GRO, 1) != 0)
+    LOG(LS_INFO) << "No UDP GRO, reading packets one by one.";
+
+  const size_t kSegmentSize = 1200;
+  const size_t kNumPackets = 10;
+  const std::vector<char> burst = CreateBurst(kSegmentSize, kNumPackets);
+  EXPECT_EQ(static_cast<int>(burst.size()),
+            socket->SendToSegmented(burst.data(), burst.size(), kSegmentSize,
+                                    socket->GetLocalAddress()));
+
+  std::vector<size_t> sizes;
+  std::vector<char> bytes;
+  char buffer[2 * kSegmentSize];
+  SocketAddress remote_addr;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    int received =
+        socket->RecvFrom(buffer, sizeof(buffer), &remote_addr, nullptr);
+    ASSERT_GT(received, 0);
+    EXPECT_EQ(socket->GetLocalAddress(), remote_addr);
+    sizes.push_back(received);
+    bytes.insert(bytes.end(), buffer, buffer + received);
+  }
+  EXPECT_EQ(BurstSizes(kSegmentSize, kNumPackets), sizes);
+  EXPECT_EQ(burst, bytes);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedIPv4) {
+  UdpSegmented(kIPv4Loopback, false, false, 1000, 4);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpSegmented(kIPv6Loopback, false, false, 1000, 4);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedWithGroIPv4) {
+  UdpSegmented(kIPv4Loopback, true, false, 1000, 4);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedWithGroIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpSegmented(kIPv6Loopback, true, false, 1000, 4);
+}
+
+// 100 packets of 1200 bytes take more than one send, as the kernel segments
+// at most 64 packets and 64 kB at a time.
+TEST_F(PhysicalSocketTest, TestUdpSegmentedLargeBurstIPv4) {
+  UdpSegmented(kIPv4Loopback, false, false, 1200, 100);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedLargeBurstIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpSegmented(kIPv6Loopback, false, false, 1200, 100);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedLargeBurstWithGroIPv4) {
+  UdpSegmented(kIPv4Loopback, true, false, 1200, 100);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedLargeBurstWithGroIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpSegmented(kIPv6Loopback, true, false, 1200, 100);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedThroughAdapterWithGroIPv4) {
+  UdpSegmented(kIPv4Loopback, true, true, 1200, 10);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedThroughAdapterWithGroIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpSegmented(kIPv6Loopback, true, true, 1200, 10);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedRecvFromIPv4) {
+  UdpSegmentedRecvFrom(kIPv4Loopback);
+}
+
+TEST_F(PhysicalSocketTest, TestUdpSegmentedRecvFromIPv6) {
+  MAYBE_SKIP_IPV6;
+  UdpSegmentedRecvFrom(kIPv6Loopback);
+}
+
 #if defined(WEBRTC_POSIX)
 
 // We don't get recv timestamps on Mac.
@@ -13,6 +13,7 @@
 #include "webrtc/base/checks.h"
 
 #if defined(WEBRTC_LINUX)
+#include <sched.h>
 #include <sys/prctl.h>
 #include <sys/syscall.h>
 #endif
@@ -206,11 +207,16 @@ void PlatformThread::Run() {
 #endif  // defined(WEBRTC_WIN)
 }
 
-bool PlatformThread::SetPriority(ThreadPriority priority) {
-  RTC_DCHECK(thread_checker_.CalledOnValidThread());
-  RTC_DCHECK(IsRunning());
+namespace {
+#if defined(WEBRTC_WIN)
+typedef HANDLE ThreadHandle;
+#else
+typedef pthread_t ThreadHandle;
+#endif
+
+bool SetPriorityOfThread(ThreadHandle thread, ThreadPriority priority) {
 #if defined(WEBRTC_WIN)
-  return SetThreadPriority(thread_, priority) != FALSE;
+  return SetThreadPriority(thread, priority) != FALSE;
 #elif defined(__native_client__)
   // Setting thread priorities is not supported in NaCl.
   return true;
@@ -256,10 +262,39 @@ bool PlatformThread::SetPriority(ThreadPriority priority) {
       param.sched_priority = top_prio;
       break;
   }
-  return pthread_setschedparam(thread_, policy, &param) == 0;
+  return pthread_setschedparam(thread, policy, &param) == 0;
 #endif  // defined(WEBRTC_WIN)
 }
 
+}  // namespace
+
+bool PlatformThread::SetPriority(ThreadPriority priority) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  RTC_DCHECK(IsRunning());
+  return SetPriorityOfThread(thread_, priority);
+}
+
+bool SetCurrentThreadPriority(ThreadPriority priority) {
+#if defined(WEBRTC_WIN)
+  return SetPriorityOfThread(GetCurrentThread(), priority);
+#else
+  return SetPriorityOfThread(pthread_self(), priority);
+#endif
+}
+
+bool SetCurrentThreadAffinity(int cpu) {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+  return false;
+#endif
+}
+
 #if defined(WEBRTC_WIN)
 bool PlatformThread::QueueAPC(PAPCFUNC function, ULONG_PTR data) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
@@ -50,6 +50,14 @@ enum ThreadPriority {
 #endif
 };
 
+// Sets the priority of the calling thread, the way PlatformThread::SetPriority
+// does for the thread it starts.
+bool SetCurrentThreadPriority(ThreadPriority priority);
+
+// Restricts the calling thread to run on |cpu| only. Returns false if that
+// fails or isn't supported, which it is only on Linux and Android.
+bool SetCurrentThreadAffinity(int cpu);
+
 // Represents a simple worker thread.  The implementation must be assumed
 // to be single threaded, meaning that all methods of the class, must be
 // called from the same thread, including instantiation.
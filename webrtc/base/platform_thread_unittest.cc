@@ -10,6 +10,10 @@
 
 #include "webrtc/base/platform_thread.h"
 
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+#include <sched.h>
+#endif
+
 #include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/gtest.h"
 
@@ -62,4 +66,31 @@ TEST(PlatformThreadTest, RunFunctionIsCalled) {
   // We expect the thread to have run at least once.
   EXPECT_TRUE(flag);
 }
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+namespace {
+bool SetAffinityRunFunction(void* obj) {
+  int* cpu = static_cast<int*>(obj);
+  // Pick a CPU the process may use, which in a container need not be CPU 0.
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+  int first_allowed = 0;
+  while (!CPU_ISSET(first_allowed, &allowed))
+    ++first_allowed;
+  EXPECT_TRUE(SetCurrentThreadAffinity(first_allowed));
+  EXPECT_FALSE(SetCurrentThreadAffinity(-1));
+  *cpu = sched_getcpu() == first_allowed ? first_allowed : -1;
+  return false;
+}
+}  // namespace
+
+TEST(PlatformThreadTest, SetCurrentThreadAffinity) {
+  int cpu = -1;
+  PlatformThread thread(&SetAffinityRunFunction, &cpu, "SetAffinity");
+  thread.Start();
+  thread.Stop();
+  EXPECT_NE(-1, cpu);
+}
+#endif  // defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
 }  // rtc
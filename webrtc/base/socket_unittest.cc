@@ -1044,6 +1044,8 @@ void SocketTest::SocketRecvTimestamp(const IPAddress& loopback) {
   char buffer[3];
   socket->RecvFrom(buffer, 3, nullptr, &recv_timestamp_1);
   EXPECT_GT(recv_timestamp_1, -1);
+  // Timestamps are on the same clock as TimeMicros().
+  EXPECT_NEAR(send_time_1, recv_timestamp_1, 10000);
 
   const int64_t kTimeBetweenPacketsMs = 100;
   Thread::SleepMs(kTimeBetweenPacketsMs);
@@ -888,6 +888,28 @@ int LoggingSocketAdapter::RecvFrom(void* pv,
   return res;
 }
 
+int LoggingSocketAdapter::SendToSegmented(const void* pv,
+                                          size_t cb,
+                                          size_t segment_size,
+                                          const SocketAddress& addr) {
+  int res = AsyncSocketAdapter::SendToSegmented(pv, cb, segment_size, addr);
+  if (res > 0)
+    LogMultiline(level_, label_.c_str(), false, pv, res, hex_mode_, &lms_);
+  return res;
+}
+
+int LoggingSocketAdapter::RecvFromSegmented(void* pv,
+                                            size_t cb,
+                                            SocketAddress* paddr,
+                                            int64_t* timestamp,
+                                            size_t* segment_size) {
+  int res = AsyncSocketAdapter::RecvFromSegmented(pv, cb, paddr, timestamp,
+                                                  segment_size);
+  if (res > 0)
+    LogMultiline(level_, label_.c_str(), true, pv, res, hex_mode_, &lms_);
+  return res;
+}
+
 int LoggingSocketAdapter::Close() {
   LogMultiline(level_, label_.c_str(), false, NULL, 0, hex_mode_, &lms_);
   LogMultiline(level_, label_.c_str(), true, NULL, 0, hex_mode_, &lms_);
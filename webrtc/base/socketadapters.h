@@ -229,6 +229,15 @@ class LoggingSocketAdapter : public AsyncSocketAdapter {
                size_t cb,
                SocketAddress* paddr,
                int64_t* timestamp) override;
+  int SendToSegmented(const void* pv,
+                      size_t cb,
+                      size_t segment_size,
+                      const SocketAddress& addr) override;
+  int RecvFromSegmented(void* pv,
+                        size_t cb,
+                        SocketAddress* paddr,
+                        int64_t* timestamp,
+                        size_t* segment_size) override;
   int Close() override;
 
  protected:
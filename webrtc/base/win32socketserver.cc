@@ -617,6 +617,9 @@ int Win32Socket::TranslateOption(Option opt, int* slevel, int* sopt) {
     case OPT_DSCP:
       LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+    case OPT_UDP_GRO:
+      LOG(LS_WARNING) << "Socket::OPT_UDP_GRO not supported.";
+      return -1;
     default:
       ASSERT(false);
       return -1;
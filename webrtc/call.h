@@ -98,6 +98,11 @@ class Call {
     // RtcEventLog to use for this call. Required.
     // Use webrtc::RtcEventLog::CreateNull() for a null implementation.
     RtcEventLog* event_log = nullptr;
+
+    // Send the RTCP of all streams created with the same Transport packed
+    // into MTU-sized datagrams, on a schedule shared by the streams, rather
+    // than in one datagram per stream and report.
+    bool aggregate_rtcp = false;
   };
 
   struct Stats {
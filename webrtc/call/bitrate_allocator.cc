@@ -48,6 +48,7 @@ double MediaRatio(uint32_t allocated_bitrate, uint32_t protection_bitrate) {
 BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
     : limit_observer_(limit_observer),
       bitrate_observer_configs_(),
+      notification_threshold_(0.0),
       last_bitrate_bps_(kDefaultBitrateBps),
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
       last_fraction_loss_(0),
@@ -82,8 +83,11 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
 
   ObserverAllocation allocation = AllocateBitrates(target_bitrate_bps);
 
-  for (auto& config : bitrate_observer_configs_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    ObserverConfig& config = bitrate_observer_configs_[i];
+    uint32_t allocated_bitrate = allocation[i];
+    if (SkipNotification(config, allocated_bitrate))
+      continue;
     uint32_t protection_bitrate = config.observer->OnBitrateUpdated(
         allocated_bitrate, last_fraction_loss_, last_rtt_);
 
@@ -111,6 +115,7 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
     if (allocated_bitrate > 0)
       config.media_ratio = MediaRatio(allocated_bitrate, protection_bitrate);
     config.allocated_bitrate_bps = allocated_bitrate;
+    config.fraction_loss = last_fraction_loss_;
   }
 }
 
@@ -119,6 +124,16 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
                                    uint32_t max_bitrate_bps,
                                    uint32_t pad_up_bitrate_bps,
                                    bool enforce_min_bitrate) {
+  AddObserver(observer, min_bitrate_bps, max_bitrate_bps, pad_up_bitrate_bps,
+              enforce_min_bitrate, kDefaultPriority);
+}
+
+void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
+                                   uint32_t min_bitrate_bps,
+                                   uint32_t max_bitrate_bps,
+                                   uint32_t pad_up_bitrate_bps,
+                                   bool enforce_min_bitrate,
+                                   int priority) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   auto it = FindObserverConfig(observer);
 
@@ -128,21 +143,39 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
     it->max_bitrate_bps = max_bitrate_bps;
     it->pad_up_bitrate_bps = pad_up_bitrate_bps;
     it->enforce_min_bitrate = enforce_min_bitrate;
+    if (it->priority != priority) {
+      const size_t index = it - bitrate_observer_configs_.begin();
+      const int old_priority = it->priority;
+      RemoveFromPriorityGroup(index);
+      it->priority = priority;
+      AddToPriorityGroup(index);
+      OnPriorityGroupChanged(old_priority);
+    }
   } else {
     bitrate_observer_configs_.push_back(
         ObserverConfig(observer, min_bitrate_bps, max_bitrate_bps,
-                       pad_up_bitrate_bps, enforce_min_bitrate));
+                       pad_up_bitrate_bps, enforce_min_bitrate, priority));
+    observer_indices_[observer] = bitrate_observer_configs_.size() - 1;
+    AddToPriorityGroup(bitrate_observer_configs_.size() - 1);
   }
+  OnPriorityGroupChanged(priority);
 
   ObserverAllocation allocation;
   if (last_bitrate_bps_ > 0) {
-    // Calculate a new allocation and update all observers.
+    // Calculate a new allocation and update all observers, except those
+    // skipped by the notification threshold.
     allocation = AllocateBitrates(last_bitrate_bps_);
-    for (auto& config : bitrate_observer_configs_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      ObserverConfig& config = bitrate_observer_configs_[i];
+      uint32_t allocated_bitrate = allocation[i];
+      if (config.observer != observer &&
+          SkipNotification(config, allocated_bitrate)) {
+        continue;
+      }
       uint32_t protection_bitrate = config.observer->OnBitrateUpdated(
           allocated_bitrate, last_fraction_loss_, last_rtt_);
       config.allocated_bitrate_bps = allocated_bitrate;
+      config.fraction_loss = last_fraction_loss_;
       if (allocated_bitrate > 0)
         config.media_ratio = MediaRatio(allocated_bitrate, protection_bitrate);
     }
@@ -180,7 +213,27 @@ void BitrateAllocator::RemoveObserver(BitrateAllocatorObserver* observer) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   auto it = FindObserverConfig(observer);
   if (it != bitrate_observer_configs_.end()) {
+    const size_t index = it - bitrate_observer_configs_.begin();
+    const int priority = it->priority;
+    RemoveFromPriorityGroup(index);
     bitrate_observer_configs_.erase(it);
+    observer_indices_.erase(observer);
+    // The observers after |index| moved down one.
+    for (auto& observer_index : observer_indices_) {
+      if (observer_index.second > index)
+        --observer_index.second;
+    }
+    for (PriorityGroup& group : priority_groups_) {
+      for (size_t& i : group.observers) {
+        if (i > index)
+          --i;
+      }
+      for (size_t& i : group.max_bitrate_order) {
+        if (i > index)
+          --i;
+      }
+    }
+    OnPriorityGroupChanged(priority);
   }
 
   UpdateAllocationLimits();
@@ -203,15 +256,87 @@ int BitrateAllocator::GetStartBitrate(BitrateAllocatorObserver* observer) {
   }
 }
 
+void BitrateAllocator::SetNotificationThreshold(double ratio) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  RTC_DCHECK_GE(ratio, 0.0);
+  notification_threshold_ = ratio;
+}
+
 BitrateAllocator::ObserverConfigs::iterator
 BitrateAllocator::FindObserverConfig(const BitrateAllocatorObserver* observer) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  for (auto it = bitrate_observer_configs_.begin();
-       it != bitrate_observer_configs_.end(); ++it) {
-    if (it->observer == observer)
-      return it;
+  auto it = observer_indices_.find(observer);
+  if (it == observer_indices_.end())
+    return bitrate_observer_configs_.end();
+  RTC_DCHECK(bitrate_observer_configs_[it->second].observer == observer);
+  return bitrate_observer_configs_.begin() + it->second;
+}
+
+BitrateAllocator::PriorityGroup::PriorityGroup(int priority)
+    : priority(priority), sum_min_bitrates(0), sum_max_bitrates(0) {}
+
+BitrateAllocator::PriorityGroup::PriorityGroup(const PriorityGroup&) = default;
+
+BitrateAllocator::PriorityGroup::~PriorityGroup() = default;
+
+BitrateAllocator::PriorityGroup* BitrateAllocator::GetOrCreatePriorityGroup(
+    int priority) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  auto it = priority_groups_.begin();
+  while (it != priority_groups_.end() && it->priority > priority)
+    ++it;
+  if (it == priority_groups_.end() || it->priority != priority)
+    it = priority_groups_.insert(it, PriorityGroup(priority));
+  return &*it;
+}
+
+void BitrateAllocator::AddToPriorityGroup(size_t index) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  std::vector<size_t>& observers =
+      GetOrCreatePriorityGroup(bitrate_observer_configs_[index].priority)
+          ->observers;
+  observers.insert(std::lower_bound(observers.begin(), observers.end(), index),
+                   index);
+}
+
+void BitrateAllocator::RemoveFromPriorityGroup(size_t index) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  std::vector<size_t>& observers =
+      GetOrCreatePriorityGroup(bitrate_observer_configs_[index].priority)
+          ->observers;
+  auto it = std::lower_bound(observers.begin(), observers.end(), index);
+  RTC_DCHECK(it != observers.end() && *it == index);
+  observers.erase(it);
+}
+
+void BitrateAllocator::OnPriorityGroupChanged(int priority) {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
+  auto it = std::find_if(
+      priority_groups_.begin(), priority_groups_.end(),
+      [priority](const PriorityGroup& group) {
+        return group.priority == priority;
+      });
+  if (it == priority_groups_.end())
+    return;
+  if (it->observers.empty()) {
+    priority_groups_.erase(it);
+    return;
+  }
+
+  PriorityGroup& group = *it;
+  group.sum_min_bitrates = 0;
+  group.sum_max_bitrates = 0;
+  for (size_t i : group.observers) {
+    group.sum_min_bitrates += bitrate_observer_configs_[i].min_bitrate_bps;
+    group.sum_max_bitrates += bitrate_observer_configs_[i].max_bitrate_bps;
   }
-  return bitrate_observer_configs_.end();
+  group.max_bitrate_order = group.observers;
+  std::stable_sort(group.max_bitrate_order.begin(),
+                   group.max_bitrate_order.end(),
+                   [this](size_t a, size_t b) {
+                     return bitrate_observer_configs_[a].max_bitrate_bps <
+                            bitrate_observer_configs_[b].max_bitrate_bps;
+                   });
 }
 
 BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
@@ -220,64 +345,73 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
   if (bitrate_observer_configs_.empty())
     return ObserverAllocation();
 
+  ObserverAllocation allocation(bitrate_observer_configs_.size(), 0);
   if (bitrate == 0)
-    return ZeroRateAllocation();
+    return allocation;
 
-  uint32_t sum_min_bitrates = 0;
-  uint32_t sum_max_bitrates = 0;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    sum_min_bitrates += observer_config.min_bitrate_bps;
-    sum_max_bitrates += observer_config.max_bitrate_bps;
+  // Each group gets what the groups before it left, and leaves what it
+  // doesn't use to the ones after it.
+  int64_t remaining_bitrate = bitrate;
+  bool all_groups_at_max = true;
+  for (const PriorityGroup& group : priority_groups_) {
+    const uint32_t group_bitrate =
+        static_cast<uint32_t>(std::max<int64_t>(remaining_bitrate, 0));
+    if (!EnoughBitrateForAllObservers(group, group_bitrate)) {
+      // Not enough for all observers to get an allocation, allocate
+      // according to: enforced min bitrate -> allocated bitrate previous
+      // round -> restart paused streams.
+      remaining_bitrate -= LowRateAllocation(group, group_bitrate, &allocation);
+      all_groups_at_max = false;
+    } else if (group_bitrate <= group.sum_max_bitrates) {
+      // All observers will get their min bitrate plus an even share of the
+      // rest.
+      remaining_bitrate -=
+          NormalRateAllocation(group, group_bitrate, &allocation);
+      all_groups_at_max = false;
+    } else {
+      remaining_bitrate -= MaxRateAllocation(group, &allocation);
+    }
   }
 
-  // Not enough for all observers to get an allocation, allocate according to:
-  // enforced min bitrate -> allocated bitrate previous round -> restart paused
-  // streams.
-  if (!EnoughBitrateForAllObservers(bitrate, sum_min_bitrates))
-    return LowRateAllocation(bitrate);
-
-  // All observers will get their min bitrate plus an even share of the rest.
-  if (bitrate <= sum_max_bitrates)
-    return NormalRateAllocation(bitrate, sum_min_bitrates);
-
-  // All observers will get up to kTransmissionMaxBitrateMultiplier x max.
-  return MaxRateAllocation(bitrate, sum_max_bitrates);
-}
-
-BitrateAllocator::ObserverAllocation BitrateAllocator::ZeroRateAllocation() {
-  RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  ObserverAllocation allocation;
-  for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = 0;
+  // All observers will get up to kTransmissionMaxBitrateMultiplier x max,
+  // those with a higher priority first.
+  if (all_groups_at_max) {
+    for (const PriorityGroup& group : priority_groups_) {
+      if (remaining_bitrate <= 0)
+        break;
+      remaining_bitrate = DistributeBitrateEvenly(
+          group, static_cast<uint32_t>(remaining_bitrate), true,
+          kTransmissionMaxBitrateMultiplier, &allocation);
+    }
+  }
   return allocation;
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
-    uint32_t bitrate) {
+int64_t BitrateAllocator::LowRateAllocation(const PriorityGroup& group,
+                                            uint32_t bitrate,
+                                            ObserverAllocation* allocation) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  ObserverAllocation allocation;
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    int32_t allocated_bitrate = 0;
-    if (observer_config.enforce_min_bitrate)
-      allocated_bitrate = observer_config.min_bitrate_bps;
-
-    allocation[observer_config.observer] = allocated_bitrate;
-    remaining_bitrate -= allocated_bitrate;
+  for (size_t i : group.observers) {
+    if (bitrate_observer_configs_[i].enforce_min_bitrate) {
+      (*allocation)[i] = bitrate_observer_configs_[i].min_bitrate_bps;
+      remaining_bitrate -= (*allocation)[i];
+    }
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i : group.observers) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (observer_config.enforce_min_bitrate ||
           LastAllocatedBitrate(observer_config) == 0)
         continue;
 
       uint32_t required_bitrate = MinBitrateWithHysteresis(observer_config);
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -285,55 +419,52 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i : group.observers) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (LastAllocatedBitrate(observer_config) != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = MinBitrateWithHysteresis(observer_config);
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
   }
 
   // Split a possible remainder evenly on all streams with an allocation.
-  if (remaining_bitrate > 0)
-    DistributeBitrateEvenly(remaining_bitrate, false, 1, &allocation);
+  if (remaining_bitrate > 0) {
+    remaining_bitrate = DistributeBitrateEvenly(
+        group, static_cast<uint32_t>(remaining_bitrate), false, 1, allocation);
+  }
 
-  RTC_DCHECK_EQ(allocation.size(), bitrate_observer_configs_.size());
-  return allocation;
+  return bitrate - remaining_bitrate;
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::NormalRateAllocation(
+int64_t BitrateAllocator::NormalRateAllocation(
+    const PriorityGroup& group,
     uint32_t bitrate,
-    uint32_t sum_min_bitrates) {
+    ObserverAllocation* allocation) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  ObserverAllocation allocation;
-  for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = observer_config.min_bitrate_bps;
+  for (size_t i : group.observers)
+    (*allocation)[i] = bitrate_observer_configs_[i].min_bitrate_bps;
 
-  bitrate -= sum_min_bitrates;
-  if (bitrate > 0)
-    DistributeBitrateEvenly(bitrate, true, 1, &allocation);
+  uint32_t remaining_bitrate = bitrate - group.sum_min_bitrates;
+  if (remaining_bitrate > 0) {
+    remaining_bitrate = DistributeBitrateEvenly(group, remaining_bitrate, true,
+                                                1, allocation);
+  }
 
-  return allocation;
+  return bitrate - remaining_bitrate;
 }
 
-BitrateAllocator::ObserverAllocation BitrateAllocator::MaxRateAllocation(
-    uint32_t bitrate,
-    uint32_t sum_max_bitrates) {
+int64_t BitrateAllocator::MaxRateAllocation(const PriorityGroup& group,
+                                            ObserverAllocation* allocation) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  ObserverAllocation allocation;
-
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    allocation[observer_config.observer] = observer_config.max_bitrate_bps;
-    bitrate -= observer_config.max_bitrate_bps;
-  }
-  DistributeBitrateEvenly(bitrate, true, kTransmissionMaxBitrateMultiplier,
-                          &allocation);
-  return allocation;
+  for (size_t i : group.observers)
+    (*allocation)[i] = bitrate_observer_configs_[i].max_bitrate_bps;
+  return group.sum_max_bitrates;
 }
 
 uint32_t BitrateAllocator::LastAllocatedBitrate(
@@ -365,51 +496,71 @@ uint32_t BitrateAllocator::MinBitrateWithHysteresis(
   return min_bitrate;
 }
 
-void BitrateAllocator::DistributeBitrateEvenly(uint32_t bitrate,
-                                               bool include_zero_allocations,
-                                               int max_multiplier,
-                                               ObserverAllocation* allocation) {
+bool BitrateAllocator::SkipNotification(const ObserverConfig& observer_config,
+                                        uint32_t allocated_bitrate) {
+  if (notification_threshold_ <= 0.0 ||
+      observer_config.fraction_loss != last_fraction_loss_) {
+    return false;
+  }
+  const int64_t last_bitrate = observer_config.allocated_bitrate_bps;
+  // Observers are always told when they get their first allocation, and when
+  // they are paused or resumed.
+  if (last_bitrate == -1 || (allocated_bitrate == 0) != (last_bitrate == 0))
+    return false;
+  const int64_t change = allocated_bitrate > last_bitrate
+                             ? allocated_bitrate - last_bitrate
+                             : last_bitrate - allocated_bitrate;
+  return change <= notification_threshold_ * last_bitrate;
+}
+
+uint32_t BitrateAllocator::DistributeBitrateEvenly(
+    const PriorityGroup& group,
+    uint32_t bitrate,
+    bool include_zero_allocations,
+    int max_multiplier,
+    ObserverAllocation* allocation) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   RTC_DCHECK_EQ(allocation->size(), bitrate_observer_configs_.size());
 
-  ObserverSortingMap list_max_bitrates;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(std::pair<uint32_t, const ObserverConfig*>(
-          observer_config.max_bitrate_bps, &observer_config));
-    }
+  size_t num_observers = 0;
+  for (size_t i : group.max_bitrate_order) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      ++num_observers;
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  for (size_t i : group.max_bitrate_order) {
+    if (!include_zero_allocations && (*allocation)[i] == 0)
+      continue;
+
     RTC_DCHECK_GT(bitrate, 0u);
+    const uint32_t max_bitrate = bitrate_observer_configs_[i].max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(num_observers);
+    uint32_t total_allocation = extra_allocation + (*allocation)[i];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_multiplier * max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_multiplier * max_bitrate;
+      total_allocation = max_multiplier * max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[i] = total_allocation;
+    --num_observers;
   }
+  return bitrate;
 }
 
-bool BitrateAllocator::EnoughBitrateForAllObservers(uint32_t bitrate,
-                                                    uint32_t sum_min_bitrates) {
+bool BitrateAllocator::EnoughBitrateForAllObservers(const PriorityGroup& group,
+                                                    uint32_t bitrate) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  if (bitrate < sum_min_bitrates)
+  if (bitrate < group.sum_min_bitrates)
     return false;
 
   uint32_t extra_bitrate_per_observer =
-      (bitrate - sum_min_bitrates) /
-      static_cast<uint32_t>(bitrate_observer_configs_.size());
-  for (const auto& observer_config : bitrate_observer_configs_) {
+      (bitrate - group.sum_min_bitrates) /
+      static_cast<uint32_t>(group.observers.size());
+  for (size_t i : group.observers) {
+    const ObserverConfig& observer_config = bitrate_observer_configs_[i];
     if (observer_config.min_bitrate_bps + extra_bitrate_per_observer <
         MinBitrateWithHysteresis(observer_config))
       return false;
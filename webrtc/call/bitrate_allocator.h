@@ -55,6 +55,9 @@ class BitrateAllocator {
     virtual ~LimitObserver() {}
   };
 
+  // The priority of observers added without one.
+  static const int kDefaultPriority = 0;
+
   explicit BitrateAllocator(LimitObserver* limit_observer);
   ~BitrateAllocator();
 
@@ -80,6 +83,18 @@ class BitrateAllocator {
                    uint32_t max_bitrate_bps,
                    uint32_t pad_up_bitrate_bps,
                    bool enforce_min_bitrate);
+  // Same as above, with |observer| in the priority group of |priority|. The
+  // groups are allocated in order of decreasing priority, each getting up to
+  // the sum of its observers' max bitrates before the next gets anything.
+  // Within a group, bitrate is allocated as if the group were alone. What is
+  // left when all groups are at their max goes to the groups in the same
+  // order, up to twice their max.
+  void AddObserver(BitrateAllocatorObserver* observer,
+                   uint32_t min_bitrate_bps,
+                   uint32_t max_bitrate_bps,
+                   uint32_t pad_up_bitrate_bps,
+                   bool enforce_min_bitrate,
+                   int priority);
 
   // Removes a previously added observer, but will not trigger a new bitrate
   // allocation.
@@ -89,6 +104,15 @@ class BitrateAllocator {
   // the list of added observers, a best guess is returned.
   int GetStartBitrate(BitrateAllocatorObserver* observer);
 
+  // Makes OnNetworkChanged() and AddObserver() skip the observers whose
+  // allocation differs by at most |ratio| of the allocation they were last
+  // given, as long as they are not paused or resumed and the fraction lost is
+  // the same as they were last given. An added observer is always updated.
+  // Observers get the current rtt with their next update. With the default
+  // of 0, every observer is updated every time, as when there is no
+  // threshold.
+  void SetNotificationThreshold(double ratio);
+
  private:
   // Note: All bitrates for member variables and methods are in bps.
   struct ObserverConfig {
@@ -96,13 +120,16 @@ class BitrateAllocator {
                    uint32_t min_bitrate_bps,
                    uint32_t max_bitrate_bps,
                    uint32_t pad_up_bitrate_bps,
-                   bool enforce_min_bitrate)
+                   bool enforce_min_bitrate,
+                   int priority)
         : observer(observer),
           min_bitrate_bps(min_bitrate_bps),
           max_bitrate_bps(max_bitrate_bps),
           pad_up_bitrate_bps(pad_up_bitrate_bps),
           enforce_min_bitrate(enforce_min_bitrate),
+          priority(priority),
           allocated_bitrate_bps(-1),
+          fraction_loss(0),
           media_ratio(1.0) {}
 
     BitrateAllocatorObserver* observer;
@@ -110,49 +137,101 @@ class BitrateAllocator {
     uint32_t max_bitrate_bps;
     uint32_t pad_up_bitrate_bps;
     bool enforce_min_bitrate;
+    int priority;
+    // The allocation and fraction lost the observer was last updated with.
     int64_t allocated_bitrate_bps;
+    uint8_t fraction_loss;
     double media_ratio;  // Part of the total bitrate used for media [0.0, 1.0].
   };
 
+  // The observers of one priority, as indices into
+  // |bitrate_observer_configs_| in insertion order, and the state derived
+  // from their configs.
+  struct PriorityGroup {
+    explicit PriorityGroup(int priority);
+    PriorityGroup(const PriorityGroup&);
+    ~PriorityGroup();
+
+    int priority;
+    std::vector<size_t> observers;
+    // Sums of the configured min and max bitrates of the observers.
+    uint32_t sum_min_bitrates;
+    uint32_t sum_max_bitrates;
+    // |observers| sorted by max bitrate. Observers with the same max bitrate
+    // keep their insertion order.
+    std::vector<size_t> max_bitrate_order;
+  };
+
   // Calculates the minimum requested send bitrate and max padding bitrate and
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits();
 
   typedef std::vector<ObserverConfig> ObserverConfigs;
+  // Looks up |observer| in |observer_indices_|.
   ObserverConfigs::iterator FindObserverConfig(
       const BitrateAllocatorObserver* observer);
 
-  typedef std::multimap<uint32_t, const ObserverConfig*> ObserverSortingMap;
-  typedef std::map<BitrateAllocatorObserver*, int> ObserverAllocation;
+  // Allocated bitrates, in the order of |bitrate_observer_configs_|.
+  typedef std::vector<uint32_t> ObserverAllocation;
+
+  // Returns the group of |priority|, creating it if there is none.
+  PriorityGroup* GetOrCreatePriorityGroup(int priority);
+  // Adds the observer at |index| of |bitrate_observer_configs_| to the group
+  // of its priority, or removes it from that group.
+  void AddToPriorityGroup(size_t index);
+  void RemoveFromPriorityGroup(size_t index);
+  // Updates the state derived from the configs of the group of |priority|,
+  // which is reused by every allocation until they change again. Groups left
+  // empty are removed.
+  void OnPriorityGroupChanged(int priority);
 
   ObserverAllocation AllocateBitrates(uint32_t bitrate);
 
-  ObserverAllocation ZeroRateAllocation();
-  ObserverAllocation LowRateAllocation(uint32_t bitrate);
-  ObserverAllocation NormalRateAllocation(uint32_t bitrate,
-                                          uint32_t sum_min_bitrates);
-  ObserverAllocation MaxRateAllocation(uint32_t bitrate,
-                                       uint32_t sum_max_bitrates);
+  // Allocate at most |bitrate| to the observers of |group|, writing to their
+  // entries in |allocation|. Return the bitrate allocated, which may be more
+  // than |bitrate| for observers enforcing their min bitrate.
+  int64_t LowRateAllocation(const PriorityGroup& group,
+                            uint32_t bitrate,
+                            ObserverAllocation* allocation);
+  int64_t NormalRateAllocation(const PriorityGroup& group,
+                               uint32_t bitrate,
+                               ObserverAllocation* allocation);
+  int64_t MaxRateAllocation(const PriorityGroup& group,
+                            ObserverAllocation* allocation);
 
   uint32_t LastAllocatedBitrate(const ObserverConfig& observer_config);
   // The minimum bitrate required by this observer, including enable-hysteresis
   // if the observer is in a paused state.
   uint32_t MinBitrateWithHysteresis(const ObserverConfig& observer_config);
-  // Splits |bitrate| evenly to observers already in |allocation|.
+  // Returns true if the notification threshold lets |observer_config| skip
+  // the update to |allocated_bitrate|, as described in
+  // SetNotificationThreshold().
+  bool SkipNotification(const ObserverConfig& observer_config,
+                        uint32_t allocated_bitrate);
+  // Splits |bitrate| evenly to the observers of |group| already in
+  // |allocation|, starting with the ones with the lowest max bitrate.
   // |include_zero_allocations| decides if zero allocations should be part of
   // the distribution or not. The allowed max bitrate is |max_multiplier| x
-  // observer max bitrate.
-  void DistributeBitrateEvenly(uint32_t bitrate,
-                               bool include_zero_allocations,
-                               int max_multiplier,
-                               ObserverAllocation* allocation);
-  bool EnoughBitrateForAllObservers(uint32_t bitrate,
-                                    uint32_t sum_min_bitrates);
+  // observer max bitrate. Returns what is left of |bitrate| when all of them
+  // are at that.
+  uint32_t DistributeBitrateEvenly(const PriorityGroup& group,
+                                   uint32_t bitrate,
+                                   bool include_zero_allocations,
+                                   int max_multiplier,
+                                   ObserverAllocation* allocation);
+  bool EnoughBitrateForAllObservers(const PriorityGroup& group,
+                                    uint32_t bitrate);
 
   rtc::SequencedTaskChecker sequenced_checker_;
   LimitObserver* const limit_observer_ GUARDED_BY(&sequenced_checker_);
   // Stored in a list to keep track of the insertion order.
   ObserverConfigs bitrate_observer_configs_ GUARDED_BY(&sequenced_checker_);
+  // The index of each observer's config in |bitrate_observer_configs_|.
+  std::map<const BitrateAllocatorObserver*, size_t> observer_indices_
+      GUARDED_BY(&sequenced_checker_);
+  // Sorted by decreasing priority.
+  std::vector<PriorityGroup> priority_groups_ GUARDED_BY(&sequenced_checker_);
+  double notification_threshold_ GUARDED_BY(&sequenced_checker_);
   uint32_t last_bitrate_bps_ GUARDED_BY(&sequenced_checker_);
   uint32_t last_non_zero_bitrate_bps_ GUARDED_BY(&sequenced_checker_);
   uint8_t last_fraction_loss_ GUARDED_BY(&sequenced_checker_);
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/call/bitrate_allocator.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumObservers = 500;
+const int kNumNetworkChanges = 2000;
+
+class NullLimitObserver : public BitrateAllocator::LimitObserver {
+ public:
+  void OnAllocationLimitsChanged(uint32_t min_send_bitrate_bps,
+                                 uint32_t max_padding_bitrate_bps) override {}
+};
+
+class CountingBitrateObserver : public BitrateAllocatorObserver {
+ public:
+  int updates() const { return updates_; }
+
+  uint32_t OnBitrateUpdated(uint32_t bitrate_bps,
+                            uint8_t fraction_loss,
+                            int64_t rtt) override {
+    ++updates_;
+    return 0;
+  }
+
+ private:
+  int updates_ = 0;
+};
+
+}  // namespace
+
+// Adds |kNumObservers| audio and video streams to one allocator, as a Call
+// hosting many send streams does, and reports the time spent per observer
+// added and per bandwidth estimate update.
+TEST(BitrateAllocatorPerformanceTest, ManyObservers) {
+  NullLimitObserver limit_observer;
+  BitrateAllocator allocator(&limit_observer);
+  allocator.OnNetworkChanged(300000, 0, 0);
+  std::vector<CountingBitrateObserver> observers(kNumObservers);
+
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumObservers; ++i) {
+    if (i % 2 == 0) {
+      allocator.AddObserver(&observers[i], 6000, 32000, 0, true);
+    } else {
+      allocator.AddObserver(&observers[i], 30000, 2500000, 0, false);
+    }
+  }
+  const int64_t add_ns = rtc::TimeNanos() - start_ns;
+
+  // Estimates ranging from too low for all observers to above the sum of
+  // their max bitrates.
+  Random random(0x5eed);
+  start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumNetworkChanges; ++i) {
+    allocator.OnNetworkChanged(random.Rand(1000000, 1000000000), 0, 50);
+  }
+  const int64_t network_changed_ns = rtc::TimeNanos() - start_ns;
+
+  for (const auto& observer : observers)
+    EXPECT_GE(observer.updates(), kNumNetworkChanges);
+
+  test::PrintResult("bitrate_allocator_time", "", "add_observer",
+                    static_cast<size_t>(add_ns / kNumObservers), "ns", true);
+  test::PrintResult("bitrate_allocator_time", "", "network_changed",
+                    static_cast<size_t>(network_changed_ns /
+                                        rtc::kNumNanosecsPerMicrosec /
+                                        kNumNetworkChanges),
+                    "us", true);
+}
+
+}  // namespace webrtc
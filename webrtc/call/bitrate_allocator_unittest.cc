@@ -498,4 +498,77 @@ TEST_F(BitrateAllocatorTest, AvoidTogglePercent) {
   allocator_->RemoveObserver(&observer);
 }
 
+TEST_F(BitrateAllocatorTest, HigherPriorityAllocatedFirst) {
+  TestBitrateObserver high_observer;
+  TestBitrateObserver low_observer;
+  allocator_->AddObserver(&high_observer, 100000, 300000, 0, true, 1);
+  allocator_->AddObserver(&low_observer, 100000, 300000, 0, true);
+
+  // The high priority observer gets its max before the low priority one gets
+  // more than its enforced min.
+  allocator_->OnNetworkChanged(350000, 0, 50);
+  EXPECT_EQ(300000u, high_observer.last_bitrate_bps_);
+  EXPECT_EQ(100000u, low_observer.last_bitrate_bps_);
+
+  allocator_->OnNetworkChanged(500000, 0, 50);
+  EXPECT_EQ(300000u, high_observer.last_bitrate_bps_);
+  EXPECT_EQ(200000u, low_observer.last_bitrate_bps_);
+
+  // What is left when both are at their max goes to the high priority
+  // observer first.
+  allocator_->OnNetworkChanged(800000, 0, 50);
+  EXPECT_EQ(500000u, high_observer.last_bitrate_bps_);
+  EXPECT_EQ(300000u, low_observer.last_bitrate_bps_);
+
+  // Adding the observer again changes its priority.
+  allocator_->AddObserver(&low_observer, 100000, 300000, 0, true, 2);
+  allocator_->OnNetworkChanged(350000, 0, 50);
+  EXPECT_EQ(100000u, high_observer.last_bitrate_bps_);
+  EXPECT_EQ(300000u, low_observer.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&high_observer);
+  allocator_->OnNetworkChanged(200000, 0, 50);
+  EXPECT_EQ(200000u, low_observer.last_bitrate_bps_);
+  allocator_->RemoveObserver(&low_observer);
+}
+
+TEST_F(BitrateAllocatorTest, AddObserverUpdatesAllObservers) {
+  TestBitrateObserver observer_1;
+  TestBitrateObserver observer_2;
+  allocator_->AddObserver(&observer_1, 100000, 200000, 0, true);
+  allocator_->OnNetworkChanged(1000000, 0, 50);
+  EXPECT_EQ(400000u, observer_1.last_bitrate_bps_);
+
+  // Without a notification threshold, observers are updated even if their
+  // allocation did not change.
+  observer_1.last_bitrate_bps_ = 0;
+  allocator_->AddObserver(&observer_2, 100000, 300000, 0, true);
+  EXPECT_EQ(400000u, observer_1.last_bitrate_bps_);
+  EXPECT_EQ(600000u, observer_2.last_bitrate_bps_);
+
+  allocator_->RemoveObserver(&observer_1);
+  allocator_->RemoveObserver(&observer_2);
+}
+
+TEST_F(BitrateAllocatorTest, NotificationThreshold) {
+  TestBitrateObserver observer;
+  allocator_->SetNotificationThreshold(0.1);
+  allocator_->AddObserver(&observer, 100000, 1500000, 0, true);
+  EXPECT_EQ(300000u, observer.last_bitrate_bps_);
+
+  // Changes of up to 10% are not reported.
+  allocator_->OnNetworkChanged(320000, 0, 50);
+  EXPECT_EQ(300000u, observer.last_bitrate_bps_);
+
+  allocator_->OnNetworkChanged(340000, 0, 50);
+  EXPECT_EQ(340000u, observer.last_bitrate_bps_);
+
+  // A change in packet loss is always reported.
+  allocator_->OnNetworkChanged(350000, 10, 50);
+  EXPECT_EQ(350000u, observer.last_bitrate_bps_);
+  EXPECT_EQ(10, observer.last_fraction_loss_);
+
+  allocator_->RemoveObserver(&observer);
+}
+
 }  // namespace webrtc
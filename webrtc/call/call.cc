@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "webrtc/audio/audio_receive_stream.h"
@@ -27,6 +28,7 @@
 #include "webrtc/base/trace_event.h"
 #include "webrtc/call.h"
 #include "webrtc/call/bitrate_allocator.h"
+#include "webrtc/call/rtcp_aggregator.h"
 #include "webrtc/config.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
 #include "webrtc/modules/bitrate_controller/include/bitrate_controller.h"
@@ -55,6 +57,15 @@ const int Call::Config::kDefaultStartBitrateBps = 300000;
 
 namespace internal {
 
+namespace {
+// The size of the aggregated RTCP datagrams. Leaves room for SRTCP and TURN
+// below a 1500 byte MTU, like the RTP packet size used for video.
+const size_t kAggregatedRtcpPacketSize = 1200;
+// How long regular reports may be held, against a report interval of about
+// one second for video and five for audio.
+const int64_t kAggregatedRtcpMaxDelayMs = 20;
+}  // namespace
+
 class Call : public webrtc::Call,
              public PacketReceiver,
              public CongestionController::Observer,
@@ -119,6 +130,14 @@ class Call : public webrtc::Call,
   void ConfigureSync(const std::string& sync_group)
       EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
 
+  // Returns the transport to give a stream that sends on |transport|. That is
+  // the RTCP aggregator shared by all streams sending on |transport| if RTCP
+  // aggregation is enabled, and |transport| itself otherwise.
+  Transport* AcquireTransport(Transport* transport);
+  // Releases a transport returned by AcquireTransport(), once the stream using
+  // it is gone.
+  void ReleaseTransport(Transport* transport);
+
   VoiceEngine* voice_engine() {
     internal::AudioState* audio_state =
         static_cast<internal::AudioState*>(config_.audio_state.get());
@@ -148,9 +167,15 @@ class Call : public webrtc::Call,
 
   std::unique_ptr<RWLockWrapper> receive_crit_;
   // Audio and Video receive streams are owned by the client that creates them.
-  std::map<uint32_t, AudioReceiveStream*> audio_receive_ssrcs_
+  // Every received RTP packet is routed with one lookup in
+  // |receive_ssrcs_|, whatever its media type.
+  struct ReceiveStreams {
+    AudioReceiveStream* audio = nullptr;
+    VideoReceiveStream* video = nullptr;
+  };
+  std::unordered_map<uint32_t, ReceiveStreams> receive_ssrcs_
       GUARDED_BY(receive_crit_);
-  std::map<uint32_t, VideoReceiveStream*> video_receive_ssrcs_
+  std::set<AudioReceiveStream*> audio_receive_streams_
       GUARDED_BY(receive_crit_);
   std::set<VideoReceiveStream*> video_receive_streams_
       GUARDED_BY(receive_crit_);
@@ -185,6 +210,13 @@ class Call : public webrtc::Call,
 
   std::map<std::string, rtc::NetworkRoute> network_routes_;
 
+  struct RtcpAggregatorUsers {
+    std::unique_ptr<RtcpAggregator> aggregator;
+    int num_streams;
+  };
+  // The RTCP aggregators in use, by the transport they send on.
+  std::map<Transport*, RtcpAggregatorUsers> rtcp_aggregators_;
+
   VieRemb remb_;
   const std::unique_ptr<CongestionController> congestion_controller_;
   const std::unique_ptr<SendDelayStats> video_send_delay_stats_;
@@ -278,9 +310,10 @@ Call::~Call() {
   RTC_CHECK(audio_send_ssrcs_.empty());
   RTC_CHECK(video_send_ssrcs_.empty());
   RTC_CHECK(video_send_streams_.empty());
-  RTC_CHECK(audio_receive_ssrcs_.empty());
-  RTC_CHECK(video_receive_ssrcs_.empty());
+  RTC_CHECK(receive_ssrcs_.empty());
+  RTC_CHECK(audio_receive_streams_.empty());
   RTC_CHECK(video_receive_streams_.empty());
+  RTC_CHECK(rtcp_aggregators_.empty());
 
   pacer_thread_->Stop();
   pacer_thread_->DeRegisterModule(congestion_controller_->pacer());
@@ -371,9 +404,12 @@ webrtc::AudioSendStream* Call::CreateAudioSendStream(
   TRACE_EVENT0("webrtc", "Call::CreateAudioSendStream");
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
   event_log_->LogAudioSendStreamConfig(config);
+  webrtc::AudioSendStream::Config stream_config = config;
+  stream_config.send_transport = AcquireTransport(config.send_transport);
   AudioSendStream* send_stream = new AudioSendStream(
-      config, config_.audio_state, &worker_queue_, congestion_controller_.get(),
-      bitrate_allocator_.get(), event_log_, call_stats_->rtcp_rtt_stats());
+      stream_config, config_.audio_state, &worker_queue_,
+      congestion_controller_.get(), bitrate_allocator_.get(), event_log_,
+      call_stats_->rtcp_rtt_stats());
   {
     WriteLockScoped write_lock(*send_crit_);
     RTC_DCHECK(audio_send_ssrcs_.find(config.rtp.ssrc) ==
@@ -401,7 +437,9 @@ void Call::DestroyAudioSendStream(webrtc::AudioSendStream* send_stream) {
     RTC_DCHECK(num_deleted == 1);
   }
   UpdateAggregateNetworkState();
+  Transport* transport = audio_send_stream->config().send_transport;
   delete audio_send_stream;
+  ReleaseTransport(transport);
 }
 
 webrtc::AudioReceiveStream* Call::CreateAudioReceiveStream(
@@ -409,13 +447,18 @@ webrtc::AudioReceiveStream* Call::CreateAudioReceiveStream(
   TRACE_EVENT0("webrtc", "Call::CreateAudioReceiveStream");
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
   event_log_->LogAudioReceiveStreamConfig(config);
-  AudioReceiveStream* receive_stream = new AudioReceiveStream(
-      congestion_controller_.get(), config, config_.audio_state, event_log_);
+  webrtc::AudioReceiveStream::Config stream_config = config;
+  stream_config.rtcp_send_transport =
+      AcquireTransport(config.rtcp_send_transport);
+  AudioReceiveStream* receive_stream =
+      new AudioReceiveStream(congestion_controller_.get(), stream_config,
+                             config_.audio_state, event_log_);
   {
     WriteLockScoped write_lock(*receive_crit_);
-    RTC_DCHECK(audio_receive_ssrcs_.find(config.rtp.remote_ssrc) ==
-               audio_receive_ssrcs_.end());
-    audio_receive_ssrcs_[config.rtp.remote_ssrc] = receive_stream;
+    ReceiveStreams& streams = receive_ssrcs_[config.rtp.remote_ssrc];
+    RTC_DCHECK(!streams.audio);
+    streams.audio = receive_stream;
+    audio_receive_streams_.insert(receive_stream);
     ConfigureSync(config.sync_group);
   }
   receive_stream->SignalNetworkState(audio_network_state_);
@@ -432,8 +475,14 @@ void Call::DestroyAudioReceiveStream(
       static_cast<webrtc::internal::AudioReceiveStream*>(receive_stream);
   {
     WriteLockScoped write_lock(*receive_crit_);
-    size_t num_deleted = audio_receive_ssrcs_.erase(
-        audio_receive_stream->config().rtp.remote_ssrc);
+    auto ssrc_it =
+        receive_ssrcs_.find(audio_receive_stream->config().rtp.remote_ssrc);
+    RTC_DCHECK(ssrc_it != receive_ssrcs_.end());
+    RTC_DCHECK(ssrc_it->second.audio == audio_receive_stream);
+    ssrc_it->second.audio = nullptr;
+    if (!ssrc_it->second.video)
+      receive_ssrcs_.erase(ssrc_it);
+    size_t num_deleted = audio_receive_streams_.erase(audio_receive_stream);
     RTC_DCHECK(num_deleted == 1);
     const std::string& sync_group = audio_receive_stream->config().sync_group;
     const auto it = sync_stream_mapping_.find(sync_group);
@@ -444,7 +493,9 @@ void Call::DestroyAudioReceiveStream(
     }
   }
   UpdateAggregateNetworkState();
+  Transport* transport = audio_receive_stream->config().rtcp_send_transport;
   delete audio_receive_stream;
+  ReleaseTransport(transport);
 }
 
 webrtc::VideoSendStream* Call::CreateVideoSendStream(
@@ -460,6 +511,7 @@ webrtc::VideoSendStream* Call::CreateVideoSendStream(
   // the call has already started.
   // Copy ssrcs from |config| since |config| is moved.
   std::vector<uint32_t> ssrcs = config.rtp.ssrcs;
+  config.send_transport = AcquireTransport(config.send_transport);
   VideoSendStream* send_stream = new VideoSendStream(
       num_cpu_cores_, module_process_thread_.get(), &worker_queue_,
       call_stats_.get(), congestion_controller_.get(), bitrate_allocator_.get(),
@@ -512,13 +564,17 @@ void Call::DestroyVideoSendStream(webrtc::VideoSendStream* send_stream) {
   }
 
   UpdateAggregateNetworkState();
+  Transport* transport = send_stream_impl->config().send_transport;
   delete send_stream_impl;
+  ReleaseTransport(transport);
 }
 
 webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     webrtc::VideoReceiveStream::Config configuration) {
   TRACE_EVENT0("webrtc", "Call::CreateVideoReceiveStream");
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
+  configuration.rtcp_send_transport =
+      AcquireTransport(configuration.rtcp_send_transport);
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
       num_cpu_cores_, congestion_controller_.get(), std::move(configuration),
       voice_engine(), module_process_thread_.get(), call_stats_.get(), &remb_);
@@ -526,14 +582,14 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
     WriteLockScoped write_lock(*receive_crit_);
-    RTC_DCHECK(video_receive_ssrcs_.find(config.rtp.remote_ssrc) ==
-               video_receive_ssrcs_.end());
-    video_receive_ssrcs_[config.rtp.remote_ssrc] = receive_stream;
+    ReceiveStreams& streams = receive_ssrcs_[config.rtp.remote_ssrc];
+    RTC_DCHECK(!streams.video);
+    streams.video = receive_stream;
     // TODO(pbos): Configure different RTX payloads per receive payload.
     VideoReceiveStream::Config::Rtp::RtxMap::const_iterator it =
         config.rtp.rtx.begin();
     if (it != config.rtp.rtx.end())
-      video_receive_ssrcs_[it->second.ssrc] = receive_stream;
+      receive_ssrcs_[it->second.ssrc].video = receive_stream;
     video_receive_streams_.insert(receive_stream);
     ConfigureSync(config.sync_group);
   }
@@ -553,23 +609,26 @@ void Call::DestroyVideoReceiveStream(
     WriteLockScoped write_lock(*receive_crit_);
     // Remove all ssrcs pointing to a receive stream. As RTX retransmits on a
     // separate SSRC there can be either one or two.
-    auto it = video_receive_ssrcs_.begin();
-    while (it != video_receive_ssrcs_.end()) {
-      if (it->second == static_cast<VideoReceiveStream*>(receive_stream)) {
-        if (receive_stream_impl != nullptr)
-          RTC_DCHECK(receive_stream_impl == it->second);
-        receive_stream_impl = it->second;
-        video_receive_ssrcs_.erase(it++);
-      } else {
-        ++it;
+    auto it = receive_ssrcs_.begin();
+    while (it != receive_ssrcs_.end()) {
+      if (it->second.video ==
+          static_cast<VideoReceiveStream*>(receive_stream)) {
+        receive_stream_impl = it->second.video;
+        it->second.video = nullptr;
       }
+      if (!it->second.audio && !it->second.video)
+        receive_ssrcs_.erase(it++);
+      else
+        ++it;
     }
     video_receive_streams_.erase(receive_stream_impl);
     RTC_CHECK(receive_stream_impl != nullptr);
     ConfigureSync(receive_stream_impl->config().sync_group);
   }
   UpdateAggregateNetworkState();
+  Transport* transport = receive_stream_impl->config().rtcp_send_transport;
   delete receive_stream_impl;
+  ReleaseTransport(transport);
 }
 
 Call::Stats Call::GetStats() const {
@@ -651,11 +710,11 @@ void Call::SignalChannelNetworkState(MediaType media, NetworkState state) {
   }
   {
     ReadLockScoped read_lock(*receive_crit_);
-    for (auto& kv : audio_receive_ssrcs_) {
-      kv.second->SignalNetworkState(audio_network_state_);
+    for (AudioReceiveStream* stream : audio_receive_streams_) {
+      stream->SignalNetworkState(audio_network_state_);
     }
-    for (auto& kv : video_receive_ssrcs_) {
-      kv.second->SignalNetworkState(video_network_state_);
+    for (VideoReceiveStream* stream : video_receive_streams_) {
+      stream->SignalNetworkState(video_network_state_);
     }
   }
 }
@@ -712,9 +771,9 @@ void Call::UpdateAggregateNetworkState() {
   }
   {
     ReadLockScoped read_lock(*receive_crit_);
-    if (audio_receive_ssrcs_.size() > 0)
+    if (audio_receive_streams_.size() > 0)
       have_audio = true;
-    if (video_receive_ssrcs_.size() > 0)
+    if (video_receive_streams_.size() > 0)
       have_video = true;
   }
 
@@ -801,15 +860,15 @@ void Call::ConfigureSync(const std::string& sync_group) {
     sync_audio_stream = it->second;
   } else {
     // No configured audio stream, see if we can find one.
-    for (const auto& kv : audio_receive_ssrcs_) {
-      if (kv.second->config().sync_group == sync_group) {
+    for (AudioReceiveStream* stream : audio_receive_streams_) {
+      if (stream->config().sync_group == sync_group) {
         if (sync_audio_stream != nullptr) {
           LOG(LS_WARNING) << "Attempting to sync more than one audio stream "
                              "within the same sync group. This is not "
                              "supported in the current implementation.";
           break;
         }
-        sync_audio_stream = kv.second;
+        sync_audio_stream = stream;
       }
     }
   }
@@ -837,6 +896,36 @@ void Call::ConfigureSync(const std::string& sync_group) {
   }
 }
 
+Transport* Call::AcquireTransport(Transport* transport) {
+  RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
+  if (!config_.aggregate_rtcp || transport == nullptr)
+    return transport;
+  RtcpAggregatorUsers& users = rtcp_aggregators_[transport];
+  if (!users.aggregator) {
+    users.aggregator.reset(new RtcpAggregator(clock_, transport,
+                                              kAggregatedRtcpPacketSize,
+                                              kAggregatedRtcpMaxDelayMs));
+    users.num_streams = 0;
+    module_process_thread_->RegisterModule(users.aggregator.get());
+  }
+  ++users.num_streams;
+  return users.aggregator.get();
+}
+
+void Call::ReleaseTransport(Transport* transport) {
+  RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
+  for (auto it = rtcp_aggregators_.begin(); it != rtcp_aggregators_.end();
+       ++it) {
+    if (it->second.aggregator.get() != transport)
+      continue;
+    if (--it->second.num_streams == 0) {
+      module_process_thread_->DeRegisterModule(it->second.aggregator.get());
+      rtcp_aggregators_.erase(it);
+    }
+    return;
+  }
+}
+
 PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
                                                  const uint8_t* packet,
                                                  size_t length) {
@@ -859,8 +948,8 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
   }
   if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
     ReadLockScoped read_lock(*receive_crit_);
-    for (auto& kv : audio_receive_ssrcs_) {
-      if (kv.second->DeliverRtcp(packet, length))
+    for (AudioReceiveStream* stream : audio_receive_streams_) {
+      if (stream->DeliverRtcp(packet, length))
         rtcp_delivered = true;
     }
   }
@@ -896,33 +985,28 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
 
   uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(&packet[8]);
   ReadLockScoped read_lock(*receive_crit_);
-  if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
-    auto it = audio_receive_ssrcs_.find(ssrc);
-    if (it != audio_receive_ssrcs_.end()) {
-      received_bytes_per_second_counter_.Add(static_cast<int>(length));
-      received_audio_bytes_per_second_counter_.Add(static_cast<int>(length));
-      auto status = it->second->DeliverRtp(packet, length, packet_time)
-                        ? DELIVERY_OK
-                        : DELIVERY_PACKET_ERROR;
-      if (status == DELIVERY_OK)
-        event_log_->LogRtpHeader(kIncomingPacket, media_type, packet, length);
-      return status;
-    }
-  }
-  if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
-    auto it = video_receive_ssrcs_.find(ssrc);
-    if (it != video_receive_ssrcs_.end()) {
-      received_bytes_per_second_counter_.Add(static_cast<int>(length));
-      received_video_bytes_per_second_counter_.Add(static_cast<int>(length));
-      auto status = it->second->DeliverRtp(packet, length, packet_time)
-                        ? DELIVERY_OK
-                        : DELIVERY_PACKET_ERROR;
-      if (status == DELIVERY_OK)
-        event_log_->LogRtpHeader(kIncomingPacket, media_type, packet, length);
-      return status;
-    }
+  auto it = receive_ssrcs_.find(ssrc);
+  if (it == receive_ssrcs_.end())
+    return DELIVERY_UNKNOWN_SSRC;
+  bool delivered;
+  if (it->second.audio &&
+      (media_type == MediaType::ANY || media_type == MediaType::AUDIO)) {
+    received_bytes_per_second_counter_.Add(static_cast<int>(length));
+    received_audio_bytes_per_second_counter_.Add(static_cast<int>(length));
+    delivered = it->second.audio->DeliverRtp(packet, length, packet_time);
+  } else if (it->second.video &&
+             (media_type == MediaType::ANY ||
+              media_type == MediaType::VIDEO)) {
+    received_bytes_per_second_counter_.Add(static_cast<int>(length));
+    received_video_bytes_per_second_counter_.Add(static_cast<int>(length));
+    delivered = it->second.video->DeliverRtp(packet, length, packet_time);
+  } else {
+    return DELIVERY_UNKNOWN_SSRC;
   }
-  return DELIVERY_UNKNOWN_SSRC;
+  if (!delivered)
+    return DELIVERY_PACKET_ERROR;
+  event_log_->LogRtpHeader(kIncomingPacket, media_type, packet, length);
+  return DELIVERY_OK;
 }
 
 PacketReceiver::DeliveryStatus Call::DeliverPacket(
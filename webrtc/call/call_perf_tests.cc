@@ -8,6 +8,11 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+#if defined(WEBRTC_LINUX)
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <limits>
 #include <memory>
@@ -24,8 +29,10 @@
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_utility.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
+#include "webrtc/system_wrappers/include/memory_usage.h"
 #include "webrtc/system_wrappers/include/metrics_default.h"
 #include "webrtc/system_wrappers/include/rtp_to_ntp.h"
+#include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/call_test.h"
 #include "webrtc/test/direct_transport.h"
 #include "webrtc/test/drifting_clock.h"
@@ -49,6 +56,29 @@ using webrtc::test::FakeAudioDevice;
 
 namespace webrtc {
 
+namespace {
+
+// Returns the resident set size of the process in bytes, or 0 where that
+// isn't available.
+size_t ResidentBytes() {
+#if defined(WEBRTC_LINUX)
+  FILE* file = fopen("/proc/self/statm", "r");
+  if (!file)
+    return 0;
+  unsigned long size_pages = 0;
+  unsigned long resident_pages = 0;
+  const int fields = fscanf(file, "%lu %lu", &size_pages, &resident_pages);
+  fclose(file);
+  if (fields != 2)
+    return 0;
+  return resident_pages * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
 class CallPerfTest : public test::CallTest {
  protected:
   enum class FecMode {
@@ -67,6 +97,10 @@ class CallPerfTest : public test::CallTest {
 
   void TestMinTransmitBitrate(bool pad_to_min_bitrate);
 
+  void TestMemoryFootprint(size_t num_audio_streams,
+                           size_t num_video_streams,
+                           const std::string& test_label);
+
   void TestCaptureNtpTime(const FakeNetworkPipe::Config& net_config,
                           int threshold_ms,
                           int start_time_ms,
@@ -735,4 +769,100 @@ TEST_F(CallPerfTest, KeepsHighBitrateWhenReconfiguringSender) {
   RunBaseTest(&test);
 }
 
+void CallPerfTest::TestMemoryFootprint(size_t num_audio_streams,
+                                       size_t num_video_streams,
+                                       const std::string& test_label) {
+  static const int kRunTimeMs = 10000;
+  class MemoryObserver : public test::EndToEndTest {
+   public:
+    MemoryObserver(size_t num_audio_streams,
+                   size_t num_video_streams,
+                   const std::string& test_label)
+        : EndToEndTest(kLongTimeoutMs),
+          num_audio_streams_(num_audio_streams),
+          num_video_streams_(num_video_streams),
+          test_label_(test_label),
+          resident_bytes_before_(ResidentBytes()) {
+      memory_usage::Enable();
+      memory_usage::ResetPeaks();
+      net_config_.queue_delay_ms = 50;
+      net_config_.delay_standard_deviation_ms = 10;
+    }
+
+   private:
+    size_t GetNumAudioStreams() const override { return num_audio_streams_; }
+    size_t GetNumVideoStreams() const override { return num_video_streams_; }
+
+    test::PacketTransport* CreateSendTransport(Call* sender_call) override {
+      return new test::PacketTransport(
+          sender_call, this, test::PacketTransport::kSender, net_config_);
+    }
+
+    test::PacketTransport* CreateReceiveTransport() override {
+      return new test::PacketTransport(
+          nullptr, this, test::PacketTransport::kReceiver, net_config_);
+    }
+
+    void ModifyVideoConfigs(
+        VideoSendStream::Config* send_config,
+        std::vector<VideoReceiveStream::Config>* receive_configs,
+        VideoEncoderConfig* encoder_config) override {
+      send_config->rtp.nack.rtp_history_ms = kNackRtpHistoryMs;
+      for (auto& receive_config : *receive_configs)
+        receive_config.rtp.nack.rtp_history_ms = kNackRtpHistoryMs;
+    }
+
+    void ModifyVideoCaptureStartResolution(int* width,
+                                           int* height,
+                                           int* frame_rate) override {
+      *width = 1280;
+      *height = 720;
+    }
+
+    void PerformTest() override {
+      // Let the jitter buffers, packet histories and frame pools fill up.
+      SleepMs(kRunTimeMs);
+
+      // Both ends of the call run in this process, so this is what a client
+      // and a server endpoint hold for one call together.
+      for (int i = 0; i < memory_usage::kNumSubsystems; ++i) {
+        const memory_usage::Subsystem subsystem =
+            static_cast<memory_usage::Subsystem>(i);
+        test::PrintResult(
+            "memory_usage", std::string("_") + memory_usage::GetName(subsystem),
+            test_label_,
+            static_cast<size_t>(memory_usage::GetUsage(subsystem).peak_bytes),
+            "bytes", false);
+      }
+      const size_t resident_bytes = ResidentBytes();
+      if (resident_bytes > 0) {
+        test::PrintResult("memory_usage", "_resident", test_label_,
+                          resident_bytes - std::min(resident_bytes,
+                                                    resident_bytes_before_),
+                          "bytes", false);
+      }
+    }
+
+    const size_t num_audio_streams_;
+    const size_t num_video_streams_;
+    const std::string test_label_;
+    const size_t resident_bytes_before_;
+    FakeNetworkPipe::Config net_config_;
+  } test(num_audio_streams, num_video_streams, test_label);
+
+  RunBaseTest(&test);
+}
+
+TEST_F(CallPerfTest, MemoryFootprintAudioOnly) {
+  TestMemoryFootprint(1, 0, "audio_only");
+}
+
+TEST_F(CallPerfTest, MemoryFootprintAudioVideo) {
+  TestMemoryFootprint(1, 1, "audio_video");
+}
+
+TEST_F(CallPerfTest, MemoryFootprintSimulcast) {
+  TestMemoryFootprint(1, kNumSsrcs, "simulcast");
+}
+
 }  // namespace webrtc
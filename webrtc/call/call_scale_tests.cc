@@ -0,0 +1,412 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#if defined(WEBRTC_POSIX)
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/call.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/system_wrappers/include/sleep.h"
+#include "webrtc/test/call_test.h"
+#include "webrtc/test/direct_transport.h"
+#include "webrtc/test/encoder_settings.h"
+#include "webrtc/test/fake_encoder.h"
+#include "webrtc/test/frame_generator_capturer.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kWarmUpTimeMs = 2000;
+const int kRunTimeMs = 10000;
+const int kWidth = 320;
+const int kHeight = 180;
+const int kFramerate = 30;
+const int kStreamBitrateBps = 300000;
+const uint32_t kFirstSsrc = 0x10000;
+
+// CPU time and context switches of the process.
+struct ProcessUsage {
+  int64_t cpu_time_us = 0;
+  int64_t context_switches = 0;
+};
+
+ProcessUsage GetProcessUsage() {
+  ProcessUsage usage;
+#if defined(WEBRTC_POSIX)
+  struct rusage rusage;
+  if (getrusage(RUSAGE_SELF, &rusage) == 0) {
+    usage.cpu_time_us =
+        (rusage.ru_utime.tv_sec + rusage.ru_stime.tv_sec) *
+            rtc::kNumMicrosecsPerSec +
+        rusage.ru_utime.tv_usec + rusage.ru_stime.tv_usec;
+    usage.context_switches = rusage.ru_nvcsw + rusage.ru_nivcsw;
+  }
+#endif
+  return usage;
+}
+
+// Returns the number of threads in the process, or 0 where that isn't
+// available.
+size_t NumThreads() {
+  size_t threads = 0;
+#if defined(WEBRTC_LINUX)
+  FILE* file = fopen("/proc/self/status", "r");
+  if (!file)
+    return 0;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (sscanf(line, "Threads: %zu", &threads) == 1)
+      break;
+  }
+  fclose(file);
+#endif
+  return threads;
+}
+
+// Hands the frames of one capturer to all send streams, so that the number of
+// capture threads doesn't grow with the number of streams.
+class FrameForwarder : public rtc::VideoSourceInterface<VideoFrame>,
+                       public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  void AddOrUpdateSink(rtc::VideoSinkInterface<VideoFrame>* sink,
+                       const rtc::VideoSinkWants& wants) override {
+    rtc::CritScope lock(&crit_);
+    if (std::find(sinks_.begin(), sinks_.end(), sink) == sinks_.end())
+      sinks_.push_back(sink);
+  }
+
+  void RemoveSink(rtc::VideoSinkInterface<VideoFrame>* sink) override {
+    rtc::CritScope lock(&crit_);
+    sinks_.erase(std::remove(sinks_.begin(), sinks_.end(), sink),
+                 sinks_.end());
+  }
+
+  void OnFrame(const VideoFrame& frame) override {
+    rtc::CritScope lock(&crit_);
+    for (rtc::VideoSinkInterface<VideoFrame>* sink : sinks_)
+      sink->OnFrame(frame);
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  std::vector<rtc::VideoSinkInterface<VideoFrame>*> sinks_ GUARDED_BY(crit_);
+};
+
+// Collects the time from sending the first packet of a frame until the frame
+// is rendered, over all streams.
+class LatencyTracker {
+ public:
+  void OnRtpSent(const uint8_t* packet, size_t length) {
+    if (length < 12)
+      return;
+    const uint64_t key = Key(ByteReader<uint32_t>::ReadBigEndian(&packet[8]),
+                             ByteReader<uint32_t>::ReadBigEndian(&packet[4]));
+    const int64_t now_ms = rtc::TimeMillis();
+    rtc::CritScope lock(&crit_);
+    // Forget frames that were never rendered, e.g. because a packet was lost,
+    // so that the map doesn't grow for the length of the test.
+    while (!send_order_.empty() &&
+           now_ms - send_order_.front().first > kMaxLatencyMs) {
+      auto it = send_times_ms_.find(send_order_.front().second);
+      if (it != send_times_ms_.end() &&
+          it->second == send_order_.front().first) {
+        send_times_ms_.erase(it);
+      }
+      send_order_.pop_front();
+    }
+    // Only the first packet of a frame starts its latency.
+    if (send_times_ms_.insert(std::make_pair(key, now_ms)).second)
+      send_order_.push_back(std::make_pair(now_ms, key));
+  }
+
+  void OnFrameRendered(uint32_t ssrc, uint32_t rtp_timestamp) {
+    const int64_t now_ms = rtc::TimeMillis();
+    rtc::CritScope lock(&crit_);
+    auto it = send_times_ms_.find(Key(ssrc, rtp_timestamp));
+    if (it == send_times_ms_.end())
+      return;
+    if (measuring_)
+      latencies_ms_.push_back(now_ms - it->second);
+    ++frames_rendered_;
+    send_times_ms_.erase(it);
+  }
+
+  // Clears the results and starts collecting new ones.
+  void StartMeasuring() {
+    rtc::CritScope lock(&crit_);
+    measuring_ = true;
+    latencies_ms_.clear();
+    frames_rendered_ = 0;
+  }
+
+  // Returns the collected latencies, sorted, and stops collecting.
+  std::vector<int64_t> StopMeasuring(size_t* frames_rendered) {
+    rtc::CritScope lock(&crit_);
+    measuring_ = false;
+    *frames_rendered = frames_rendered_;
+    std::sort(latencies_ms_.begin(), latencies_ms_.end());
+    return latencies_ms_;
+  }
+
+ private:
+  // Frames not rendered this long after they were sent are taken as lost.
+  static const int64_t kMaxLatencyMs = 5000;
+
+  static uint64_t Key(uint32_t ssrc, uint32_t rtp_timestamp) {
+    return (static_cast<uint64_t>(ssrc) << 32) | rtp_timestamp;
+  }
+
+  rtc::CriticalSection crit_;
+  std::map<uint64_t, int64_t> send_times_ms_ GUARDED_BY(crit_);
+  // Send times and keys of |send_times_ms_|, oldest first.
+  std::deque<std::pair<int64_t, uint64_t>> send_order_ GUARDED_BY(crit_);
+  bool measuring_ GUARDED_BY(crit_) = false;
+  std::vector<int64_t> latencies_ms_ GUARDED_BY(crit_);
+  size_t frames_rendered_ GUARDED_BY(crit_) = 0;
+};
+
+class LatencyTrackingTransport : public test::DirectTransport {
+ public:
+  LatencyTrackingTransport(Call* send_call, LatencyTracker* tracker)
+      : test::DirectTransport(send_call), tracker_(tracker) {}
+
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    tracker_->OnRtpSent(packet, length);
+    return test::DirectTransport::SendRtp(packet, length, options);
+  }
+
+ private:
+  LatencyTracker* const tracker_;
+};
+
+class Renderer : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  Renderer(uint32_t ssrc, LatencyTracker* tracker)
+      : ssrc_(ssrc), tracker_(tracker) {}
+
+  void OnFrame(const VideoFrame& frame) override {
+    tracker_->OnFrameRendered(ssrc_, frame.timestamp());
+  }
+
+ private:
+  const uint32_t ssrc_;
+  LatencyTracker* const tracker_;
+};
+
+// One call: a sender and a receiver Call, each with its own pacer, process and
+// transport threads, and |num_streams| video streams from the sender to the
+// receiver, fed by |source|.
+class CallPair {
+ public:
+  CallPair(RtcEventLog* event_log,
+           Clock* clock,
+           size_t num_streams,
+           uint32_t first_ssrc,
+           rtc::VideoSourceInterface<VideoFrame>* source,
+           LatencyTracker* latency_tracker) {
+    Call::Config sender_config(event_log);
+    sender_config.bitrate_config.start_bitrate_bps =
+        kStreamBitrateBps * num_streams;
+    sender_call_.reset(Call::Create(sender_config));
+    receiver_call_.reset(Call::Create(Call::Config(event_log)));
+
+    send_transport_.reset(
+        new LatencyTrackingTransport(sender_call_.get(), latency_tracker));
+    receive_transport_.reset(new test::DirectTransport(receiver_call_.get()));
+    send_transport_->SetReceiver(receiver_call_->Receiver());
+    receive_transport_->SetReceiver(sender_call_->Receiver());
+
+    for (size_t i = 0; i < num_streams; ++i) {
+      const uint32_t ssrc = first_ssrc + static_cast<uint32_t>(i);
+      encoders_.emplace_back(new test::FakeEncoder(clock));
+      VideoSendStream::Config send_config(send_transport_.get());
+      send_config.encoder_settings.encoder = encoders_.back().get();
+      send_config.encoder_settings.payload_name = "FAKE";
+      send_config.encoder_settings.payload_type =
+          test::CallTest::kFakeVideoSendPayloadType;
+      send_config.rtp.ssrcs.push_back(ssrc);
+      VideoEncoderConfig encoder_config;
+      test::FillEncoderConfiguration(1, &encoder_config);
+      send_streams_.push_back(sender_call_->CreateVideoSendStream(
+          send_config.Copy(), encoder_config.Copy()));
+      send_streams_.back()->SetSource(source);
+
+      renderers_.emplace_back(new Renderer(ssrc, latency_tracker));
+      VideoReceiveStream::Config receive_config(receive_transport_.get());
+      receive_config.rtp.remote_ssrc = ssrc;
+      receive_config.rtp.local_ssrc = test::CallTest::kReceiverLocalVideoSsrc;
+      receive_config.rtp.remb = true;
+      receive_config.renderer = renderers_.back().get();
+      VideoReceiveStream::Decoder decoder =
+          test::CreateMatchingDecoder(send_config.encoder_settings);
+      decoders_.emplace_back(decoder.decoder);
+      receive_config.decoders.push_back(decoder);
+      receive_streams_.push_back(
+          receiver_call_->CreateVideoReceiveStream(receive_config.Copy()));
+    }
+  }
+
+  ~CallPair() {
+    send_transport_->StopSending();
+    receive_transport_->StopSending();
+    for (VideoSendStream* send_stream : send_streams_)
+      sender_call_->DestroyVideoSendStream(send_stream);
+    for (VideoReceiveStream* receive_stream : receive_streams_)
+      receiver_call_->DestroyVideoReceiveStream(receive_stream);
+    send_transport_.reset();
+    receive_transport_.reset();
+  }
+
+  void Start() {
+    for (VideoReceiveStream* receive_stream : receive_streams_)
+      receive_stream->Start();
+    for (VideoSendStream* send_stream : send_streams_)
+      send_stream->Start();
+  }
+
+  void Stop() {
+    for (VideoSendStream* send_stream : send_streams_)
+      send_stream->Stop();
+    for (VideoReceiveStream* receive_stream : receive_streams_)
+      receive_stream->Stop();
+  }
+
+ private:
+  std::unique_ptr<Call> sender_call_;
+  std::unique_ptr<Call> receiver_call_;
+  std::unique_ptr<LatencyTrackingTransport> send_transport_;
+  std::unique_ptr<test::DirectTransport> receive_transport_;
+  std::vector<std::unique_ptr<test::FakeEncoder>> encoders_;
+  std::vector<std::unique_ptr<VideoDecoder>> decoders_;
+  std::vector<std::unique_ptr<Renderer>> renderers_;
+  std::vector<VideoSendStream*> send_streams_;
+  std::vector<VideoReceiveStream*> receive_streams_;
+};
+
+}  // namespace
+
+// Runs ::testing::get<0>(GetParam()) concurrent calls, each a sender and a
+// receiver Call of their own with ::testing::get<1>(GetParam()) video streams,
+// using fake codecs, and reports how the process scales: CPU time and frames
+// rendered per stream, threads, context switches and the send-to-render
+// latency percentiles. Streams within one call share its pacer and threads,
+// while every extra call brings its own, so both dimensions are swept.
+class CallScaleTest
+    : public test::CallTest,
+      public ::testing::WithParamInterface< ::testing::tuple<size_t, size_t>> {
+};
+
+TEST_P(CallScaleTest, VideoStreams) {
+  const size_t num_calls = ::testing::get<0>(GetParam());
+  const size_t streams_per_call = ::testing::get<1>(GetParam());
+  const size_t num_streams = num_calls * streams_per_call;
+  const std::string test_label = std::to_string(num_calls) + "_calls_" +
+                                 std::to_string(streams_per_call) + "_streams";
+
+  LatencyTracker latency_tracker;
+  FrameForwarder frame_forwarder;
+  std::unique_ptr<test::FrameGeneratorCapturer> capturer(
+      test::FrameGeneratorCapturer::Create(kWidth, kHeight, kFramerate,
+                                           clock_));
+  capturer->AddOrUpdateSink(&frame_forwarder, rtc::VideoSinkWants());
+
+  std::vector<std::unique_ptr<CallPair>> calls;
+  for (size_t i = 0; i < num_calls; ++i) {
+    calls.emplace_back(new CallPair(
+        &event_log_, clock_, streams_per_call,
+        kFirstSsrc + static_cast<uint32_t>(i * streams_per_call),
+        &frame_forwarder, &latency_tracker));
+  }
+
+  for (const std::unique_ptr<CallPair>& call : calls)
+    call->Start();
+  capturer->Start();
+
+  SleepMs(kWarmUpTimeMs);
+  latency_tracker.StartMeasuring();
+  const ProcessUsage usage_before = GetProcessUsage();
+  const int64_t start_us = rtc::TimeMicros();
+  SleepMs(kRunTimeMs);
+  const ProcessUsage usage_after = GetProcessUsage();
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  size_t frames_rendered = 0;
+  std::vector<int64_t> latencies_ms =
+      latency_tracker.StopMeasuring(&frames_rendered);
+  const size_t num_threads = NumThreads();
+
+  capturer->Stop();
+  for (const std::unique_ptr<CallPair>& call : calls)
+    call->Stop();
+  calls.clear();
+
+  EXPECT_GT(frames_rendered, 0u);
+  const double elapsed_s =
+      static_cast<double>(elapsed_us) / rtc::kNumMicrosecsPerSec;
+  test::PrintResult(
+      "call_scale", "_cpu_per_stream", test_label,
+      static_cast<size_t>((usage_after.cpu_time_us - usage_before.cpu_time_us) /
+                          elapsed_s / num_streams),
+      "us/s", true);
+  test::PrintResult("call_scale", "_fps_per_stream", test_label,
+                    static_cast<size_t>(frames_rendered / elapsed_s /
+                                        num_streams),
+                    "fps", true);
+  test::PrintResult("call_scale", "_threads", test_label, num_threads,
+                    "threads", true);
+  test::PrintResult(
+      "call_scale", "_context_switches", test_label,
+      static_cast<size_t>(
+          (usage_after.context_switches - usage_before.context_switches) /
+          elapsed_s),
+      "switches/s", true);
+  if (!latencies_ms.empty()) {
+    for (int percentile : {50, 90, 99}) {
+      test::PrintResult(
+          "call_scale", "_latency_p" + std::to_string(percentile), test_label,
+          static_cast<size_t>(
+              latencies_ms[(latencies_ms.size() - 1) * percentile / 100]),
+          "ms", true);
+    }
+  }
+}
+
+// More streams within a single call.
+INSTANTIATE_TEST_CASE_P(StreamCounts,
+                        CallScaleTest,
+                        ::testing::Combine(::testing::Values(1),
+                                           ::testing::Values(1, 10, 100,
+                                                             1000)));
+
+// More calls, with one or a few streams each.
+INSTANTIATE_TEST_CASE_P(CallCounts,
+                        CallScaleTest,
+                        ::testing::Combine(::testing::Values(10, 100),
+                                           ::testing::Values(1, 10)));
+
+}  // namespace webrtc
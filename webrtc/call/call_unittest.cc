@@ -12,22 +12,27 @@
 #include <memory>
 
 #include "webrtc/api/call/audio_state.h"
+#include "webrtc/audio/audio_receive_stream.h"
+#include "webrtc/audio/audio_send_stream.h"
 #include "webrtc/call.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
 #include "webrtc/modules/audio_coding/codecs/mock/mock_audio_decoder_factory.h"
 #include "webrtc/test/gtest.h"
+#include "webrtc/test/mock_transport.h"
 #include "webrtc/test/mock_voice_engine.h"
 
 namespace {
 
 struct CallHelper {
   explicit CallHelper(
-      rtc::scoped_refptr<webrtc::AudioDecoderFactory> decoder_factory = nullptr)
+      rtc::scoped_refptr<webrtc::AudioDecoderFactory> decoder_factory = nullptr,
+      bool aggregate_rtcp = false)
       : voice_engine_(decoder_factory) {
     webrtc::AudioState::Config audio_state_config;
     audio_state_config.voice_engine = &voice_engine_;
     webrtc::Call::Config config(&event_log_);
     config.audio_state = webrtc::AudioState::Create(audio_state_config);
+    config.aggregate_rtcp = aggregate_rtcp;
     call_.reset(webrtc::Call::Create(config));
   }
 
@@ -117,4 +122,33 @@ TEST(CallTest, CreateDestroy_AudioReceiveStreams) {
     streams.clear();
   }
 }
+
+TEST(CallTest, CreateDestroy_AudioStreamsWithRtcpAggregation) {
+  rtc::scoped_refptr<webrtc::AudioDecoderFactory> decoder_factory(
+      new rtc::RefCountedObject<webrtc::MockAudioDecoderFactory>);
+  CallHelper call(decoder_factory, true);
+  MockTransport transport;
+  AudioSendStream::Config send_config(&transport);
+  send_config.rtp.ssrc = 42;
+  send_config.voe_channel_id = 123;
+  AudioSendStream* send_stream = call->CreateAudioSendStream(send_config);
+  AudioReceiveStream::Config receive_config;
+  receive_config.rtp.remote_ssrc = 43;
+  receive_config.voe_channel_id = 124;
+  receive_config.decoder_factory = decoder_factory;
+  receive_config.rtcp_send_transport = &transport;
+  AudioReceiveStream* receive_stream =
+      call->CreateAudioReceiveStream(receive_config);
+  // The streams share an aggregator, which goes away with the last of them.
+  const Transport* aggregator =
+      static_cast<internal::AudioSendStream*>(send_stream)
+          ->config()
+          .send_transport;
+  EXPECT_NE(nullptr, aggregator);
+  EXPECT_NE(&transport, aggregator);
+  EXPECT_EQ(aggregator, static_cast<internal::AudioReceiveStream*>(
+                            receive_stream)->config().rtcp_send_transport);
+  call->DestroyAudioSendStream(send_stream);
+  call->DestroyAudioReceiveStream(receive_stream);
+}
 }  // namespace webrtc
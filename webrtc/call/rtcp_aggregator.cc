@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/call/rtcp_aggregator.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "webrtc/modules/utility/include/process_thread.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+// How long the process thread may sleep while no reports are held. Holding
+// one wakes it up.
+const int64_t kIdleProcessIntervalMs = 60 * 1000;
+
+// Returns true if the compound |packet| only holds regular reports, which can
+// wait for the next shared send. Malformed packets are sent as they are.
+bool IsRegularReport(const uint8_t* packet, size_t length) {
+  const uint8_t* const packet_end = packet + length;
+  rtcp::CommonHeader header;
+  for (const uint8_t* next = packet; next != packet_end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, packet_end - next))
+      return false;
+    switch (header.type()) {
+      case rtcp::SenderReport::kPacketType:
+      case rtcp::ReceiverReport::kPacketType:
+      case rtcp::Sdes::kPacketType:
+      case rtcp::ExtendedReports::kPacketType:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+RtcpAggregator::RtcpAggregator(Clock* clock,
+                               Transport* transport,
+                               size_t max_packet_size,
+                               int64_t max_delay_ms)
+    : clock_(clock),
+      transport_(transport),
+      max_packet_size_(max_packet_size),
+      max_delay_ms_(max_delay_ms),
+      hold_start_ms_(0),
+      process_thread_(nullptr) {
+  RTC_DCHECK(transport);
+  RTC_DCHECK_GT(max_delay_ms, 0);
+}
+
+RtcpAggregator::~RtcpAggregator() {
+  std::vector<uint8_t> packets;
+  {
+    rtc::CritScope lock(&crit_);
+    TakeHeldPackets(&packets);
+  }
+  SendPackets(packets);
+}
+
+bool RtcpAggregator::SendRtp(const uint8_t* packet,
+                             size_t length,
+                             const PacketOptions& options) {
+  return transport_->SendRtp(packet, length, options);
+}
+
+bool RtcpAggregator::SendRtcp(const uint8_t* packet, size_t length) {
+  const bool regular_report = IsRegularReport(packet, length);
+  // Held packets that |packet| doesn't fit behind, and then |packet| together
+  // with the packets held before it.
+  std::vector<uint8_t> earlier_packets;
+  std::vector<uint8_t> packets;
+  bool send_alone = false;
+  ProcessThread* process_thread = nullptr;
+  {
+    rtc::CritScope lock(&crit_);
+    ++stats_.rtcp_packets_received;
+    if (held_packets_.size() + length > max_packet_size_)
+      TakeHeldPackets(&earlier_packets);
+    if (length > max_packet_size_) {
+      ++stats_.rtcp_packets_sent;
+      send_alone = true;
+    } else if (!regular_report) {
+      held_packets_.insert(held_packets_.end(), packet, packet + length);
+      TakeHeldPackets(&packets);
+    } else {
+      if (held_packets_.empty()) {
+        hold_start_ms_ = clock_->TimeInMilliseconds();
+        process_thread = process_thread_;
+      }
+      held_packets_.insert(held_packets_.end(), packet, packet + length);
+    }
+  }
+  // Called without |crit_|, since the process thread takes its own lock
+  // before asking for TimeUntilNextProcess().
+  if (process_thread)
+    process_thread->WakeUp(this);
+  SendPackets(earlier_packets);
+  if (send_alone)
+    return transport_->SendRtcp(packet, length);
+  SendPackets(packets);
+  return true;
+}
+
+int64_t RtcpAggregator::TimeUntilNextProcess() {
+  rtc::CritScope lock(&crit_);
+  if (held_packets_.empty())
+    return kIdleProcessIntervalMs;
+  return std::max<int64_t>(
+      hold_start_ms_ + max_delay_ms_ - clock_->TimeInMilliseconds(), 0);
+}
+
+void RtcpAggregator::Process() {
+  std::vector<uint8_t> packets;
+  {
+    rtc::CritScope lock(&crit_);
+    // The process thread also calls in right after a WakeUp().
+    if (clock_->TimeInMilliseconds() - hold_start_ms_ >= max_delay_ms_)
+      TakeHeldPackets(&packets);
+  }
+  SendPackets(packets);
+}
+
+void RtcpAggregator::ProcessThreadAttached(ProcessThread* process_thread) {
+  rtc::CritScope lock(&crit_);
+  process_thread_ = process_thread;
+}
+
+RtcpAggregator::Stats RtcpAggregator::GetStats() const {
+  rtc::CritScope lock(&crit_);
+  return stats_;
+}
+
+void RtcpAggregator::TakeHeldPackets(std::vector<uint8_t>* packets) {
+  if (held_packets_.empty())
+    return;
+  ++stats_.rtcp_packets_sent;
+  packets->swap(held_packets_);
+}
+
+void RtcpAggregator::SendPackets(const std::vector<uint8_t>& packets) {
+  if (packets.empty())
+    return;
+  // The streams have already counted the held packets as sent, so a failure
+  // here can't be reported back.
+  transport_->SendRtcp(packets.data(), packets.size());
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef WEBRTC_CALL_RTCP_AGGREGATOR_H_
+#define WEBRTC_CALL_RTCP_AGGREGATOR_H_
+
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/include/module.h"
+#include "webrtc/transport.h"
+
+namespace webrtc {
+
+class Clock;
+
+namespace internal {
+
+// Packs the RTCP of the streams that share a Transport into as few datagrams
+// as fit |max_packet_size|, instead of sending one per stream and report.
+// Regular reports (SR, RR, SDES and XR) are held for up to |max_delay_ms|,
+// which is small next to the randomized report interval of RFC 3550. Any
+// other RTCP, such as NACK, PLI or transport feedback, is sent right away
+// together with the reports held at the time. RTP passes straight through.
+// Process() is to be called on a ProcessThread, which the aggregator wakes up
+// when it starts holding reports and leaves idle while it holds none. Packets
+// are sent on the transport without holding the aggregator's lock.
+class RtcpAggregator : public Transport, public Module {
+ public:
+  struct Stats {
+    // RTCP compound packets sent by the streams.
+    size_t rtcp_packets_received = 0;
+    // RTCP datagrams sent on the transport.
+    size_t rtcp_packets_sent = 0;
+  };
+
+  RtcpAggregator(Clock* clock,
+                 Transport* transport,
+                 size_t max_packet_size,
+                 int64_t max_delay_ms);
+  // Sends the reports still held.
+  ~RtcpAggregator() override;
+
+  // Implements Transport.
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override;
+  bool SendRtcp(const uint8_t* packet, size_t length) override;
+
+  // Implements Module.
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+  void ProcessThreadAttached(ProcessThread* process_thread) override;
+
+  Stats GetStats() const;
+
+ private:
+  // Moves the held packets to |packets|, to be sent by SendPackets() once
+  // |crit_| is released.
+  void TakeHeldPackets(std::vector<uint8_t>* packets)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void SendPackets(const std::vector<uint8_t>& packets);
+
+  Clock* const clock_;
+  Transport* const transport_;
+  const size_t max_packet_size_;
+  const int64_t max_delay_ms_;
+
+  rtc::CriticalSection crit_;
+  // The compound packets held, back to back. Never more than
+  // |max_packet_size_| bytes.
+  std::vector<uint8_t> held_packets_ GUARDED_BY(crit_);
+  // When the oldest of |held_packets_| was held.
+  int64_t hold_start_ms_ GUARDED_BY(crit_);
+  ProcessThread* process_thread_ GUARDED_BY(crit_);
+  Stats stats_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtcpAggregator);
+};
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_RTCP_AGGREGATOR_H_
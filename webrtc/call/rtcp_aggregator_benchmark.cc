@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/call/rtcp_aggregator.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_sender.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const int64_t kDurationMs = 10000;  // As in the reported benchmark names.
+const size_t kMaxPacketSize = 1200;
+const int64_t kMaxDelayMs = 20;
+
+// Counts the datagrams handed to it, each of which is a send call on the
+// socket.
+class CountingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    ++packets_;
+    bytes_ += length;
+    return true;
+  }
+
+  size_t packets_ = 0;
+  size_t bytes_ = 0;
+};
+
+// Runs |num_streams| video receive streams' RTCP senders for |kDurationMs|,
+// sending on one transport, either directly or through an RtcpAggregator.
+// Reports the time that takes along with the RTCP datagrams sent, one socket
+// send call each.
+void RunRtcpBenchmark(int num_streams, bool aggregate) {
+  size_t packets = 0;
+  size_t bytes = 0;
+  test::BenchmarkOptions options;
+  options.warmup_iterations = 0;
+  options.repetitions = 5;
+  options.iterations = 1;
+  test::BenchmarkResult result = test::RunBenchmark(
+      "rtcp_10s_" + std::to_string(num_streams) + "_streams_" +
+          (aggregate ? "aggregated" : "direct"),
+      options, [&] {
+        SimulatedClock clock(1);
+        CountingTransport transport;
+        internal::RtcpAggregator aggregator(&clock, &transport, kMaxPacketSize,
+                                            kMaxDelayMs);
+        Transport* stream_transport =
+            aggregate ? static_cast<Transport*>(&aggregator) : &transport;
+        std::vector<std::unique_ptr<RTCPSender>> senders;
+        for (int i = 0; i < num_streams; ++i) {
+          // RTCPSender seeds the randomization of its report interval with
+          // the time, which has to differ for the streams not to report in
+          // lockstep.
+          clock.AdvanceTimeMicroseconds(1);
+          senders.emplace_back(new RTCPSender(false, &clock, nullptr, nullptr,
+                                              nullptr, stream_transport));
+          senders.back()->SetRTCPStatus(RtcpMode::kCompound);
+          senders.back()->SetSSRC(1000 + i);
+          senders.back()->SetRemoteSSRC(2000 + i);
+          senders.back()->SetCNAME("rtcp_aggregator_benchmark");
+        }
+
+        const RTCPSender::FeedbackState feedback_state;
+        for (int64_t time_ms = 0; time_ms < kDurationMs; ++time_ms) {
+          for (const auto& sender : senders) {
+            if (sender->TimeToSendRTCPReport())
+              sender->SendRTCP(feedback_state, kRtcpReport);
+          }
+          if (aggregator.TimeUntilNextProcess() == 0)
+            aggregator.Process();
+          clock.AdvanceTimeMilliseconds(1);
+        }
+        packets = transport.packets_;
+        bytes = transport.bytes_;
+      });
+  result.counters.push_back(
+      {"packets", static_cast<double>(packets), "packets"});
+  result.counters.push_back(
+      {"bytes_per_packet", packets ? static_cast<double>(bytes) / packets : 0,
+       "bytes"});
+  test::ReportBenchmark(result);
+}
+
+}  // namespace
+
+TEST(RtcpAggregatorBenchmark, TenStreams) {
+  RunRtcpBenchmark(10, false);
+  RunRtcpBenchmark(10, true);
+}
+
+TEST(RtcpAggregatorBenchmark, HundredStreams) {
+  RunRtcpBenchmark(100, false);
+  RunRtcpBenchmark(100, true);
+}
+
+TEST(RtcpAggregatorBenchmark, FiveHundredStreams) {
+  RunRtcpBenchmark(500, false);
+  RunRtcpBenchmark(500, true);
+}
+
+}  // namespace webrtc
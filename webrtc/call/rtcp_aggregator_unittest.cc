@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/buffer.h"
+#include "webrtc/call/rtcp_aggregator.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "webrtc/modules/utility/include/mock/mock_process_thread.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/mock_transport.h"
+
+using ::testing::_;
+using ::testing::ElementsAreArray;
+using ::testing::Invoke;
+using ::testing::Return;
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+const size_t kMaxPacketSize = 1200;
+const int64_t kMaxDelayMs = 20;
+
+rtc::Buffer BuildReceiverReport(uint32_t sender_ssrc) {
+  rtcp::ReceiverReport report;
+  report.SetSenderSsrc(sender_ssrc);
+  return report.Build();
+}
+
+rtc::Buffer BuildPli(uint32_t sender_ssrc) {
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(sender_ssrc);
+  pli.SetMediaSsrc(sender_ssrc + 1);
+  return pli.Build();
+}
+
+class RtcpAggregatorTest : public ::testing::Test {
+ protected:
+  RtcpAggregatorTest()
+      : clock_(1234),
+        aggregator_(&clock_, &transport_, kMaxPacketSize, kMaxDelayMs) {
+    ON_CALL(transport_, SendRtcp(_, _))
+        .WillByDefault(Invoke([this](const uint8_t* data, size_t length) {
+          sent_.emplace_back(data, data + length);
+          return true;
+        }));
+  }
+
+  void AdvanceTimeAndProcess(int64_t delta_ms) {
+    clock_.AdvanceTimeMilliseconds(delta_ms);
+    if (aggregator_.TimeUntilNextProcess() == 0)
+      aggregator_.Process();
+  }
+
+  SimulatedClock clock_;
+  ::testing::NiceMock<MockTransport> transport_;
+  RtcpAggregator aggregator_;
+  std::vector<std::vector<uint8_t>> sent_;
+};
+
+}  // namespace
+
+TEST_F(RtcpAggregatorTest, ForwardsRtp) {
+  const uint8_t kPacket[] = {0x80, 96, 0, 1};
+  EXPECT_CALL(transport_, SendRtp(kPacket, sizeof(kPacket), _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(aggregator_.SendRtp(kPacket, sizeof(kPacket), PacketOptions()));
+}
+
+TEST_F(RtcpAggregatorTest, SendsReportsTogetherOnProcess) {
+  rtc::Buffer first = BuildReceiverReport(1);
+  rtc::Buffer second = BuildReceiverReport(2);
+  EXPECT_TRUE(aggregator_.SendRtcp(first.data(), first.size()));
+  EXPECT_TRUE(aggregator_.SendRtcp(second.data(), second.size()));
+  AdvanceTimeAndProcess(kMaxDelayMs - 1);
+  EXPECT_TRUE(sent_.empty());
+
+  AdvanceTimeAndProcess(1);
+  ASSERT_EQ(1u, sent_.size());
+  rtc::Buffer expected;
+  expected.AppendData(first);
+  expected.AppendData(second);
+  EXPECT_THAT(sent_[0], ElementsAreArray(expected.data(), expected.size()));
+  EXPECT_EQ(2u, aggregator_.GetStats().rtcp_packets_received);
+  EXPECT_EQ(1u, aggregator_.GetStats().rtcp_packets_sent);
+}
+
+TEST_F(RtcpAggregatorTest, SendsFeedbackRightAwayWithHeldReports) {
+  rtc::Buffer report = BuildReceiverReport(1);
+  rtc::Buffer pli = BuildPli(2);
+  aggregator_.SendRtcp(report.data(), report.size());
+  aggregator_.SendRtcp(pli.data(), pli.size());
+  ASSERT_EQ(1u, sent_.size());
+  rtc::Buffer expected;
+  expected.AppendData(report);
+  expected.AppendData(pli);
+  EXPECT_THAT(sent_[0], ElementsAreArray(expected.data(), expected.size()));
+
+  AdvanceTimeAndProcess(kMaxDelayMs);
+  EXPECT_EQ(1u, sent_.size());
+}
+
+TEST_F(RtcpAggregatorTest, SendsWhenNextPacketDoesNotFit) {
+  rtc::Buffer report = BuildReceiverReport(1);
+  const size_t kReportsPerPacket = kMaxPacketSize / report.size();
+  for (size_t i = 0; i <= kReportsPerPacket; ++i)
+    aggregator_.SendRtcp(report.data(), report.size());
+  ASSERT_EQ(1u, sent_.size());
+  EXPECT_EQ(kReportsPerPacket * report.size(), sent_[0].size());
+
+  AdvanceTimeAndProcess(kMaxDelayMs);
+  ASSERT_EQ(2u, sent_.size());
+  EXPECT_EQ(report.size(), sent_[1].size());
+}
+
+TEST_F(RtcpAggregatorTest, SendsMalformedPacketsRightAway) {
+  const uint8_t kPacket[] = {0x80, 201, 0, 5};
+  aggregator_.SendRtcp(kPacket, sizeof(kPacket));
+  EXPECT_EQ(1u, sent_.size());
+}
+
+TEST_F(RtcpAggregatorTest, IdlesWhileNothingIsHeld) {
+  EXPECT_GT(aggregator_.TimeUntilNextProcess(), 1000);
+  rtc::Buffer report = BuildReceiverReport(1);
+  aggregator_.SendRtcp(report.data(), report.size());
+  EXPECT_EQ(kMaxDelayMs, aggregator_.TimeUntilNextProcess());
+  AdvanceTimeAndProcess(kMaxDelayMs);
+  EXPECT_EQ(1u, sent_.size());
+  EXPECT_GT(aggregator_.TimeUntilNextProcess(), 1000);
+}
+
+TEST_F(RtcpAggregatorTest, WakesProcessThreadWhenStartingToHold) {
+  MockProcessThread process_thread;
+  aggregator_.ProcessThreadAttached(&process_thread);
+  rtc::Buffer report = BuildReceiverReport(1);
+  EXPECT_CALL(process_thread, WakeUp(&aggregator_)).Times(1);
+  aggregator_.SendRtcp(report.data(), report.size());
+  aggregator_.SendRtcp(report.data(), report.size());
+
+  // An early call after the wake-up doesn't send the reports.
+  aggregator_.Process();
+  EXPECT_TRUE(sent_.empty());
+  aggregator_.ProcessThreadAttached(nullptr);
+}
+
+TEST(RtcpAggregatorDestructionTest, SendsHeldReports) {
+  SimulatedClock clock(0);
+  MockTransport transport;
+  rtc::Buffer report = BuildReceiverReport(1);
+  EXPECT_CALL(transport, SendRtcp(_, report.size())).WillOnce(Return(true));
+  RtcpAggregator aggregator(&clock, &transport, kMaxPacketSize, kMaxDelayMs);
+  aggregator.SendRtcp(report.data(), report.size());
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -200,6 +200,8 @@
           'sources': [
             'fir_filter_sse.cc',
             'resampler/sinc_resampler_sse.cc',
+            'signal_processing/cross_correlation_sse2.c',
+            'signal_processing/min_max_operations_sse2.c',
           ],
           'conditions': [
             ['os_posix==1', {
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/common_audio/resampler/include/push_resampler.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+// Resamples 10 ms of interleaved audio per run.
+template <typename T>
+void RunResamplerBenchmark(int src_rate_hz,
+                           int dst_rate_hz,
+                           size_t num_channels,
+                           const std::string& name) {
+  PushResampler<T> resampler;
+  ASSERT_EQ(0, resampler.InitializeIfNeeded(src_rate_hz, dst_rate_hz,
+                                            num_channels));
+  Random random(0x5a3);
+  std::vector<T> src(src_rate_hz / 100 * num_channels);
+  for (T& sample : src)
+    sample = static_cast<T>(random.Rand(-8000, 8000));
+  std::vector<T> dst(dst_rate_hz / 100 * num_channels);
+  int samples = 0;
+  test::ReportBenchmark(
+      test::RunBenchmark(name, test::BenchmarkOptions(), [&] {
+        samples =
+            resampler.Resample(src.data(), src.size(), dst.data(), dst.size());
+      }));
+  EXPECT_EQ(static_cast<int>(dst.size()), samples);
+}
+
+}  // namespace
+
+// Capture at 48 kHz down to the 16 kHz processing rate.
+TEST(ResamplerBenchmark, Int16Mono48kHzTo16kHz) {
+  RunResamplerBenchmark<int16_t>(48000, 16000, 1,
+                                 "push_resampler_int16_mono_48khz_to_16khz");
+}
+
+// A 44.1 kHz device feeding a 48 kHz stereo stream.
+TEST(ResamplerBenchmark, Int16Stereo44kHzTo48kHz) {
+  RunResamplerBenchmark<int16_t>(44100, 48000, 2,
+                                 "push_resampler_int16_stereo_44khz_to_48khz");
+}
+
+TEST(ResamplerBenchmark, FloatMono48kHzTo32kHz) {
+  RunResamplerBenchmark<float>(48000, 32000, 1,
+                               "push_resampler_float_mono_48khz_to_32khz");
+}
+
+}  // namespace webrtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Maximum absolute value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length) {
+  const size_t length8 = length & ~(size_t)7;
+  int absolute = 0, maximum = 0;
+  size_t i = 0;
+
+  RTC_DCHECK_GT(length, 0);
+
+  if (length8 > 0) {
+    // SSE2 has no 16-bit absolute value, so track the largest and the smallest
+    // value instead. This also keeps -32768 intact.
+    __m128i max_v = _mm_loadu_si128((const __m128i*)vector);
+    __m128i min_v = max_v;
+    for (i = 8; i < length8; i += 8) {
+      const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+      max_v = _mm_max_epi16(max_v, v);
+      min_v = _mm_min_epi16(min_v, v);
+    }
+    // Fold the largest magnitude of the eight lanes into lane 0.
+    max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 8));
+    max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 4));
+    max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 2));
+    min_v = _mm_min_epi16(min_v, _mm_srli_si128(min_v, 8));
+    min_v = _mm_min_epi16(min_v, _mm_srli_si128(min_v, 4));
+    min_v = _mm_min_epi16(min_v, _mm_srli_si128(min_v, 2));
+    maximum = abs((int)(int16_t)_mm_extract_epi16(max_v, 0));
+    absolute = abs((int)(int16_t)_mm_extract_epi16(min_v, 0));
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Calculate the rest of the samples.
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
@@ -12,6 +12,7 @@
 #include <sstream>
 
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -471,11 +472,11 @@ TEST_F(SplTest, CrossCorrelationTest) {
                              kCrossCorrelationDimension, kShift, kStep);
 
   // WebRtcSpl_CrossCorrelationC() and WebRtcSpl_CrossCorrelationNeon()
-  // are not bit-exact.
+  // are not bit-exact. WebRtcSpl_CrossCorrelationSSE2() is.
   const int32_t kExpected[kCrossCorrelationDimension] =
       {-266947903, -15579555, -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] =
       {-266947901, -15579553, -171281999};
   if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
@@ -487,6 +488,50 @@ TEST_F(SplTest, CrossCorrelationTest) {
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(SplTest, SSE2IsBitExact) {
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+  // Long enough to exercise both the vectorized loops and their tails, and
+  // filled with extreme values, so that the 32-bit sums wrap around.
+  const size_t kLength = 203;
+  int16_t seq1[kLength];
+  int16_t seq2[2 * kLength];
+  uint32_t seed = 4711;
+  for (size_t i = 0; i < 2 * kLength; ++i) {
+    const int16_t value = static_cast<int16_t>(WebRtcSpl_RandU(&seed) * 2);
+    seq2[i] = i % 7 == 0 ? WEBRTC_SPL_WORD16_MIN : value;
+    if (i < kLength) {
+      seq1[i] = i % 5 == 0 ? WEBRTC_SPL_WORD16_MIN : -value;
+    }
+  }
+
+  for (size_t length = 1; length <= kLength; ++length) {
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(seq1, length),
+              WebRtcSpl_MaxAbsValueW16SSE2(seq1, length));
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(seq2 + 1, length),
+              WebRtcSpl_MaxAbsValueW16SSE2(seq2 + 1, length));
+  }
+
+  const size_t kDimCorrelation = 20;
+  for (int right_shifts = 0; right_shifts <= 6; right_shifts += 3) {
+    for (size_t length : {7u, 8u, 64u, 150u, 203u}) {
+      int32_t expected[kDimCorrelation];
+      int32_t actual[kDimCorrelation];
+      WebRtcSpl_CrossCorrelationC(expected, seq1, seq2 + kDimCorrelation,
+                                  length, kDimCorrelation, right_shifts, -1);
+      WebRtcSpl_CrossCorrelationSSE2(actual, seq1, seq2 + kDimCorrelation,
+                                     length, kDimCorrelation, right_shifts,
+                                     -1);
+      for (size_t i = 0; i < kDimCorrelation; ++i) {
+        EXPECT_EQ(expected[i], actual[i]);
+      }
+    }
+  }
+}
+#endif
+
 TEST_F(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
@@ -9,7 +9,7 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers for ARM, MIPS and x86 platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
@@ -44,6 +44,15 @@ static void InitPointersToC() {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Initialize function pointers to the SSE2 version, on top of the generic C
+ * ones. */
+static void InitPointersToSSE2() {
+  WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16SSE2;
+  WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationSSE2;
+}
+#endif
+
 #if defined(WEBRTC_HAS_NEON)
 /* Initialize function pointers to the Neon version. */
 static void InitPointersToNeon() {
@@ -89,6 +98,11 @@ static void InitFunctionPointers(void) {
   InitPointersToMIPS();
 #else
   InitPointersToC();
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    InitPointersToSSE2();
+  }
+#endif
 #endif  /* WEBRTC_HAS_NEON */
 }
 
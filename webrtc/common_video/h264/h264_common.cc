@@ -10,11 +10,28 @@
 
 #include "webrtc/common_video/h264/h264_common.h"
 
+#include <string.h>
+
 namespace webrtc {
 namespace H264 {
 
 const uint8_t kNaluTypeMask = 0x1F;
 
+namespace {
+
+// Both start sequences and emulation prevention sequences begin with a zero
+// byte, and those are rare in coded slice data. The scanners below test eight
+// bytes at a time for one and skip the lot if there is none.
+const size_t kWordSize = sizeof(uint64_t);
+
+bool HasZeroByte(const uint8_t* bytes) {
+  uint64_t word;
+  memcpy(&word, bytes, kWordSize);
+  return ((word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull) != 0;
+}
+
+}  // namespace
+
 std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
                                        size_t buffer_size) {
   // This is sorta like Boyer-Moore, but with only the first optimization step:
@@ -25,7 +42,10 @@ std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
   std::vector<NaluIndex> sequences;
   const size_t end = buffer_size - kNaluShortStartSequenceSize;
   for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
+    if (end - i >= kWordSize && !HasZeroByte(&buffer[i])) {
+      // No start sequence can begin in the next eight bytes.
+      i += kWordSize;
+    } else if (buffer[i + 2] > 1) {
       i += 3;
     } else if (buffer[i + 2] == 1 && buffer[i + 1] == 0 && buffer[i] == 0) {
       // We found a start sequence, now check if it was a 3 of 4 byte one.
@@ -59,25 +79,35 @@ NaluType ParseNaluType(uint8_t data) {
 }
 
 std::unique_ptr<rtc::Buffer> ParseRbsp(const uint8_t* data, size_t length) {
-  std::unique_ptr<rtc::Buffer> rbsp_buffer(new rtc::Buffer(0, length));
-  const char* sps_bytes = reinterpret_cast<const char*>(data);
-  for (size_t i = 0; i < length;) {
-    // Be careful about over/underflow here. byte_length_ - 3 can underflow, and
-    // i + 3 can overflow, but byte_length_ - i can't, because i < byte_length_
-    // above, and that expression will produce the number of bytes left in
-    // the stream including the byte at i.
-    if (length - i >= 3 && data[i] == 0 && data[i + 1] == 0 &&
-        data[i + 2] == 3) {
-      // Two rbsp bytes + the emulation byte.
-      rbsp_buffer->AppendData(sps_bytes + i, 2);
+  std::unique_ptr<rtc::Buffer> rbsp_buffer(new rtc::Buffer(length));
+  rbsp_buffer->SetSize(ParseRbsp(data, length, rbsp_buffer->data()));
+  return rbsp_buffer;
+}
+
+size_t ParseRbsp(const uint8_t* data, size_t length, uint8_t* destination) {
+  size_t rbsp_length = 0;
+  // Start of the bytes not yet copied to |destination|.
+  size_t copy_start = 0;
+  // Be careful about over/underflow here. length - 3 can underflow, and i + 3
+  // can overflow, but length - i can't, because i never steps past length.
+  for (size_t i = 0; length - i >= 3;) {
+    if (length - i >= kWordSize && !HasZeroByte(&data[i])) {
+      i += kWordSize;
+    } else if (data[i + 2] > 3) {
       i += 3;
+    } else if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 3) {
+      // Copy up to and including the two rbsp bytes, and drop the emulation
+      // byte.
+      memcpy(&destination[rbsp_length], &data[copy_start], i + 2 - copy_start);
+      rbsp_length += i + 2 - copy_start;
+      i += 3;
+      copy_start = i;
     } else {
-      // Single rbsp byte.
-      rbsp_buffer->AppendData(sps_bytes[i]);
       ++i;
     }
   }
-  return rbsp_buffer;
+  memcpy(&destination[rbsp_length], &data[copy_start], length - copy_start);
+  return rbsp_length + length - copy_start;
 }
 
 void WriteRbsp(const uint8_t* bytes, size_t length, rtc::Buffer* destination) {
@@ -79,6 +79,12 @@ NaluType ParseNaluType(uint8_t data);
 // Parse the given data and remove any emulation byte escaping.
 std::unique_ptr<rtc::Buffer> ParseRbsp(const uint8_t* data, size_t length);
 
+// Same as above, but writes to |destination|, which must have room for
+// |length| bytes, and returns the number of bytes written. Parsing a prefix of
+// the data gives a prefix of the RBSP, so a header can be parsed without
+// unescaping the payload after it.
+size_t ParseRbsp(const uint8_t* data, size_t length, uint8_t* destination);
+
 // Write the given data to the destination buffer, inserting and emulation
 // bytes in order to escape any data the could be interpreted as a start
 // sequence.
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/common_video/h264/h264_common.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace H264 {
+namespace {
+
+// Removes emulation bytes one byte at a time, as ParseRbsp() did before it
+// skipped ahead over bytes that can't start an emulation sequence.
+std::vector<uint8_t> ReferenceParseRbsp(const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> rbsp;
+  for (size_t i = 0; i < data.size();) {
+    if (data.size() - i >= 3 && data[i] == 0 && data[i + 1] == 0 &&
+        data[i + 2] == 3) {
+      rbsp.push_back(0);
+      rbsp.push_back(0);
+      i += 3;
+    } else {
+      rbsp.push_back(data[i]);
+      ++i;
+    }
+  }
+  return rbsp;
+}
+
+}  // namespace
+
+TEST(H264CommonTest, FindsNaluIndicesAtEveryAlignment) {
+  for (size_t offset = 0; offset < 16; ++offset) {
+    std::vector<uint8_t> buffer(offset, 0xff);
+    const uint8_t kStartSequence[] = {0x00, 0x00, 0x00, 0x01};
+    buffer.insert(buffer.end(), kStartSequence,
+                  kStartSequence + sizeof(kStartSequence));
+    buffer.insert(buffer.end(), 20 + offset, 0xaa);
+    buffer.insert(buffer.end(), kStartSequence + 1,
+                  kStartSequence + sizeof(kStartSequence));
+    buffer.insert(buffer.end(), 5, 0xbb);
+
+    std::vector<NaluIndex> indices =
+        FindNaluIndices(buffer.data(), buffer.size());
+    ASSERT_EQ(2u, indices.size()) << "offset " << offset;
+    EXPECT_EQ(offset, indices[0].start_offset);
+    EXPECT_EQ(offset + 4, indices[0].payload_start_offset);
+    EXPECT_EQ(20 + offset, indices[0].payload_size);
+    EXPECT_EQ(offset + 24 + offset, indices[1].start_offset);
+    EXPECT_EQ(offset + 27 + offset, indices[1].payload_start_offset);
+    EXPECT_EQ(5u, indices[1].payload_size);
+  }
+}
+
+TEST(H264CommonTest, ParseRbspRemovesEmulationBytes) {
+  // Emulation sequences at every alignment, back to back, and at the end.
+  std::vector<uint8_t> data;
+  for (size_t run = 0; run < 20; ++run) {
+    data.insert(data.end(), run, 0x42);
+    const uint8_t kEmulated[] = {0x00, 0x00, 0x03, 0x01};
+    data.insert(data.end(), kEmulated, kEmulated + sizeof(kEmulated));
+  }
+  const uint8_t kTail[] = {0x00, 0x00, 0x03, 0x00, 0x00, 0x03};
+  data.insert(data.end(), kTail, kTail + sizeof(kTail));
+
+  const std::vector<uint8_t> expected = ReferenceParseRbsp(data);
+  std::vector<uint8_t> rbsp(data.size());
+  ASSERT_EQ(expected.size(), ParseRbsp(data.data(), data.size(), rbsp.data()));
+  rbsp.resize(expected.size());
+  EXPECT_EQ(expected, rbsp);
+
+  std::unique_ptr<rtc::Buffer> rbsp_buffer = ParseRbsp(data.data(), data.size());
+  EXPECT_EQ(expected, std::vector<uint8_t>(rbsp_buffer->data(),
+                                           rbsp_buffer->data() +
+                                               rbsp_buffer->size()));
+}
+
+TEST(H264CommonTest, ParseRbspOfPrefixIsPrefixOfRbsp) {
+  const std::vector<uint8_t> data = {0x65, 0x00, 0x00, 0x03, 0x00, 0x00,
+                                     0x03, 0x01, 0x7f, 0x00, 0x00, 0x03};
+  const std::vector<uint8_t> expected = ReferenceParseRbsp(data);
+  for (size_t length = 0; length <= data.size(); ++length) {
+    std::vector<uint8_t> rbsp(length);
+    const size_t rbsp_length = ParseRbsp(data.data(), length, rbsp.data());
+    rbsp.resize(rbsp_length);
+    EXPECT_EQ(std::vector<uint8_t>(expected.begin(),
+                                   expected.begin() + rbsp_length),
+              rbsp)
+        << "length " << length;
+  }
+}
+
+}  // namespace H264
+}  // namespace webrtc
@@ -27,6 +27,10 @@ namespace webrtc {
 // closer to 24 or so, but better safe than sorry.
 const size_t kMaxVuiSpsIncrease = 64;
 
+// SPSs are some tens of bytes, so the RBSP and the rewritten copy of it are
+// kept on the stack, unless the SPS carries unusually large scaling lists.
+const size_t kMaxStackSpsSize = 128;
+
 #define RETURN_FALSE_ON_FAIL(x)                                  \
   if (!(x)) {                                                    \
     LOG_F(LS_ERROR) << " (line:" << __LINE__ << ") FAILED: " #x; \
@@ -72,10 +76,21 @@ SpsVuiRewriter::ParseResult SpsVuiRewriter::ParseAndRewriteSps(
     size_t length,
     rtc::Optional<SpsParser::SpsState>* sps,
     rtc::Buffer* destination) {
+  uint8_t rbsp_storage[kMaxStackSpsSize];
+  uint8_t out_storage[kMaxStackSpsSize + kMaxVuiSpsIncrease];
+  std::unique_ptr<uint8_t[]> heap_storage;
+  uint8_t* rbsp = rbsp_storage;
+  uint8_t* out_buffer = out_storage;
+  const size_t out_buffer_size = length + kMaxVuiSpsIncrease;
+  if (length > kMaxStackSpsSize) {
+    heap_storage.reset(new uint8_t[length + out_buffer_size]);
+    rbsp = heap_storage.get();
+    out_buffer = rbsp + length;
+  }
+
   // Create temporary RBSP decoded buffer of the payload (exlcuding the
   // leading nalu type header byte (the SpsParser uses only the payload).
-  std::unique_ptr<rtc::Buffer> rbsp_buffer = H264::ParseRbsp(buffer, length);
-  rtc::BitBuffer source_buffer(rbsp_buffer->data(), rbsp_buffer->size());
+  rtc::BitBuffer source_buffer(rbsp, H264::ParseRbsp(buffer, length, rbsp));
   rtc::Optional<SpsParser::SpsState> sps_state =
       SpsParser::ParseSpsUpToVui(&source_buffer);
   if (!sps_state)
@@ -90,14 +105,13 @@ SpsVuiRewriter::ParseResult SpsVuiRewriter::ParseAndRewriteSps(
 
   // We're going to completely muck up alignment, so we need a BitBuffer to
   // write with.
-  rtc::Buffer out_buffer(length + kMaxVuiSpsIncrease);
-  rtc::BitBufferWriter sps_writer(out_buffer.data(), out_buffer.size());
+  rtc::BitBufferWriter sps_writer(out_buffer, out_buffer_size);
 
   // Check how far the SpsParser has read, and copy that data in bulk.
   size_t byte_offset;
   size_t bit_offset;
   source_buffer.GetCurrentOffset(&byte_offset, &bit_offset);
-  memcpy(out_buffer.data(), rbsp_buffer->data(),
+  memcpy(out_buffer, rbsp,
          byte_offset + (bit_offset > 0 ? 1 : 0));  // OK to copy the last bits.
 
   // SpsParser will have read the vui_params_present flag, which we want to
@@ -138,10 +152,8 @@ SpsVuiRewriter::ParseResult SpsVuiRewriter::ParseAndRewriteSps(
   RTC_DCHECK(byte_offset <= length + kMaxVuiSpsIncrease);
   RTC_CHECK(destination != nullptr);
 
-  out_buffer.SetSize(byte_offset);
-
   // Write updates SPS to destination with added RBSP
-  H264::WriteRbsp(out_buffer.data(), out_buffer.size(), destination);
+  H264::WriteRbsp(out_buffer, byte_offset, destination);
 
   return ParseResult::kVuiRewritten;
 }
@@ -20,6 +20,7 @@
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/common_video/rotation.h"
 #include "webrtc/system_wrappers/include/aligned_malloc.h"
+#include "webrtc/system_wrappers/include/memory_usage.h"
 
 namespace webrtc {
 
@@ -135,6 +136,7 @@ class I420Buffer : public VideoFrameBuffer {
   const int stride_u_;
   const int stride_v_;
   const std::unique_ptr<uint8_t, AlignedFreeDeleter> data_;
+  memory_usage::Tracker memory_usage_;
 };
 
 // Base class for native-handle buffer is a wrapper around a |native_handle|.
@@ -49,12 +49,14 @@ I420Buffer::I420Buffer(int width,
       stride_v_(stride_v),
       data_(static_cast<uint8_t*>(AlignedMalloc(
           I420DataSize(height, stride_y, stride_u, stride_v),
-          kBufferAlignment))) {
+          kBufferAlignment))),
+      memory_usage_(memory_usage::kVideoFrameBuffers) {
   RTC_DCHECK_GT(width, 0);
   RTC_DCHECK_GT(height, 0);
   RTC_DCHECK_GE(stride_y, width);
   RTC_DCHECK_GE(stride_u, (width + 1) / 2);
   RTC_DCHECK_GE(stride_v, (width + 1) / 2);
+  memory_usage_.Set(I420DataSize(height, stride_y, stride_u, stride_v));
 }
 
 I420Buffer::~I420Buffer() {
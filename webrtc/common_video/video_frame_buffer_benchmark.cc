@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "webrtc/base/random.h"
+#include "webrtc/common_video/include/video_frame_buffer.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const int kSourceWidth = 1280;
+const int kSourceHeight = 720;
+
+rtc::scoped_refptr<I420Buffer> CreateNoiseBuffer(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  Random random(0x5ca1e);
+  for (int i = 0; i < buffer->StrideY() * height; ++i)
+    buffer->MutableDataY()[i] = random.Rand<uint8_t>();
+  for (int i = 0; i < buffer->StrideU() * ((height + 1) / 2); ++i) {
+    buffer->MutableDataU()[i] = random.Rand<uint8_t>();
+    buffer->MutableDataV()[i] = random.Rand<uint8_t>();
+  }
+  return buffer;
+}
+
+// Scales a 720p frame to |width|x|height| per run, cropping to the aspect
+// ratio of the destination if |crop| is set.
+void RunScaleBenchmark(int width,
+                       int height,
+                       bool crop,
+                       const std::string& name) {
+  rtc::scoped_refptr<VideoFrameBuffer> source =
+      CreateNoiseBuffer(kSourceWidth, kSourceHeight);
+  rtc::scoped_refptr<I420Buffer> destination =
+      I420Buffer::Create(width, height);
+  test::BenchmarkOptions options;
+  // A frame takes tens of microseconds or more to scale.
+  options.warmup_iterations = 10;
+  options.iterations = 100;
+  test::ReportBenchmark(test::RunBenchmark(name, options, [&] {
+    if (crop)
+      destination->CropAndScaleFrom(source);
+    else
+      destination->ScaleFrom(source);
+  }));
+}
+
+}  // namespace
+
+// The simulcast layers below 720p.
+TEST(VideoFrameBufferBenchmark, Scale720pToHalf) {
+  RunScaleBenchmark(640, 360, false, "i420_scale_720p_to_360p");
+}
+
+TEST(VideoFrameBufferBenchmark, Scale720pToQuarter) {
+  RunScaleBenchmark(320, 180, false, "i420_scale_720p_to_180p");
+}
+
+// Adapting a 16:9 camera to a 4:3 encoder resolution.
+TEST(VideoFrameBufferBenchmark, CropAndScale720pTo480p) {
+  RunScaleBenchmark(640, 480, true, "i420_crop_and_scale_720p_to_480p");
+}
+
+}  // namespace webrtc
@@ -101,6 +101,13 @@ struct MediaConfig {
   // PeerConnection constraint 'googDscp'.
   bool enable_dscp = false;
 
+  // Pack the RTCP of the streams that a media channel sends on one transport
+  // into shared datagrams. This flag comes from PeerConnection's
+  // RTCConfiguration, and the MediaController copies it to
+  // webrtc::Call::Config::aggregate_rtcp. It pays off with BUNDLE, where the
+  // streams of a channel share one transport.
+  bool aggregate_rtcp = false;
+
   // Video-specific config.
   struct Video {
     // Enable WebRTC CPU Overuse Detection. This flag comes from the
@@ -1080,6 +1087,17 @@ struct SendDataParams {
 
 enum SendDataResult { SDR_SUCCESS, SDR_ERROR, SDR_BLOCK };
 
+// A data message queued for sending, used to hand several messages to the
+// transport at once.
+struct OutgoingDataMessage {
+  OutgoingDataMessage(const SendDataParams& params,
+                      const rtc::CopyOnWriteBuffer& payload)
+      : params(params), payload(payload) {}
+
+  SendDataParams params;
+  rtc::CopyOnWriteBuffer payload;
+};
+
 struct DataSendParameters : RtpSendParameters<DataCodec> {
   std::string ToString() const {
     std::ostringstream ost;
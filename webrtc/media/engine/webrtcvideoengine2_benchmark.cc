@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "webrtc/base/byteorder.h"
+#include "webrtc/base/copyonwritebuffer.h"
+#include "webrtc/call.h"
+#include "webrtc/logging/rtc_event_log/rtc_event_log.h"
+#include "webrtc/media/base/mediaconstants.h"
+#include "webrtc/media/base/streamparams.h"
+#include "webrtc/media/engine/fakewebrtcvideoengine.h"
+#include "webrtc/media/engine/webrtcvideoengine2.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace cricket {
+namespace {
+
+const uint32_t kSsrc = 1234;
+const size_t kPayloadSize = 1200;
+// 30 fps video at about 1 Mbps.
+const int kPacketsPerFrame = 4;
+const uint32_t kRtpTimestampPerFrame = 3000;
+
+// Offsets into the packet that change from packet to packet.
+const size_t kSequenceNumberOffset = 2;
+const size_t kTimestampOffset = 4;
+const size_t kHeaderSize = 12;
+const size_t kVp8DescriptorOffset = kHeaderSize;
+const size_t kVp8PayloadHeaderOffset = kHeaderSize + 1;
+
+// Writes a VP8 packet of a 640x480 stream into |packet|, the first frame a
+// key frame and the rest delta frames.
+class Vp8PacketWriter {
+ public:
+  Vp8PacketWriter(int payload_type, rtc::CopyOnWriteBuffer* packet)
+      : packet_(packet) {
+    packet_->SetSize(kHeaderSize + kPayloadSize);
+    uint8_t* data = packet_->data();
+    memset(data, 0, packet_->size());
+    data[0] = 0x80;  // Version 2.
+    data[1] = static_cast<uint8_t>(payload_type);
+    rtc::SetBE32(data + 8, kSsrc);
+    // VP8 key frame header: show_frame, then the start code and the size.
+    const uint8_t kKeyFrameHeader[] = {0x10, 0x00, 0x00, 0x9d, 0x01,
+                                       0x2a, 0x80, 0x02, 0xe0, 0x01};
+    memcpy(data + kVp8PayloadHeaderOffset, kKeyFrameHeader,
+           sizeof(kKeyFrameHeader));
+  }
+
+  void WriteNextPacket() {
+    uint8_t* data = packet_->data();
+    const int packet_in_frame = packet_index_ % kPacketsPerFrame;
+    const uint32_t frame = packet_index_ / kPacketsPerFrame;
+    rtc::SetBE16(data + kSequenceNumberOffset,
+                 static_cast<uint16_t>(packet_index_));
+    rtc::SetBE32(data + kTimestampOffset, frame * kRtpTimestampPerFrame);
+    // Marker bit on the last packet of a frame.
+    data[1] = (data[1] & 0x7f) |
+              (packet_in_frame == kPacketsPerFrame - 1 ? 0x80 : 0);
+    // Start of partition on the first packet of a frame.
+    data[kVp8DescriptorOffset] = packet_in_frame == 0 ? 0x10 : 0;
+    // Inverse key frame bit.
+    if (frame > 0)
+      data[kVp8PayloadHeaderOffset] |= 0x01;
+    ++packet_index_;
+  }
+
+ private:
+  rtc::CopyOnWriteBuffer* const packet_;
+  uint32_t packet_index_ = 0;
+};
+
+}  // namespace
+
+// Delivers a packet of a signaled video stream the way BaseChannel hands it to
+// the media channel on the worker thread. That covers the routing in
+// WebRtcVideoChannel2 and Call, and the parsing and jitter buffering in the
+// receive stream, with a fake decoder on the decode thread.
+TEST(WebRtcVideoChannel2Benchmark, ReceivePacket) {
+  webrtc::RtcEventLogNullImpl event_log;
+  std::unique_ptr<webrtc::Call> call(
+      webrtc::Call::Create(webrtc::Call::Config(&event_log)));
+  FakeWebRtcVideoDecoderFactory decoder_factory;
+  decoder_factory.AddSupportedVideoCodecType(webrtc::kVideoCodecVP8);
+  WebRtcVideoEngine2 engine;
+  engine.SetExternalDecoderFactory(&decoder_factory);
+  engine.Init();
+  std::unique_ptr<VideoMediaChannel> channel(
+      engine.CreateChannel(call.get(), MediaConfig(), VideoOptions()));
+
+  VideoRecvParameters parameters;
+  for (const VideoCodec& codec : engine.codecs()) {
+    if (codec.name == kVp8CodecName)
+      parameters.codecs.push_back(codec);
+  }
+  ASSERT_FALSE(parameters.codecs.empty());
+  ASSERT_TRUE(channel->SetRecvParameters(parameters));
+  ASSERT_TRUE(channel->AddRecvStream(StreamParams::CreateLegacy(kSsrc)));
+
+  rtc::CopyOnWriteBuffer packet;
+  Vp8PacketWriter writer(parameters.codecs[0].id, &packet);
+  webrtc::test::ReportBenchmark(webrtc::test::RunBenchmark(
+      "video_channel_receive_packet", webrtc::test::BenchmarkOptions(), [&] {
+        writer.WriteNextPacket();
+        channel->OnPacketReceived(&packet, rtc::PacketTime());
+      }));
+
+  EXPECT_TRUE(channel->RemoveRecvStream(kSsrc));
+}
+
+}  // namespace cricket
@@ -34,11 +34,13 @@ namespace acm2 {
 
 AcmReceiver::AcmReceiver(const AudioCodingModule::Config& config)
     : last_audio_buffer_(new int16_t[AudioFrame::kMaxDataSizeSamples]),
+      resampled_last_output_frame_(true),
       neteq_(NetEq::Create(config.neteq_config, config.decoder_factory)),
-      clock_(config.clock),
-      resampled_last_output_frame_(true) {
+      clock_(config.clock) {
   assert(clock_);
-  memset(last_audio_buffer_.get(), 0, AudioFrame::kMaxDataSizeSamples);
+  memset(last_audio_buffer_.get(), 0,
+         sizeof(int16_t) * AudioFrame::kMaxDataSizeSamples);
+  last_output_sample_rate_hz_ = neteq_->last_output_sample_rate_hz();
 }
 
 AcmReceiver::~AcmReceiver() {
@@ -69,7 +71,10 @@ rtc::Optional<int> AcmReceiver::last_packet_sample_rate_hz() const {
 }
 
 int AcmReceiver::last_output_sample_rate_hz() const {
-  return neteq_->last_output_sample_rate_hz();
+  // NetEq only changes its output rate in GetAudio(), so the value cached
+  // there is current, and reading it does not wait for NetEq.
+  rtc::CritScope lock(&crit_sect_);
+  return last_output_sample_rate_hz_;
 }
 
 int AcmReceiver::InsertPacket(const WebRtcRTPHeader& rtp_header,
@@ -78,8 +83,9 @@ int AcmReceiver::InsertPacket(const WebRtcRTPHeader& rtp_header,
   const RTPHeader* header = &rtp_header.header;  // Just a shorthand.
 
   {
-    rtc::CritScope lock(&crit_sect_);
-
+    // The decoder lookup goes through NetEq, so it is done under
+    // |decoder_crit_sect_| rather than |crit_sect_|.
+    rtc::CritScope decoder_lock(&decoder_crit_sect_);
     const rtc::Optional<CodecInst> ci =
         RtpHeaderToDecoder(*header, incoming_payload[0]);
     if (!ci) {
@@ -90,6 +96,7 @@ int AcmReceiver::InsertPacket(const WebRtcRTPHeader& rtp_header,
     }
     receive_timestamp = NowInTimestamp(ci->plfreq);
 
+    rtc::CritScope lock(&crit_sect_);
     if (STR_CASE_CMP(ci->plname, "cn") == 0) {
       if (last_audio_decoder_ && last_audio_decoder_->channels > 1) {
         // This is a CNG and the audio codec is not mono, so skip pushing in
@@ -101,7 +108,7 @@ int AcmReceiver::InsertPacket(const WebRtcRTPHeader& rtp_header,
       last_packet_sample_rate_hz_ = rtc::Optional<int>(ci->plfreq);
     }
 
-  }  // |crit_sect_| is released.
+  }  // |decoder_crit_sect_| and |crit_sect_| are released.
 
   if (neteq_->InsertPacket(rtp_header, incoming_payload, receive_timestamp) <
       0) {
@@ -117,15 +124,17 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
                           AudioFrame* audio_frame,
                           bool* muted) {
   RTC_DCHECK(muted);
-  // Accessing members, take the lock.
-  rtc::CritScope lock(&crit_sect_);
+  // Only the playout state is accessed below; |crit_sect_| is taken at the
+  // end, to publish the results.
+  rtc::CritScope lock(&playout_crit_sect_);
 
   if (neteq_->GetAudio(audio_frame, muted) != NetEq::kOK) {
     LOG(LERROR) << "AcmReceiver::GetAudio - NetEq Failed.";
     return -1;
   }
 
-  const int current_sample_rate_hz = neteq_->last_output_sample_rate_hz();
+  // NetEq outputs audio at its |last_output_sample_rate_hz()|.
+  const int current_sample_rate_hz = audio_frame->sample_rate_hz_;
 
   // Update if resampling is required.
   const bool need_resampling =
@@ -166,13 +175,16 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   } else {
     resampled_last_output_frame_ = false;
     // We might end up here ONLY if codec is changed.
+    // Store current audio in |last_audio_buffer_|, to prime the resampler with
+    // if the next frame needs resampling. After a resampled frame, the
+    // resampler already has the history it needs.
+    memcpy(last_audio_buffer_.get(), audio_frame->data_,
+           sizeof(int16_t) * audio_frame->samples_per_channel_ *
+               audio_frame->num_channels_);
   }
 
-  // Store current audio in |last_audio_buffer_| for next time.
-  memcpy(last_audio_buffer_.get(), audio_frame->data_,
-         sizeof(int16_t) * audio_frame->samples_per_channel_ *
-             audio_frame->num_channels_);
-
+  rtc::CritScope stats_lock(&crit_sect_);
+  last_output_sample_rate_hz_ = current_sample_rate_hz;
   call_stats_.DecodedByNetEq(audio_frame->speech_type_, *muted);
   return 0;
 }
@@ -200,8 +212,7 @@ int32_t AcmReceiver::AddCodec(int acm_codec_id,
   const rtc::Optional<SdpAudioFormat> new_format =
       RentACodec::NetEqDecoderToSdpAudioFormat(neteq_decoder);
 
-  rtc::CritScope lock(&crit_sect_);
-
+  rtc::CritScope lock(&decoder_crit_sect_);
   const auto old_format = neteq_->GetDecoderFormat(payload_type);
   if (old_format && new_format && *old_format == *new_format) {
     // Re-registering the same codec. Do nothing and return.
@@ -232,6 +243,7 @@ int32_t AcmReceiver::AddCodec(int acm_codec_id,
 
 bool AcmReceiver::AddCodec(int rtp_payload_type,
                            const SdpAudioFormat& audio_format) {
+  rtc::CritScope lock(&decoder_crit_sect_);
   const auto old_format = neteq_->GetDecoderFormat(rtp_payload_type);
   if (old_format && *old_format == audio_format) {
     // Re-registering the same codec. Do nothing and return.
@@ -260,19 +272,21 @@ void AcmReceiver::FlushBuffers() {
 }
 
 void AcmReceiver::RemoveAllCodecs() {
-  rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decoder_lock(&decoder_crit_sect_);
   neteq_->RemoveAllPayloadTypes();
+  rtc::CritScope lock(&crit_sect_);
   last_audio_decoder_ = rtc::Optional<CodecInst>();
   last_packet_sample_rate_hz_ = rtc::Optional<int>();
 }
 
 int AcmReceiver::RemoveCodec(uint8_t payload_type) {
-  rtc::CritScope lock(&crit_sect_);
+  rtc::CritScope decoder_lock(&decoder_crit_sect_);
   if (neteq_->RemovePayloadType(payload_type) != NetEq::kOK &&
       neteq_->LastError() != NetEq::kDecoderNotFound) {
     LOG(LERROR) << "AcmReceiver::RemoveCodec" << static_cast<int>(payload_type);
     return -1;
   }
+  rtc::CritScope lock(&crit_sect_);
   if (last_audio_decoder_ && payload_type == last_audio_decoder_->pltype) {
     last_audio_decoder_ = rtc::Optional<CodecInst>();
     last_packet_sample_rate_hz_ = rtc::Optional<int>();
@@ -322,7 +336,6 @@ void AcmReceiver::GetNetworkStatistics(NetworkStatistics* acm_stat) {
 
 int AcmReceiver::DecoderByPayloadType(uint8_t payload_type,
                                       CodecInst* codec) const {
-  rtc::CritScope lock(&crit_sect_);
   const rtc::Optional<CodecInst> ci = neteq_->GetDecoder(payload_type);
   if (ci) {
     *codec = *ci;
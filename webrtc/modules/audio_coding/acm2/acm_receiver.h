@@ -265,21 +265,39 @@ class AcmReceiver {
     int sample_rate_hz;
   };
 
+  // Calls into NetEq, so must not be called with |crit_sect_| held.
   const rtc::Optional<CodecInst> RtpHeaderToDecoder(
       const RTPHeader& rtp_header,
-      uint8_t first_payload_byte) const EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+      uint8_t first_payload_byte) const
+      EXCLUSIVE_LOCKS_REQUIRED(decoder_crit_sect_) LOCKS_EXCLUDED(crit_sect_);
 
   uint32_t NowInTimestamp(int decoder_sampling_rate) const;
 
+  // Serializes the changes to NetEq's decoders with the decoder lookups in
+  // InsertPacket(), so that a packet is never accounted to a decoder that was
+  // just removed or replaced. Held across calls into NetEq, but only the packet
+  // insertion and codec registration paths take it.
+  rtc::CriticalSection decoder_crit_sect_ ACQUIRED_BEFORE(crit_sect_);
+
+  // Guards the state that is shared between the packet insertion, playout and
+  // stats paths. It is only held for short reads and updates, never across a
+  // call into NetEq or the resampler, so that these paths do not wait for each
+  // other's decoding or resampling. NetEq has its own lock.
   rtc::CriticalSection crit_sect_;
   rtc::Optional<CodecInst> last_audio_decoder_ GUARDED_BY(crit_sect_);
-  ACMResampler resampler_ GUARDED_BY(crit_sect_);
-  std::unique_ptr<int16_t[]> last_audio_buffer_ GUARDED_BY(crit_sect_);
   CallStatistics call_stats_ GUARDED_BY(crit_sect_);
+  int last_output_sample_rate_hz_ GUARDED_BY(crit_sect_);
+  rtc::Optional<int> last_packet_sample_rate_hz_ GUARDED_BY(crit_sect_);
+
+  // State of the playout path, which only GetAudio() uses. Its lock is
+  // therefore not contended as long as audio is pulled from a single thread.
+  rtc::CriticalSection playout_crit_sect_ ACQUIRED_BEFORE(crit_sect_);
+  ACMResampler resampler_ GUARDED_BY(playout_crit_sect_);
+  std::unique_ptr<int16_t[]> last_audio_buffer_ GUARDED_BY(playout_crit_sect_);
+  bool resampled_last_output_frame_ GUARDED_BY(playout_crit_sect_);
+
   NetEq* neteq_;
   Clock* clock_;  // TODO(henrik.lundin) Make const if possible.
-  bool resampled_last_output_frame_ GUARDED_BY(crit_sect_);
-  rtc::Optional<int> last_packet_sample_rate_hz_ GUARDED_BY(crit_sect_);
 };
 
 }  // namespace acm2
@@ -0,0 +1,189 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_coding/acm2/acm_receiver.h"
+#include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
+#include "webrtc/modules/audio_coding/include/audio_coding_module.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/sleep.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace acm2 {
+namespace {
+
+constexpr int kPayloadType = 107;
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kPacketSizeSamples = kSampleRateHz / 100;  // 10 ms.
+constexpr int kNumPullCalls = 20000;
+// How far the network thread may run ahead of the playout thread.
+constexpr int kMaxPacketsAhead = 5;
+// Number of stats reads per audio pull.
+constexpr int kStatsReadsPerPull = 2;
+
+// Collects the latencies of calls to one operation.
+class LatencyRecorder {
+ public:
+  LatencyRecorder() { latencies_ns_.reserve(10 * kNumPullCalls); }
+
+  void Add(int64_t latency_ns) { latencies_ns_.push_back(latency_ns); }
+
+  void Print(const std::string& operation) {
+    ASSERT_FALSE(latencies_ns_.empty());
+    int64_t sum_ns = 0;
+    for (int64_t latency_ns : latencies_ns_) {
+      sum_ns += latency_ns;
+    }
+    const size_t p99_index = latencies_ns_.size() * 99 / 100;
+    std::nth_element(latencies_ns_.begin(), latencies_ns_.begin() + p99_index,
+                     latencies_ns_.end());
+    test::PrintResult("acm_receiver_" + operation + "_time", "", "mean",
+                      static_cast<size_t>(sum_ns / latencies_ns_.size()), "ns",
+                      false);
+    test::PrintResult("acm_receiver_" + operation + "_time", "", "p99",
+                      static_cast<size_t>(latencies_ns_[p99_index]), "ns",
+                      false);
+  }
+
+ private:
+  std::vector<int64_t> latencies_ns_;
+};
+
+// Runs a network thread inserting packets, a stats thread polling the
+// receiver's getters, and a playout thread (the test thread) pulling audio, all
+// against the same AcmReceiver, and measures the latency of each call. The
+// network and stats threads are paced by the playout thread, so that the test
+// also gives meaningful numbers on machines with few cores.
+class AcmReceiverPerformanceTest : public ::testing::Test {
+ protected:
+  AcmReceiverPerformanceTest()
+      : insert_thread_(&InsertThread, this, "insert_thread"),
+        stats_thread_(&StatsThread, this, "stats_thread") {
+    AudioCodingModule::Config config;
+    config.clock = Clock::GetRealTimeClock();
+    config.decoder_factory = CreateBuiltinAudioDecoderFactory();
+    receiver_.reset(new AcmReceiver(config));
+    EXPECT_TRUE(receiver_->AddCodec(kPayloadType,
+                                    SdpAudioFormat("l16", kSampleRateHz, 1)));
+    for (size_t i = 0; i < payload_.size(); ++i) {
+      payload_[i] = static_cast<uint8_t>(i * 17);
+    }
+  }
+
+  void Run() {
+    insert_thread_.Start();
+    stats_thread_.Start();
+    AudioFrame frame;
+    bool muted;
+    for (int i = 0; i < kNumPullCalls; ++i) {
+      // Wait for the network thread, so that NetEq plays out real packets.
+      while (rtc::AtomicOps::AcquireLoad(&num_inserted_) <= i) {
+        SleepMs(0);  // Hand over timeslice, prevents busy looping.
+      }
+      const int64_t start_ns = rtc::TimeNanos();
+      ASSERT_EQ(0, receiver_->GetAudio(48000, &frame, &muted));
+      get_audio_latencies_.Add(rtc::TimeNanos() - start_ns);
+      rtc::AtomicOps::ReleaseStore(&num_pulled_, i + 1);
+    }
+    rtc::AtomicOps::ReleaseStore(&done_, 1);
+    insert_thread_.Stop();
+    stats_thread_.Stop();
+
+    insert_latencies_.Print("insert_packet");
+    get_audio_latencies_.Print("get_audio");
+    stats_latencies_.Print("stats_read");
+  }
+
+ private:
+  static bool InsertThread(void* obj) {
+    return static_cast<AcmReceiverPerformanceTest*>(obj)->InsertPacket();
+  }
+
+  static bool StatsThread(void* obj) {
+    return static_cast<AcmReceiverPerformanceTest*>(obj)->ReadStats();
+  }
+
+  bool InsertPacket() {
+    if (rtc::AtomicOps::AcquireLoad(&done_))
+      return false;
+    if (num_inserted_local_ >=
+        rtc::AtomicOps::AcquireLoad(&num_pulled_) + kMaxPacketsAhead) {
+      SleepMs(0);
+      return true;
+    }
+    WebRtcRTPHeader rtp_header;
+    memset(&rtp_header, 0, sizeof(rtp_header));
+    rtp_header.header.payloadType = kPayloadType;
+    rtp_header.header.ssrc = 0x1234;
+    rtp_header.header.sequenceNumber =
+        static_cast<uint16_t>(num_inserted_local_);
+    rtp_header.header.timestamp =
+        static_cast<uint32_t>(num_inserted_local_ * kPacketSizeSamples);
+    rtp_header.type.Audio.channel = 1;
+    const int64_t start_ns = rtc::TimeNanos();
+    EXPECT_EQ(0, receiver_->InsertPacket(rtp_header, payload_));
+    insert_latencies_.Add(rtc::TimeNanos() - start_ns);
+    ++num_inserted_local_;
+    rtc::AtomicOps::ReleaseStore(&num_inserted_, num_inserted_local_);
+    return true;
+  }
+
+  bool ReadStats() {
+    if (rtc::AtomicOps::AcquireLoad(&done_))
+      return false;
+    if (num_stats_reads_ >=
+        rtc::AtomicOps::AcquireLoad(&num_pulled_) * kStatsReadsPerPull) {
+      SleepMs(0);
+      return true;
+    }
+    CodecInst codec;
+    AudioDecodingCallStats call_stats;
+    const int64_t start_ns = rtc::TimeNanos();
+    receiver_->LastAudioCodec(&codec);
+    receiver_->last_packet_sample_rate_hz();
+    receiver_->last_output_sample_rate_hz();
+    receiver_->GetDecodingCallStatistics(&call_stats);
+    stats_latencies_.Add(rtc::TimeNanos() - start_ns);
+    ++num_stats_reads_;
+    return true;
+  }
+
+  std::unique_ptr<AcmReceiver> receiver_;
+  std::array<uint8_t, 2 * kPacketSizeSamples> payload_;
+  rtc::PlatformThread insert_thread_;
+  rtc::PlatformThread stats_thread_;
+  volatile int done_ = 0;
+  volatile int num_inserted_ = 0;
+  volatile int num_pulled_ = 0;
+  int num_inserted_local_ = 0;  // Only used on the network thread.
+  int num_stats_reads_ = 0;  // Only used on the stats thread.
+  LatencyRecorder insert_latencies_;
+  LatencyRecorder get_audio_latencies_;
+  LatencyRecorder stats_latencies_;
+};
+
+}  // namespace
+
+TEST_F(AcmReceiverPerformanceTest, Contention) {
+  Run();
+}
+
+}  // namespace acm2
+}  // namespace webrtc
@@ -228,14 +228,14 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   int RegisterReceiveCodecUnlocked(
       const CodecInst& codec,
       rtc::FunctionView<std::unique_ptr<AudioDecoder>()> isac_factory)
-      EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
+      EXCLUSIVE_LOCKS_REQUIRED(receiver_crit_sect_);
 
   int Add10MsDataInternal(const AudioFrame& audio_frame, InputData* input_data)
       EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
   int Encode(const InputData& input_data)
       EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
 
-  int InitializeReceiverSafe() EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
+  int InitializeReceiverSafe() EXCLUSIVE_LOCKS_REQUIRED(receiver_crit_sect_);
 
   bool HaveValidEncoder(const char* caller_name) const
       EXCLUSIVE_LOCKS_REQUIRED(acm_crit_sect_);
@@ -275,8 +275,14 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   // RegisterEncoder.
   std::unique_ptr<AudioEncoder> encoder_stack_ GUARDED_BY(acm_crit_sect_);
 
-  std::unique_ptr<AudioDecoder> isac_decoder_16k_ GUARDED_BY(acm_crit_sect_);
-  std::unique_ptr<AudioDecoder> isac_decoder_32k_ GUARDED_BY(acm_crit_sect_);
+  // Receive codec configuration is guarded by its own lock, so that it does not
+  // wait for an ongoing encode. It is taken before |acm_crit_sect_| when both
+  // are needed.
+  rtc::CriticalSection receiver_crit_sect_;
+  std::unique_ptr<AudioDecoder> isac_decoder_16k_
+      GUARDED_BY(receiver_crit_sect_);
+  std::unique_ptr<AudioDecoder> isac_decoder_32k_
+      GUARDED_BY(receiver_crit_sect_);
 
   // This is to keep track of CN instances where we can send DTMFs.
   uint8_t previous_pltype_ GUARDED_BY(acm_crit_sect_);
@@ -289,7 +295,7 @@ class AudioCodingModuleImpl final : public AudioCodingModule {
   // be used in other methods, locks need to be taken.
   std::unique_ptr<WebRtcRTPHeader> aux_rtp_header_;
 
-  bool receiver_initialized_ GUARDED_BY(acm_crit_sect_);
+  bool receiver_initialized_ GUARDED_BY(receiver_crit_sect_);
 
   AudioFrame preprocess_frame_ GUARDED_BY(acm_crit_sect_);
   bool first_10ms_data_ GUARDED_BY(acm_crit_sect_);
@@ -943,7 +949,7 @@ int AudioCodingModuleImpl::VAD(bool* dtx_enabled, bool* vad_enabled,
 //
 
 int AudioCodingModuleImpl::InitializeReceiver() {
-  rtc::CritScope lock(&acm_crit_sect_);
+  rtc::CritScope lock(&receiver_crit_sect_);
   return InitializeReceiverSafe();
 }
 
@@ -993,7 +999,7 @@ int AudioCodingModuleImpl::PlayoutFrequency() const {
 bool AudioCodingModuleImpl::RegisterReceiveCodec(
     int rtp_payload_type,
     const SdpAudioFormat& audio_format) {
-  rtc::CritScope lock(&acm_crit_sect_);
+  rtc::CritScope lock(&receiver_crit_sect_);
   RTC_DCHECK(receiver_initialized_);
 
   if (!acm2::RentACodec::IsPayloadTypeValid(rtp_payload_type)) {
@@ -1006,16 +1012,19 @@ bool AudioCodingModuleImpl::RegisterReceiveCodec(
 }
 
 int AudioCodingModuleImpl::RegisterReceiveCodec(const CodecInst& codec) {
-  rtc::CritScope lock(&acm_crit_sect_);
-  auto* ef = encoder_factory_.get();
-  return RegisterReceiveCodecUnlocked(
-      codec, [&] { return ef->rent_a_codec.RentIsacDecoder(codec.plfreq); });
+  rtc::CritScope lock(&receiver_crit_sect_);
+  return RegisterReceiveCodecUnlocked(codec, [&] {
+    // The iSAC decoder is paired with the encoder, so this needs the encoder
+    // lock as well.
+    rtc::CritScope encoder_lock(&acm_crit_sect_);
+    return encoder_factory_->rent_a_codec.RentIsacDecoder(codec.plfreq);
+  });
 }
 
 int AudioCodingModuleImpl::RegisterReceiveCodec(
     const CodecInst& codec,
     rtc::FunctionView<std::unique_ptr<AudioDecoder>()> isac_factory) {
-  rtc::CritScope lock(&acm_crit_sect_);
+  rtc::CritScope lock(&receiver_crit_sect_);
   return RegisterReceiveCodecUnlocked(codec, isac_factory);
 }
 
@@ -1063,7 +1072,7 @@ int AudioCodingModuleImpl::RegisterExternalReceiveCodec(
     int sample_rate_hz,
     int num_channels,
     const std::string& name) {
-  rtc::CritScope lock(&acm_crit_sect_);
+  rtc::CritScope lock(&receiver_crit_sect_);
   RTC_DCHECK(receiver_initialized_);
   if (num_channels > 2 || num_channels < 0) {
     LOG_F(LS_ERROR) << "Unsupported number of channels: " << num_channels;
@@ -1083,7 +1092,6 @@ int AudioCodingModuleImpl::RegisterExternalReceiveCodec(
 
 // Get current received codec.
 int AudioCodingModuleImpl::ReceiveCodec(CodecInst* current_codec) const {
-  rtc::CritScope lock(&acm_crit_sect_);
   return receiver_.LastAudioCodec(current_codec);
 }
 
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/codecs/ilbc/ilbc.h"
+#include "webrtc/modules/audio_coding/codecs/tools/audio_codec_speed_test.h"
+
+using ::std::string;
+
+namespace webrtc {
+
+static const int kIlbcBlockDurationMs = 30;
+static const int kIlbcSamplingKhz = 8;
+
+class IlbcSpeedTest : public AudioCodecSpeedTest {
+ protected:
+  IlbcSpeedTest();
+  void SetUp() override;
+  void TearDown() override;
+  float EncodeABlock(int16_t* in_data, uint8_t* bit_stream,
+                     size_t max_bytes, size_t* encoded_bytes) override;
+  float DecodeABlock(const uint8_t* bit_stream, size_t encoded_bytes,
+                     int16_t* out_data) override;
+  IlbcEncoderInstance* ilbc_encoder_;
+  IlbcDecoderInstance* ilbc_decoder_;
+};
+
+IlbcSpeedTest::IlbcSpeedTest()
+    : AudioCodecSpeedTest(kIlbcBlockDurationMs,
+                          kIlbcSamplingKhz,
+                          kIlbcSamplingKhz),
+      ilbc_encoder_(NULL),
+      ilbc_decoder_(NULL) {
+}
+
+void IlbcSpeedTest::SetUp() {
+  AudioCodecSpeedTest::SetUp();
+  // Create encoder and decoder memory, and set the frame length.
+  EXPECT_EQ(0, WebRtcIlbcfix_EncoderCreate(&ilbc_encoder_));
+  EXPECT_EQ(0, WebRtcIlbcfix_DecoderCreate(&ilbc_decoder_));
+  EXPECT_EQ(0, WebRtcIlbcfix_EncoderInit(ilbc_encoder_, block_duration_ms_));
+  EXPECT_EQ(0, WebRtcIlbcfix_DecoderInit(ilbc_decoder_, block_duration_ms_));
+}
+
+void IlbcSpeedTest::TearDown() {
+  AudioCodecSpeedTest::TearDown();
+  // Free memory.
+  EXPECT_EQ(0, WebRtcIlbcfix_EncoderFree(ilbc_encoder_));
+  EXPECT_EQ(0, WebRtcIlbcfix_DecoderFree(ilbc_decoder_));
+}
+
+float IlbcSpeedTest::EncodeABlock(int16_t* in_data, uint8_t* bit_stream,
+                                  size_t max_bytes, size_t* encoded_bytes) {
+  clock_t clocks = clock();
+  int value = WebRtcIlbcfix_Encode(ilbc_encoder_, in_data,
+                                   input_length_sample_, bit_stream);
+  clocks = clock() - clocks;
+  EXPECT_GT(value, 0);
+  *encoded_bytes = static_cast<size_t>(value);
+  assert(*encoded_bytes <= max_bytes);
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+float IlbcSpeedTest::DecodeABlock(const uint8_t* bit_stream,
+                                  size_t encoded_bytes, int16_t* out_data) {
+  int value;
+  int16_t audio_type;
+  clock_t clocks = clock();
+  value = WebRtcIlbcfix_Decode(ilbc_decoder_, bit_stream, encoded_bytes,
+                               out_data, &audio_type);
+  clocks = clock() - clocks;
+  EXPECT_EQ(output_length_sample_, static_cast<size_t>(value));
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+TEST_P(IlbcSpeedTest, IlbcEncodeDecodeTest) {
+  size_t kDurationSec = 400;  // Test audio length in second.
+  EncodeDecode(kDurationSec);
+}
+
+// iLBC has a fixed bit rate for a given frame length, so the bit rate here is
+// informational only. There is no 8 kHz speech resource, so the 16 kHz one is
+// played out at 8 kHz, which is fine for measuring speed.
+const coding_param param_set[] =
+    {::std::tr1::make_tuple(1, 13330, string("audio_coding/speech_mono_16kHz"),
+                            string("pcm"), true)};
+
+INSTANTIATE_TEST_CASE_P(AllTest, IlbcSpeedTest,
+                        ::testing::ValuesIn(param_set));
+
+}  // namespace webrtc
@@ -230,4 +230,23 @@ void WebRtcIsac_Dir2Lat(double* a, int orderCoef, float* sth, float* cth);
 
 void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order);
 
+/* Computes corr[k] = sum of x[n] * y[n + k] over 0 <= n < N, for
+ * 0 <= k < num_lags. */
+void WebRtcIsac_CrossCorr(double* corr, const double* x, const double* y,
+                          size_t N, size_t num_lags);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* SSE2 versions of the functions above. Each output is accumulated in the same
+ * order as in the C version, so they are bit-exact with it. They are selected
+ * at run time, by the C versions, on CPUs that support SSE2. */
+void WebRtcIsac_AllZeroFilterSse2(double* In, double* Coef, size_t lengthInOut,
+                                  int orderCoef, double* Out);
+
+void WebRtcIsac_AutoCorrSse2(double* r, const double* x, size_t N,
+                             size_t order);
+
+void WebRtcIsac_CrossCorrSse2(double* corr, const double* x, const double* y,
+                              size_t N, size_t num_lags);
+#endif
+
 #endif /* WEBRTC_MODULES_AUDIO_CODING_CODECS_ISAC_MAIN_SOURCE_CODEC_H_ */
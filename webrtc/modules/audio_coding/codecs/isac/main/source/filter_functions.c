@@ -16,7 +16,50 @@
 #include "pitch_estimator.h"
 #include "lpc_analysis.h"
 #include "codec.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(WEBRTC_POSIX)
+#include <pthread.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+static int use_sse2 = 0;
 
+static void InitUseSse2(void) {
+  use_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+}
+
+#if defined(WEBRTC_POSIX)
+static void InitUseSse2Once(void) {
+  static pthread_once_t once = PTHREAD_ONCE_INIT;
+  pthread_once(&once, InitUseSse2);
+}
+#elif defined(_WIN32)
+static BOOL CALLBACK InitUseSse2Callback(PINIT_ONCE once,
+                                         PVOID parameter,
+                                         PVOID* context) {
+  InitUseSse2();
+  return TRUE;
+}
+
+static void InitUseSse2Once(void) {
+  static INIT_ONCE once = INIT_ONCE_STATIC_INIT;
+  InitOnceExecuteOnce(&once, InitUseSse2Callback, NULL, NULL);
+}
+#endif
+
+/* Returns nonzero if the SSE2 versions of the filter functions can be used.
+ * The CPU is queried once, even when encoders and VADs on several threads get
+ * here at the same time. */
+static int UseSse2(void) {
+  InitUseSse2Once();
+  return use_sse2;
+}
+#endif
 
 
 void WebRtcIsac_AllPoleFilter(double* InOut,
@@ -67,6 +110,13 @@ void WebRtcIsac_AllZeroFilter(double* In,
   int k;
   double tmp;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    WebRtcIsac_AllZeroFilterSse2(In, Coef, lengthInOut, orderCoef, Out);
+    return;
+  }
+#endif
+
   for(n = 0; n < lengthInOut; n++)
   {
     tmp = In[0] * Coef[0];
@@ -100,6 +150,13 @@ void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order) {
   double sum, prod;
   const double *x_lag;
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    WebRtcIsac_AutoCorrSse2(r, x, N, order);
+    return;
+  }
+#endif
+
   for (lag = 0; lag <= order; lag++)
   {
     sum = 0.0f;
@@ -116,6 +173,28 @@ void WebRtcIsac_AutoCorr(double* r, const double* x, size_t N, size_t order) {
 }
 
 
+void WebRtcIsac_CrossCorr(double* corr, const double* x, const double* y,
+                          size_t N, size_t num_lags) {
+  size_t k, n;
+  double sum;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (UseSse2()) {
+    WebRtcIsac_CrossCorrSse2(corr, x, y, N, num_lags);
+    return;
+  }
+#endif
+
+  for (k = 0; k < num_lags; k++) {
+    sum = 0.0;
+    for (n = 0; n < N; n++) {
+      sum += x[n] * y[n + k];
+    }
+    corr[k] = sum;
+  }
+}
+
+
 void WebRtcIsac_BwExpand(double* out, double* in, double coef, size_t length) {
   size_t i;
   double  chirp;
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 versions of the filter functions in filter_functions.c. Two outputs
+ * are computed at a time, one in each lane, and every lane adds its products
+ * in the same order as the C version does, which keeps the results bit-exact.
+ */
+
+#include <emmintrin.h>
+
+#include "codec.h"
+
+void WebRtcIsac_AllZeroFilterSse2(double* In,
+                                  double* Coef,
+                                  size_t lengthInOut,
+                                  int orderCoef,
+                                  double* Out) {
+  /* the state of filter is assumed to be in In[-1] to In[-orderCoef] */
+
+  size_t n;
+  int k;
+  double tmp;
+  const __m128d coef0 = _mm_set1_pd(Coef[0]);
+
+  for (n = 0; n + 1 < lengthInOut; n += 2) {
+    __m128d sum = _mm_mul_pd(_mm_loadu_pd(&In[n]), coef0);
+    for (k = 1; k <= orderCoef; k++) {
+      sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(Coef[k]),
+                                       _mm_loadu_pd(&In[n - k])));
+    }
+    _mm_storeu_pd(&Out[n], sum);
+  }
+
+  if (n < lengthInOut) {
+    tmp = In[n] * Coef[0];
+    for (k = 1; k <= orderCoef; k++) {
+      tmp += Coef[k] * In[n - k];
+    }
+    Out[n] = tmp;
+  }
+}
+
+void WebRtcIsac_AutoCorrSse2(double* r, const double* x, size_t N,
+                             size_t order) {
+  size_t lag, n;
+  double sum[2];
+
+  for (lag = 0; lag + 1 <= order; lag += 2) {
+    /* Lags |lag| and |lag| + 1 share all but the last product of |lag|. */
+    __m128d sum_v = _mm_setzero_pd();
+    for (n = 0; n + lag + 1 < N; n++) {
+      sum_v = _mm_add_pd(sum_v, _mm_mul_pd(_mm_set1_pd(x[n]),
+                                           _mm_loadu_pd(&x[n + lag])));
+    }
+    _mm_storeu_pd(sum, sum_v);
+    r[lag] = sum[0] + x[n] * x[n + lag];
+    r[lag + 1] = sum[1];
+  }
+
+  if (lag <= order) {
+    sum[0] = 0.0;
+    for (n = 0; n + lag < N; n++) {
+      sum[0] += x[n] * x[n + lag];
+    }
+    r[lag] = sum[0];
+  }
+}
+
+void WebRtcIsac_CrossCorrSse2(double* corr, const double* x, const double* y,
+                              size_t N, size_t num_lags) {
+  size_t k, n;
+  double sum;
+
+  for (k = 0; k + 1 < num_lags; k += 2) {
+    __m128d sum_v = _mm_setzero_pd();
+    for (n = 0; n < N; n++) {
+      sum_v = _mm_add_pd(sum_v, _mm_mul_pd(_mm_set1_pd(x[n]),
+                                           _mm_loadu_pd(&y[n + k])));
+    }
+    _mm_storeu_pd(&corr[k], sum_v);
+  }
+
+  if (k < num_lags) {
+    sum = 0.0;
+    for (n = 0; n < N; n++) {
+      sum += x[n] * y[n + k];
+    }
+    corr[k] = sum;
+  }
+}
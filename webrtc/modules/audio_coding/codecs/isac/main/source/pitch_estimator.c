@@ -9,6 +9,7 @@
  */
 
 #include "pitch_estimator.h"
+#include "codec.h"
 
 #include <math.h>
 #include <memory.h>
@@ -90,35 +91,28 @@ __inline static void Intrpol2D(double T[3][3], double *x, double *y, double *pea
 
 static void PCorr(const double *in, double *outcorr)
 {
-  double sum, ysum, prod;
-  const double *x, *inptr;
+  double corr[PITCH_LAG_SPAN2];
+  double ysum;
+  const double *x;
   int k, n;
 
+  x = in + PITCH_MAX_LAG/2 + 2;
+  WebRtcIsac_CrossCorr(corr, x, in, PITCH_CORR_LEN2, PITCH_LAG_SPAN2);
+
   //ysum = 1e-6;          /* use this with float (i.s.o. double)! */
   ysum = 1e-13;
-  sum = 0.0;
-  x = in + PITCH_MAX_LAG/2 + 2;
   for (n = 0; n < PITCH_CORR_LEN2; n++) {
     ysum += in[n] * in[n];
-    sum += x[n] * in[n];
   }
 
   outcorr += PITCH_LAG_SPAN2 - 1;     /* index of last element in array */
-  *outcorr = sum / sqrt(ysum);
+  *outcorr = corr[0] / sqrt(ysum);
 
   for (k = 1; k < PITCH_LAG_SPAN2; k++) {
     ysum -= in[k-1] * in[k-1];
     ysum += in[PITCH_CORR_LEN2 + k - 1] * in[PITCH_CORR_LEN2 + k - 1];
-    sum = 0.0;
-    inptr = &in[k];
-    prod = x[0] * inptr[0];
-    for (n = 1; n < PITCH_CORR_LEN2; n++) {
-      sum += prod;
-      prod = x[n] * inptr[n];
-    }
-    sum += prod;
     outcorr--;
-    *outcorr = sum / sqrt(ysum);
+    *outcorr = corr[k] / sqrt(ysum);
   }
 }
 
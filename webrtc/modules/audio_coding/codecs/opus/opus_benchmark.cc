@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <math.h>
+
+#include "webrtc/modules/audio_coding/codecs/opus/opus_interface.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 48000;
+const size_t kSamplesPer20Ms = kSampleRateHz / 50;
+const int kBitrateBps = 32000;
+const size_t kMaxPacketBytes = 1500;
+// The VoIP application, as AudioEncoderOpus uses for mono.
+const int32_t kApplicationVoip = 0;
+
+// A 20 ms mix of two tones, so that the encoder has some content to work on.
+void FillInput(int16_t* input) {
+  for (size_t i = 0; i < kSamplesPer20Ms; ++i) {
+    input[i] = static_cast<int16_t>(
+        4000 * sin(2 * M_PI * 440 * i / kSampleRateHz) +
+        2000 * sin(2 * M_PI * 1250 * i / kSampleRateHz));
+  }
+}
+
+class OpusBenchmark : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_EQ(0, WebRtcOpus_EncoderCreate(&encoder_, 1, kApplicationVoip));
+    ASSERT_EQ(0, WebRtcOpus_SetBitRate(encoder_, kBitrateBps));
+    ASSERT_EQ(0, WebRtcOpus_DecoderCreate(&decoder_, 1));
+    FillInput(input_);
+  }
+
+  void TearDown() override {
+    WebRtcOpus_EncoderFree(encoder_);
+    WebRtcOpus_DecoderFree(decoder_);
+  }
+
+  OpusEncInst* encoder_ = nullptr;
+  OpusDecInst* decoder_ = nullptr;
+  int16_t input_[kSamplesPer20Ms];
+};
+
+}  // namespace
+
+TEST_F(OpusBenchmark, Encode) {
+  uint8_t packet[kMaxPacketBytes];
+  int packet_bytes = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "opus_encode_mono_20ms", test::BenchmarkOptions(), [&] {
+        packet_bytes = WebRtcOpus_Encode(encoder_, input_, kSamplesPer20Ms,
+                                         kMaxPacketBytes, packet);
+      }));
+  EXPECT_GT(packet_bytes, 0);
+}
+
+TEST_F(OpusBenchmark, Decode) {
+  uint8_t packet[kMaxPacketBytes];
+  const int packet_bytes = WebRtcOpus_Encode(encoder_, input_, kSamplesPer20Ms,
+                                             kMaxPacketBytes, packet);
+  ASSERT_GT(packet_bytes, 0);
+  int16_t output[kSamplesPer20Ms];
+  int decoded_samples = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "opus_decode_mono_20ms", test::BenchmarkOptions(), [&] {
+        int16_t audio_type;
+        decoded_samples = WebRtcOpus_Decode(decoder_, packet, packet_bytes,
+                                            output, &audio_type);
+      }));
+  EXPECT_EQ(static_cast<int>(kSamplesPer20Ms), decoded_samples);
+}
+
+}  // namespace webrtc
@@ -184,16 +184,18 @@ TEST(DecoderDatabase, CheckPayloadTypes) {
   EXPECT_EQ(DecoderDatabase::kDecoderNotFound,
             db.CheckPayloadTypes(packet_list));
 
-  delete packet_list.back();
+  Packet* unknown_packet = packet_list.back();
   packet_list.pop_back();  // Remove the unknown one.
+  delete unknown_packet;
 
   EXPECT_EQ(DecoderDatabase::kOK, db.CheckPayloadTypes(packet_list));
 
   // Delete all packets.
   PacketList::iterator it = packet_list.begin();
   while (it != packet_list.end()) {
-    delete packet_list.front();
+    Packet* packet = *it;
     it = packet_list.erase(it);
+    delete packet;
   }
 }
 
@@ -29,6 +29,7 @@ DelayManager::DelayManager(size_t max_packets_in_buffer,
     : first_packet_received_(false),
       max_packets_in_buffer_(max_packets_in_buffer),
       iat_vector_(kMaxIat + 1, 0),
+      iat_vector_end_(0),
       iat_factor_(0),
       tick_timer_(tick_timer),
       base_target_level_(4),  // In Q0 domain.
@@ -66,6 +67,7 @@ void DelayManager::ResetHistogram() {
     temp_prob >>= 1;
     (*it) = temp_prob << 16;
   }
+  TrimHistogram(iat_vector_.size());
   base_target_level_ = 4;
   target_level_ = base_target_level_ << 8;
 }
@@ -181,12 +183,14 @@ void DelayManager::UpdateCumulativeSums(int packet_len_ms,
 // is reset, the factor is set to 0 to facilitate rapid convergence in the
 // beginning. With each update of the histogram, the factor is increased towards
 // the steady-state value |kIatFactor_|.
+// The elements from |iat_vector_end_| on are zero, and stay zero through all
+// of the above, so they are skipped.
 void DelayManager::UpdateHistogram(size_t iat_packets) {
   assert(iat_packets < iat_vector_.size());
   int vector_sum = 0;  // Sum up the vector elements as they are processed.
   // Multiply each element in |iat_vector_| with |iat_factor_|.
   for (IATVector::iterator it = iat_vector_.begin();
-      it != iat_vector_.end(); ++it) {
+      it != iat_vector_.begin() + iat_vector_end_; ++it) {
     *it = (static_cast<int64_t>(*it) * iat_factor_) >> 15;
     vector_sum += *it;
   }
@@ -196,6 +200,7 @@ void DelayManager::UpdateHistogram(size_t iat_packets) {
   // Thus, left-shift 15 steps to obtain result in Q30.
   iat_vector_[iat_packets] += (32768 - iat_factor_) << 15;
   vector_sum += (32768 - iat_factor_) << 15;  // Add to vector sum.
+  iat_vector_end_ = std::max(iat_vector_end_, iat_packets + 1);
 
   // |iat_vector_| should sum up to 1 (in Q30), but it may not due to
   // fixed-point rounding errors.
@@ -204,7 +209,8 @@ void DelayManager::UpdateHistogram(size_t iat_packets) {
     // Modify a few values early in |iat_vector_|.
     int flip_sign = vector_sum > 0 ? -1 : 1;
     IATVector::iterator it = iat_vector_.begin();
-    while (it != iat_vector_.end() && abs(vector_sum) > 0) {
+    while (it != iat_vector_.begin() + iat_vector_end_ &&
+           abs(vector_sum) > 0) {
       // Add/subtract 1/16 of the element, but not more than |vector_sum|.
       int correction = flip_sign * std::min(abs(vector_sum), (*it) >> 4);
       *it += correction;
@@ -213,12 +219,19 @@ void DelayManager::UpdateHistogram(size_t iat_packets) {
     }
   }
   assert(vector_sum == 0);  // Verify that the above is correct.
+  TrimHistogram(iat_vector_end_);
 
   // Update |iat_factor_| (changes only during the first seconds after a reset).
   // The factor converges to |kIatFactor_|.
   iat_factor_ += (kIatFactor_ - iat_factor_ + 3) >> 2;
 }
 
+void DelayManager::TrimHistogram(size_t end) {
+  iat_vector_end_ = end;
+  while (iat_vector_end_ > 0 && iat_vector_[iat_vector_end_ - 1] == 0)
+    --iat_vector_end_;
+}
+
 // Enforces upper and lower limits for |target_level_|. The upper limit is
 // chosen to be minimum of i) 75% of |max_packets_in_buffer_|, to leave some
 // headroom for natural fluctuations around the target, and ii) equivalent of
@@ -128,6 +128,10 @@ class DelayManager {
   // all other entries are decreased. This method is called by Update().
   void UpdateHistogram(size_t iat_packets);
 
+  // Sets |iat_vector_end_| to one past the last non-zero element of
+  // |iat_vector_| before |end|. The elements from |end| on must be zero.
+  void TrimHistogram(size_t end);
+
   // Makes sure that |target_level_| is not too large, taking
   // |max_packets_in_buffer_| and |extra_delay_ms_| into account. This method is
   // called by Update().
@@ -136,6 +140,10 @@ class DelayManager {
   bool first_packet_received_;
   const size_t max_packets_in_buffer_;  // Capacity of the packet buffer.
   IATVector iat_vector_;  // Histogram of inter-arrival times.
+  // The elements of |iat_vector_| from this index on are zero. They decay to
+  // zero after long enough without a matching inter-arrival time, and are
+  // then skipped by UpdateHistogram().
+  size_t iat_vector_end_;
   int iat_factor_;  // Forgetting factor for updating the IAT histogram (Q15).
   const TickTimer* tick_timer_;
   // Time elapsed since last packet.
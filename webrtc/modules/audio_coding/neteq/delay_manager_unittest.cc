@@ -13,7 +13,12 @@
 #include "webrtc/modules/audio_coding/neteq/delay_manager.h"
 
 #include <math.h>
+#include <stdlib.h>
 
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/random.h"
 #include "webrtc/modules/audio_coding/neteq/mock/mock_delay_peak_detector.h"
 #include "webrtc/test/gmock.h"
 #include "webrtc/test/gtest.h"
@@ -23,6 +28,62 @@ namespace webrtc {
 using ::testing::Return;
 using ::testing::_;
 
+namespace {
+
+// Snapshot of the inter-arrival time histogram as DelayManager implemented it
+// before it skipped the elements that decayed to zero, which updated every
+// element on each packet.
+class ReferenceIatHistogram {
+ public:
+  ReferenceIatHistogram() : iat_vector_(65), iat_factor_(0) {
+    uint16_t temp_prob = 0x4002;
+    for (int& probability : iat_vector_) {
+      temp_prob >>= 1;
+      probability = temp_prob << 16;
+    }
+  }
+
+  void Update(size_t iat_packets) {
+    int vector_sum = 0;
+    for (int& probability : iat_vector_) {
+      probability = (static_cast<int64_t>(probability) * iat_factor_) >> 15;
+      vector_sum += probability;
+    }
+    iat_vector_[iat_packets] += (32768 - iat_factor_) << 15;
+    vector_sum += (32768 - iat_factor_) << 15;
+    vector_sum -= 1 << 30;
+    if (vector_sum != 0) {
+      int flip_sign = vector_sum > 0 ? -1 : 1;
+      for (size_t i = 0; i < iat_vector_.size() && abs(vector_sum) > 0; ++i) {
+        int correction =
+            flip_sign * std::min(abs(vector_sum), iat_vector_[i] >> 4);
+        iat_vector_[i] += correction;
+        vector_sum += correction;
+      }
+    }
+    iat_factor_ += (32745 - iat_factor_ + 3) >> 2;
+  }
+
+  int TargetLevel(int limit_probability) const {
+    size_t index = 0;
+    int sum = 1 << 30;
+    sum -= iat_vector_[index];
+    do {
+      ++index;
+      sum -= iat_vector_[index];
+    } while ((sum > limit_probability) && (index < iat_vector_.size() - 1));
+    return static_cast<int>(index);
+  }
+
+  const std::vector<int>& iat_vector() const { return iat_vector_; }
+
+ private:
+  std::vector<int> iat_vector_;
+  int iat_factor_;
+};
+
+}  // namespace
+
 class DelayManagerTest : public ::testing::Test {
  protected:
   static const int kMaxNumberOfPackets = 240;
@@ -37,6 +98,7 @@ class DelayManagerTest : public ::testing::Test {
   void SetPacketAudioLength(int lengt_ms);
   void InsertNextPacket();
   void IncreaseTime(int inc_ms);
+  void ExpectHistogramMatchesReference(bool streaming_mode);
 
   DelayManager* dm_;
   TickTimer tick_timer_;
@@ -70,6 +132,38 @@ void DelayManagerTest::IncreaseTime(int inc_ms) {
     tick_timer_.Increment();
   }
 }
+// Verifies that the histogram and the base target level are bit-exact with
+// the implementation that updated every element, for inter-arrival times with
+// frequent jitter and occasional delay spikes. The spikes make elements far
+// into the histogram non-zero, and then decay to zero again.
+void DelayManagerTest::ExpectHistogramMatchesReference(bool streaming_mode) {
+  const int kNumPackets = 100000;
+  const int limit_probability =
+      streaming_mode ? 536871 : 53687091;  // 1/2000 or 1/20 in Q30.
+  dm_->set_streaming_mode(streaming_mode);
+  SetPacketAudioLength(kFrameSizeMs);
+  EXPECT_CALL(detector_, Update(_, _)).WillRepeatedly(Return(false));
+  Random random(0x1234567);
+  ReferenceIatHistogram reference;
+  InsertNextPacket();
+  for (int i = 0; i < kNumPackets; ++i) {
+    int iat_packets = 1;
+    const float spike = random.Rand<float>();
+    if (i % 40000 < 20000 && spike < 0.001f) {
+      iat_packets = random.Rand(0, 64);
+    } else if (spike < 0.3f) {
+      iat_packets = random.Rand(0, 3);
+    }
+    IncreaseTime(iat_packets * kFrameSizeMs);
+    InsertNextPacket();
+    reference.Update(iat_packets);
+    ASSERT_EQ(reference.TargetLevel(limit_probability),
+              dm_->base_target_level())
+        << "Packet " << i;
+    ASSERT_EQ(reference.iat_vector(), dm_->iat_vector()) << "Packet " << i;
+  }
+}
+
 void DelayManagerTest::TearDown() {
   EXPECT_CALL(detector_, Die());
   delete dm_;
@@ -266,6 +360,14 @@ TEST_F(DelayManagerTest, MinAndRequiredDelay) {
   EXPECT_EQ(kMinDelayPackets << 8, dm_->TargetLevel());
 }
 
+TEST_F(DelayManagerTest, HistogramMatchesReference) {
+  ExpectHistogramMatchesReference(false);
+}
+
+TEST_F(DelayManagerTest, HistogramMatchesReferenceStreamingMode) {
+  ExpectHistogramMatchesReference(true);
+}
+
 TEST_F(DelayManagerTest, Failures) {
   // Wrong sample rate.
   EXPECT_EQ(-1, dm_->Update(0, 0, -1));
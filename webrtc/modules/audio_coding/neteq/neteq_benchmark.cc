@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
+#include "webrtc/modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "webrtc/modules/audio_coding/neteq/include/neteq.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 32000;
+const size_t kSamplesPer10Ms = kSampleRateHz / 100;
+const int kPayloadType = 95;
+
+// Inserts one 10 ms PCM16b packet and pulls 10 ms of audio per run, dropping
+// one out of |loss_rate| packets so that concealment is exercised as well.
+void RunNetEqBenchmark(int loss_rate, const std::string& name) {
+  NetEq::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  std::unique_ptr<NetEq> neteq(
+      NetEq::Create(config, CreateBuiltinAudioDecoderFactory()));
+  ASSERT_EQ(NetEq::kOK,
+            neteq->RegisterPayloadType(NetEqDecoder::kDecoderPCM16Bswb32kHz,
+                                       "pcm16-swb32", kPayloadType));
+
+  Random random(0x4e7e9);
+  int16_t input[kSamplesPer10Ms];
+  for (int16_t& sample : input)
+    sample = random.Rand(-8000, 8000);
+  uint8_t payload[kSamplesPer10Ms * sizeof(int16_t)];
+  WebRtcPcm16b_Encode(input, kSamplesPer10Ms, payload);
+
+  WebRtcRTPHeader rtp_header;
+  rtp_header.header.payloadType = kPayloadType;
+  rtp_header.header.ssrc = 0x1234;
+  rtp_header.header.markerBit = false;
+  uint16_t sequence_number = 0;
+  uint32_t timestamp = 0;
+  AudioFrame output;
+  bool ok = true;
+  test::ReportBenchmark(
+      test::RunBenchmark(name, test::BenchmarkOptions(), [&] {
+        if (loss_rate == 0 || sequence_number % loss_rate != 0) {
+          rtp_header.header.sequenceNumber = sequence_number;
+          rtp_header.header.timestamp = timestamp;
+          ok &= neteq->InsertPacket(rtp_header, payload, timestamp) ==
+                NetEq::kOK;
+        }
+        ++sequence_number;
+        timestamp += kSamplesPer10Ms;
+        bool muted;
+        ok &= neteq->GetAudio(&output, &muted) == NetEq::kOK;
+      }));
+  EXPECT_TRUE(ok);
+}
+
+}  // namespace
+
+TEST(NetEqBenchmark, InsertAndGetAudio) {
+  RunNetEqBenchmark(0, "neteq_insert_and_get_audio");
+}
+
+TEST(NetEqBenchmark, InsertAndGetAudioWithLoss) {
+  RunNetEqBenchmark(10, "neteq_insert_and_get_audio_10_percent_loss");
+}
+
+}  // namespace webrtc
@@ -41,6 +41,7 @@
 #include "webrtc/modules/audio_coding/neteq/normal.h"
 #include "webrtc/modules/audio_coding/neteq/packet_buffer.h"
 #include "webrtc/modules/audio_coding/neteq/packet.h"
+#include "webrtc/modules/audio_coding/neteq/packet_pool.h"
 #include "webrtc/modules/audio_coding/neteq/red_payload_splitter.h"
 #include "webrtc/modules/audio_coding/neteq/post_decode_vad.h"
 #include "webrtc/modules/audio_coding/neteq/preemptive_expand.h"
@@ -54,7 +55,8 @@ namespace webrtc {
 NetEqImpl::Dependencies::Dependencies(
     const NetEq::Config& config,
     const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory)
-    : tick_timer(new TickTimer),
+    : packet_pool(new PacketPool),
+      tick_timer(new TickTimer),
       buffer_level_filter(new BufferLevelFilter),
       decoder_database(new DecoderDatabase(decoder_factory)),
       delay_peak_detector(new DelayPeakDetector(tick_timer.get())),
@@ -65,7 +67,7 @@ NetEqImpl::Dependencies::Dependencies(
       dtmf_tone_generator(new DtmfToneGenerator),
       packet_buffer(
           new PacketBuffer(config.max_packets_in_buffer, tick_timer.get())),
-      red_payload_splitter(new RedPayloadSplitter),
+      red_payload_splitter(new RedPayloadSplitter(packet_pool.get())),
       timestamp_scaler(new TimestampScaler(*decoder_database)),
       accelerate_factory(new AccelerateFactory),
       expand_factory(new ExpandFactory),
@@ -76,7 +78,8 @@ NetEqImpl::Dependencies::~Dependencies() = default;
 NetEqImpl::NetEqImpl(const NetEq::Config& config,
                      Dependencies&& deps,
                      bool create_components)
-    : tick_timer_(std::move(deps.tick_timer)),
+    : packet_pool_(std::move(deps.packet_pool)),
+      tick_timer_(std::move(deps.tick_timer)),
       buffer_level_filter_(std::move(deps.buffer_level_filter)),
       decoder_database_(std::move(deps.decoder_database)),
       delay_manager_(std::move(deps.delay_manager)),
@@ -105,7 +108,8 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       playout_mode_(config.playout_mode),
       enable_fast_accelerate_(config.enable_fast_accelerate),
       nack_enabled_(false),
-      enable_muted_state_(config.enable_muted_state) {
+      enable_muted_state_(config.enable_muted_state),
+      memory_usage_(memory_usage::kNetEq) {
   LOG(LS_INFO) << "NetEq config: " << config.ToString();
   int fs = config.sample_rate_hz;
   if (fs != 8000 && fs != 16000 && fs != 32000 && fs != 48000) {
@@ -587,7 +591,7 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
     // Create |packet| within this separate scope, since it should not be used
     // directly once it's been inserted in the packet list. This way, |packet|
     // is not defined outside of this block.
-    Packet* packet = new Packet;
+    Packet* packet = new (packet_pool_.get()) Packet;
     packet->header.markerBit = false;
     packet->header.payloadType = rtp_header.header.payloadType;
     packet->header.sequenceNumber = rtp_header.header.sequenceNumber;
@@ -678,8 +682,8 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
         PacketBuffer::DeleteAllPackets(&packet_list);
         return kDtmfInsertError;
       }
-      delete current_packet;
       it = packet_list.erase(it);
+      delete current_packet;
     } else {
       ++it;
     }
@@ -708,6 +712,8 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
         decoder_database_->GetDecoderInfo(packet->header.payloadType);
     if (!info) {
       LOG(LS_WARNING) << "SplitAudio unknown payload type";
+      PacketBuffer::DeleteAllPackets(&packet_list);
+      PacketBuffer::DeleteAllPackets(&parsed_packet_list);
       return kUnknownRtpPayloadType;
     }
 
@@ -724,7 +730,7 @@ int NetEqImpl::InsertPacketInternal(const WebRtcRTPHeader& rtp_header,
         RTC_DCHECK(result.frame);
         // Reuse the packet if possible.
         if (!packet) {
-          packet.reset(new Packet);
+          packet.reset(new (packet_pool_.get()) Packet);
           packet->header = original_header;
         }
         packet->header.timestamp = result.timestamp;
@@ -1779,6 +1785,7 @@ int NetEqImpl::DoRfc3389Cng(PacketList* packet_list, bool play_dtmf) {
     packet_list->pop_front();
     if (!decoder_database_->IsComfortNoise(packet->header.payloadType)) {
       LOG(LS_ERROR) << "Trying to decode non-CNG payload as CNG.";
+      delete packet;
       return kOtherError;
     }
     // UpdateParameters() deletes |packet|.
@@ -2112,6 +2119,9 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
     decoded_buffer_length_ = kMaxFrameSize * channels;
     decoded_buffer_.reset(new int16_t[decoded_buffer_length_]);
   }
+  memory_usage_.Set(
+      (sync_buffer_->Channels() * sync_buffer_->Size() +
+       decoded_buffer_length_) * sizeof(int16_t));
 
   // Create DecisionLogic if it is not created yet, then communicate new sample
   // rate and output size to DecisionLogic object.
@@ -26,6 +26,7 @@
 #include "webrtc/modules/audio_coding/neteq/rtcp.h"
 #include "webrtc/modules/audio_coding/neteq/statistics_calculator.h"
 #include "webrtc/modules/audio_coding/neteq/tick_timer.h"
+#include "webrtc/system_wrappers/include/memory_usage.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -46,6 +47,7 @@ class Merge;
 class NackTracker;
 class Normal;
 class PacketBuffer;
+class PacketPool;
 class RedPayloadSplitter;
 class PostDecodeVad;
 class PreemptiveExpand;
@@ -78,6 +80,7 @@ class NetEqImpl : public webrtc::NetEq {
         const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory);
     ~Dependencies();
 
+    std::unique_ptr<PacketPool> packet_pool;
     std::unique_ptr<TickTimer> tick_timer;
     std::unique_ptr<BufferLevelFilter> buffer_level_filter;
     std::unique_ptr<DecoderDatabase> decoder_database;
@@ -345,6 +348,9 @@ class NetEqImpl : public webrtc::NetEq {
   virtual void CreateDecisionLogic() EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
   rtc::CriticalSection crit_sect_;
+  // Declared first among the components, so that it is destroyed after all
+  // components that may hold packets allocated from it.
+  const std::unique_ptr<PacketPool> packet_pool_ GUARDED_BY(crit_sect_);
   const std::unique_ptr<TickTimer> tick_timer_ GUARDED_BY(crit_sect_);
   const std::unique_ptr<BufferLevelFilter> buffer_level_filter_
       GUARDED_BY(crit_sect_);
@@ -411,6 +417,8 @@ class NetEqImpl : public webrtc::NetEq {
       AudioFrame::kVadPassive;
   std::unique_ptr<TickTimer::Stopwatch> generated_noise_stopwatch_
       GUARDED_BY(crit_sect_);
+  // Reports the memory held by |sync_buffer_| and |decoded_buffer_|.
+  memory_usage::Tracker memory_usage_ GUARDED_BY(crit_sect_);
 
  private:
   RTC_DISALLOW_COPY_AND_ASSIGN(NetEqImpl);
@@ -10,10 +10,104 @@
 
 #include "webrtc/modules/audio_coding/neteq/packet.h"
 
+#include <cstddef>
+#include <new>
+
+#include "webrtc/modules/audio_coding/neteq/packet_pool.h"
+
 namespace webrtc {
 
+namespace {
+// Header in front of each Packet, recording the pool that the memory came from,
+// or null if it came from the heap. Aligned so that the Packet that follows it
+// is suitably aligned for any type.
+struct alignas(alignof(std::max_align_t)) PacketHeader {
+  PacketPool* pool;
+};
+}  // namespace
+
 Packet::Packet() = default;
 
 Packet::~Packet() = default;
 
+void* Packet::operator new(size_t size) {
+  return operator new(size, nullptr);
+}
+
+void* Packet::operator new(size_t size, PacketPool* packet_pool) {
+  const size_t block_size = sizeof(PacketHeader) + size;
+  PacketHeader* header = static_cast<PacketHeader*>(
+      packet_pool ? packet_pool->Allocate(block_size)
+                  : ::operator new(block_size));
+  header->pool = packet_pool;
+  return header + 1;
+}
+
+void Packet::operator delete(void* p) {
+  if (!p)
+    return;
+  PacketHeader* header = static_cast<PacketHeader*>(p) - 1;
+  if (header->pool) {
+    header->pool->Free(header);
+  } else {
+    ::operator delete(header);
+  }
+}
+
+void Packet::operator delete(void* p, PacketPool* /* packet_pool */) {
+  operator delete(p);
+}
+
+PacketList::PacketList() {
+  head_.prev_ = &head_;
+  head_.next_ = &head_;
+}
+
+PacketList::iterator PacketList::insert(iterator pos, Packet* packet) {
+  RTC_DCHECK(packet);
+  PacketListNode* next = pos.node_;
+  PacketListNode* prev = next->prev_;
+  packet->prev_ = prev;
+  packet->next_ = next;
+  prev->next_ = packet;
+  next->prev_ = packet;
+  ++size_;
+  return iterator(packet);
+}
+
+PacketList::iterator PacketList::erase(iterator pos) {
+  PacketListNode* node = pos.node_;
+  RTC_DCHECK(node != &head_);
+  RTC_DCHECK_GT(size_, 0u);
+  PacketListNode* next = node->next_;
+  node->prev_->next_ = next;
+  next->prev_ = node->prev_;
+  node->prev_ = nullptr;
+  node->next_ = nullptr;
+  --size_;
+  return iterator(next);
+}
+
+void PacketList::splice(iterator pos, PacketList* other) {
+  RTC_DCHECK(other != this);
+  if (other->empty())
+    return;
+  PacketListNode* first = other->head_.next_;
+  PacketListNode* last = other->head_.prev_;
+  PacketListNode* next = pos.node_;
+  PacketListNode* prev = next->prev_;
+  first->prev_ = prev;
+  prev->next_ = first;
+  last->next_ = next;
+  next->prev_ = last;
+  size_ += other->size_;
+  other->clear();
+}
+
+void PacketList::clear() {
+  head_.prev_ = &head_;
+  head_.next_ = &head_;
+  size_ = 0;
+}
+
 }  // namespace webrtc
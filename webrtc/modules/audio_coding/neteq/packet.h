@@ -11,10 +11,14 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_H_
 
-#include <list>
+#include <stddef.h>
+
+#include <iterator>
 #include <memory>
 
 #include "webrtc/base/buffer.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/audio_coding/codecs/audio_decoder.h"
 #include "webrtc/modules/audio_coding/neteq/tick_timer.h"
 #include "webrtc/modules/include/module_common_types.h"
@@ -22,8 +26,28 @@
 
 namespace webrtc {
 
+class PacketList;
+class PacketPool;
+
+// The links that make a Packet a member of a PacketList. They are stored in the
+// packet itself, so that adding a packet to a list does not allocate a list
+// node. A packet can be a member of at most one list at a time.
+class PacketListNode {
+ protected:
+  PacketListNode() = default;
+  ~PacketListNode() = default;
+
+ private:
+  friend class PacketList;
+
+  PacketListNode* prev_ = nullptr;
+  PacketListNode* next_ = nullptr;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketListNode);
+};
+
 // Struct for holding RTP packets.
-struct Packet {
+struct Packet : public PacketListNode {
   struct Priority {
     Priority() : codec_level(0), red_level(0) {}
     Priority(int codec_level, int red_level)
@@ -76,6 +100,15 @@ struct Packet {
   Packet();
   ~Packet();
 
+  // Packets created with |new (packet_pool) Packet| take their memory from
+  // |packet_pool|, and give it back to the pool when deleted. Packets created
+  // with a plain |new Packet| use the heap. Either kind is deleted with
+  // |delete|.
+  static void* operator new(size_t size);
+  static void* operator new(size_t size, PacketPool* packet_pool);
+  static void operator delete(void* p);
+  static void operator delete(void* p, PacketPool* packet_pool);
+
   // Comparison operators. Establish a packet ordering based on (1) timestamp,
   // (2) sequence number and (3) redundancy.
   // Timestamp and sequence numbers are compared taking wrap-around into
@@ -107,8 +140,106 @@ struct Packet {
   bool empty() const { return !frame && payload.empty(); }
 };
 
-// A list of packets.
-typedef std::list<Packet*> PacketList;
+// A list of packets. This is an intrusive list, with the parts of the
+// std::list<Packet*> interface that NetEq uses; adding and removing packets
+// never allocates. As with std::list<Packet*>, the list does not own the
+// packets, and destroying or clearing the list does not delete them. Since the
+// links are stored in the packets, a packet must be removed from its list
+// before it is deleted or added to another list.
+class PacketList {
+ public:
+  // Dereferencing an iterator yields the packet pointer by value, so a
+  // separate const_iterator type is not needed.
+  class iterator {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef Packet* value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Packet* const* pointer;
+    typedef Packet* reference;
+
+    iterator() : node_(nullptr) {}
+
+    Packet* operator*() const { return static_cast<Packet*>(node_); }
+    iterator& operator++() {
+      node_ = node_->next_;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator it = *this;
+      node_ = node_->next_;
+      return it;
+    }
+    iterator& operator--() {
+      node_ = node_->prev_;
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator it = *this;
+      node_ = node_->prev_;
+      return it;
+    }
+    bool operator==(const iterator& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const iterator& rhs) const { return node_ != rhs.node_; }
+
+   private:
+    friend class PacketList;
+    explicit iterator(PacketListNode* node) : node_(node) {}
+
+    PacketListNode* node_;
+  };
+  typedef iterator const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef reverse_iterator const_reverse_iterator;
+
+  PacketList();
+  ~PacketList() = default;
+
+  iterator begin() const { return iterator(head_.next_); }
+  iterator end() const { return iterator(head()); }
+  reverse_iterator rbegin() const { return reverse_iterator(end()); }
+  reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  Packet* front() const {
+    RTC_DCHECK(!empty());
+    return *begin();
+  }
+  Packet* back() const {
+    RTC_DCHECK(!empty());
+    return *iterator(head_.prev_);
+  }
+
+  void push_front(Packet* packet) { insert(begin(), packet); }
+  void push_back(Packet* packet) { insert(end(), packet); }
+  void pop_front() { erase(begin()); }
+  void pop_back() { erase(iterator(head_.prev_)); }
+
+  // Inserts |packet| before |pos|, and returns an iterator to it.
+  iterator insert(iterator pos, Packet* packet);
+
+  // Removes the packet at |pos| from the list, without deleting it, and returns
+  // an iterator to the packet that followed it.
+  iterator erase(iterator pos);
+
+  // Moves all packets in |other| to this list, before |pos|.
+  void splice(iterator pos, PacketList* other);
+
+  // Empties the list, without deleting or touching the packets.
+  void clear();
+
+ private:
+  PacketListNode* head() const { return const_cast<PacketListNode*>(&head_); }
+
+  // Sentinel node; |head_.next_| is the first packet and |head_.prev_| the
+  // last.
+  PacketListNode head_;
+  size_t size_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketList);
+};
 
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_H_
@@ -112,8 +112,9 @@ int PacketBuffer::InsertPacket(Packet* packet) {
   PacketList::iterator it = rit.base();
   if (it != buffer_.end() &&
       packet->header.timestamp == (*it)->header.timestamp) {
-    delete *it;
+    Packet* replaced_packet = *it;
     it = buffer_.erase(it);
+    delete replaced_packet;
   }
   buffer_.insert(it, packet);  // Insert the packet at that position.
 
@@ -127,7 +128,10 @@ int PacketBuffer::InsertPacketList(
     rtc::Optional<uint8_t>* current_cng_rtp_payload_type) {
   bool flushed = false;
   while (!packet_list->empty()) {
+    // Remove the packet from |packet_list| before inserting it; a packet can
+    // only be in one list at a time.
     Packet* packet = packet_list->front();
+    packet_list->pop_front();
     if (decoder_database.IsComfortNoise(packet->header.payloadType)) {
       if (*current_cng_rtp_payload_type &&
           **current_cng_rtp_payload_type != packet->header.payloadType) {
@@ -154,7 +158,6 @@ int PacketBuffer::InsertPacketList(
           rtc::Optional<uint8_t>(packet->header.payloadType);
     }
     int return_val = InsertPacket(packet);
-    packet_list->pop_front();
     if (return_val == kFlushed) {
       // The buffer flushed, but this is not an error. We can still continue.
       flushed = true;
@@ -267,8 +270,8 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
   for (auto it = buffer_.begin(); it != buffer_.end(); /* */) {
     Packet* packet = *it;
     if (packet->header.payloadType == payload_type) {
-      delete packet;
       it = buffer_.erase(it);
+      delete packet;
     } else {
       ++it;
     }
@@ -304,8 +307,8 @@ bool PacketBuffer::DeleteFirstPacket(PacketList* packet_list) {
     return false;
   }
   Packet* first_packet = packet_list->front();
-  delete first_packet;
   packet_list->pop_front();
+  delete first_packet;
   return true;
 }
 
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/neteq/packet_pool.h"
+
+#include <new>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+PacketPool::PacketPool() = default;
+
+PacketPool::~PacketPool() {
+  RTC_DCHECK_EQ(0u, num_blocks_in_use_);
+  while (free_blocks_) {
+    FreeBlock* block = free_blocks_;
+    free_blocks_ = block->next;
+    ::operator delete(block);
+  }
+}
+
+void* PacketPool::Allocate(size_t size) {
+  RTC_DCHECK_GE(size, sizeof(FreeBlock));
+  RTC_DCHECK(block_size_ == 0 || block_size_ == size);
+  block_size_ = size;
+  ++num_blocks_in_use_;
+  if (!free_blocks_)
+    return ::operator new(size);
+  FreeBlock* block = free_blocks_;
+  free_blocks_ = block->next;
+  --num_free_blocks_;
+  return block;
+}
+
+void PacketPool::Free(void* block) {
+  RTC_DCHECK(block);
+  RTC_DCHECK_GT(num_blocks_in_use_, 0u);
+  --num_blocks_in_use_;
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = free_blocks_;
+  free_blocks_ = free_block;
+  ++num_free_blocks_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_POOL_H_
+#define WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_POOL_H_
+
+#include <stddef.h>
+
+#include "webrtc/base/constructormagic.h"
+
+namespace webrtc {
+
+// A pool of equally sized memory blocks for Packet objects; see
+// Packet::operator new. Freed blocks are kept for reuse rather than returned
+// to the heap, so once the pool has grown to the peak number of packets in
+// flight, creating and deleting packets does not allocate. Each NetEq instance
+// owns one pool. The class is not thread-safe, and the pool must outlive all
+// packets allocated from it.
+class PacketPool {
+ public:
+  PacketPool();
+  ~PacketPool();
+
+  // Returns a block of |size| bytes. All calls must use the same |size|.
+  void* Allocate(size_t size);
+
+  // Returns |block|, obtained from Allocate(), to the pool.
+  void Free(void* block);
+
+  // The number of blocks currently handed out by Allocate(), and the number of
+  // free blocks kept for reuse.
+  size_t num_blocks_in_use() const { return num_blocks_in_use_; }
+  size_t num_free_blocks() const { return num_free_blocks_; }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  size_t block_size_ = 0;
+  FreeBlock* free_blocks_ = nullptr;
+  size_t num_free_blocks_ = 0;
+  size_t num_blocks_in_use_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PacketPool);
+};
+
+}  // namespace webrtc
+#endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_POOL_H_
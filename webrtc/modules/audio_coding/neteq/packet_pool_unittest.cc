@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Unit tests for PacketPool and PacketList.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "webrtc/modules/audio_coding/neteq/packet.h"
+#include "webrtc/modules/audio_coding/neteq/packet_pool.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+Packet* CreatePacket(PacketPool* pool, uint16_t sequence_number) {
+  Packet* packet = new (pool) Packet;
+  packet->header.sequenceNumber = sequence_number;
+  return packet;
+}
+
+std::vector<uint16_t> SequenceNumbers(const PacketList& list) {
+  std::vector<uint16_t> sequence_numbers;
+  for (const Packet* packet : list) {
+    sequence_numbers.push_back(packet->header.sequenceNumber);
+  }
+  return sequence_numbers;
+}
+
+void DeleteAll(PacketList* list) {
+  while (!list->empty()) {
+    Packet* packet = list->front();
+    list->pop_front();
+    delete packet;
+  }
+}
+
+}  // namespace
+
+TEST(PacketPool, ReusesFreedBlocks) {
+  PacketPool pool;
+  Packet* packet1 = new (&pool) Packet;
+  Packet* packet2 = new (&pool) Packet;
+  EXPECT_EQ(2u, pool.num_blocks_in_use());
+  EXPECT_EQ(0u, pool.num_free_blocks());
+
+  delete packet1;
+  EXPECT_EQ(1u, pool.num_blocks_in_use());
+  EXPECT_EQ(1u, pool.num_free_blocks());
+
+  // The freed block is handed out again.
+  Packet* packet3 = new (&pool) Packet;
+  EXPECT_EQ(packet1, packet3);  // Compare pointer addresses.
+  EXPECT_EQ(2u, pool.num_blocks_in_use());
+  EXPECT_EQ(0u, pool.num_free_blocks());
+
+  delete packet2;
+  delete packet3;
+  EXPECT_EQ(0u, pool.num_blocks_in_use());
+  EXPECT_EQ(2u, pool.num_free_blocks());
+}
+
+TEST(PacketPool, HeapAndPooledPackets) {
+  PacketPool pool;
+  std::unique_ptr<Packet> heap_packet(new Packet);
+  std::unique_ptr<Packet> pooled_packet(new (&pool) Packet);
+  EXPECT_EQ(1u, pool.num_blocks_in_use());
+  heap_packet.reset();
+  EXPECT_EQ(1u, pool.num_blocks_in_use());
+  pooled_packet.reset();
+  EXPECT_EQ(0u, pool.num_blocks_in_use());
+  EXPECT_EQ(1u, pool.num_free_blocks());
+}
+
+TEST(PacketList, PushAndPop) {
+  PacketPool pool;
+  PacketList list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(0u, list.size());
+  EXPECT_TRUE(list.begin() == list.end());
+
+  list.push_back(CreatePacket(&pool, 2));
+  list.push_back(CreatePacket(&pool, 3));
+  list.push_front(CreatePacket(&pool, 1));
+  EXPECT_FALSE(list.empty());
+  EXPECT_EQ(3u, list.size());
+  EXPECT_EQ(1, list.front()->header.sequenceNumber);
+  EXPECT_EQ(3, list.back()->header.sequenceNumber);
+  EXPECT_EQ(std::vector<uint16_t>({1, 2, 3}), SequenceNumbers(list));
+
+  Packet* packet = list.back();
+  list.pop_back();
+  delete packet;
+  packet = list.front();
+  list.pop_front();
+  delete packet;
+  EXPECT_EQ(std::vector<uint16_t>({2}), SequenceNumbers(list));
+
+  DeleteAll(&list);
+  EXPECT_TRUE(list.empty());
+  EXPECT_EQ(0u, pool.num_blocks_in_use());
+}
+
+TEST(PacketList, InsertAndErase) {
+  PacketPool pool;
+  PacketList list;
+  list.push_back(CreatePacket(&pool, 1));
+  list.push_back(CreatePacket(&pool, 3));
+
+  PacketList::iterator it = list.begin();
+  ++it;
+  it = list.insert(it, CreatePacket(&pool, 2));
+  EXPECT_EQ(2, (*it)->header.sequenceNumber);
+  EXPECT_EQ(std::vector<uint16_t>({1, 2, 3}), SequenceNumbers(list));
+
+  Packet* packet = *it;
+  it = list.erase(it);
+  delete packet;
+  EXPECT_EQ(3, (*it)->header.sequenceNumber);
+  EXPECT_EQ(2u, list.size());
+  EXPECT_EQ(std::vector<uint16_t>({1, 3}), SequenceNumbers(list));
+
+  DeleteAll(&list);
+}
+
+TEST(PacketList, ReverseIteration) {
+  PacketPool pool;
+  PacketList list;
+  for (uint16_t i = 1; i <= 4; ++i) {
+    list.push_back(CreatePacket(&pool, i));
+  }
+
+  // Find the last packet with an even sequence number, from the back, and
+  // insert a new packet after it, like PacketBuffer::InsertPacket() does.
+  PacketList::reverse_iterator rit =
+      std::find_if(list.rbegin(), list.rend(), [](const Packet* packet) {
+        return packet->header.sequenceNumber % 2 == 0 &&
+               packet->header.sequenceNumber < 4;
+      });
+  ASSERT_TRUE(rit != list.rend());
+  EXPECT_EQ(2, (*rit)->header.sequenceNumber);
+  list.insert(rit.base(), CreatePacket(&pool, 10));
+  EXPECT_EQ(std::vector<uint16_t>({1, 2, 10, 3, 4}), SequenceNumbers(list));
+
+  DeleteAll(&list);
+}
+
+TEST(PacketList, Splice) {
+  PacketPool pool;
+  PacketList list;
+  list.push_back(CreatePacket(&pool, 1));
+  list.push_back(CreatePacket(&pool, 4));
+  PacketList other;
+  other.push_back(CreatePacket(&pool, 2));
+  other.push_back(CreatePacket(&pool, 3));
+
+  list.splice(++list.begin(), &other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(4u, list.size());
+  EXPECT_EQ(std::vector<uint16_t>({1, 2, 3, 4}), SequenceNumbers(list));
+
+  // Splicing an empty list is a no-op.
+  list.splice(list.end(), &other);
+  EXPECT_EQ(4u, list.size());
+
+  // A packet removed from one list can be added to another.
+  Packet* packet = list.front();
+  list.pop_front();
+  other.push_back(packet);
+  EXPECT_EQ(std::vector<uint16_t>({2, 3, 4}), SequenceNumbers(list));
+  EXPECT_EQ(std::vector<uint16_t>({1}), SequenceNumbers(other));
+
+  DeleteAll(&list);
+  DeleteAll(&other);
+  EXPECT_EQ(0u, pool.num_blocks_in_use());
+}
+
+}  // namespace webrtc
@@ -105,7 +105,7 @@ bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
           break;
         }
 
-        Packet* new_packet = new Packet;
+        Packet* new_packet = new (packet_pool_) Packet;
         new_packet->header = red_packet->header;
         new_packet->header.timestamp = new_header.timestamp;
         new_packet->header.payloadType = new_header.payload_type;
@@ -117,18 +117,18 @@ bool RedPayloadSplitter::SplitRed(PacketList* packet_list) {
       }
       // Insert new packets into original list, before the element pointed to by
       // iterator |it|.
-      packet_list->splice(it, new_packets, new_packets.begin(),
-                          new_packets.end());
+      packet_list->splice(it, &new_packets);
     } else {
       LOG(LS_WARNING) << "SplitRed too many blocks: " << new_headers.size();
       ret = false;
     }
-    // Delete old packet payload.
-    delete (*it);
     // Remove |it| from the packet list. This operation effectively moves the
     // iterator |it| to the next packet in the list. Thus, we do not have to
     // increment it manually.
+    Packet* old_packet = *it;
     it = packet_list->erase(it);
+    // Delete old packet payload.
+    delete old_packet;
   }
   return ret;
 }
@@ -150,11 +150,12 @@ int RedPayloadSplitter::CheckRedPayloads(
         if (this_payload_type != main_payload_type) {
           // We do not allow redundant payloads of a different type.
           // Discard this payload.
-          delete (*it);
+          Packet* discarded_packet = *it;
           // Remove |it| from the packet list. This operation effectively
           // moves the iterator |it| to the next packet in the list. Thus, we
           // do not have to increment it manually.
           it = packet_list->erase(it);
+          delete discarded_packet;
           ++num_deleted_packets;
           continue;
         }
@@ -18,13 +18,18 @@ namespace webrtc {
 
 // Forward declarations.
 class DecoderDatabase;
+class PacketPool;
 
 // This class handles splitting of RED payloads into smaller parts.
 // Codec-specific packet splitting can be performed by
 // AudioDecoder::ParsePayload.
 class RedPayloadSplitter {
  public:
-  RedPayloadSplitter() {}
+  RedPayloadSplitter() : RedPayloadSplitter(nullptr) {}
+
+  // The split packets are allocated from |packet_pool|, if not null.
+  explicit RedPayloadSplitter(PacketPool* packet_pool)
+      : packet_pool_(packet_pool) {}
 
   virtual ~RedPayloadSplitter() {}
 
@@ -44,6 +49,8 @@ class RedPayloadSplitter {
                                const DecoderDatabase& decoder_database);
 
  private:
+  PacketPool* const packet_pool_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(RedPayloadSplitter);
 };
 
@@ -192,8 +192,8 @@ TEST(RedPayloadSplitter, OnePacketTwoPayloads) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber,
                kBaseTimestamp, 1, true);
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check second packet.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
@@ -223,8 +223,8 @@ TEST(RedPayloadSplitter, TwoPacketsOnePayload) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp, 0, true);
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check second packet.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber + 1,
@@ -261,32 +261,32 @@ TEST(RedPayloadSplitter, TwoPacketsThreePayloads) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[2], kSequenceNumber,
                kBaseTimestamp, 2, {0, 0});
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check second packet, A2.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber,
                kBaseTimestamp - kTimestampOffset, 1, {0, 1});
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check third packet, A3.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp - 2 * kTimestampOffset, 0, {0, 2});
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check fourth packet, B1.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[2], kSequenceNumber + 1,
                kBaseTimestamp + kTimestampOffset, 2, {0, 0});
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check fifth packet, B2.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[1], kSequenceNumber + 1,
                kBaseTimestamp, 1, {0, 1});
-  delete packet;
   packet_list.pop_front();
+  delete packet;
   // Check sixth packet, B3.
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber + 1,
@@ -329,8 +329,8 @@ TEST(RedPayloadSplitter, CheckRedPayloads) {
   for (int i = 0; i <= 2; ++i) {
     Packet* packet = packet_list.front();
     VerifyPacket(packet, 10, i, kSequenceNumber, kBaseTimestamp, 0, true);
-    delete packet;
     packet_list.pop_front();
+    delete packet;
   }
   EXPECT_TRUE(packet_list.empty());
 }
@@ -354,8 +354,8 @@ TEST(RedPayloadSplitter, WrongPayloadLength) {
   packet = packet_list.front();
   VerifyPacket(packet, kPayloadLength, payload_types[0], kSequenceNumber,
                kBaseTimestamp - 2 * kTimestampOffset, 0, {0, 2});
-  delete packet;
   packet_list.pop_front();
+  delete packet;
 }
 
 }  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/audio_coding/neteq/delay_manager.h"
+#include "webrtc/modules/audio_coding/neteq/delay_peak_detector.h"
+#include "webrtc/modules/audio_coding/neteq/tick_timer.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumPackets = 1000000;
+constexpr int kSampleRateHz = 16000;
+constexpr int kFrameSizeMs = 20;
+constexpr uint32_t kTsIncrement = kFrameSizeMs * kSampleRateHz / 1000;
+
+// Measures the time spent in DelayManager::Update() per packet, for packets
+// arriving with some jitter.
+void RunUpdateTest(bool streaming_mode, const std::string& trace) {
+  TickTimer tick_timer(kFrameSizeMs / 2);
+  DelayPeakDetector peak_detector(&tick_timer);
+  DelayManager delay_manager(200, &peak_detector, &tick_timer);
+  delay_manager.SetPacketAudioLength(kFrameSizeMs);
+  delay_manager.set_streaming_mode(streaming_mode);
+  Random random(0x5eed);
+  uint16_t sequence_number = 0;
+  uint32_t timestamp = 0;
+  int64_t update_time_ns = 0;
+
+  for (int i = 0; i < kNumPackets; ++i) {
+    // Mostly regular arrivals, with some jitter.
+    const int num_ticks = random.Rand<float>() < 0.8f ? 2 : random.Rand(0, 6);
+    for (int tick = 0; tick < num_ticks; ++tick) {
+      tick_timer.Increment();
+    }
+    const int64_t start_ns = rtc::TimeNanos();
+    ASSERT_EQ(0,
+              delay_manager.Update(sequence_number, timestamp, kSampleRateHz));
+    update_time_ns += rtc::TimeNanos() - start_ns;
+    ++sequence_number;
+    timestamp += kTsIncrement;
+  }
+
+  test::PrintResult("delay_manager_update_time", "", trace,
+                    static_cast<size_t>(update_time_ns / kNumPackets), "ns",
+                    true);
+}
+
+}  // namespace
+
+TEST(DelayManagerPerformanceTest, Update) {
+  RunUpdateTest(false, "normal");
+}
+
+TEST(DelayManagerPerformanceTest, UpdateStreamingMode) {
+  RunUpdateTest(true, "streaming");
+}
+
+}  // namespace webrtc
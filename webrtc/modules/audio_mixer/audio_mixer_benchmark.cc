@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_mixer/audio_mixer_impl.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const int kSampleRateHz = 48000;
+
+// Hands out the same 10 ms of speech on every call, as a receive stream with a
+// steady jitter buffer does.
+class SpeechSource : public AudioMixer::Source {
+ public:
+  SpeechSource(int amplitude, Random* random) {
+    frame_.sample_rate_hz_ = kSampleRateHz;
+    frame_.num_channels_ = 1;
+    frame_.samples_per_channel_ = kSampleRateHz / 100;
+    frame_.vad_activity_ = AudioFrame::kVadActive;
+    frame_.speech_type_ = AudioFrame::kNormalSpeech;
+    for (size_t i = 0; i < frame_.samples_per_channel_; ++i)
+      frame_.data_[i] = random->Rand(-amplitude, amplitude);
+  }
+
+  AudioFrameWithInfo GetAudioFrameWithInfo(int32_t id,
+                                           int sample_rate_hz) override {
+    // The mixer may modify the frame it gets.
+    output_frame_.CopyFrom(frame_);
+    return {&output_frame_, AudioFrameInfo::kNormal};
+  }
+
+ private:
+  AudioFrame frame_;
+  AudioFrame output_frame_;
+};
+
+// Mixes 10 ms from |num_sources| speaking sources per run, of which the
+// mixer picks the loudest.
+void RunMixerBenchmark(int num_sources, const std::string& name) {
+  std::unique_ptr<AudioMixerImpl> mixer(AudioMixerImpl::Create(1));
+  Random random(0x313);
+  std::vector<std::unique_ptr<SpeechSource>> sources;
+  for (int i = 0; i < num_sources; ++i) {
+    sources.emplace_back(new SpeechSource(1000 + 500 * i, &random));
+    ASSERT_EQ(0, mixer->SetMixabilityStatus(sources.back().get(), true));
+  }
+  AudioFrame mixed_frame;
+  test::ReportBenchmark(
+      test::RunBenchmark(name, test::BenchmarkOptions(), [&] {
+        mixer->Mix(kSampleRateHz, 1, &mixed_frame);
+      }));
+  EXPECT_EQ(static_cast<size_t>(kSampleRateHz / 100),
+            mixed_frame.samples_per_channel_);
+}
+
+}  // namespace
+
+TEST(AudioMixerBenchmark, ThreeSources) {
+  RunMixerBenchmark(3, "audio_mixer_3_sources");
+}
+
+TEST(AudioMixerBenchmark, TenSources) {
+  RunMixerBenchmark(10, "audio_mixer_10_sources");
+}
+
+}  // namespace webrtc
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+void FillFrame(int sample_rate_hz, Random* random, AudioFrame* frame) {
+  frame->sample_rate_hz_ = sample_rate_hz;
+  frame->samples_per_channel_ = sample_rate_hz / 100;
+  frame->num_channels_ = 1;
+  for (size_t i = 0; i < frame->samples_per_channel_; ++i)
+    frame->data_[i] = random->Rand(-8000, 8000);
+}
+
+// Processes 10 ms of capture and render audio per run, with the submodules
+// that are enabled by default on desktop (|mobile| false) or on mobile.
+void RunApmBenchmark(int sample_rate_hz, bool mobile, const std::string& name) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create());
+  ASSERT_EQ(AudioProcessing::kNoError, apm->high_pass_filter()->Enable(true));
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->Enable(true));
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_mode(
+                mobile ? GainControl::kFixedDigital
+                       : GainControl::kAdaptiveAnalog));
+  ASSERT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+  if (mobile) {
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->echo_control_mobile()->Enable(true));
+  } else {
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->echo_cancellation()->Enable(true));
+  }
+
+  Random random(0xa9);
+  AudioFrame capture_frame;
+  AudioFrame render_frame;
+  FillFrame(sample_rate_hz, &random, &capture_frame);
+  FillFrame(sample_rate_hz, &random, &render_frame);
+  AudioFrame frame;
+  bool ok = true;
+  test::ReportBenchmark(
+      test::RunBenchmark(name, test::BenchmarkOptions(), [&] {
+        frame.CopyFrom(render_frame);
+        ok &= apm->ProcessReverseStream(&frame) == AudioProcessing::kNoError;
+        frame.CopyFrom(capture_frame);
+        apm->set_stream_delay_ms(50);
+        if (!mobile)
+          apm->gain_control()->set_stream_analog_level(128);
+        ok &= apm->ProcessStream(&frame) == AudioProcessing::kNoError;
+      }));
+  EXPECT_TRUE(ok);
+}
+
+}  // namespace
+
+TEST(AudioProcessingBenchmark, Desktop48kHz) {
+  RunApmBenchmark(48000, false, "apm_process_desktop_48khz");
+}
+
+TEST(AudioProcessingBenchmark, Mobile16kHz) {
+  RunApmBenchmark(16000, true, "apm_process_mobile_16khz");
+}
+
+}  // namespace webrtc
@@ -16,6 +16,7 @@
 #include "webrtc/modules/audio_processing/aec/aec_core.h"
 #include "webrtc/modules/audio_processing/aec/echo_cancellation.h"
 #include "webrtc/modules/audio_processing/audio_buffer.h"
+#include "webrtc/system_wrappers/include/memory_usage.h"
 
 namespace webrtc {
 
@@ -76,9 +77,12 @@ struct EchoCancellationImpl::StreamProperties {
 
 class EchoCancellationImpl::Canceller {
  public:
-  Canceller() {
+  Canceller() : memory_usage_(memory_usage::kAudioProcessing) {
     state_ = WebRtcAec_Create();
     RTC_DCHECK(state_);
+    // The filter and spectra held by the AEC dominate its memory use; the
+    // ring buffers it allocates separately are left out.
+    memory_usage_.Set(sizeof(Aec) + sizeof(AecCore));
   }
 
   ~Canceller() {
@@ -98,6 +102,7 @@ class EchoCancellationImpl::Canceller {
 
  private:
   void* state_;
+  memory_usage::Tracker memory_usage_;
 };
 
 EchoCancellationImpl::EchoCancellationImpl(rtc::CriticalSection* crit_render,
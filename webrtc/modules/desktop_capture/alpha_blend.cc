@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/alpha_blend.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/typedefs.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WEBRTC_IOS)
+#include "webrtc/modules/desktop_capture/alpha_blend_sse2.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#define WEBRTC_ALPHA_BLEND_SSE2
+#endif
+
+namespace webrtc {
+
+namespace {
+
+void AlphaBlendRow_C(uint8_t* dest, const uint8_t* src, int width) {
+  for (int x = 0; x < width; ++x) {
+    uint32_t base_alpha = 255 - src[x * DesktopFrame::kBytesPerPixel + 3];
+    if (base_alpha == 255) {
+      continue;
+    } else if (base_alpha == 0) {
+      memcpy(dest + x * DesktopFrame::kBytesPerPixel,
+             src + x * DesktopFrame::kBytesPerPixel,
+             DesktopFrame::kBytesPerPixel);
+    } else {
+      dest[x * DesktopFrame::kBytesPerPixel] =
+          dest[x * DesktopFrame::kBytesPerPixel] * base_alpha / 255 +
+          src[x * DesktopFrame::kBytesPerPixel];
+      dest[x * DesktopFrame::kBytesPerPixel + 1] =
+          dest[x * DesktopFrame::kBytesPerPixel + 1] * base_alpha / 255 +
+          src[x * DesktopFrame::kBytesPerPixel + 1];
+      dest[x * DesktopFrame::kBytesPerPixel + 2] =
+          dest[x * DesktopFrame::kBytesPerPixel + 2] * base_alpha / 255 +
+          src[x * DesktopFrame::kBytesPerPixel + 2];
+    }
+  }
+}
+
+// Blends as many pixels of the row as the SIMD version handles, and returns
+// their number.
+int AlphaBlendRow_SIMD(uint8_t* dest, const uint8_t* src, int width) {
+#if defined(WEBRTC_ALPHA_BLEND_SSE2)
+  static const bool have_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+  if (have_sse2) {
+    const int simd_width = width & ~3;
+    AlphaBlendRow_SSE2(dest, src, simd_width);
+    return simd_width;
+  }
+#endif
+  return 0;
+}
+
+}  // namespace
+
+void AlphaBlend(uint8_t* dest,
+                int dest_stride,
+                const uint8_t* src,
+                int src_stride,
+                const DesktopSize& size,
+                uint8_t* backup,
+                int backup_stride) {
+  const int row_bytes = size.width() * DesktopFrame::kBytesPerPixel;
+  for (int y = 0; y < size.height(); ++y) {
+    if (backup) {
+      // The row stays in the cache for blending.
+      memcpy(backup, dest, row_bytes);
+      backup += backup_stride;
+    }
+    const int done = AlphaBlendRow_SIMD(dest, src, size.width());
+    AlphaBlendRow_C(dest + done * DesktopFrame::kBytesPerPixel,
+                    src + done * DesktopFrame::kBytesPerPixel,
+                    size.width() - done);
+    src += src_stride;
+    dest += dest_stride;
+  }
+}
+
+DesktopRect GetVisibleRect(const DesktopFrame& image) {
+  int left = image.size().width();
+  int top = image.size().height();
+  int right = 0;
+  int bottom = 0;
+  for (int y = 0; y < image.size().height(); ++y) {
+    const uint8_t* row = image.data() + y * image.stride();
+    for (int x = 0; x < image.size().width(); ++x) {
+      if (row[x * DesktopFrame::kBytesPerPixel + 3] != 0) {
+        left = std::min(left, x);
+        right = std::max(right, x + 1);
+        top = std::min(top, y);
+        bottom = y + 1;
+      }
+    }
+  }
+  if (left >= right)
+    return DesktopRect();
+  return DesktopRect::MakeLTRB(left, top, right, bottom);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_H_
+#define WEBRTC_MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_H_
+
+#include <stdint.h>
+
+#include "webrtc/modules/desktop_capture/desktop_geometry.h"
+
+namespace webrtc {
+
+class DesktopFrame;
+
+// Blends |size| pixels of |src| into |dest|. The source image must be
+// pre-multiplied with the alpha channel. The destination is assumed to be
+// opaque, its alpha channel is left as it is except where the source is
+// opaque. If |backup| is not null, the original content of |dest| is copied
+// there row by row while blending, so it can be restored later.
+void AlphaBlend(uint8_t* dest,
+                int dest_stride,
+                const uint8_t* src,
+                int src_stride,
+                const DesktopSize& size,
+                uint8_t* backup,
+                int backup_stride);
+
+// Returns the smallest rectangle of |image| that contains all of its pixels
+// that are not fully transparent, i.e. the only part of |image| AlphaBlend()
+// changes the destination with.
+DesktopRect GetVisibleRect(const DesktopFrame& image);
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_H_
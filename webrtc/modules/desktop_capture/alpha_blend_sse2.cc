@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/alpha_blend_sse2.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <mmintrin.h>
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+// Returns |dest| * |alpha| / 255 + |src| for 16-bit lanes holding 8-bit
+// values, truncated to 8 bits like the C version. The division is exact for
+// all products of two 8-bit values: x / 255 == (x + 1 + (x >> 8)) >> 8.
+inline __m128i BlendChannels(__m128i dest, __m128i alpha, __m128i src) {
+  const __m128i product = _mm_mullo_epi16(dest, alpha);
+  const __m128i quotient = _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(product, _mm_set1_epi16(1)),
+                    _mm_srli_epi16(product, 8)),
+      8);
+  return _mm_and_si128(_mm_add_epi16(quotient, src), _mm_set1_epi16(0xff));
+}
+
+// Returns |a| where |mask| is set and |b| elsewhere.
+inline __m128i Select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+}  // namespace
+
+extern void AlphaBlendRow_SSE2(uint8_t* dest, const uint8_t* src, int width) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i max_alpha = _mm_set1_epi32(255);
+  const __m128i alpha_channel =
+      _mm_set1_epi32(static_cast<int32_t>(0xff000000));
+  __m128i* d = reinterpret_cast<__m128i*>(dest);
+  const __m128i* s = reinterpret_cast<const __m128i*>(src);
+
+  // Four pixels at a time.
+  for (int x = 0; x < width; x += 4, ++d, ++s) {
+    const __m128i src_pixels = _mm_loadu_si128(s);
+    const __m128i src_alpha = _mm_srli_epi32(src_pixels, 24);
+
+    // Fully transparent source pixels leave the destination unchanged, and
+    // fully opaque ones replace it.
+    const __m128i transparent = _mm_cmpeq_epi32(src_alpha, zero);
+    if (_mm_movemask_epi8(transparent) == 0xffff)
+      continue;
+    const __m128i opaque = _mm_cmpeq_epi32(src_alpha, max_alpha);
+    if (_mm_movemask_epi8(opaque) == 0xffff) {
+      _mm_storeu_si128(d, src_pixels);
+      continue;
+    }
+
+    const __m128i dest_pixels = _mm_loadu_si128(d);
+
+    // Spread 255 - alpha of each pixel over the four 16-bit lanes of its
+    // channels.
+    __m128i base_alpha = _mm_sub_epi32(max_alpha, src_alpha);
+    base_alpha = _mm_or_si128(base_alpha, _mm_slli_epi32(base_alpha, 16));
+    const __m128i low = BlendChannels(
+        _mm_unpacklo_epi8(dest_pixels, zero),
+        _mm_unpacklo_epi32(base_alpha, base_alpha),
+        _mm_unpacklo_epi8(src_pixels, zero));
+    const __m128i high = BlendChannels(
+        _mm_unpackhi_epi8(dest_pixels, zero),
+        _mm_unpackhi_epi32(base_alpha, base_alpha),
+        _mm_unpackhi_epi8(src_pixels, zero));
+    __m128i result = _mm_packus_epi16(low, high);
+
+    // The C version doesn't blend the alpha channel.
+    result = Select(alpha_channel, dest_pixels, result);
+    result = Select(opaque, src_pixels, result);
+    result = Select(transparent, dest_pixels, result);
+    _mm_storeu_si128(d, result);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/alpha_blend.h"
+
+#include <string.h>
+
+#include <memory>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+uint32_t GetPixel(const DesktopFrame& frame, int x, int y) {
+  uint32_t pixel;
+  memcpy(&pixel, frame.GetFrameDataAtPos(DesktopVector(x, y)), sizeof(pixel));
+  return pixel;
+}
+
+void SetPixel(DesktopFrame* frame, int x, int y, uint32_t pixel) {
+  memcpy(frame->GetFrameDataAtPos(DesktopVector(x, y)), &pixel,
+         sizeof(pixel));
+}
+
+// Reference implementation of blending one pixel.
+uint32_t BlendPixel(uint32_t dest, uint32_t src) {
+  const uint32_t base_alpha = 255 - (src >> 24);
+  if (base_alpha == 255)
+    return dest;
+  if (base_alpha == 0)
+    return src;
+  uint32_t result = dest & 0xff000000;
+  for (int shift = 0; shift < 24; shift += 8) {
+    const uint32_t channel =
+        ((dest >> shift) & 0xff) * base_alpha / 255 + ((src >> shift) & 0xff);
+    result |= (channel & 0xff) << shift;
+  }
+  return result;
+}
+
+// Returns a random premultiplied pixel. A quarter of them are fully
+// transparent and a quarter fully opaque.
+uint32_t RandomCursorPixel(Random* random) {
+  uint32_t alpha;
+  switch (random->Rand(0, 3)) {
+    case 0:
+      alpha = 0;
+      break;
+    case 1:
+      alpha = 255;
+      break;
+    default:
+      alpha = random->Rand(1, 254);
+  }
+  uint32_t pixel = alpha << 24;
+  for (int shift = 0; shift < 24; shift += 8) {
+    pixel |= random->Rand(0u, alpha) << shift;
+  }
+  return pixel;
+}
+
+}  // namespace
+
+TEST(AlphaBlendTest, MatchesReference) {
+  Random random(0x1234);
+  for (int width = 1; width <= 20; ++width) {
+    const DesktopSize size(width, 7);
+    BasicDesktopFrame dest(size);
+    BasicDesktopFrame src(size);
+    BasicDesktopFrame expected(size);
+    for (int y = 0; y < size.height(); ++y) {
+      for (int x = 0; x < size.width(); ++x) {
+        const uint32_t dest_pixel = random.Rand<uint32_t>() | 0xff000000;
+        const uint32_t src_pixel = RandomCursorPixel(&random);
+        SetPixel(&dest, x, y, dest_pixel);
+        SetPixel(&src, x, y, src_pixel);
+        SetPixel(&expected, x, y, BlendPixel(dest_pixel, src_pixel));
+      }
+    }
+
+    BasicDesktopFrame original(size);
+    original.CopyPixelsFrom(dest, DesktopVector(), DesktopRect::MakeSize(size));
+    BasicDesktopFrame backup(size);
+    AlphaBlend(dest.data(), dest.stride(), src.data(), src.stride(), size,
+               backup.data(), backup.stride());
+
+    for (int y = 0; y < size.height(); ++y) {
+      for (int x = 0; x < size.width(); ++x) {
+        ASSERT_EQ(GetPixel(expected, x, y), GetPixel(dest, x, y))
+            << "width " << width << " at " << x << ", " << y;
+        ASSERT_EQ(GetPixel(original, x, y), GetPixel(backup, x, y));
+      }
+    }
+  }
+}
+
+TEST(AlphaBlendTest, DestinationAlphaIsKept) {
+  const DesktopSize size(8, 1);
+  BasicDesktopFrame dest(size);
+  BasicDesktopFrame src(size);
+  for (int x = 0; x < size.width(); ++x) {
+    SetPixel(&dest, x, 0, 0x00404040);
+    SetPixel(&src, x, 0, 0x80202020);
+  }
+  SetPixel(&src, 7, 0, 0xff102030);
+  AlphaBlend(dest.data(), dest.stride(), src.data(), src.stride(), size,
+             nullptr, 0);
+  for (int x = 0; x < 7; ++x) {
+    EXPECT_EQ(BlendPixel(0x00404040, 0x80202020), GetPixel(dest, x, 0));
+    EXPECT_EQ(0u, GetPixel(dest, x, 0) >> 24);
+  }
+  EXPECT_EQ(0xff102030, GetPixel(dest, 7, 0));
+}
+
+TEST(AlphaBlendTest, GetVisibleRect) {
+  BasicDesktopFrame image(DesktopSize(32, 32));
+  memset(image.data(), 0, image.stride() * image.size().height());
+  EXPECT_TRUE(GetVisibleRect(image).is_empty());
+
+  // Color without alpha doesn't count.
+  SetPixel(&image, 20, 20, 0x00ffffff);
+  EXPECT_TRUE(GetVisibleRect(image).is_empty());
+
+  SetPixel(&image, 3, 5, 0x01000000);
+  SetPixel(&image, 10, 2, 0xffffffff);
+  EXPECT_TRUE(DesktopRect::MakeLTRB(3, 2, 11, 6).equals(GetVisibleRect(image)));
+}
+
+}  // namespace webrtc
@@ -10,9 +10,8 @@
 
 #include "webrtc/modules/desktop_capture/desktop_and_cursor_composer.h"
 
-#include <string.h>
-
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/desktop_capture/alpha_blend.h"
 #include "webrtc/modules/desktop_capture/desktop_capturer.h"
 #include "webrtc/modules/desktop_capture/desktop_frame.h"
 #include "webrtc/modules/desktop_capture/mouse_cursor.h"
@@ -21,44 +20,15 @@ namespace webrtc {
 
 namespace {
 
-// Helper function that blends one image into another. Source image must be
-// pre-multiplied with the alpha channel. Destination is assumed to be opaque.
-void AlphaBlend(uint8_t* dest, int dest_stride,
-                const uint8_t* src, int src_stride,
-                const DesktopSize& size) {
-  for (int y = 0; y < size.height(); ++y) {
-    for (int x = 0; x < size.width(); ++x) {
-      uint32_t base_alpha = 255 - src[x * DesktopFrame::kBytesPerPixel + 3];
-      if (base_alpha == 255) {
-        continue;
-      } else if (base_alpha == 0) {
-        memcpy(dest + x * DesktopFrame::kBytesPerPixel,
-               src + x * DesktopFrame::kBytesPerPixel,
-               DesktopFrame::kBytesPerPixel);
-      } else {
-        dest[x * DesktopFrame::kBytesPerPixel] =
-            dest[x * DesktopFrame::kBytesPerPixel] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel];
-        dest[x * DesktopFrame::kBytesPerPixel + 1] =
-            dest[x * DesktopFrame::kBytesPerPixel + 1] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel + 1];
-        dest[x * DesktopFrame::kBytesPerPixel + 2] =
-            dest[x * DesktopFrame::kBytesPerPixel + 2] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel + 2];
-      }
-    }
-    src += src_stride;
-    dest += dest_stride;
-  }
-}
-
 // DesktopFrame wrapper that draws mouse on a frame and restores original
 // content before releasing the underlying frame.
 class DesktopFrameWithCursor : public DesktopFrame {
  public:
-  // Takes ownership of |frame|.
+  // Takes ownership of |frame|. |visible_rect| is the part of the cursor image
+  // that is not fully transparent, only that part is drawn.
   DesktopFrameWithCursor(std::unique_ptr<DesktopFrame> frame,
                          const MouseCursor& cursor,
+                         const DesktopRect& visible_rect,
                          const DesktopVector& position);
   virtual ~DesktopFrameWithCursor();
 
@@ -74,6 +44,7 @@ class DesktopFrameWithCursor : public DesktopFrame {
 DesktopFrameWithCursor::DesktopFrameWithCursor(
     std::unique_ptr<DesktopFrame> frame,
     const MouseCursor& cursor,
+    const DesktopRect& visible_rect,
     const DesktopVector& position)
     : DesktopFrame(frame->size(),
                    frame->stride(),
@@ -85,31 +56,28 @@ DesktopFrameWithCursor::DesktopFrameWithCursor(
   original_frame_ = std::move(frame);
 
   DesktopVector image_pos = position.subtract(cursor.hotspot());
-  DesktopRect target_rect = DesktopRect::MakeSize(cursor.image()->size());
+  DesktopRect target_rect = visible_rect;
   target_rect.Translate(image_pos);
-  DesktopVector target_origin = target_rect.top_left();
   target_rect.IntersectWith(DesktopRect::MakeSize(size()));
 
   if (target_rect.is_empty())
     return;
 
-  // Copy original screen content under cursor to |restore_frame_|.
+  // Blit the cursor, and save the original screen content under it to
+  // |restore_frame_| in the same pass.
   restore_position_ = target_rect.top_left();
   restore_frame_.reset(new BasicDesktopFrame(target_rect.size()));
-  restore_frame_->CopyPixelsFrom(*this, target_rect.top_left(),
-                                 DesktopRect::MakeSize(restore_frame_->size()));
-
-  // Blit the cursor.
   uint8_t* target_rect_data = reinterpret_cast<uint8_t*>(data()) +
                               target_rect.top() * stride() +
                               target_rect.left() * DesktopFrame::kBytesPerPixel;
-  DesktopVector origin_shift = target_rect.top_left().subtract(target_origin);
+  DesktopVector origin_shift = target_rect.top_left().subtract(image_pos);
   AlphaBlend(target_rect_data, stride(),
              cursor.image()->data() +
                  origin_shift.y() * cursor.image()->stride() +
                  origin_shift.x() * DesktopFrame::kBytesPerPixel,
              cursor.image()->stride(),
-             target_rect.size());
+             target_rect.size(),
+             restore_frame_->data(), restore_frame_->stride());
 }
 
 DesktopFrameWithCursor::~DesktopFrameWithCursor() {
@@ -127,8 +95,15 @@ DesktopFrameWithCursor::~DesktopFrameWithCursor() {
 DesktopAndCursorComposer::DesktopAndCursorComposer(
     DesktopCapturer* desktop_capturer,
     MouseCursorMonitor* mouse_monitor)
+    : DesktopAndCursorComposer(desktop_capturer, mouse_monitor, nullptr) {}
+
+DesktopAndCursorComposer::DesktopAndCursorComposer(
+    DesktopCapturer* desktop_capturer,
+    MouseCursorMonitor* mouse_monitor,
+    MouseCursorMonitor::Callback* cursor_callback)
     : desktop_capturer_(desktop_capturer),
-      mouse_monitor_(mouse_monitor) {
+      mouse_monitor_(mouse_monitor),
+      cursor_callback_(cursor_callback) {
 }
 
 DesktopAndCursorComposer::~DesktopAndCursorComposer() {}
@@ -160,19 +135,28 @@ void DesktopAndCursorComposer::OnCaptureResult(
     std::unique_ptr<DesktopFrame> frame) {
   if (frame && cursor_ && cursor_state_ == MouseCursorMonitor::INSIDE) {
     frame = std::unique_ptr<DesktopFrameWithCursor>(new DesktopFrameWithCursor(
-        std::move(frame), *cursor_, cursor_position_));
+        std::move(frame), *cursor_, cursor_visible_rect_, cursor_position_));
   }
 
   callback_->OnCaptureResult(result, std::move(frame));
 }
 
 void DesktopAndCursorComposer::OnMouseCursor(MouseCursor* cursor) {
+  if (cursor_callback_) {
+    cursor_callback_->OnMouseCursor(cursor);
+    return;
+  }
   cursor_.reset(cursor);
+  cursor_visible_rect_ = GetVisibleRect(*cursor_->image());
 }
 
 void DesktopAndCursorComposer::OnMouseCursorPosition(
     MouseCursorMonitor::CursorState state,
     const DesktopVector& position) {
+  if (cursor_callback_) {
+    cursor_callback_->OnMouseCursorPosition(state, position);
+    return;
+  }
   cursor_state_ = state;
   cursor_position_ = position;
 }
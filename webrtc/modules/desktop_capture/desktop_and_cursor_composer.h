@@ -31,6 +31,16 @@ class DesktopAndCursorComposer : public DesktopCapturer,
   // of both arguments.
   DesktopAndCursorComposer(DesktopCapturer* desktop_capturer,
                       MouseCursorMonitor* mouse_monitor);
+
+  // Creates a new composer that doesn't render the cursor into the frames.
+  // Instead, the cursor shape and position captured by |mouse_monitor| are
+  // passed on to |cursor_callback| before the frame they belong to is
+  // delivered, so that the cursor can be sent as metadata and drawn by the
+  // receiver. Takes ownership of |desktop_capturer| and |mouse_monitor|, but
+  // not of |cursor_callback|, which must outlive the composer.
+  DesktopAndCursorComposer(DesktopCapturer* desktop_capturer,
+                           MouseCursorMonitor* mouse_monitor,
+                           MouseCursorMonitor::Callback* cursor_callback);
   virtual ~DesktopAndCursorComposer();
 
   // DesktopCapturer interface.
@@ -54,8 +64,11 @@ class DesktopAndCursorComposer : public DesktopCapturer,
   std::unique_ptr<MouseCursorMonitor> mouse_monitor_;
 
   DesktopCapturer::Callback* callback_;
+  MouseCursorMonitor::Callback* const cursor_callback_;
 
   std::unique_ptr<MouseCursor> cursor_;
+  // The part of |cursor_| that is not fully transparent.
+  DesktopRect cursor_visible_rect_;
   MouseCursorMonitor::CursorState cursor_state_;
   DesktopVector cursor_position_;
 
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/desktop_capture/desktop_and_cursor_composer.h"
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/mouse_cursor.h"
+#include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumFrames = 20000;
+const int kScreenWidth = 1920;
+const int kScreenHeight = 1080;
+
+// Returns the same frame every time, as screen capturers reuse their buffers.
+class FakeScreenCapturer : public DesktopCapturer {
+ public:
+  FakeScreenCapturer()
+      : frame_(SharedDesktopFrame::Wrap(std::unique_ptr<DesktopFrame>(
+            new BasicDesktopFrame(DesktopSize(kScreenWidth, kScreenHeight))))) {
+    memset(frame_->data(), 0x80, frame_->stride() * kScreenHeight);
+  }
+
+  void Start(Callback* callback) override { callback_ = callback; }
+
+  void Capture(const DesktopRegion& region) override {
+    callback_->OnCaptureResult(Result::SUCCESS, frame_->Share());
+  }
+
+ private:
+  Callback* callback_ = nullptr;
+  std::unique_ptr<SharedDesktopFrame> frame_;
+};
+
+// Reports a |size| x |size| cursor shaped like an arrow, i.e. with its lower
+// left half visible, at a random position in every frame.
+class FakeMouseMonitor : public MouseCursorMonitor {
+ public:
+  explicit FakeMouseMonitor(int size) : size_(size), random_(0x5eed) {}
+
+  void Init(Callback* callback, Mode mode) override { callback_ = callback; }
+
+  void Capture() override {
+    if (!sent_shape_) {
+      std::unique_ptr<DesktopFrame> image(
+          new BasicDesktopFrame(DesktopSize(size_, size_)));
+      for (int y = 0; y < size_; ++y) {
+        uint32_t* row = reinterpret_cast<uint32_t*>(
+            image->data() + y * image->stride());
+        for (int x = 0; x < size_; ++x) {
+          // Opaque inside, an anti-aliased edge and transparent outside.
+          row[x] = x < y ? 0xff000000 : (x == y ? 0x80404040 : 0);
+        }
+      }
+      callback_->OnMouseCursor(new MouseCursor(image.release(),
+                                               DesktopVector()));
+      sent_shape_ = true;
+    }
+    callback_->OnMouseCursorPosition(
+        INSIDE, DesktopVector(random_.Rand(0, kScreenWidth - 1),
+                              random_.Rand(0, kScreenHeight - 1)));
+  }
+
+ private:
+  const int size_;
+  Random random_;
+  Callback* callback_ = nullptr;
+  bool sent_shape_ = false;
+};
+
+class FrameCallback : public DesktopCapturer::Callback,
+                      public MouseCursorMonitor::Callback {
+ public:
+  int frames() const { return frames_; }
+
+  // DesktopCapturer::Callback interface.
+  void OnCaptureResult(DesktopCapturer::Result result,
+                       std::unique_ptr<DesktopFrame> frame) override {
+    if (frame)
+      ++frames_;
+  }
+
+  // MouseCursorMonitor::Callback interface.
+  void OnMouseCursor(MouseCursor* cursor) override { delete cursor; }
+  void OnMouseCursorPosition(MouseCursorMonitor::CursorState state,
+                             const DesktopVector& position) override {}
+
+ private:
+  int frames_ = 0;
+};
+
+// Measures the time spent per frame on capturing a frame and drawing a
+// |cursor_size| x |cursor_size| cursor on it, and on restoring the frame when
+// it is released. With |metadata| set, the cursor is only passed on.
+void RunComposerTest(int cursor_size, bool metadata) {
+  FrameCallback callback;
+  DesktopAndCursorComposer composer(
+      new FakeScreenCapturer(), new FakeMouseMonitor(cursor_size),
+      metadata ? &callback : nullptr);
+  composer.Start(&callback);
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumFrames; ++i) {
+    composer.Capture(DesktopRegion());
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  EXPECT_EQ(kNumFrames, callback.frames());
+
+  test::PrintResult("cursor_composition_time",
+                    metadata ? "_metadata" : "_composite",
+                    std::to_string(cursor_size) + "px",
+                    static_cast<size_t>(elapsed_ns / kNumFrames), "ns", true);
+}
+
+}  // namespace
+
+TEST(DesktopAndCursorComposerPerformanceTest, Composite) {
+  for (int size : {16, 32, 64, 128, 256}) {
+    RunComposerTest(size, false);
+  }
+}
+
+TEST(DesktopAndCursorComposerPerformanceTest, Metadata) {
+  RunComposerTest(32, true);
+}
+
+}  // namespace webrtc
@@ -248,6 +248,59 @@ TEST_F(DesktopAndCursorComposerTest, Blend) {
   }
 }
 
+class FakeCursorCallback : public MouseCursorMonitor::Callback {
+ public:
+  void OnMouseCursor(MouseCursor* cursor) override {
+    cursor_.reset(cursor);
+  }
+
+  void OnMouseCursorPosition(MouseCursorMonitor::CursorState state,
+                             const DesktopVector& position) override {
+    state_ = state;
+    position_ = position;
+  }
+
+  std::unique_ptr<MouseCursor> cursor_;
+  MouseCursorMonitor::CursorState state_ = MouseCursorMonitor::OUTSIDE;
+  DesktopVector position_;
+};
+
+// Verify that the cursor is passed on instead of drawn when a cursor callback
+// is given.
+TEST(DesktopAndCursorComposerMetadataTest, CursorAsMetadata) {
+  FakeScreenCapturer* fake_screen = new FakeScreenCapturer();
+  FakeMouseMonitor* fake_cursor = new FakeMouseMonitor();
+  FakeCursorCallback cursor_callback;
+  DesktopAndCursorComposer composer(fake_screen, fake_cursor,
+                                    &cursor_callback);
+
+  class FrameCallback : public DesktopCapturer::Callback {
+   public:
+    void OnCaptureResult(DesktopCapturer::Result result,
+                         std::unique_ptr<DesktopFrame> frame) override {
+      frame_ = std::move(frame);
+    }
+    std::unique_ptr<DesktopFrame> frame_;
+  } frame_callback;
+  composer.Start(&frame_callback);
+
+  const DesktopVector hotspot(2, 5);
+  const DesktopVector pos(50, 50);
+  fake_cursor->SetHotspot(hotspot);
+  fake_cursor->SetState(MouseCursorMonitor::INSIDE, pos);
+  fake_screen->SetNextFrame(std::unique_ptr<DesktopFrame>(CreateTestFrame()));
+
+  composer.Capture(DesktopRegion());
+
+  ASSERT_TRUE(frame_callback.frame_);
+  VerifyFrame(*frame_callback.frame_, MouseCursorMonitor::OUTSIDE,
+              DesktopVector());
+  ASSERT_TRUE(cursor_callback.cursor_);
+  EXPECT_TRUE(hotspot.equals(cursor_callback.cursor_->hotspot()));
+  EXPECT_EQ(MouseCursorMonitor::INSIDE, cursor_callback.state_);
+  EXPECT_TRUE(pos.equals(cursor_callback.position_));
+}
+
 }  // namespace
 
 }  // namespace webrtc
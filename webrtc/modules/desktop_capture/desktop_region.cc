@@ -76,6 +76,20 @@ bool DesktopRegion::Equals(const DesktopRegion& region) const {
   return it2 == region.rows_.end();
 }
 
+DesktopRect DesktopRegion::GetBoundingRect() const {
+  if (rows_.empty())
+    return DesktopRect();
+
+  int32_t left = rows_.begin()->second->spans.front().left;
+  int32_t right = rows_.begin()->second->spans.back().right;
+  for (Rows::const_iterator it = rows_.begin(); it != rows_.end(); ++it) {
+    left = std::min(left, it->second->spans.front().left);
+    right = std::max(right, it->second->spans.back().right);
+  }
+  return DesktopRect::MakeLTRB(left, rows_.begin()->second->top, right,
+                               rows_.rbegin()->second->bottom);
+}
+
 void DesktopRegion::Clear() {
   for (Rows::iterator row = rows_.begin(); row != rows_.end(); ++row) {
     delete row->second;
@@ -102,6 +102,9 @@ class DesktopRegion {
 
   bool Equals(const DesktopRegion& region) const;
 
+  // Returns the smallest rectangle that contains the whole region.
+  DesktopRect GetBoundingRect() const;
+
   // Reset the region to be empty.
   void Clear();
 
@@ -134,6 +137,9 @@ class DesktopRegion {
   void Swap(DesktopRegion* region);
 
  private:
+  // TiledDesktopRegion::ToDesktopRegion() builds the rows directly.
+  friend class TiledDesktopRegion;
+
   // Comparison functions used for std::lower_bound(). Compare left or right
   // edges withs a given |value|.
   static bool CompareSpanLeft(const RowSpan& r, int32_t value);
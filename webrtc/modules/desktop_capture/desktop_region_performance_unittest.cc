@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
+#include "webrtc/modules/desktop_capture/screen_capturer_helper.h"
+#include "webrtc/modules/desktop_capture/tiled_desktop_region.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFrames = 500;
+constexpr int kScreenWidth = 1920;
+constexpr int kScreenHeight = 1080;
+// The grid ScreenCapturerX11 expands its damage to.
+constexpr int kLogGridSize = 4;
+// The block size of the differ.
+constexpr int kBlockSize = 32;
+
+typedef std::vector<DesktopRect> Damage;
+
+// Damage from typing: glyph-sized rectangles along a few lines of text, plus
+// the caret.
+Damage TypingDamage(Random* random) {
+  Damage damage;
+  for (int line = 0; line < 4; ++line) {
+    const int top = 100 + random->Rand(0, 40) * 20;
+    for (int i = 0; i < 40; ++i) {
+      damage.push_back(DesktopRect::MakeXYWH(200 + random->Rand(0, 150) * 9,
+                                             top, 9, 18));
+    }
+  }
+  damage.push_back(DesktopRect::MakeXYWH(random->Rand(200, 1500),
+                                         random->Rand(100, 900), 2, 18));
+  return damage;
+}
+
+// Damage from a video playing in a window, as reported by the differ: the
+// changed 32x32 blocks of a 854x480 window.
+Damage VideoDamage(Random* random) {
+  Damage damage;
+  const DesktopRect window = DesktopRect::MakeXYWH(333, 211, 854, 480);
+  for (int y = window.top(); y < window.bottom(); y += kBlockSize) {
+    for (int x = window.left(); x < window.right(); x += kBlockSize) {
+      if (random->Rand<float>() < 0.6f) {
+        DesktopRect block = DesktopRect::MakeXYWH(x, y, kBlockSize, kBlockSize);
+        block.IntersectWith(window);
+        damage.push_back(block);
+      }
+    }
+  }
+  return damage;
+}
+
+// Small rectangles all over the screen, e.g. from animated widgets.
+Damage ScatteredDamage(Random* random) {
+  Damage damage;
+  for (int i = 0; i < 300; ++i) {
+    damage.push_back(DesktopRect::MakeXYWH(random->Rand(0, kScreenWidth - 20),
+                                           random->Rand(0, kScreenHeight - 20),
+                                           random->Rand(1, 20),
+                                           random->Rand(1, 20)));
+  }
+  return damage;
+}
+
+// Measures the time spent per frame on accumulating |damage| and expanding it
+// to the grid, using DesktopRegion alone and with the help of a
+// TiledDesktopRegion.
+void RunDamageTest(Damage (*generate)(Random*), const std::string& trace) {
+  Random random(0x5eed);
+  std::vector<Damage> frames;
+  for (int i = 0; i < kNumFrames; ++i) {
+    frames.push_back(generate(&random));
+  }
+  const DesktopRect screen = DesktopRect::MakeWH(kScreenWidth, kScreenHeight);
+  const int grid_size = 1 << kLogGridSize;
+  const int grid_mask = ~(grid_size - 1);
+
+  // Accumulate the damage in a DesktopRegion and expand each rectangle to the
+  // grid, as ScreenCapturerHelper did before it used TiledDesktopRegion.
+  int64_t region_time_ns = 0;
+  size_t region_rects = 0;
+  for (const Damage& damage : frames) {
+    const int64_t start_ns = rtc::TimeNanos();
+    DesktopRegion invalid;
+    invalid.AddRects(damage.data(), static_cast<int>(damage.size()));
+    DesktopRegion expanded;
+    for (DesktopRegion::Iterator it(invalid); !it.IsAtEnd(); it.Advance()) {
+      expanded.AddRect(DesktopRect::MakeLTRB(
+          it.rect().left() & grid_mask, it.rect().top() & grid_mask,
+          (it.rect().right() + grid_size - 1) & grid_mask,
+          (it.rect().bottom() + grid_size - 1) & grid_mask));
+    }
+    expanded.IntersectWith(screen);
+    region_time_ns += rtc::TimeNanos() - start_ns;
+    for (DesktopRegion::Iterator it(expanded); !it.IsAtEnd(); it.Advance())
+      ++region_rects;
+  }
+
+  // The same with ScreenCapturerHelper::ExpandToGrid().
+  int64_t helper_time_ns = 0;
+  size_t helper_rects = 0;
+  for (const Damage& damage : frames) {
+    const int64_t start_ns = rtc::TimeNanos();
+    DesktopRegion invalid;
+    invalid.AddRects(damage.data(), static_cast<int>(damage.size()));
+    DesktopRegion expanded;
+    ScreenCapturerHelper::ExpandToGrid(invalid, kLogGridSize, &expanded);
+    expanded.IntersectWith(screen);
+    helper_time_ns += rtc::TimeNanos() - start_ns;
+    for (DesktopRegion::Iterator it(expanded); !it.IsAtEnd(); it.Advance())
+      ++helper_rects;
+  }
+
+  // Accumulate straight into a TiledDesktopRegion of the screen.
+  int64_t tiled_time_ns = 0;
+  size_t tiled_rects = 0;
+  TiledDesktopRegion tiles(screen, kLogGridSize);
+  for (const Damage& damage : frames) {
+    const int64_t start_ns = rtc::TimeNanos();
+    tiles.Clear();
+    tiles.AddRects(damage.data(), static_cast<int>(damage.size()));
+    DesktopRegion expanded;
+    tiles.ToDesktopRegion(&expanded);
+    tiled_time_ns += rtc::TimeNanos() - start_ns;
+    for (DesktopRegion::Iterator it(expanded); !it.IsAtEnd(); it.Advance())
+      ++tiled_rects;
+  }
+
+  // All three produce the same, canonical region.
+  EXPECT_EQ(region_rects, helper_rects);
+  EXPECT_EQ(region_rects, tiled_rects);
+
+  test::PrintResult("desktop_region_damage_time", "_desktop_region", trace,
+                    static_cast<size_t>(region_time_ns / 1000 / kNumFrames),
+                    "us", true);
+  test::PrintResult("desktop_region_damage_time", "_expand_to_grid", trace,
+                    static_cast<size_t>(helper_time_ns / 1000 / kNumFrames),
+                    "us", true);
+  test::PrintResult("desktop_region_damage_time", "_tiled", trace,
+                    static_cast<size_t>(tiled_time_ns / 1000 / kNumFrames),
+                    "us", true);
+}
+
+}  // namespace
+
+TEST(DesktopRegionPerformanceTest, TypingDamage) {
+  RunDamageTest(&TypingDamage, "typing");
+}
+
+TEST(DesktopRegionPerformanceTest, VideoDamage) {
+  RunDamageTest(&VideoDamage, "video");
+}
+
+TEST(DesktopRegionPerformanceTest, ScatteredDamage) {
+  RunDamageTest(&ScatteredDamage, "scattered");
+}
+
+}  // namespace webrtc
@@ -370,6 +370,20 @@ TEST(DesktopRegionTest, Equals) {
   }
 }
 
+TEST(DesktopRegionTest, GetBoundingRect) {
+  DesktopRegion region;
+  EXPECT_TRUE(region.GetBoundingRect().is_empty());
+
+  region.AddRect(DesktopRect::MakeLTRB(10, 20, 30, 40));
+  EXPECT_TRUE(region.GetBoundingRect().equals(
+      DesktopRect::MakeLTRB(10, 20, 30, 40)));
+
+  region.AddRect(DesktopRect::MakeLTRB(-5, 30, 0, 35));
+  region.AddRect(DesktopRect::MakeLTRB(40, 50, 45, 60));
+  EXPECT_TRUE(region.GetBoundingRect().equals(
+      DesktopRect::MakeLTRB(-5, 20, 45, 60)));
+}
+
 TEST(DesktopRegionTest, Translate) {
   struct Case {
     int input_count;
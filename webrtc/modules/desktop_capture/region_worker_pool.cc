@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/region_worker_pool.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+
+namespace webrtc {
+
+// A thread that runs one task on one part of a region at a time.
+class RegionWorkerPool::Worker {
+ public:
+  Worker()
+      : thread_(&Worker::Run, this, "RegionWorker"),
+        wake_event_(false, false),
+        done_event_(false, false) {
+    thread_.Start();
+  }
+
+  ~Worker() {
+    stopping_ = true;
+    wake_event_.Set();
+    thread_.Stop();
+  }
+
+  // Starts running |task| on |part|. Both must stay alive until Wait()
+  // returns.
+  void Post(const Task* task, const DesktopRegion* part) {
+    task_ = task;
+    part_ = part;
+    wake_event_.Set();
+  }
+
+  // Waits for the task passed to Post() to finish.
+  void Wait() { done_event_.Wait(rtc::Event::kForever); }
+
+ private:
+  static bool Run(void* obj) { return static_cast<Worker*>(obj)->Process(); }
+
+  bool Process() {
+    wake_event_.Wait(rtc::Event::kForever);
+    if (stopping_)
+      return false;
+    (*task_)(*part_);
+    done_event_.Set();
+    return true;
+  }
+
+  rtc::PlatformThread thread_;
+  // The events also order the accesses to the fields below between the
+  // threads.
+  rtc::Event wake_event_;
+  rtc::Event done_event_;
+  bool stopping_ = false;
+  const Task* task_ = nullptr;
+  const DesktopRegion* part_ = nullptr;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+RegionWorkerPool::RegionWorkerPool(int max_parts, int min_part_area)
+    : max_parts_(std::max(max_parts, 1)),
+      min_part_area_(std::max(min_part_area, 1)) {
+  for (int i = 1; i < max_parts_; ++i) {
+    workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+  }
+}
+
+RegionWorkerPool::~RegionWorkerPool() {}
+
+void RegionWorkerPool::Run(const DesktopRegion& region, const Task& task) {
+  if (region.is_empty())
+    return;
+
+  if (workers_.empty()) {
+    task(region);
+    return;
+  }
+
+  std::vector<DesktopRegion> parts;
+  Split(region, max_parts_, min_part_area_, &parts);
+  RTC_DCHECK_LE(parts.size(), workers_.size() + 1);
+  for (size_t i = 1; i < parts.size(); ++i) {
+    workers_[i - 1]->Post(&task, &parts[i]);
+  }
+  task(parts[0]);
+  for (size_t i = 1; i < parts.size(); ++i) {
+    workers_[i - 1]->Wait();
+  }
+}
+
+// static
+void RegionWorkerPool::Split(const DesktopRegion& region,
+                             int max_parts,
+                             int min_part_area,
+                             std::vector<DesktopRegion>* parts) {
+  parts->clear();
+
+  int64_t area = 0;
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    area += static_cast<int64_t>(it.rect().width()) * it.rect().height();
+  }
+  if (area == 0)
+    return;
+
+  const int64_t count = std::max<int64_t>(
+      1, std::min<int64_t>(max_parts, area / std::max(min_part_area, 1)));
+  parts->resize(static_cast<size_t>(count));
+  if (count == 1) {
+    (*parts)[0] = region;
+    return;
+  }
+
+  // Fill the parts one after another, splitting rectangles along their rows
+  // where a part becomes full. The last part takes whatever is left.
+  const int64_t part_area = (area + count - 1) / count;
+  size_t index = 0;
+  int64_t filled = 0;
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    DesktopRect rect = it.rect();
+    while (!rect.is_empty()) {
+      if (index == parts->size() - 1) {
+        (*parts)[index].AddRect(rect);
+        break;
+      }
+
+      const int64_t rows =
+          (part_area - filled + rect.width() - 1) / rect.width();
+      if (rows >= rect.height()) {
+        (*parts)[index].AddRect(rect);
+        filled += static_cast<int64_t>(rect.width()) * rect.height();
+        if (filled >= part_area) {
+          ++index;
+          filled = 0;
+        }
+        break;
+      }
+
+      const int32_t split = rect.top() + static_cast<int32_t>(rows);
+      (*parts)[index].AddRect(
+          DesktopRect::MakeLTRB(rect.left(), rect.top(), rect.right(), split));
+      rect = DesktopRect::MakeLTRB(rect.left(), split, rect.right(),
+                                   rect.bottom());
+      ++index;
+      filled = 0;
+    }
+  }
+
+  // Rounding the parts up to whole rows may leave the last ones empty.
+  while (parts->back().is_empty()) {
+    parts->pop_back();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_DESKTOP_CAPTURE_REGION_WORKER_POOL_H_
+#define WEBRTC_MODULES_DESKTOP_CAPTURE_REGION_WORKER_POOL_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
+
+namespace webrtc {
+
+// Processes a DesktopRegion on a fixed set of threads: Run() splits the region
+// into disjoint parts of about the same area, hands them to the worker threads
+// and the calling thread, and returns once all of them have been processed.
+// Capturers use it to copy pixels of large frames in parallel.
+//
+// Run() must always be called on the same thread.
+class RegionWorkerPool {
+ public:
+  typedef std::function<void(const DesktopRegion& part)> Task;
+
+  // Creates a pool that splits regions into up to |max_parts| parts, using
+  // |max_parts| - 1 worker threads. Parts are never smaller than
+  // |min_part_area| pixels, so small regions are processed on the calling
+  // thread only.
+  RegionWorkerPool(int max_parts, int min_part_area);
+  ~RegionWorkerPool();
+
+  int max_parts() const { return max_parts_; }
+
+  // Runs |task| on disjoint parts of |region| that together cover it exactly,
+  // and returns when all of them are done. |task| is not called for an empty
+  // region.
+  void Run(const DesktopRegion& region, const Task& task);
+
+  // Splits |region| into at most |max_parts| disjoint parts of about the same
+  // area, none of them smaller than |min_part_area| unless |region| is. The
+  // rectangles of |region| are split along rows where needed.
+  static void Split(const DesktopRegion& region,
+                    int max_parts,
+                    int min_part_area,
+                    std::vector<DesktopRegion>* parts);
+
+ private:
+  class Worker;
+
+  const int max_parts_;
+  const int min_part_area_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RegionWorkerPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_DESKTOP_CAPTURE_REGION_WORKER_POOL_H_
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/region_worker_pool.h"
+
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+int64_t Area(const DesktopRegion& region) {
+  int64_t area = 0;
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    area += static_cast<int64_t>(it.rect().width()) * it.rect().height();
+  }
+  return area;
+}
+
+// Verifies that |parts| are disjoint and cover |region| exactly.
+void ExpectPartition(const DesktopRegion& region,
+                     const std::vector<DesktopRegion>& parts) {
+  DesktopRegion sum;
+  int64_t area = 0;
+  for (const DesktopRegion& part : parts) {
+    EXPECT_FALSE(part.is_empty());
+    sum.AddRegion(part);
+    area += Area(part);
+  }
+  EXPECT_TRUE(region.Equals(sum));
+  EXPECT_EQ(Area(region), area);
+}
+
+}  // namespace
+
+TEST(RegionWorkerPoolTest, SplitEmptyRegion) {
+  std::vector<DesktopRegion> parts;
+  RegionWorkerPool::Split(DesktopRegion(), 4, 1, &parts);
+  EXPECT_TRUE(parts.empty());
+}
+
+TEST(RegionWorkerPoolTest, SplitRect) {
+  const DesktopRegion region(DesktopRect::MakeWH(100, 100));
+  std::vector<DesktopRegion> parts;
+  RegionWorkerPool::Split(region, 4, 1, &parts);
+  ASSERT_EQ(4u, parts.size());
+  ExpectPartition(region, parts);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    EXPECT_TRUE(DesktopRegion(DesktopRect::MakeXYWH(0, i * 25, 100, 25))
+                    .Equals(parts[i]));
+  }
+}
+
+TEST(RegionWorkerPoolTest, SplitRespectsMinPartArea) {
+  const DesktopRegion region(DesktopRect::MakeWH(100, 100));
+  std::vector<DesktopRegion> parts;
+  RegionWorkerPool::Split(region, 4, 3000, &parts);
+  ASSERT_EQ(3u, parts.size());
+  ExpectPartition(region, parts);
+
+  RegionWorkerPool::Split(region, 4, 20000, &parts);
+  ASSERT_EQ(1u, parts.size());
+  EXPECT_TRUE(region.Equals(parts[0]));
+}
+
+TEST(RegionWorkerPoolTest, SplitFragmentedRegion) {
+  DesktopRegion region;
+  for (int i = 0; i < 50; ++i) {
+    region.AddRect(DesktopRect::MakeXYWH((i * 37) % 300, (i * 53) % 200,
+                                         1 + i % 17, 1 + i % 23));
+  }
+  std::vector<DesktopRegion> parts;
+  for (int max_parts = 1; max_parts < 8; ++max_parts) {
+    RegionWorkerPool::Split(region, max_parts, 1, &parts);
+    EXPECT_LE(parts.size(), static_cast<size_t>(max_parts));
+    ExpectPartition(region, parts);
+  }
+
+  // A single pixel can't be split.
+  region.SetRect(DesktopRect::MakeXYWH(5, 5, 1, 1));
+  RegionWorkerPool::Split(region, 4, 1, &parts);
+  ASSERT_EQ(1u, parts.size());
+  ExpectPartition(region, parts);
+}
+
+TEST(RegionWorkerPoolTest, RunCoversRegion) {
+  RegionWorkerPool pool(4, 100);
+  const DesktopRegion region(DesktopRect::MakeWH(200, 100));
+  for (int i = 0; i < 10; ++i) {
+    rtc::CriticalSection crit;
+    std::vector<DesktopRegion> parts;
+    pool.Run(region, [&crit, &parts](const DesktopRegion& part) {
+      rtc::CritScope lock(&crit);
+      parts.push_back(part);
+    });
+    EXPECT_EQ(4u, parts.size());
+    ExpectPartition(region, parts);
+  }
+
+  bool called = false;
+  pool.Run(DesktopRegion(),
+           [&called](const DesktopRegion& part) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+}  // namespace webrtc
@@ -13,12 +13,22 @@
 #include <assert.h>
 #include <algorithm>
 
+#include "webrtc/modules/desktop_capture/tiled_desktop_region.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
 namespace webrtc {
 
+namespace {
+
+// The largest number of grid cells for which a TiledDesktopRegion, which needs
+// one bit per cell, is used to expand or accumulate the invalid region.
+const int64_t kMaxGridCells = 1 << 22;
+
+}  // namespace
+
 ScreenCapturerHelper::ScreenCapturerHelper()
-    : invalid_region_lock_(RWLockWrapper::CreateRWLock()),
+    : invalid_tiles_(DesktopRect(), 0),
+      invalid_region_lock_(RWLockWrapper::CreateRWLock()),
       log_grid_size_(0) {
 }
 
@@ -28,39 +38,66 @@ ScreenCapturerHelper::~ScreenCapturerHelper() {
 void ScreenCapturerHelper::ClearInvalidRegion() {
   WriteLockScoped scoped_invalid_region_lock(*invalid_region_lock_);
   invalid_region_.Clear();
+  invalid_tiles_.Clear();
 }
 
 void ScreenCapturerHelper::InvalidateRegion(
     const DesktopRegion& invalid_region) {
   WriteLockScoped scoped_invalid_region_lock(*invalid_region_lock_);
-  invalid_region_.AddRegion(invalid_region);
+  if (!invalid_tiles_.area().is_empty() &&
+      invalid_tiles_.area().ContainsRect(invalid_region.GetBoundingRect())) {
+    invalid_tiles_.AddRegion(invalid_region);
+  } else {
+    invalid_region_.AddRegion(invalid_region);
+  }
 }
 
 void ScreenCapturerHelper::InvalidateScreen(const DesktopSize& size) {
   WriteLockScoped scoped_invalid_region_lock(*invalid_region_lock_);
-  invalid_region_.AddRect(DesktopRect::MakeSize(size));
+  const DesktopRect rect = DesktopRect::MakeSize(size);
+  if (!invalid_tiles_.area().is_empty() &&
+      invalid_tiles_.area().ContainsRect(rect)) {
+    invalid_tiles_.AddRect(rect);
+  } else {
+    invalid_region_.AddRect(rect);
+  }
 }
 
 void ScreenCapturerHelper::TakeInvalidRegion(
     DesktopRegion* invalid_region) {
   invalid_region->Clear();
 
+  DesktopRegion invalid_tiles;
   {
     WriteLockScoped scoped_invalid_region_lock(*invalid_region_lock_);
     invalid_region->Swap(&invalid_region_);
+    if (!invalid_tiles_.is_empty()) {
+      invalid_tiles_.ToDesktopRegion(&invalid_tiles);
+      invalid_tiles_.Clear();
+    }
   }
 
   if (log_grid_size_ > 0) {
-    DesktopRegion expanded_region;
-    ExpandToGrid(*invalid_region, log_grid_size_, &expanded_region);
-    expanded_region.Swap(invalid_region);
-
-    invalid_region->IntersectWith(DesktopRect::MakeSize(size_most_recent_));
+    if (!invalid_region->is_empty()) {
+      DesktopRegion expanded_region;
+      ExpandToGrid(*invalid_region, log_grid_size_, &expanded_region);
+      expanded_region.Swap(invalid_region);
+
+      invalid_region->IntersectWith(DesktopRect::MakeSize(size_most_recent_));
+    }
+
+    // The tiles are already on the grid and within the screen.
+    if (invalid_region->is_empty()) {
+      invalid_region->Swap(&invalid_tiles);
+    } else {
+      invalid_region->AddRegion(invalid_tiles);
+    }
   }
 }
 
 void ScreenCapturerHelper::SetLogGridSize(int log_grid_size) {
   log_grid_size_ = log_grid_size;
+  ResetInvalidTiles();
 }
 
 const DesktopSize& ScreenCapturerHelper::size_most_recent() const {
@@ -69,7 +106,29 @@ const DesktopSize& ScreenCapturerHelper::size_most_recent() const {
 
 void ScreenCapturerHelper::set_size_most_recent(
     const DesktopSize& size) {
+  if (size_most_recent_.equals(size))
+    return;
   size_most_recent_ = size;
+  ResetInvalidTiles();
+}
+
+void ScreenCapturerHelper::ResetInvalidTiles() {
+  WriteLockScoped scoped_invalid_region_lock(*invalid_region_lock_);
+  if (!invalid_tiles_.is_empty()) {
+    // The tiles are on the grid already, so they don't change if they are
+    // expanded to it again.
+    DesktopRegion invalid_tiles;
+    invalid_tiles_.ToDesktopRegion(&invalid_tiles);
+    invalid_region_.AddRegion(invalid_tiles);
+  }
+
+  DesktopRect area;
+  if (log_grid_size_ > 0 &&
+      ((static_cast<int64_t>(size_most_recent_.width()) >> log_grid_size_) *
+       (size_most_recent_.height() >> log_grid_size_)) <= kMaxGridCells) {
+    area = DesktopRect::MakeSize(size_most_recent_);
+  }
+  invalid_tiles_ = TiledDesktopRegion(area, std::max(log_grid_size_, 0));
 }
 
 // Returns the largest multiple of |n| that is <= |x|.
@@ -92,12 +151,37 @@ void ScreenCapturerHelper::ExpandToGrid(const DesktopRegion& region,
   int grid_size_mask = ~(grid_size - 1);
 
   result->Clear();
-  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
-    int left = DownToMultiple(it.rect().left(), grid_size_mask);
-    int right = UpToMultiple(it.rect().right(), grid_size, grid_size_mask);
-    int top = DownToMultiple(it.rect().top(), grid_size_mask);
-    int bottom = UpToMultiple(it.rect().bottom(), grid_size, grid_size_mask);
-    result->AddRect(DesktopRect::MakeLTRB(left, top, right, bottom));
+  if (region.is_empty())
+    return;
+
+  const DesktopRect region_bounds = region.GetBoundingRect();
+  const DesktopRect bounds = DesktopRect::MakeLTRB(
+      DownToMultiple(region_bounds.left(), grid_size_mask),
+      DownToMultiple(region_bounds.top(), grid_size_mask),
+      UpToMultiple(region_bounds.right(), grid_size, grid_size_mask),
+      UpToMultiple(region_bounds.bottom(), grid_size, grid_size_mask));
+
+  // Adding the expanded rectangles to |result| one by one merges rows on every
+  // call, which gets expensive when the damage is fragmented. Marking grid
+  // cells in a bitmap of the bounds and converting that once avoids this, as
+  // long as the bitmap stays reasonably small.
+  int64_t cells = (static_cast<int64_t>(bounds.width()) >> log_grid_size) *
+                  (bounds.height() >> log_grid_size);
+  if (cells <= kMaxGridCells) {
+    TiledDesktopRegion cells_region(bounds, log_grid_size);
+    cells_region.AddRegion(region);
+    cells_region.ToDesktopRegion(result);
+    return;
+  }
+
+  for (DesktopRegion::Iterator rect_it(region); !rect_it.IsAtEnd();
+       rect_it.Advance()) {
+    const DesktopRect& rect = rect_it.rect();
+    result->AddRect(DesktopRect::MakeLTRB(
+        DownToMultiple(rect.left(), grid_size_mask),
+        DownToMultiple(rect.top(), grid_size_mask),
+        UpToMultiple(rect.right(), grid_size, grid_size_mask),
+        UpToMultiple(rect.bottom(), grid_size, grid_size_mask)));
   }
 }
 
@@ -16,6 +16,7 @@
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/desktop_capture/desktop_geometry.h"
 #include "webrtc/modules/desktop_capture/desktop_region.h"
+#include "webrtc/modules/desktop_capture/tiled_desktop_region.h"
 #include "webrtc/system_wrappers/include/rw_lock_wrapper.h"
 
 namespace webrtc {
@@ -66,12 +67,22 @@ class ScreenCapturerHelper {
                            DesktopRegion* result);
 
  private:
+  // Moves the content of |invalid_tiles_| to |invalid_region_| and sets it up
+  // for the current grid and screen size.
+  void ResetInvalidTiles();
+
   // A region that has been manually invalidated (through InvalidateRegion).
   // These will be returned as dirty_region in the capture data during the next
   // capture.
   DesktopRegion invalid_region_;
 
-  // A lock protecting |invalid_region_| across threads.
+  // When the invalid region is expanded to a grid, the invalidated areas that
+  // lie within the most recently captured screen are accumulated here, one bit
+  // per grid cell, rather than in |invalid_region_|. This is much cheaper for
+  // fragmented damage.
+  TiledDesktopRegion invalid_tiles_;
+
+  // A lock protecting |invalid_region_| and |invalid_tiles_| across threads.
   std::unique_ptr<RWLockWrapper> invalid_region_lock_;
 
   // The size of the most recently captured screen.
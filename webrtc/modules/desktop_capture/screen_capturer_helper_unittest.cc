@@ -103,6 +103,28 @@ TEST_F(ScreenCapturerHelperTest, SetLogGridSize) {
   EXPECT_TRUE(DesktopRegion(DesktopRect::MakeXYWH(7, 7, 1, 1)).Equals(region));
 }
 
+TEST_F(ScreenCapturerHelperTest, InvalidateRegionAcrossSizeChange) {
+  capturer_helper_.SetLogGridSize(2);
+  capturer_helper_.set_size_most_recent(DesktopSize(10, 10));
+  capturer_helper_.InvalidateRegion(
+      DesktopRegion(DesktopRect::MakeXYWH(5, 5, 1, 1)));
+
+  // Damage outside of the old screen is kept as well.
+  capturer_helper_.InvalidateRegion(
+      DesktopRegion(DesktopRect::MakeXYWH(13, 1, 1, 1)));
+
+  capturer_helper_.set_size_most_recent(DesktopSize(20, 10));
+  capturer_helper_.InvalidateRegion(
+      DesktopRegion(DesktopRect::MakeXYWH(17, 9, 1, 1)));
+
+  DesktopRegion region;
+  capturer_helper_.TakeInvalidRegion(&region);
+  DesktopRegion expected(DesktopRect::MakeXYWH(4, 4, 4, 4));
+  expected.AddRect(DesktopRect::MakeXYWH(12, 0, 4, 4));
+  expected.AddRect(DesktopRect::MakeXYWH(16, 8, 4, 2));
+  EXPECT_TRUE(expected.Equals(region));
+}
+
 void TestExpandRegionToGrid(const DesktopRegion& region, int log_grid_size,
                             const DesktopRegion& expanded_region_expected) {
   DesktopRegion expanded_region1;
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/desktop_capture/desktop_capture_options.h"
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/rgba_color.h"
+#include "webrtc/modules/desktop_capture/screen_capturer.h"
+#include "webrtc/modules/desktop_capture/screen_drawer.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kNumFrames = 100;
+const int kRectsPerFrame = 20;
+const int kMaxRectSize = 200;
+
+class FrameCounter : public DesktopCapturer::Callback {
+ public:
+  FrameCounter() {}
+
+  int frames() const { return frames_; }
+  int failures() const { return failures_; }
+
+  // DesktopCapturer::Callback interface.
+  void OnCaptureResult(DesktopCapturer::Result result,
+                       std::unique_ptr<DesktopFrame> frame) override {
+    if (result == DesktopCapturer::Result::SUCCESS && frame) {
+      ++frames_;
+    } else {
+      ++failures_;
+    }
+  }
+
+ private:
+  int frames_ = 0;
+  int failures_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(FrameCounter);
+};
+
+// Draws |kRectsPerFrame| random rectangles with |drawer| before each capture
+// and reports the time spent in ScreenCapturer::Capture().
+void RunCaptureTest(bool use_update_notifications,
+                    bool detect_updated_region,
+                    const std::string& trace) {
+  std::unique_ptr<ScreenDrawer> drawer = ScreenDrawer::Create();
+  if (!drawer || drawer->DrawableRegion().is_empty()) {
+    LOG(LS_WARNING) << "No ScreenDrawer implementation for current platform.";
+    return;
+  }
+
+  DesktopCaptureOptions options(DesktopCaptureOptions::CreateDefault());
+  options.set_use_update_notifications(use_update_notifications);
+  options.set_detect_updated_region(detect_updated_region);
+  std::unique_ptr<ScreenCapturer> capturer(ScreenCapturer::Create(options));
+  ASSERT_TRUE(capturer);
+  FrameCounter counter;
+  capturer->Start(&counter);
+
+  // The first frame is always a full-screen capture.
+  drawer->Clear();
+  drawer->WaitForPendingDraws();
+  capturer->Capture(DesktopRegion());
+
+  const DesktopRect area = drawer->DrawableRegion();
+  Random random(0x5eed);
+  int64_t capture_time_ns = 0;
+  for (int i = 0; i < kNumFrames; ++i) {
+    for (int j = 0; j < kRectsPerFrame; ++j) {
+      const int left = random.Rand(area.left(), area.right() - 2);
+      const int top = random.Rand(area.top(), area.bottom() - 2);
+      drawer->DrawRectangle(
+          DesktopRect::MakeLTRB(
+              left, top,
+              random.Rand(left + 1, std::min(left + kMaxRectSize,
+                                             area.right())),
+              random.Rand(top + 1, std::min(top + kMaxRectSize,
+                                            area.bottom()))),
+          RgbaColor(random.Rand<uint8_t>(), random.Rand<uint8_t>(),
+                    random.Rand<uint8_t>()));
+    }
+    drawer->WaitForPendingDraws();
+
+    const int64_t start_ns = rtc::TimeNanos();
+    capturer->Capture(DesktopRegion());
+    capture_time_ns += rtc::TimeNanos() - start_ns;
+  }
+
+  EXPECT_EQ(kNumFrames + 1, counter.frames());
+  EXPECT_EQ(0, counter.failures());
+
+  test::PrintResult("screen_capture_time", "", trace,
+                    static_cast<size_t>(capture_time_ns /
+                                        rtc::kNumNanosecsPerMicrosec /
+                                        kNumFrames),
+                    "us", true);
+}
+
+}  // namespace
+
+// These tests draw on the screen, so they are only run manually with
+// --gtest_also_run_disabled_tests --gtest_filter=ScreenCapturerPerformanceTest.*
+TEST(ScreenCapturerPerformanceTest, DISABLED_Polling) {
+  RunCaptureTest(false, false, "polling");
+}
+
+TEST(ScreenCapturerPerformanceTest, DISABLED_PollingWithDiffer) {
+  RunCaptureTest(false, true, "polling_differ");
+}
+
+TEST(ScreenCapturerPerformanceTest, DISABLED_UpdateNotifications) {
+  RunCaptureTest(true, false, "notifications");
+}
+
+TEST(ScreenCapturerPerformanceTest, DISABLED_UpdateNotificationsWithDiffer) {
+  RunCaptureTest(true, true, "notifications_differ");
+}
+
+}  // namespace webrtc
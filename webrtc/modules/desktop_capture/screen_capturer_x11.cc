@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <utility>
@@ -26,16 +27,25 @@
 #include "webrtc/base/timeutils.h"
 #include "webrtc/modules/desktop_capture/desktop_capture_options.h"
 #include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/region_worker_pool.h"
 #include "webrtc/modules/desktop_capture/screen_capture_frame_queue.h"
 #include "webrtc/modules/desktop_capture/screen_capturer_differ_wrapper.h"
 #include "webrtc/modules/desktop_capture/screen_capturer_helper.h"
 #include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
 #include "webrtc/modules/desktop_capture/x11/x_server_pixel_buffer.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
 namespace webrtc {
 namespace {
 
+// The maximum number of threads used to copy pixels of a frame.
+const int kMaxCaptureThreads = 4;
+
+// Regions smaller than this many pixels are not worth splitting between
+// threads.
+const int kMinPixelsPerThread = 256 * 256;
+
 // A class to perform video frame capturing for Linux.
 //
 // If XDamage is used, this class sets DesktopFrame::updated_region() according
@@ -79,11 +89,12 @@ class ScreenCapturerLinux : public ScreenCapturer,
   void ScreenConfigurationChanged();
 
   // Synchronize the current buffer with |last_buffer_|, by copying pixels from
-  // the area of |last_invalid_rects|.
+  // the area of |last_invalid_rects| that is not going to be captured again as
+  // part of |updated_region|.
   // Note this only works on the assumption that kNumBuffers == 2, as
   // |last_invalid_rects| holds the differences from the previous buffer and
   // the one prior to that (which will then be the current buffer).
-  void SynchronizeFrame();
+  void SynchronizeFrame(const DesktopRegion& updated_region);
 
   void DeinitXlib();
 
@@ -110,6 +121,10 @@ class ScreenCapturerLinux : public ScreenCapturer,
   // Access to the X Server's pixel buffer.
   XServerPixelBuffer x_server_pixel_buffer_;
 
+  // Threads copying the captured pixels. Large captures, e.g. of several
+  // monitors, are split between them.
+  RegionWorkerPool workers_;
+
   // A thread-safe list of invalid rectangles, and the size of the most
   // recently captured screen.
   ScreenCapturerHelper helper_;
@@ -124,7 +139,10 @@ class ScreenCapturerLinux : public ScreenCapturer,
   RTC_DISALLOW_COPY_AND_ASSIGN(ScreenCapturerLinux);
 };
 
-ScreenCapturerLinux::ScreenCapturerLinux() {
+ScreenCapturerLinux::ScreenCapturerLinux()
+    : workers_(std::min(static_cast<int>(CpuInfo::DetectNumberOfCores()),
+                        kMaxCaptureThreads),
+               kMinPixelsPerThread) {
   helper_.SetLogGridSize(4);
 }
 
@@ -299,13 +317,6 @@ std::unique_ptr<DesktopFrame> ScreenCapturerLinux::CaptureScreen() {
   // expands that region to a grid.
   helper_.set_size_most_recent(frame->size());
 
-  // In the DAMAGE case, ensure the frame is up-to-date with the previous frame
-  // if any.  If there isn't a previous frame, that means a screen-resolution
-  // change occurred, and |invalid_rects| will be updated to include the whole
-  // screen.
-  if (use_damage_ && queue_.previous_frame())
-    SynchronizeFrame();
-
   DesktopRegion* updated_region = frame->mutable_updated_region();
 
   x_server_pixel_buffer_.Synchronize();
@@ -332,16 +343,21 @@ std::unique_ptr<DesktopFrame> ScreenCapturerLinux::CaptureScreen() {
     updated_region->IntersectWith(
         DesktopRect::MakeSize(x_server_pixel_buffer_.window_size()));
 
-    for (DesktopRegion::Iterator it(*updated_region);
-         !it.IsAtEnd(); it.Advance()) {
-      x_server_pixel_buffer_.CaptureRect(it.rect(), frame.get());
-    }
+    // Ensure the frame is up-to-date with the previous frame outside of the
+    // damaged portions. If there isn't a previous frame, that means a
+    // screen-resolution change occurred, and a full-screen capture is done
+    // below.
+    SynchronizeFrame(*updated_region);
+
+    x_server_pixel_buffer_.CaptureRegion(*updated_region, frame.get(),
+                                         &workers_);
   } else {
     // Doing full-screen polling, or this is the first capture after a
     // screen-resolution change.  In either case, need a full-screen capture.
     DesktopRect screen_rect = DesktopRect::MakeSize(frame->size());
-    x_server_pixel_buffer_.CaptureRect(screen_rect, frame.get());
     updated_region->SetRect(screen_rect);
+    x_server_pixel_buffer_.CaptureRegion(*updated_region, frame.get(),
+                                         &workers_);
   }
 
   return std::move(frame);
@@ -358,24 +374,26 @@ void ScreenCapturerLinux::ScreenConfigurationChanged() {
   }
 }
 
-void ScreenCapturerLinux::SynchronizeFrame() {
+void ScreenCapturerLinux::SynchronizeFrame(
+    const DesktopRegion& updated_region) {
   // Synchronize the current buffer with the previous one since we do not
   // capture the entire desktop. Note that encoder may be reading from the
   // previous buffer at this time so thread access complaints are false
   // positives.
-
-  // TODO(hclam): We can reduce the amount of copying here by subtracting
-  // |capturer_helper_|s region from |last_invalid_region_|.
-  // http://crbug.com/92354
   RTC_DCHECK(queue_.previous_frame());
 
   DesktopFrame* current = queue_.current_frame();
   DesktopFrame* last = queue_.previous_frame();
   RTC_DCHECK(current != last);
-  for (DesktopRegion::Iterator it(last_invalid_region_);
-       !it.IsAtEnd(); it.Advance()) {
-    current->CopyPixelsFrom(*last, it.rect().top_left(), it.rect());
-  }
+
+  // The pixels of |updated_region| are going to be overwritten anyway.
+  DesktopRegion copy_region(last_invalid_region_);
+  copy_region.Subtract(updated_region);
+  workers_.Run(copy_region, [current, last](const DesktopRegion& part) {
+    for (DesktopRegion::Iterator it(part); !it.IsAtEnd(); it.Advance()) {
+      current->CopyPixelsFrom(*last, it.rect().top_left(), it.rect());
+    }
+  });
 }
 
 void ScreenCapturerLinux::DeinitXlib() {
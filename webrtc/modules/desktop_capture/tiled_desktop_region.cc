@@ -0,0 +1,318 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/tiled_desktop_region.h"
+
+#include <assert.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the index of the lowest set bit of |word|, which must not be zero.
+int CountTrailingZeros(uint64_t word) {
+  assert(word != 0);
+  int count = 0;
+  if ((word & 0xffffffff) == 0) {
+    word >>= 32;
+    count += 32;
+  }
+  if ((word & 0xffff) == 0) {
+    word >>= 16;
+    count += 16;
+  }
+  if ((word & 0xff) == 0) {
+    word >>= 8;
+    count += 8;
+  }
+  if ((word & 0xf) == 0) {
+    word >>= 4;
+    count += 4;
+  }
+  if ((word & 0x3) == 0) {
+    word >>= 2;
+    count += 2;
+  }
+  if ((word & 0x1) == 0) {
+    count += 1;
+  }
+  return count;
+}
+
+}  // namespace
+
+TiledDesktopRegion::TiledDesktopRegion(const DesktopRect& area,
+                                       int log_tile_size)
+    : area_(area), log_tile_size_(log_tile_size) {
+  assert(log_tile_size >= 0 && log_tile_size < 31);
+  const int tile_size = 1 << log_tile_size_;
+  columns_ = area_.is_empty()
+                 ? 0
+                 : (area_.width() + tile_size - 1) >> log_tile_size_;
+  rows_ = area_.is_empty()
+              ? 0
+              : (area_.height() + tile_size - 1) >> log_tile_size_;
+  words_per_row_ = (columns_ + kBitsPerWord - 1) / kBitsPerWord;
+  bits_.resize(static_cast<size_t>(words_per_row_) * rows_, 0);
+}
+
+TiledDesktopRegion::TiledDesktopRegion(const TiledDesktopRegion& other) =
+    default;
+
+TiledDesktopRegion::~TiledDesktopRegion() {}
+
+TiledDesktopRegion& TiledDesktopRegion::operator=(
+    const TiledDesktopRegion& other) = default;
+
+bool TiledDesktopRegion::is_empty() const {
+  for (Word word : bits_) {
+    if (word != 0)
+      return false;
+  }
+  return true;
+}
+
+bool TiledDesktopRegion::Equals(const TiledDesktopRegion& region) const {
+  return area_.equals(region.area_) &&
+         log_tile_size_ == region.log_tile_size_ && bits_ == region.bits_;
+}
+
+void TiledDesktopRegion::Clear() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+}
+
+void TiledDesktopRegion::SetRect(const DesktopRect& rect) {
+  Clear();
+  AddRect(rect);
+}
+
+void TiledDesktopRegion::AddRect(const DesktopRect& rect) {
+  int first_column, first_row, end_column, end_row;
+  if (!GetTouchedTiles(rect, &first_column, &first_row, &end_column,
+                       &end_row)) {
+    return;
+  }
+  for (int y = first_row; y < end_row; ++y) {
+    SetBits(row(y), first_column, end_column);
+  }
+}
+
+void TiledDesktopRegion::AddRects(const DesktopRect* rects, int count) {
+  for (int i = 0; i < count; ++i) {
+    AddRect(rects[i]);
+  }
+}
+
+void TiledDesktopRegion::AddRegion(const DesktopRegion& region) {
+  // Walk the rows directly. DesktopRegion::Iterator merges spans vertically,
+  // which costs more than marking the tiles of each span separately.
+  for (DesktopRegion::Rows::const_iterator it = region.rows_.begin();
+       it != region.rows_.end(); ++it) {
+    const DesktopRegion::Row& region_row = *it->second;
+    for (const DesktopRegion::RowSpan& span : region_row.spans) {
+      AddRect(DesktopRect::MakeLTRB(span.left, region_row.top, span.right,
+                                    region_row.bottom));
+    }
+  }
+}
+
+void TiledDesktopRegion::AddRegion(const TiledDesktopRegion& region) {
+  assert(area_.equals(region.area_) &&
+         log_tile_size_ == region.log_tile_size_);
+  for (size_t i = 0; i < bits_.size(); ++i) {
+    bits_[i] |= region.bits_[i];
+  }
+}
+
+void TiledDesktopRegion::IntersectWith(const TiledDesktopRegion& region) {
+  assert(area_.equals(region.area_) &&
+         log_tile_size_ == region.log_tile_size_);
+  for (size_t i = 0; i < bits_.size(); ++i) {
+    bits_[i] &= region.bits_[i];
+  }
+}
+
+void TiledDesktopRegion::Subtract(const TiledDesktopRegion& region) {
+  assert(area_.equals(region.area_) &&
+         log_tile_size_ == region.log_tile_size_);
+  for (size_t i = 0; i < bits_.size(); ++i) {
+    bits_[i] &= ~region.bits_[i];
+  }
+}
+
+void TiledDesktopRegion::IntersectWith(const DesktopRect& rect) {
+  int first_column, first_row, end_column, end_row;
+  if (!GetTouchedTiles(rect, &first_column, &first_row, &end_column,
+                       &end_row)) {
+    Clear();
+    return;
+  }
+  std::fill(bits_.begin(), bits_.begin() + first_row * words_per_row_, 0);
+  std::fill(bits_.begin() + end_row * words_per_row_, bits_.end(), 0);
+  for (int y = first_row; y < end_row; ++y) {
+    ClearBits(row(y), 0, first_column);
+    ClearBits(row(y), end_column, columns_);
+  }
+}
+
+void TiledDesktopRegion::Subtract(const DesktopRect& rect) {
+  int first_column, first_row, end_column, end_row;
+  if (!GetCoveredTiles(rect, &first_column, &first_row, &end_column,
+                       &end_row)) {
+    return;
+  }
+  for (int y = first_row; y < end_row; ++y) {
+    ClearBits(row(y), first_column, end_column);
+  }
+}
+
+void TiledDesktopRegion::Swap(TiledDesktopRegion* region) {
+  std::swap(area_, region->area_);
+  std::swap(log_tile_size_, region->log_tile_size_);
+  std::swap(columns_, region->columns_);
+  std::swap(rows_, region->rows_);
+  std::swap(words_per_row_, region->words_per_row_);
+  bits_.swap(region->bits_);
+}
+
+void TiledDesktopRegion::ToDesktopRegion(DesktopRegion* region) const {
+  region->Clear();
+
+  // Horizontal runs of tiles in the band of identical rows that is being
+  // built, as pairs of [first column, end column).
+  std::vector<std::pair<int, int>> band_runs;
+  std::vector<std::pair<int, int>> runs;
+  int band_top = 0;
+
+  for (int y = 0; y <= rows_; ++y) {
+    runs.clear();
+    if (y < rows_) {
+      const Word* bits = row(y);
+      for (int x = FindBit(bits, 0, true); x < columns_;
+           x = FindBit(bits, x, true)) {
+        int end = FindBit(bits, x, false);
+        runs.push_back(std::make_pair(x, end));
+        x = end;
+      }
+      if (runs == band_runs)
+        continue;
+    }
+
+    // The band ends here. Consecutive bands never have the same runs and the
+    // runs are sorted and disjoint, so the band can be stored as a row of
+    // |region| as it is, without going through AddRect().
+    if (!band_runs.empty()) {
+      const int32_t top = area_.top() + (band_top << log_tile_size_);
+      const int32_t bottom =
+          std::min(area_.top() + (y << log_tile_size_), area_.bottom());
+      DesktopRegion::Row* band = new DesktopRegion::Row(top, bottom);
+      band->spans.reserve(band_runs.size());
+      for (const std::pair<int, int>& run : band_runs) {
+        band->spans.push_back(DesktopRegion::RowSpan(
+            area_.left() + (run.first << log_tile_size_),
+            std::min(area_.left() + (run.second << log_tile_size_),
+                     area_.right())));
+      }
+      region->rows_.insert(region->rows_.end(),
+                           DesktopRegion::Rows::value_type(bottom, band));
+    }
+    band_runs.swap(runs);
+    band_top = y;
+  }
+}
+
+bool TiledDesktopRegion::GetTouchedTiles(const DesktopRect& rect,
+                                         int* first_column,
+                                         int* first_row,
+                                         int* end_column,
+                                         int* end_row) const {
+  DesktopRect clipped = rect;
+  clipped.IntersectWith(area_);
+  if (clipped.is_empty())
+    return false;
+
+  const int tile_size = 1 << log_tile_size_;
+  *first_column = (clipped.left() - area_.left()) >> log_tile_size_;
+  *first_row = (clipped.top() - area_.top()) >> log_tile_size_;
+  *end_column =
+      (clipped.right() - area_.left() + tile_size - 1) >> log_tile_size_;
+  *end_row = (clipped.bottom() - area_.top() + tile_size - 1) >> log_tile_size_;
+  return true;
+}
+
+bool TiledDesktopRegion::GetCoveredTiles(const DesktopRect& rect,
+                                         int* first_column,
+                                         int* first_row,
+                                         int* end_column,
+                                         int* end_row) const {
+  DesktopRect clipped = rect;
+  clipped.IntersectWith(area_);
+  if (clipped.is_empty())
+    return false;
+
+  // A tile on the right or bottom edge of the area only needs to be covered up
+  // to the edge.
+  const int tile_size = 1 << log_tile_size_;
+  *first_column =
+      (clipped.left() - area_.left() + tile_size - 1) >> log_tile_size_;
+  *first_row = (clipped.top() - area_.top() + tile_size - 1) >> log_tile_size_;
+  *end_column = clipped.right() == area_.right()
+                    ? columns_
+                    : (clipped.right() - area_.left()) >> log_tile_size_;
+  *end_row = clipped.bottom() == area_.bottom()
+                 ? rows_
+                 : (clipped.bottom() - area_.top()) >> log_tile_size_;
+  return *first_column < *end_column && *first_row < *end_row;
+}
+
+// static
+void TiledDesktopRegion::SetBits(Word* row, int begin, int end) {
+  while (begin < end) {
+    const int bit = begin % kBitsPerWord;
+    const int count = std::min(end - begin, kBitsPerWord - bit);
+    const Word mask =
+        (count == kBitsPerWord ? ~Word(0) : ((Word(1) << count) - 1)) << bit;
+    row[begin / kBitsPerWord] |= mask;
+    begin += count;
+  }
+}
+
+// static
+void TiledDesktopRegion::ClearBits(Word* row, int begin, int end) {
+  while (begin < end) {
+    const int bit = begin % kBitsPerWord;
+    const int count = std::min(end - begin, kBitsPerWord - bit);
+    const Word mask =
+        (count == kBitsPerWord ? ~Word(0) : ((Word(1) << count) - 1)) << bit;
+    row[begin / kBitsPerWord] &= ~mask;
+    begin += count;
+  }
+}
+
+int TiledDesktopRegion::FindBit(const Word* row, int from, bool value) const {
+  if (from >= columns_)
+    return columns_;
+
+  // Search for a set bit in |row| or in its complement.
+  const Word flip = value ? 0 : ~Word(0);
+  int index = from / kBitsPerWord;
+  Word word = (row[index] ^ flip) & (~Word(0) << (from % kBitsPerWord));
+  while (word == 0) {
+    if (++index == words_per_row_)
+      return columns_;
+    word = row[index] ^ flip;
+  }
+  return std::min(index * kBitsPerWord + CountTrailingZeros(word), columns_);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_DESKTOP_CAPTURE_TILED_DESKTOP_REGION_H_
+#define WEBRTC_MODULES_DESKTOP_CAPTURE_TILED_DESKTOP_REGION_H_
+
+#include <vector>
+
+#include "webrtc/modules/desktop_capture/desktop_geometry.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// TiledDesktopRegion represents a region of a fixed area of the screen at the
+// granularity of square tiles.
+//
+// Internally the region is a bitmap with one bit per tile, so the cost of
+// adding, intersecting and subtracting depends on the size of the area rather
+// than on how fragmented the region is, and none of these operations allocate
+// memory. This makes it a better fit than DesktopRegion for accumulating
+// scattered damage that is going to be rounded to a grid anyway. The region is
+// converted to rectangles on demand with ToDesktopRegion().
+//
+// Tiles are aligned to the top-left corner of the area. Rectangles are clipped
+// to the area; AddRect() and IntersectWith() round them out to whole tiles,
+// while Subtract() only removes the tiles that are covered completely, so the
+// region never loses damage to rounding.
+class TiledDesktopRegion {
+ public:
+  // Creates an empty region covering |area|, split into tiles of
+  // 2 ^ |log_tile_size| by 2 ^ |log_tile_size| pixels.
+  TiledDesktopRegion(const DesktopRect& area, int log_tile_size);
+  TiledDesktopRegion(const TiledDesktopRegion& other);
+  ~TiledDesktopRegion();
+
+  TiledDesktopRegion& operator=(const TiledDesktopRegion& other);
+
+  const DesktopRect& area() const { return area_; }
+  int log_tile_size() const { return log_tile_size_; }
+
+  bool is_empty() const;
+
+  // Regions are equal if they cover the same area, have the same tile size and
+  // contain the same tiles.
+  bool Equals(const TiledDesktopRegion& region) const;
+
+  // Reset the region to be empty.
+  void Clear();
+
+  // Reset region to contain just the tiles touched by |rect|.
+  void SetRect(const DesktopRect& rect);
+
+  // Adds the tiles touched by the specified rect(s) or region to the region.
+  void AddRect(const DesktopRect& rect);
+  void AddRects(const DesktopRect* rects, int count);
+  void AddRegion(const DesktopRegion& region);
+
+  // The following methods require |region| to have the same area and tile
+  // size as this region.
+  void AddRegion(const TiledDesktopRegion& region);
+  void IntersectWith(const TiledDesktopRegion& region);
+  void Subtract(const TiledDesktopRegion& region);
+
+  // Removes the tiles that are not touched by |rect|.
+  void IntersectWith(const DesktopRect& rect);
+
+  // Removes the tiles that are covered completely by |rect|.
+  void Subtract(const DesktopRect& rect);
+
+  void Swap(TiledDesktopRegion* region);
+
+  // Stores the region as rectangles in |region|, replacing its content.
+  // Horizontal runs of tiles become one rectangle, and runs that repeat on
+  // consecutive rows of tiles are merged vertically. The rectangles are
+  // clipped to the area.
+  void ToDesktopRegion(DesktopRegion* region) const;
+
+ private:
+  typedef uint64_t Word;
+  static const int kBitsPerWord = 64;
+
+  // Finds the tiles touched by |rect| and stores them as the half-open ranges
+  // of columns [|*first_column|, |*end_column|) and rows [|*first_row|,
+  // |*end_row|). Returns false if no tiles are touched.
+  bool GetTouchedTiles(const DesktopRect& rect,
+                       int* first_column,
+                       int* first_row,
+                       int* end_column,
+                       int* end_row) const;
+
+  // Same as above, for the tiles that |rect| covers completely.
+  bool GetCoveredTiles(const DesktopRect& rect,
+                       int* first_column,
+                       int* first_row,
+                       int* end_column,
+                       int* end_row) const;
+
+  Word* row(int index) { return &bits_[index * words_per_row_]; }
+  const Word* row(int index) const { return &bits_[index * words_per_row_]; }
+
+  // Sets or clears the bits [|begin|, |end|) of |row|.
+  static void SetBits(Word* row, int begin, int end);
+  static void ClearBits(Word* row, int begin, int end);
+
+  // Returns the first column at or after |from| whose bit equals |value|, or
+  // |columns_| if there is none.
+  int FindBit(const Word* row, int from, bool value) const;
+
+  DesktopRect area_;
+  int log_tile_size_;
+  int columns_;
+  int rows_;
+  int words_per_row_;
+  // One bit per tile, row by row. Each row starts on a new word and the bits
+  // past |columns_| are always zero.
+  std::vector<Word> bits_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_DESKTOP_CAPTURE_TILED_DESKTOP_REGION_H_
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/tiled_desktop_region.h"
+
+#include <stdlib.h>
+
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kLogTileSize = 4;
+const int kTileSize = 1 << kLogTileSize;
+
+int RandomInt(int max) {
+  return (rand() / 256) % max;
+}
+
+// Returns |rect| expanded to the tile grid of a region whose area starts at
+// |origin|.
+DesktopRect ExpandToTiles(const DesktopRect& rect,
+                          const DesktopVector& origin) {
+  const int mask = ~(kTileSize - 1);
+  const int left = ((rect.left() - origin.x()) & mask) + origin.x();
+  const int top = ((rect.top() - origin.y()) & mask) + origin.y();
+  const int right =
+      ((rect.right() - origin.x() + kTileSize - 1) & mask) + origin.x();
+  const int bottom =
+      ((rect.bottom() - origin.y() + kTileSize - 1) & mask) + origin.y();
+  return DesktopRect::MakeLTRB(left, top, right, bottom);
+}
+
+DesktopRegion ToDesktopRegion(const TiledDesktopRegion& tiles) {
+  DesktopRegion region;
+  tiles.ToDesktopRegion(&region);
+  return region;
+}
+
+}  // namespace
+
+TEST(TiledDesktopRegionTest, Empty) {
+  TiledDesktopRegion tiles(DesktopRect::MakeWH(100, 100), kLogTileSize);
+  EXPECT_TRUE(tiles.is_empty());
+  EXPECT_TRUE(ToDesktopRegion(tiles).is_empty());
+
+  tiles.AddRect(DesktopRect::MakeXYWH(10, 10, 0, 0));
+  EXPECT_TRUE(tiles.is_empty());
+
+  // Rectangles outside of the area are ignored.
+  tiles.AddRect(DesktopRect::MakeXYWH(100, 0, 10, 10));
+  tiles.AddRect(DesktopRect::MakeXYWH(-10, -10, 10, 10));
+  EXPECT_TRUE(tiles.is_empty());
+}
+
+TEST(TiledDesktopRegionTest, AddRectExpandsToTiles) {
+  TiledDesktopRegion tiles(DesktopRect::MakeWH(100, 100), kLogTileSize);
+  tiles.AddRect(DesktopRect::MakeXYWH(17, 3, 1, 30));
+  EXPECT_FALSE(tiles.is_empty());
+  EXPECT_TRUE(DesktopRegion(DesktopRect::MakeLTRB(16, 0, 32, 48))
+                  .Equals(ToDesktopRegion(tiles)));
+
+  // The tiles on the right and bottom edges are clipped to the area.
+  tiles.SetRect(DesktopRect::MakeXYWH(90, 90, 50, 50));
+  EXPECT_TRUE(DesktopRegion(DesktopRect::MakeLTRB(80, 80, 100, 100))
+                  .Equals(ToDesktopRegion(tiles)));
+}
+
+TEST(TiledDesktopRegionTest, AreaOffset) {
+  const DesktopRect area = DesktopRect::MakeLTRB(-40, 8, 60, 108);
+  TiledDesktopRegion tiles(area, kLogTileSize);
+  tiles.AddRect(DesktopRect::MakeXYWH(-30, 30, 1, 1));
+  EXPECT_TRUE(DesktopRegion(DesktopRect::MakeXYWH(-40, 24, 16, 16))
+                  .Equals(ToDesktopRegion(tiles)));
+}
+
+TEST(TiledDesktopRegionTest, MergesRowsAndColumns) {
+  TiledDesktopRegion tiles(DesktopRect::MakeWH(256, 256), kLogTileSize);
+  for (int y = 32; y < 96; y += kTileSize) {
+    for (int x = 16; x < 80; x += kTileSize) {
+      tiles.AddRect(DesktopRect::MakeXYWH(x + 1, y + 1, 1, 1));
+    }
+  }
+  DesktopRegion region = ToDesktopRegion(tiles);
+  DesktopRegion::Iterator it(region);
+  ASSERT_FALSE(it.IsAtEnd());
+  EXPECT_TRUE(it.rect().equals(DesktopRect::MakeLTRB(16, 32, 80, 96)));
+  it.Advance();
+  EXPECT_TRUE(it.IsAtEnd());
+}
+
+TEST(TiledDesktopRegionTest, IntersectWithRect) {
+  TiledDesktopRegion tiles(DesktopRect::MakeWH(100, 100), kLogTileSize);
+  tiles.AddRect(DesktopRect::MakeWH(100, 100));
+  tiles.IntersectWith(DesktopRect::MakeLTRB(20, 20, 40, 40));
+  EXPECT_TRUE(DesktopRegion(DesktopRect::MakeLTRB(16, 16, 48, 48))
+                  .Equals(ToDesktopRegion(tiles)));
+
+  tiles.IntersectWith(DesktopRect::MakeLTRB(200, 200, 300, 300));
+  EXPECT_TRUE(tiles.is_empty());
+}
+
+TEST(TiledDesktopRegionTest, SubtractRect) {
+  TiledDesktopRegion tiles(DesktopRect::MakeWH(100, 100), kLogTileSize);
+  tiles.AddRect(DesktopRect::MakeLTRB(0, 0, 64, 16));
+
+  // Tiles that are only partially covered stay in the region.
+  tiles.Subtract(DesktopRect::MakeLTRB(8, 0, 40, 16));
+  DesktopRegion expected(DesktopRect::MakeLTRB(0, 0, 16, 16));
+  expected.AddRect(DesktopRect::MakeLTRB(32, 0, 64, 16));
+  EXPECT_TRUE(expected.Equals(ToDesktopRegion(tiles)));
+
+  // A tile on the edge of the area only needs to be covered up to the edge.
+  tiles.SetRect(DesktopRect::MakeLTRB(96, 96, 100, 100));
+  tiles.Subtract(DesktopRect::MakeLTRB(96, 96, 100, 100));
+  EXPECT_TRUE(tiles.is_empty());
+}
+
+TEST(TiledDesktopRegionTest, RegionOperations) {
+  const DesktopRect area = DesktopRect::MakeWH(200, 100);
+  TiledDesktopRegion a(area, kLogTileSize);
+  TiledDesktopRegion b(area, kLogTileSize);
+  a.AddRect(DesktopRect::MakeLTRB(0, 0, 96, 32));
+  b.AddRect(DesktopRect::MakeLTRB(64, 16, 160, 48));
+
+  TiledDesktopRegion sum = a;
+  sum.AddRegion(b);
+  DesktopRegion expected(DesktopRect::MakeLTRB(0, 0, 96, 32));
+  expected.AddRect(DesktopRect::MakeLTRB(64, 16, 160, 48));
+  EXPECT_TRUE(expected.Equals(ToDesktopRegion(sum)));
+
+  TiledDesktopRegion intersection = a;
+  intersection.IntersectWith(b);
+  EXPECT_TRUE(DesktopRegion(DesktopRect::MakeLTRB(64, 16, 96, 32))
+                  .Equals(ToDesktopRegion(intersection)));
+
+  TiledDesktopRegion difference = a;
+  difference.Subtract(b);
+  expected.SetRect(DesktopRect::MakeLTRB(0, 0, 96, 32));
+  expected.Subtract(DesktopRect::MakeLTRB(64, 16, 96, 32));
+  EXPECT_TRUE(expected.Equals(ToDesktopRegion(difference)));
+
+  EXPECT_FALSE(a.Equals(b));
+  a.Swap(&b);
+  EXPECT_TRUE(DesktopRegion(DesktopRect::MakeLTRB(64, 16, 160, 48))
+                  .Equals(ToDesktopRegion(a)));
+  a.Clear();
+  EXPECT_TRUE(a.is_empty());
+}
+
+// Verifies against DesktopRegion that random rectangles are expanded to the
+// grid, merged and converted back correctly, including for areas wider than
+// a single bitmap word.
+TEST(TiledDesktopRegionTest, MatchesDesktopRegion) {
+  const DesktopRect area = DesktopRect::MakeLTRB(-100, -50, 2000, 700);
+  for (int c = 0; c < 50; ++c) {
+    TiledDesktopRegion tiles(area, kLogTileSize);
+    DesktopRegion expected;
+    for (int i = 0; i < 100; ++i) {
+      DesktopRect rect = DesktopRect::MakeXYWH(
+          area.left() + RandomInt(area.width()),
+          area.top() + RandomInt(area.height()), 1 + RandomInt(100),
+          1 + RandomInt(50));
+      tiles.AddRect(rect);
+      DesktopRect expanded = ExpandToTiles(rect, area.top_left());
+      expanded.IntersectWith(area);
+      expected.AddRect(expanded);
+    }
+    ASSERT_TRUE(expected.Equals(ToDesktopRegion(tiles)));
+  }
+}
+
+}  // namespace webrtc
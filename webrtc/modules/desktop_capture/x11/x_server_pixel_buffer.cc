@@ -15,6 +15,8 @@
 #include <sys/shm.h>
 
 #include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
+#include "webrtc/modules/desktop_capture/region_worker_pool.h"
 #include "webrtc/modules/desktop_capture/x11/x_error_trap.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
@@ -66,6 +68,12 @@ XServerPixelBuffer::~XServerPixelBuffer() {
 }
 
 void XServerPixelBuffer::Release() {
+  ReleaseImage();
+  ReleaseSharedMemorySegment();
+  window_ = 0;
+}
+
+void XServerPixelBuffer::ReleaseImage() {
   if (x_image_) {
     XDestroyImage(x_image_);
     x_image_ = NULL;
@@ -78,6 +86,9 @@ void XServerPixelBuffer::Release() {
     XFreeGC(display_, shm_gc_);
     shm_gc_ = NULL;
   }
+}
+
+void XServerPixelBuffer::ReleaseSharedMemorySegment() {
   if (shm_segment_info_) {
     if (shm_segment_info_->shmaddr != reinterpret_cast<char*>(-1))
       shmdt(shm_segment_info_->shmaddr);
@@ -86,11 +97,15 @@ void XServerPixelBuffer::Release() {
     delete shm_segment_info_;
     shm_segment_info_ = NULL;
   }
-  window_ = 0;
+  shm_segment_size_ = 0;
 }
 
 bool XServerPixelBuffer::Init(Display* display, Window window) {
-  Release();
+  // Keep the shared memory segment, so it can be reused for |window|.
+  ReleaseImage();
+  if (display != display_)
+    ReleaseSharedMemorySegment();
+  window_ = 0;
   display_ = display;
 
   XWindowAttributes attributes;
@@ -117,53 +132,82 @@ void XServerPixelBuffer::InitShm(const XWindowAttributes& attributes) {
   Bool have_pixmaps;
   if (!XShmQueryVersion(display_, &major, &minor, &have_pixmaps)) {
     // Shared memory not supported. CaptureRect will use the XImage API instead.
+    ReleaseSharedMemorySegment();
     return;
   }
 
-  bool using_shm = false;
-  shm_segment_info_ = new XShmSegmentInfo;
-  shm_segment_info_->shmid = -1;
-  shm_segment_info_->shmaddr = reinterpret_cast<char*>(-1);
-  shm_segment_info_->readOnly = False;
-  x_image_ = XShmCreateImage(display_, default_visual, default_depth, ZPixmap,
-                             0, shm_segment_info_, window_size_.width(),
-                             window_size_.height());
-  if (x_image_) {
-    shm_segment_info_->shmid = shmget(
-        IPC_PRIVATE, x_image_->bytes_per_line * x_image_->height,
-        IPC_CREAT | 0600);
-    if (shm_segment_info_->shmid != -1) {
-      shm_segment_info_->shmaddr = x_image_->data =
-          reinterpret_cast<char*>(shmat(shm_segment_info_->shmid, 0, 0));
-      if (x_image_->data != reinterpret_cast<char*>(-1)) {
-        XErrorTrap error_trap(display_);
-        using_shm = XShmAttach(display_, shm_segment_info_);
-        XSync(display_, False);
-        if (error_trap.GetLastErrorAndDisable() != 0)
-          using_shm = false;
-        if (using_shm) {
-          LOG(LS_VERBOSE) << "Using X shared memory segment "
-                          << shm_segment_info_->shmid;
+  // Reuse the segment allocated for the previous window if the image fits.
+  // This avoids allocating and attaching a new segment every time the screen
+  // is reconfigured or another window is selected.
+  if (shm_segment_info_) {
+    x_image_ = XShmCreateImage(display_, default_visual, default_depth, ZPixmap,
+                               0, shm_segment_info_, window_size_.width(),
+                               window_size_.height());
+    if (x_image_ && static_cast<size_t>(x_image_->bytes_per_line) *
+                            x_image_->height <= shm_segment_size_) {
+      x_image_->data = shm_segment_info_->shmaddr;
+    } else {
+      if (x_image_) {
+        XDestroyImage(x_image_);
+        x_image_ = NULL;
+      }
+      ReleaseSharedMemorySegment();
+    }
+  }
+
+  if (!x_image_) {
+    bool using_shm = false;
+    size_t segment_size = 0;
+    shm_segment_info_ = new XShmSegmentInfo;
+    shm_segment_info_->shmid = -1;
+    shm_segment_info_->shmaddr = reinterpret_cast<char*>(-1);
+    shm_segment_info_->readOnly = False;
+    x_image_ = XShmCreateImage(display_, default_visual, default_depth,
+                               ZPixmap, 0, shm_segment_info_,
+                               window_size_.width(), window_size_.height());
+    if (x_image_) {
+      segment_size =
+          static_cast<size_t>(x_image_->bytes_per_line) * x_image_->height;
+      shm_segment_info_->shmid =
+          shmget(IPC_PRIVATE, segment_size, IPC_CREAT | 0600);
+      if (shm_segment_info_->shmid != -1) {
+        shm_segment_info_->shmaddr = x_image_->data =
+            reinterpret_cast<char*>(shmat(shm_segment_info_->shmid, 0, 0));
+        if (x_image_->data != reinterpret_cast<char*>(-1)) {
+          XErrorTrap error_trap(display_);
+          using_shm = XShmAttach(display_, shm_segment_info_);
+          XSync(display_, False);
+          if (error_trap.GetLastErrorAndDisable() != 0)
+            using_shm = false;
+          if (using_shm) {
+            LOG(LS_VERBOSE) << "Using X shared memory segment "
+                            << shm_segment_info_->shmid;
+          }
         }
+      } else {
+        LOG(LS_WARNING) << "Failed to get shared memory segment. "
+                        "Performance may be degraded.";
       }
-    } else {
-      LOG(LS_WARNING) << "Failed to get shared memory segment. "
+    }
+
+    if (!using_shm) {
+      LOG(LS_WARNING) << "Not using shared memory. "
                       "Performance may be degraded.";
+      // CaptureRect will use the XImage API instead.
+      ReleaseImage();
+      ReleaseSharedMemorySegment();
+      return;
     }
-  }
 
-  if (!using_shm) {
-    LOG(LS_WARNING) << "Not using shared memory. Performance may be degraded.";
-    Release();
-    return;
+    // The segment stays alive as long as it's attached.
+    shmctl(shm_segment_info_->shmid, IPC_RMID, 0);
+    shm_segment_info_->shmid = -1;
+    shm_segment_size_ = segment_size;
   }
 
   if (have_pixmaps)
     have_pixmaps = InitPixmaps(default_depth);
 
-  shmctl(shm_segment_info_->shmid, IPC_RMID, 0);
-  shm_segment_info_->shmid = -1;
-
   LOG(LS_VERBOSE) << "Using X shared memory extension v"
                   << major << "." << minor
                   << " with" << (have_pixmaps ? "" : "out") << " pixmaps.";
@@ -236,26 +280,75 @@ void XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
   assert(rect.right() <= window_size_.width());
   assert(rect.bottom() <= window_size_.height());
 
-  uint8_t* data;
-
-  if (shm_segment_info_ && (shm_pixmap_ || xshm_get_image_succeeded_)) {
+  if (HasSharedImage()) {
     if (shm_pixmap_) {
       XCopyArea(display_, window_, shm_pixmap_, shm_gc_,
                 rect.left(), rect.top(), rect.width(), rect.height(),
                 rect.left(), rect.top());
       XSync(display_, False);
     }
-    data = reinterpret_cast<uint8_t*>(x_image_->data) +
-        rect.top() * x_image_->bytes_per_line +
-        rect.left() * x_image_->bits_per_pixel / 8;
+    BlitSharedImage(rect, frame);
+    return;
+  }
+
+  if (x_image_)
+    XDestroyImage(x_image_);
+  x_image_ = XGetImage(display_, window_, rect.left(), rect.top(),
+                       rect.width(), rect.height(), AllPlanes, ZPixmap);
+  uint8_t* data = reinterpret_cast<uint8_t*>(x_image_->data);
+
+  if (IsXImageRGBFormat(x_image_)) {
+    FastBlit(data, rect, frame);
   } else {
-    if (x_image_)
-      XDestroyImage(x_image_);
-    x_image_ = XGetImage(display_, window_, rect.left(), rect.top(),
-                         rect.width(), rect.height(), AllPlanes, ZPixmap);
-    data = reinterpret_cast<uint8_t*>(x_image_->data);
+    SlowBlit(data, rect, frame);
   }
+}
+
+void XServerPixelBuffer::CaptureRegion(const DesktopRegion& region,
+                                       DesktopFrame* frame,
+                                       RegionWorkerPool* workers) {
+  if (!HasSharedImage()) {
+    for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+      CaptureRect(it.rect(), frame);
+    }
+    return;
+  }
+
+  if (shm_pixmap_) {
+    for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      assert(rect.right() <= window_size_.width());
+      assert(rect.bottom() <= window_size_.height());
+      XCopyArea(display_, window_, shm_pixmap_, shm_gc_,
+                rect.left(), rect.top(), rect.width(), rect.height(),
+                rect.left(), rect.top());
+    }
+    XSync(display_, False);
+  }
+
+  // The X server is done with the segment, so the pixels can be copied out of
+  // it on any thread.
+  const RegionWorkerPool::Task blit = [this, frame](const DesktopRegion& part) {
+    for (DesktopRegion::Iterator it(part); !it.IsAtEnd(); it.Advance()) {
+      BlitSharedImage(it.rect(), frame);
+    }
+  };
+  if (workers) {
+    workers->Run(region, blit);
+  } else {
+    blit(region);
+  }
+}
+
+bool XServerPixelBuffer::HasSharedImage() const {
+  return shm_segment_info_ && (shm_pixmap_ || xshm_get_image_succeeded_);
+}
 
+void XServerPixelBuffer::BlitSharedImage(const DesktopRect& rect,
+                                         DesktopFrame* frame) {
+  uint8_t* data = reinterpret_cast<uint8_t*>(x_image_->data) +
+      rect.top() * x_image_->bytes_per_line +
+      rect.left() * x_image_->bits_per_pixel / 8;
   if (IsXImageRGBFormat(x_image_)) {
     FastBlit(data, rect, frame);
   } else {
@@ -22,6 +22,8 @@
 namespace webrtc {
 
 class DesktopFrame;
+class DesktopRegion;
+class RegionWorkerPool;
 
 // A class to allow the X server's pixel buffer to be accessed as efficiently
 // as possible.
@@ -33,7 +35,8 @@ class XServerPixelBuffer {
   void Release();
 
   // Allocate (or reallocate) the pixel buffer for |window|. Returns false in
-  // case of an error (e.g. window doesn't exist).
+  // case of an error (e.g. window doesn't exist). The shared memory segment
+  // allocated for a previous window is reused if it is large enough.
   bool Init(Display* display, Window window);
 
   bool is_initialized() { return window_ != 0; }
@@ -57,10 +60,29 @@ class XServerPixelBuffer {
   // that |rect| is not larger than window_size().
   void CaptureRect(const DesktopRect& rect, DesktopFrame* frame);
 
+  // Same as calling CaptureRect() for each rectangle of |region|, but when
+  // shared memory is used, the X server is asked to copy all of them before
+  // waiting for it once, and the pixels are then copied to |frame| on
+  // |workers|, if given.
+  void CaptureRegion(const DesktopRegion& region,
+                     DesktopFrame* frame,
+                     RegionWorkerPool* workers);
+
  private:
+  // Releases the XImage and pixmap, but keeps the shared memory segment.
+  void ReleaseImage();
+  void ReleaseSharedMemorySegment();
+
   void InitShm(const XWindowAttributes& attributes);
   bool InitPixmaps(int depth);
 
+  // Returns true if the shared memory segment holds the window content, i.e.
+  // CaptureRect() doesn't need to fetch the pixels with XGetImage().
+  bool HasSharedImage() const;
+
+  // Copies |rect| of the shared memory image to |frame|.
+  void BlitSharedImage(const DesktopRect& rect, DesktopFrame* frame);
+
   // We expose two forms of blitting to handle variations in the pixel format.
   // In FastBlit(), the operation is effectively a memcpy.
   void FastBlit(uint8_t* image,
@@ -75,6 +97,8 @@ class XServerPixelBuffer {
   DesktopSize window_size_;
   XImage* x_image_ = nullptr;
   XShmSegmentInfo* shm_segment_info_ = nullptr;
+  // Size of the shared memory segment in bytes.
+  size_t shm_segment_size_ = 0;
   Pixmap shm_pixmap_ = 0;
   GC shm_gc_ = nullptr;
   bool xshm_get_image_succeeded_ = false;
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/pacing/paced_sender.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const int kBitrateBps = 10000000;
+const int kProcessIntervalMs = 5;
+const size_t kPacketSize = 1200;
+// About what |kBitrateBps| lets through per process interval.
+const int kPacketsPerInterval = 5;
+const uint32_t kNumStreams = 10;
+
+class CountingPacketSender : public PacedSender::PacketSender {
+ public:
+  bool TimeToSendPacket(uint32_t ssrc,
+                        uint16_t sequence_number,
+                        int64_t capture_time_ms,
+                        bool retransmission,
+                        int probe_cluster_id) override {
+    ++packets_sent_;
+    return true;
+  }
+
+  size_t TimeToSendPadding(size_t bytes, int probe_cluster_id) override {
+    return 0;
+  }
+
+  int packets_sent() const { return packets_sent_; }
+
+ private:
+  int packets_sent_ = 0;
+};
+
+}  // namespace
+
+// Runs the pacer as the process thread does, with packets of |kNumStreams|
+// streams queued between calls to Process().
+TEST(PacedSenderBenchmark, InsertAndProcess) {
+  SimulatedClock clock(123456);
+  CountingPacketSender packet_sender;
+  PacedSender pacer(&clock, &packet_sender);
+  pacer.SetProbingEnabled(false);
+  pacer.SetEstimatedBitrate(kBitrateBps);
+  uint16_t sequence_number = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "paced_sender_insert_and_process", test::BenchmarkOptions(), [&] {
+        for (int i = 0; i < kPacketsPerInterval; ++i) {
+          pacer.InsertPacket(PacedSender::kNormalPriority,
+                             sequence_number % kNumStreams, sequence_number,
+                             clock.TimeInMilliseconds(), kPacketSize, false);
+          ++sequence_number;
+        }
+        clock.AdvanceTimeMilliseconds(kProcessIntervalMs);
+        pacer.Process();
+      }));
+  EXPECT_GT(packet_sender.packets_sent(), 0);
+}
+
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "webrtc/modules/remote_bitrate_estimator/remote_estimator_proxy.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "webrtc/base/checks.h"
@@ -24,11 +25,13 @@ namespace webrtc {
 // TODO(sprang): Tune these!
 const int RemoteEstimatorProxy::kDefaultProcessIntervalMs = 50;
 const int RemoteEstimatorProxy::kBackWindowMs = 500;
+const size_t RemoteEstimatorProxy::kMaxNumberOfPackets = 1 << 13;
 
 // The maximum allowed value for a timestamp in milliseconds. This is lower
 // than the numerical limit since we often convert to microseconds.
 static constexpr int64_t kMaxTimeMs =
     std::numeric_limits<int64_t>::max() / 1000;
+static constexpr int64_t kNotReceived = -1;
 
 RemoteEstimatorProxy::RemoteEstimatorProxy(Clock* clock,
                                            PacketRouter* packet_router)
@@ -37,7 +40,10 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(Clock* clock,
       last_process_time_ms_(-1),
       media_ssrc_(0),
       feedback_sequence_(0),
-      window_start_seq_(-1) {}
+      window_start_seq_(-1),
+      arrival_times_(kMaxNumberOfPackets, kNotReceived),
+      begin_seq_(0),
+      end_seq_(0) {}
 
 RemoteEstimatorProxy::~RemoteEstimatorProxy() {}
 
@@ -112,29 +118,66 @@ void RemoteEstimatorProxy::OnPacketArrival(uint16_t sequence_number,
     return;
   }
 
-  if (packet_arrival_times_.lower_bound(window_start_seq_) ==
-      packet_arrival_times_.end()) {
+  if (window_start_seq_ >= end_seq_) {
     // Start new feedback packet, cull old packets.
-    for (auto it = packet_arrival_times_.begin();
-         it != packet_arrival_times_.end() && it->first < seq &&
-         arrival_time - it->second >= kBackWindowMs;) {
-      auto delete_it = it;
-      ++it;
-      packet_arrival_times_.erase(delete_it);
+    while (begin_seq_ < end_seq_ && begin_seq_ < seq) {
+      int64_t time = ArrivalTime(begin_seq_);
+      if (time != kNotReceived && arrival_time - time < kBackWindowMs)
+        break;
+      ++begin_seq_;
     }
   }
 
+  const int64_t num_packets = static_cast<int64_t>(kMaxNumberOfPackets);
+  if (begin_seq_ < end_seq_ && end_seq_ - seq > num_packets) {
+    LOG(LS_WARNING) << "Skipping this sequence number (" << sequence_number
+                    << ") since it is too old to keep along with the "
+                       "newer ones.";
+    return;
+  }
+
   if (window_start_seq_ == -1) {
     window_start_seq_ = sequence_number;
   } else if (seq < window_start_seq_) {
     window_start_seq_ = seq;
   }
 
+  if (begin_seq_ == end_seq_) {
+    begin_seq_ = seq;
+    end_seq_ = seq;
+  }
+  // A reordered packet older than the ones kept.
+  for (; begin_seq_ > seq; --begin_seq_)
+    ArrivalTime(begin_seq_ - 1) = kNotReceived;
+  if (seq >= end_seq_) {
+    // Drop the oldest arrival times if the newest doesn't fit, along with any
+    // feedback not yet sent for them.
+    if (seq + 1 - begin_seq_ > num_packets) {
+      begin_seq_ = seq + 1 - num_packets;
+      window_start_seq_ = std::max(window_start_seq_, begin_seq_);
+    }
+    for (end_seq_ = std::max(end_seq_, begin_seq_); end_seq_ <= seq;
+         ++end_seq_) {
+      ArrivalTime(end_seq_) = kNotReceived;
+    }
+  }
+
   // We are only interested in the first time a packet is received.
-  if (packet_arrival_times_.find(seq) != packet_arrival_times_.end())
-    return;
+  int64_t& time = ArrivalTime(seq);
+  if (time == kNotReceived)
+    time = arrival_time;
+}
 
-  packet_arrival_times_[seq] = arrival_time;
+int64_t& RemoteEstimatorProxy::ArrivalTime(int64_t seq) {
+  return arrival_times_[static_cast<size_t>(seq) & (kMaxNumberOfPackets - 1)];
+}
+
+int64_t RemoteEstimatorProxy::NextReceived(int64_t seq) {
+  for (seq = std::max(seq, begin_seq_); seq < end_seq_; ++seq) {
+    if (ArrivalTime(seq) != kNotReceived)
+      break;
+  }
+  return std::min(seq, end_seq_);
 }
 
 bool RemoteEstimatorProxy::BuildFeedbackPacket(
@@ -143,38 +186,38 @@ bool RemoteEstimatorProxy::BuildFeedbackPacket(
   // feedback packet. Some older may still be in the map, in case a reordering
   // happens and we need to retransmit them.
   rtc::CritScope cs(&lock_);
-  auto it = packet_arrival_times_.lower_bound(window_start_seq_);
-  if (it == packet_arrival_times_.end()) {
+  int64_t seq = NextReceived(window_start_seq_);
+  if (seq == end_seq_) {
     // Feedback for all packets already sent.
     return false;
   }
 
   // TODO(sprang): Measure receive times in microseconds and remove the
   // conversions below.
-  const int64_t first_sequence = it->first;
+  const int64_t first_sequence = seq;
   feedback_packet->SetMediaSsrc(media_ssrc_);
   // Base sequence is the expected next (window_start_seq_). This is known, but
   // we might not have actually received it, so the base time shall be the time
   // of the first received packet in the feedback.
   feedback_packet->SetBase(static_cast<uint16_t>(window_start_seq_ & 0xFFFF),
-                           it->second * 1000);
+                           ArrivalTime(seq) * 1000);
   feedback_packet->SetFeedbackSequenceNumber(feedback_sequence_++);
-  for (; it != packet_arrival_times_.end(); ++it) {
-    if (!feedback_packet->AddReceivedPacket(
-            static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
+  for (; seq < end_seq_; seq = NextReceived(seq + 1)) {
+    if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq & 0xFFFF),
+                                            ArrivalTime(seq) * 1000)) {
       // If we can't even add the first seq to the feedback packet, we won't be
       // able to build it at all.
-      RTC_CHECK_NE(first_sequence, it->first);
+      RTC_CHECK_NE(first_sequence, seq);
 
       // Could not add timestamp, feedback packet might be full. Return and
       // try again with a fresh packet.
       break;
     }
 
-    // Note: Don't erase items from packet_arrival_times_ after sending, in case
-    // they need to be re-sent after a reordering. Removal will be handled
-    // by OnPacketArrival once packets are too old.
-    window_start_seq_ = it->first + 1;
+    // Note: Don't drop arrival times after sending, in case they need to be
+    // re-sent after a reordering. Removal will be handled by OnPacketArrival
+    // once packets are too old.
+    window_start_seq_ = seq + 1;
   }
 
   return true;
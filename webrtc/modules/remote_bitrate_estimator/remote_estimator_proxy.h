@@ -11,7 +11,6 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 
-#include <map>
 #include <vector>
 
 #include "webrtc/base/criticalsection.h"
@@ -50,11 +49,18 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
 
   static const int kDefaultProcessIntervalMs;
   static const int kBackWindowMs;
+  // Number of sequence numbers the arrival times are kept for. At a few
+  // thousand packets per second that is well beyond |kBackWindowMs|.
+  static const size_t kMaxNumberOfPackets;
 
  private:
   void OnPacketArrival(uint16_t sequence_number, int64_t arrival_time)
       EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   bool BuildFeedbackPacket(rtcp::TransportFeedback* feedback_packet);
+  int64_t& ArrivalTime(int64_t seq) EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // First sequence number in [seq, end_seq_) that has an arrival time, or
+  // end_seq_ if there is none.
+  int64_t NextReceived(int64_t seq) EXCLUSIVE_LOCKS_REQUIRED(&lock_);
 
   Clock* const clock_;
   PacketRouter* const packet_router_;
@@ -66,8 +72,12 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   uint8_t feedback_sequence_ GUARDED_BY(&lock_);
   SequenceNumberUnwrapper unwrapper_ GUARDED_BY(&lock_);
   int64_t window_start_seq_ GUARDED_BY(&lock_);
-  // Map unwrapped seq -> time.
-  std::map<int64_t, int64_t> packet_arrival_times_ GUARDED_BY(&lock_);
+  // Ring buffer of arrival times, indexed by unwrapped sequence number, for the
+  // sequence numbers in [begin_seq_, end_seq_). Allocated once, so that
+  // recording an arrival never allocates. Packets not received have time -1.
+  std::vector<int64_t> arrival_times_ GUARDED_BY(&lock_);
+  int64_t begin_seq_ GUARDED_BY(&lock_);
+  int64_t end_seq_ GUARDED_BY(&lock_);
 };
 
 }  // namespace webrtc
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/pacing/packet_router.h"
+#include "webrtc/modules/remote_bitrate_estimator/remote_estimator_proxy.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+// A video stream at 2000 packets per second, e.g. 20 Mbps of screen share,
+// gets this many packets per feedback interval.
+const int kPacketsPerSecond = 2000;
+const int kPacketsPerFeedback =
+    kPacketsPerSecond * RemoteEstimatorProxy::kDefaultProcessIntervalMs / 1000;
+const size_t kPayloadSize = 1200;
+// Every this many packets one is lost, so that the feedback needs vector
+// chunks as well as run length ones.
+const int kLossInterval = 25;
+
+// Serializes the feedback into a reused buffer, the way RTCPSender writes it
+// into the outgoing packet.
+class SerializingPacketRouter : public PacketRouter,
+                                public rtcp::RtcpPacket::PacketReadyCallback {
+ public:
+  bool SendFeedback(rtcp::TransportFeedback* packet) override {
+    return packet->BuildExternalBuffer(buffer_, sizeof(buffer_), this);
+  }
+
+  void OnPacketReady(uint8_t* data, size_t length) override {
+    bytes_sent_ += length;
+  }
+
+  size_t bytes_sent() const { return bytes_sent_; }
+
+ private:
+  uint8_t buffer_[IP_PACKET_SIZE];
+  size_t bytes_sent_ = 0;
+};
+
+test::BenchmarkOptions FeedbackOptions() {
+  test::BenchmarkOptions options;
+  options.warmup_iterations = 20;
+  options.iterations = 100;
+  return options;
+}
+
+}  // namespace
+
+// Records a feedback interval's worth of arrivals and sends the feedback for
+// them, as the receive side of a send-side BWE stream does 20 times a second.
+TEST(RemoteEstimatorProxyBenchmark, FeedbackInterval) {
+  SimulatedClock clock(0);
+  SerializingPacketRouter router;
+  RemoteEstimatorProxy proxy(&clock, &router);
+  RTPHeader header;
+  header.ssrc = 0x12345678;
+  header.extension.hasTransportSequenceNumber = true;
+  uint16_t seq = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "remote_estimator_proxy_2000_pps_50_ms", FeedbackOptions(), [&] {
+        for (int i = 0; i < kPacketsPerFeedback; ++i) {
+          header.extension.transportSequenceNumber = seq++;
+          if (seq % kLossInterval == 0)
+            continue;
+          proxy.IncomingPacket(
+              clock.TimeInMilliseconds() +
+                  i * RemoteEstimatorProxy::kDefaultProcessIntervalMs /
+                      kPacketsPerFeedback,
+              kPayloadSize, header);
+        }
+        clock.AdvanceTimeMilliseconds(
+            RemoteEstimatorProxy::kDefaultProcessIntervalMs);
+        proxy.Process();
+      }));
+  EXPECT_GT(router.bytes_sent(), 0u);
+}
+
+// Builds and serializes the feedback for a feedback interval on its own.
+TEST(RemoteEstimatorProxyBenchmark, BuildTransportFeedback) {
+  SerializingPacketRouter router;
+  const int64_t kPacketIntervalUs = 1000000 / kPacketsPerSecond;
+  test::ReportBenchmark(test::RunBenchmark(
+      "transport_feedback_build_100_packets", FeedbackOptions(), [&] {
+        rtcp::TransportFeedback feedback;
+        feedback.SetMediaSsrc(0x12345678);
+        feedback.SetBase(0, 0);
+        for (int i = 0; i < kPacketsPerFeedback; ++i) {
+          if ((i + 1) % kLossInterval != 0)
+            feedback.AddReceivedPacket(i, i * kPacketIntervalUs);
+        }
+        router.SendFeedback(&feedback);
+      }));
+  EXPECT_GT(router.bytes_sent(), 0u);
+}
+
+}  // namespace webrtc
@@ -350,4 +350,59 @@ TEST_F(RemoteEstimatorProxyTest, RemovesTimestampsOutOfScope) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, SendsFeedbackForEveryPacket) {
+  // Enough packets for the arrival times to wrap around a few times.
+  const int kNumBatches = 40;
+  const int kPacketsPerBatch = 1000;
+  uint16_t seq = kBaseSeq;
+  int64_t time_ms = kBaseTimeMs;
+  for (int batch = 0; batch < kNumBatches; ++batch) {
+    const uint16_t first_seq = seq;
+    for (int i = 0; i < kPacketsPerBatch; ++i)
+      IncomingPacket(seq++, time_ms++);
+
+    EXPECT_CALL(router_, SendFeedback(_))
+        .Times(1)
+        .WillOnce(Invoke([first_seq, kPacketsPerBatch](
+            rtcp::TransportFeedback* packet) {
+          packet->Build();
+          EXPECT_EQ(first_seq, packet->GetBaseSequence());
+          std::vector<int64_t> delta_vec = packet->GetReceiveDeltasUs();
+          EXPECT_EQ(static_cast<size_t>(kPacketsPerBatch), delta_vec.size());
+          for (size_t i = 1; i < delta_vec.size(); ++i)
+            EXPECT_EQ(1, delta_vec[i] / 1000);
+          return true;
+        }));
+
+    Process();
+  }
+}
+
+TEST_F(RemoteEstimatorProxyTest, DropsOldestArrivalTimesWhenFull) {
+  const uint16_t kLastSeq = static_cast<uint16_t>(
+      kBaseSeq + RemoteEstimatorProxy::kMaxNumberOfPackets);
+  IncomingPacket(kBaseSeq, kBaseTimeMs);
+  IncomingPacket(kBaseSeq + 1, kBaseTimeMs + 1);
+  // Doesn't fit along with kBaseSeq, which is dropped.
+  IncomingPacket(kLastSeq, kBaseTimeMs + 2);
+
+  EXPECT_CALL(router_, SendFeedback(_))
+      .Times(1)
+      .WillOnce(Invoke([kLastSeq, this](rtcp::TransportFeedback* packet) {
+        packet->Build();
+        EXPECT_EQ(kBaseSeq + 1, packet->GetBaseSequence());
+        EXPECT_EQ(static_cast<size_t>(kLastSeq - kBaseSeq),
+                  packet->GetStatusVector().size());
+
+        std::vector<int64_t> delta_vec = packet->GetReceiveDeltasUs();
+        EXPECT_EQ(2u, delta_vec.size());
+        EXPECT_EQ(kBaseTimeMs + 1,
+                  (packet->GetBaseTimeUs() + delta_vec[0]) / 1000);
+        EXPECT_EQ(1, delta_vec[1] / 1000);
+        return true;
+      }));
+
+  Process();
+}
+
 }  // namespace webrtc
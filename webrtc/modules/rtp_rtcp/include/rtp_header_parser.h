@@ -27,8 +27,8 @@ class RtpHeaderParser {
 
   // Parses the packet and stores the parsed packet in |header|. Returns true on
   // success, false otherwise.
-  // This method is thread-safe in the sense that it can parse multiple packets
-  // at once.
+  // This method is thread-safe, but calls made at once are serialized, since
+  // they parse with the registered extensions in place.
   virtual bool Parse(const uint8_t* packet,
                      size_t length,
                      RTPHeader* header) const = 0;
@@ -24,737 +24,70 @@
 // in fec_private_tables.h, is more significant for longer codes
 // (i.e., more packets/symbols in the code, so larger (k,m), i.e.,  k > 4,
 // m > 3).
+//
+// The masks are stored in compressed form. The masks for k media packets start
+// at byte offset kPacketMaskBurstyTblOffsets[k - 1] in kPacketMaskBurstyTbl.
+// See DecodePacketMasks() in forward_error_correction_internal.cc for the
+// format.
 
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
 namespace fec_private_tables {
 
-const uint8_t kMaskBursty1_1[2] = {
-  0x80, 0x00
-};
-
-const uint8_t kMaskBursty2_1[2] = {
-  0xc0, 0x00
-};
-
-const uint8_t kMaskBursty2_2[4] = {
-  0x80, 0x00,
-  0xc0, 0x00
-};
-
-const uint8_t kMaskBursty3_1[2] = {
-  0xe0, 0x00
-};
-
-const uint8_t kMaskBursty3_2[4] = {
-  0xc0, 0x00,
-  0xa0, 0x00
-};
-
-const uint8_t kMaskBursty3_3[6] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00
-};
-
-const uint8_t kMaskBursty4_1[2] = {
-  0xf0, 0x00
-};
-
-const uint8_t kMaskBursty4_2[4] = {
-  0xa0, 0x00,
-  0xd0, 0x00
-};
-
-const uint8_t kMaskBursty4_3[6] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x90, 0x00
-};
-
-const uint8_t kMaskBursty4_4[8] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00
-};
-
-const uint8_t kMaskBursty5_1[2] = {
-  0xf8, 0x00
-};
-
-const uint8_t kMaskBursty5_2[4] = {
-  0xd0, 0x00,
-  0xa8, 0x00
-};
-
-const uint8_t kMaskBursty5_3[6] = {
-  0x70, 0x00,
-  0x90, 0x00,
-  0xc8, 0x00
-};
-
-const uint8_t kMaskBursty5_4[8] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x88, 0x00
-};
-
-const uint8_t kMaskBursty5_5[10] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00
-};
-
-const uint8_t kMaskBursty6_1[2] = {
-  0xfc, 0x00
-};
-
-const uint8_t kMaskBursty6_2[4] = {
-  0xa8, 0x00,
-  0xd4, 0x00
-};
-
-const uint8_t kMaskBursty6_3[6] = {
-  0x94, 0x00,
-  0xc8, 0x00,
-  0x64, 0x00
-};
-
-const uint8_t kMaskBursty6_4[8] = {
-  0x60, 0x00,
-  0x38, 0x00,
-  0x88, 0x00,
-  0xc4, 0x00
-};
-
-const uint8_t kMaskBursty6_5[10] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x84, 0x00
-};
-
-const uint8_t kMaskBursty6_6[12] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00
-};
-
-const uint8_t kMaskBursty7_1[2] = {
-  0xfe, 0x00
-};
-
-const uint8_t kMaskBursty7_2[4] = {
-  0xd4, 0x00,
-  0xaa, 0x00
-};
-
-const uint8_t kMaskBursty7_3[6] = {
-  0xc8, 0x00,
-  0x74, 0x00,
-  0x92, 0x00
-};
-
-const uint8_t kMaskBursty7_4[8] = {
-  0x38, 0x00,
-  0x8a, 0x00,
-  0xc4, 0x00,
-  0x62, 0x00
-};
-
-const uint8_t kMaskBursty7_5[10] = {
-  0x60, 0x00,
-  0x30, 0x00,
-  0x1c, 0x00,
-  0x84, 0x00,
-  0xc2, 0x00
-};
-
-const uint8_t kMaskBursty7_6[12] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x82, 0x00
-};
-
-const uint8_t kMaskBursty7_7[14] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00
-};
-
-const uint8_t kMaskBursty8_1[2] = {
-  0xff, 0x00
-};
-
-const uint8_t kMaskBursty8_2[4] = {
-  0xaa, 0x00,
-  0xd5, 0x00
-};
-
-const uint8_t kMaskBursty8_3[6] = {
-  0x74, 0x00,
-  0x92, 0x00,
-  0xc9, 0x00
-};
-
-const uint8_t kMaskBursty8_4[8] = {
-  0x8a, 0x00,
-  0xc5, 0x00,
-  0x62, 0x00,
-  0x31, 0x00
-};
-
-const uint8_t kMaskBursty8_5[10] = {
-  0x30, 0x00,
-  0x1c, 0x00,
-  0x85, 0x00,
-  0xc2, 0x00,
-  0x61, 0x00
-};
-
-const uint8_t kMaskBursty8_6[12] = {
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0e, 0x00,
-  0x82, 0x00,
-  0xc1, 0x00
-};
-
-const uint8_t kMaskBursty8_7[14] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x81, 0x00
-};
-
-const uint8_t kMaskBursty8_8[16] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00
-};
-
-const uint8_t kMaskBursty9_1[2] = {
-  0xff, 0x80
-};
-
-const uint8_t kMaskBursty9_2[4] = {
-  0xd5, 0x00,
-  0xaa, 0x80
-};
-
-const uint8_t kMaskBursty9_3[6] = {
-  0x92, 0x00,
-  0xc9, 0x00,
-  0x74, 0x80
-};
-
-const uint8_t kMaskBursty9_4[8] = {
-  0xc5, 0x00,
-  0x62, 0x00,
-  0x39, 0x00,
-  0x8a, 0x80
-};
-
-const uint8_t kMaskBursty9_5[10] = {
-  0x1c, 0x00,
-  0x85, 0x00,
-  0xc2, 0x80,
-  0x61, 0x00,
-  0x30, 0x80
-};
-
-const uint8_t kMaskBursty9_6[12] = {
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0e, 0x00,
-  0x82, 0x80,
-  0xc1, 0x00,
-  0x60, 0x80
-};
-
-const uint8_t kMaskBursty9_7[14] = {
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x07, 0x00,
-  0x81, 0x00,
-  0xc0, 0x80
-};
-
-const uint8_t kMaskBursty9_8[16] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x80, 0x80
-};
-
-const uint8_t kMaskBursty9_9[18] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80
-};
-
-const uint8_t kMaskBursty10_1[2] = {
-  0xff, 0xc0
-};
-
-const uint8_t kMaskBursty10_2[4] = {
-  0xaa, 0x80,
-  0xd5, 0x40
-};
-
-const uint8_t kMaskBursty10_3[6] = {
-  0xc9, 0x00,
-  0x74, 0x80,
-  0x92, 0x40
-};
-
-const uint8_t kMaskBursty10_4[8] = {
-  0x62, 0x00,
-  0x39, 0x00,
-  0x8a, 0x80,
-  0xc5, 0x40
-};
-
-const uint8_t kMaskBursty10_5[10] = {
-  0x85, 0x00,
-  0xc2, 0x80,
-  0x61, 0x40,
-  0x30, 0x80,
-  0x18, 0x40
-};
-
-const uint8_t kMaskBursty10_6[12] = {
-  0x18, 0x00,
-  0x0e, 0x00,
-  0x82, 0x80,
-  0xc1, 0x40,
-  0x60, 0x80,
-  0x30, 0x40
-};
-
-const uint8_t kMaskBursty10_7[14] = {
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x07, 0x00,
-  0x81, 0x40,
-  0xc0, 0x80,
-  0x60, 0x40
-};
-
-const uint8_t kMaskBursty10_8[16] = {
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x80, 0x80,
-  0xc0, 0x40
-};
-
-const uint8_t kMaskBursty10_9[18] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x80, 0x40
-};
-
-const uint8_t kMaskBursty10_10[20] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x00, 0xc0
-};
-
-const uint8_t kMaskBursty11_1[2] = {
-  0xff, 0xe0
-};
-
-const uint8_t kMaskBursty11_2[4] = {
-  0xd5, 0x40,
-  0xaa, 0xa0
-};
-
-const uint8_t kMaskBursty11_3[6] = {
-  0x74, 0x80,
-  0x92, 0x40,
-  0xc9, 0x20
-};
-
-const uint8_t kMaskBursty11_4[8] = {
-  0x39, 0x00,
-  0x8a, 0x80,
-  0xc5, 0x40,
-  0x62, 0x20
-};
-
-const uint8_t kMaskBursty11_5[10] = {
-  0xc2, 0xc0,
-  0x61, 0x00,
-  0x30, 0xa0,
-  0x1c, 0x40,
-  0x85, 0x20
-};
-
-const uint8_t kMaskBursty11_6[12] = {
-  0x0e, 0x00,
-  0x82, 0x80,
-  0xc1, 0x40,
-  0x60, 0xa0,
-  0x30, 0x40,
-  0x18, 0x20
-};
-
-const uint8_t kMaskBursty11_7[14] = {
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x07, 0x00,
-  0x81, 0x40,
-  0xc0, 0xa0,
-  0x60, 0x40,
-  0x30, 0x20
-};
-
-const uint8_t kMaskBursty11_8[16] = {
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x40,
-  0x80, 0xa0,
-  0xc0, 0x40,
-  0x60, 0x20
-};
-
-const uint8_t kMaskBursty11_9[18] = {
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x80, 0x40,
-  0xc0, 0x20
-};
-
-const uint8_t kMaskBursty11_10[20] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x00, 0xc0,
-  0x80, 0x20
-};
-
-const uint8_t kMaskBursty11_11[22] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x00, 0xc0,
-  0x00, 0x60
-};
-
-const uint8_t kMaskBursty12_1[2] = {
-  0xff, 0xf0
-};
-
-const uint8_t kMaskBursty12_2[4] = {
-  0xaa, 0xa0,
-  0xd5, 0x50
-};
-
-const uint8_t kMaskBursty12_3[6] = {
-  0x92, 0x40,
-  0xc9, 0x20,
-  0x74, 0x90
-};
-
-const uint8_t kMaskBursty12_4[8] = {
-  0x8a, 0x80,
-  0xc5, 0x40,
-  0x62, 0x20,
-  0x39, 0x10
-};
-
-const uint8_t kMaskBursty12_5[10] = {
-  0x61, 0x00,
-  0x30, 0xa0,
-  0x1c, 0x50,
-  0x85, 0x20,
-  0xc2, 0x90
-};
-
-const uint8_t kMaskBursty12_6[12] = {
-  0x82, 0x90,
-  0xc1, 0x40,
-  0x60, 0xa0,
-  0x30, 0x50,
-  0x18, 0x20,
-  0x0c, 0x10
-};
-
-const uint8_t kMaskBursty12_7[14] = {
-  0x0c, 0x00,
-  0x07, 0x00,
-  0x81, 0x40,
-  0xc0, 0xa0,
-  0x60, 0x50,
-  0x30, 0x20,
-  0x18, 0x10
-};
-
-const uint8_t kMaskBursty12_8[16] = {
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x80, 0xa0,
-  0xc0, 0x50,
-  0x60, 0x20,
-  0x30, 0x10
-};
-
-const uint8_t kMaskBursty12_9[18] = {
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x80, 0x50,
-  0xc0, 0x20,
-  0x60, 0x10
-};
-
-const uint8_t kMaskBursty12_10[20] = {
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x00, 0xc0,
-  0x80, 0x20,
-  0xc0, 0x10
-};
-
-const uint8_t kMaskBursty12_11[22] = {
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x00, 0xc0,
-  0x00, 0x60,
-  0x80, 0x10
-};
-
-const uint8_t kMaskBursty12_12[24] = {
-  0x80, 0x00,
-  0xc0, 0x00,
-  0x60, 0x00,
-  0x30, 0x00,
-  0x18, 0x00,
-  0x0c, 0x00,
-  0x06, 0x00,
-  0x03, 0x00,
-  0x01, 0x80,
-  0x00, 0xc0,
-  0x00, 0x60,
-  0x00, 0x30
-};
-
-const uint8_t* kPacketMaskBursty1[1] = {
-  kMaskBursty1_1
-};
-
-const uint8_t* kPacketMaskBursty2[2] = {
-  kMaskBursty2_1,
-  kMaskBursty2_2
-};
-
-const uint8_t* kPacketMaskBursty3[3] = {
-  kMaskBursty3_1,
-  kMaskBursty3_2,
-  kMaskBursty3_3
-};
-
-const uint8_t* kPacketMaskBursty4[4] = {
-  kMaskBursty4_1,
-  kMaskBursty4_2,
-  kMaskBursty4_3,
-  kMaskBursty4_4
-};
-
-const uint8_t* kPacketMaskBursty5[5] = {
-  kMaskBursty5_1,
-  kMaskBursty5_2,
-  kMaskBursty5_3,
-  kMaskBursty5_4,
-  kMaskBursty5_5
-};
-
-const uint8_t* kPacketMaskBursty6[6] = {
-  kMaskBursty6_1,
-  kMaskBursty6_2,
-  kMaskBursty6_3,
-  kMaskBursty6_4,
-  kMaskBursty6_5,
-  kMaskBursty6_6
-};
-
-const uint8_t* kPacketMaskBursty7[7] = {
-  kMaskBursty7_1,
-  kMaskBursty7_2,
-  kMaskBursty7_3,
-  kMaskBursty7_4,
-  kMaskBursty7_5,
-  kMaskBursty7_6,
-  kMaskBursty7_7
-};
-
-const uint8_t* kPacketMaskBursty8[8] = {
-  kMaskBursty8_1,
-  kMaskBursty8_2,
-  kMaskBursty8_3,
-  kMaskBursty8_4,
-  kMaskBursty8_5,
-  kMaskBursty8_6,
-  kMaskBursty8_7,
-  kMaskBursty8_8
-};
-
-const uint8_t* kPacketMaskBursty9[9] = {
-  kMaskBursty9_1,
-  kMaskBursty9_2,
-  kMaskBursty9_3,
-  kMaskBursty9_4,
-  kMaskBursty9_5,
-  kMaskBursty9_6,
-  kMaskBursty9_7,
-  kMaskBursty9_8,
-  kMaskBursty9_9
-};
-
-const uint8_t* kPacketMaskBursty10[10] = {
-  kMaskBursty10_1,
-  kMaskBursty10_2,
-  kMaskBursty10_3,
-  kMaskBursty10_4,
-  kMaskBursty10_5,
-  kMaskBursty10_6,
-  kMaskBursty10_7,
-  kMaskBursty10_8,
-  kMaskBursty10_9,
-  kMaskBursty10_10
-};
-
-const uint8_t* kPacketMaskBursty11[11] = {
-  kMaskBursty11_1,
-  kMaskBursty11_2,
-  kMaskBursty11_3,
-  kMaskBursty11_4,
-  kMaskBursty11_5,
-  kMaskBursty11_6,
-  kMaskBursty11_7,
-  kMaskBursty11_8,
-  kMaskBursty11_9,
-  kMaskBursty11_10,
-  kMaskBursty11_11
-};
-
-const uint8_t* kPacketMaskBursty12[12] = {
-  kMaskBursty12_1,
-  kMaskBursty12_2,
-  kMaskBursty12_3,
-  kMaskBursty12_4,
-  kMaskBursty12_5,
-  kMaskBursty12_6,
-  kMaskBursty12_7,
-  kMaskBursty12_8,
-  kMaskBursty12_9,
-  kMaskBursty12_10,
-  kMaskBursty12_11,
-  kMaskBursty12_12
-};
-
-const uint8_t** kPacketMaskBurstyTbl[12] = {
-  kPacketMaskBursty1,
-  kPacketMaskBursty2,
-  kPacketMaskBursty3,
-  kPacketMaskBursty4,
-  kPacketMaskBursty5,
-  kPacketMaskBursty6,
-  kPacketMaskBursty7,
-  kPacketMaskBursty8,
-  kPacketMaskBursty9,
-  kPacketMaskBursty10,
-  kPacketMaskBursty11,
-  kPacketMaskBursty12
+const uint8_t kPacketMaskBurstyTbl[561] = {
+  0xc0, 0x80, 0xc0, 0xe0, 0xc0, 0xc0, 0xe1, 0x6c, 0x1b, 0x0a, 0x0c, 0x26,
+  0xc0, 0xe0, 0xd8, 0x5b, 0x0f, 0x30, 0x9e, 0x14, 0xc3, 0x80, 0x1c, 0x33,
+  0xc0, 0xe2, 0x6b, 0x06, 0xc3, 0x7c, 0x29, 0x87, 0x98, 0x98, 0xc3, 0x6c,
+  0x33, 0xc3, 0x8c, 0x48, 0x00, 0x96, 0x20, 0xc0, 0xc0, 0xe0, 0xd8, 0x9a,
+  0xc4, 0x96, 0x2e, 0x58, 0x6d, 0x88, 0xcc, 0x43, 0xe1, 0xc6, 0x26, 0x31,
+  0x70, 0x0c, 0x33, 0xc4, 0x1e, 0x24, 0x31, 0x60, 0x00, 0x44, 0x3c, 0x50,
+  0xc0, 0xc0, 0xe3, 0x6a, 0xc1, 0xb1, 0xb2, 0x62, 0xbb, 0x85, 0x31, 0x0f,
+  0x8b, 0x16, 0x36, 0x2c, 0x46, 0x62, 0xb1, 0x88, 0x6c, 0x51, 0xf1, 0x21,
+  0x8b, 0x86, 0x36, 0x00, 0x07, 0x10, 0x78, 0xa1, 0xe2, 0xc1, 0x8d, 0x00,
+  0x01, 0x10, 0xc9, 0x8c, 0x0c, 0xc0, 0xe0, 0xd8, 0xda, 0xb1, 0x9d, 0x61,
+  0x4c, 0x6c, 0x98, 0xb1, 0x63, 0x62, 0xc6, 0x63, 0x88, 0x6c, 0x53, 0x31,
+  0x47, 0xc6, 0x85, 0x8f, 0x85, 0x8a, 0xc6, 0x33, 0x00, 0x62, 0x0f, 0x18,
+  0x3e, 0x2c, 0x18, 0xd8, 0x31, 0xf0, 0x00, 0x11, 0x62, 0x87, 0x8c, 0x0f,
+  0x1a, 0x06, 0x3c, 0x00, 0x02, 0x21, 0x90, 0xb8, 0xe0, 0x60, 0xc0, 0xe4,
+  0x6a, 0xb0, 0x6c, 0x29, 0x91, 0x92, 0xc6, 0x75, 0x91, 0x8a, 0xc7, 0x62,
+  0xc7, 0x39, 0xc7, 0x8a, 0xc5, 0x1f, 0x1a, 0x16, 0x3e, 0x16, 0x3b, 0x0e,
+  0x29, 0x98, 0xc6, 0x31, 0x46, 0xc6, 0x0f, 0x8f, 0x05, 0x91, 0x82, 0xc6,
+  0x61, 0x8e, 0xc0, 0x00, 0xe2, 0x87, 0x8e, 0x0f, 0x8d, 0x03, 0x1f, 0x03,
+  0x23, 0x00, 0x00, 0x88, 0x78, 0xc0, 0xf1, 0xc0, 0xf1, 0xe0, 0x32, 0x20,
+  0x00, 0x08, 0x86, 0x42, 0x9b, 0x20, 0x06, 0xc0, 0xe0, 0xd9, 0x1a, 0xac,
+  0x9c, 0x93, 0x21, 0xd3, 0x85, 0x32, 0x18, 0x98, 0xe7, 0x38, 0xf1, 0x59,
+  0x18, 0xac, 0x68, 0x59, 0x38, 0x56, 0x3b, 0x0e, 0x41, 0x87, 0x14, 0x6c,
+  0x61, 0x98, 0xc1, 0xf1, 0xe0, 0xb2, 0x30, 0x59, 0x0c, 0x1c, 0x63, 0x18,
+  0xe6, 0x00, 0xc5, 0x0f, 0x1c, 0x1f, 0x22, 0x05, 0x93, 0x81, 0x63, 0xb0,
+  0x64, 0x30, 0x00, 0x11, 0x63, 0x03, 0xc7, 0x03, 0xc7, 0x80, 0xc8, 0xc0,
+  0x64, 0xe0, 0x00, 0x08, 0x86, 0x42, 0xe4, 0x00, 0xf2, 0x20, 0x19, 0x30,
+  0x00, 0x00, 0x84, 0x18, 0x82, 0x8c, 0x3e, 0x48, 0x06, 0xc0, 0xe5, 0x6a,
+  0xac, 0x1b, 0x25, 0xd2, 0xc2, 0x99, 0x39, 0x26, 0x41, 0xcb, 0x1e, 0x2b,
+  0x2b, 0x15, 0x64, 0x31, 0x31, 0xf0, 0xb2, 0x58, 0x4c, 0xa3, 0x0b, 0x92,
+  0x38, 0xe4, 0xc2, 0x98, 0xc1, 0xf1, 0xe0, 0xb2, 0xb0, 0x56, 0x43, 0x07,
+  0x24, 0xc1, 0xc6, 0x19, 0x8e, 0x31, 0x8c, 0x1b, 0x1c, 0x1f, 0x22, 0x05,
+  0x93, 0x81, 0x64, 0xb0, 0x38, 0xe6, 0x19, 0x06, 0x00, 0x07, 0x18, 0x1e,
+  0x48, 0x1b, 0x93, 0x01, 0x65, 0x60, 0x2c, 0x86, 0x06, 0x4b, 0x00, 0x00,
+  0x88, 0x78, 0xe0, 0x79, 0x00, 0x3c, 0x88, 0x06, 0x4e, 0x01, 0x95, 0x80,
+  0x00, 0x04, 0x20, 0xc4, 0x14, 0x6c, 0x90, 0x0f, 0x26, 0x00, 0xca, 0x80,
+  0x00, 0x02, 0x10, 0x62, 0x0a, 0x30, 0xe4, 0x65, 0x00, 0x30, 0xc0, 0xe0,
+  0xd9, 0x5a, 0xab, 0x0a, 0x65, 0xe4, 0x96, 0x4b, 0xa5, 0x8f, 0x15, 0x97,
+  0x8a, 0x99, 0x4c, 0x47, 0x20, 0xe5, 0x94, 0xc2, 0x32, 0x8c, 0x2e, 0x58,
+  0xe2, 0xe4, 0xc2, 0x99, 0x58, 0x53, 0x2a, 0x0a, 0x65, 0xe0, 0xa6, 0x53,
+  0x05, 0xcb, 0x30, 0x5c, 0xa1, 0x83, 0x8c, 0x1b, 0x1c, 0x33, 0x1c, 0x1f,
+  0x22, 0x05, 0x97, 0x81, 0x59, 0x2c, 0x0e, 0x51, 0x81, 0xc7, 0x18, 0xc8,
+  0x18, 0x03, 0x18, 0x1e, 0x38, 0x1e, 0x4c, 0x05, 0x95, 0x80, 0xb2, 0x98,
+  0x0e, 0x41, 0x83, 0x24, 0xc0, 0x00, 0x44, 0x3c, 0x80, 0x1e, 0x54, 0x02,
+  0xcb, 0xc0, 0x2c, 0x96, 0x03, 0x29, 0x80, 0x00, 0x08, 0x41, 0x88, 0x2e,
+  0x48, 0x07, 0x93, 0x00, 0x65, 0x60, 0x0c, 0xbc, 0x00, 0x00, 0x10, 0x83,
+  0x10, 0x51, 0x87, 0xca, 0x00, 0x79, 0x50, 0x03, 0x2e, 0x00, 0x00, 0x04,
+  0x20, 0xc4, 0x14, 0x61, 0xc8, 0x27, 0x2c, 0x00, 0xc0
+};
+
+const uint16_t kPacketMaskBurstyTblOffsets[12] = {
+  0, 2, 5, 12, 24, 44, 73, 113,
+  166, 235, 321, 430
 };
 
 }  // namespace fec_private_tables
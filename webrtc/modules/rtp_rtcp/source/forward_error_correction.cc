@@ -29,6 +29,69 @@ namespace webrtc {
 namespace {
 // Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
 constexpr size_t kTransportOverhead = 28;
+
+constexpr size_t kBitsPerMaskWord = 64;
+constexpr size_t kMaxPacketMaskBits =
+    kFecMaxPacketMaskWords * kBitsPerMaskWord;
+
+// Upper bound on the number of pooled recovered packets, expressed as a
+// multiple of the maximum number of media packets covered by an FEC packet.
+constexpr size_t kRecoveredPacketPoolFactor = 2;
+
+int NumBitsSet(uint64_t word) {
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+}
+
+bool IsBitSet(const uint64_t* mask, size_t bit) {
+  return (mask[bit / kBitsPerMaskWord] >> (bit % kBitsPerMaskWord)) & 1;
+}
+
+void SetBit(uint64_t* mask, size_t bit) {
+  mask[bit / kBitsPerMaskWord] |= uint64_t{1} << (bit % kBitsPerMaskWord);
+}
+
+void ClearBit(uint64_t* mask, size_t bit) {
+  mask[bit / kBitsPerMaskWord] &= ~(uint64_t{1} << (bit % kBitsPerMaskWord));
+}
+
+// Returns the number of bits set in |mask| below position |bit|.
+size_t NumBitsSetBelow(const uint64_t* mask, size_t bit) {
+  size_t count = 0;
+  const size_t word_idx = bit / kBitsPerMaskWord;
+  for (size_t i = 0; i < word_idx; ++i) {
+    count += NumBitsSet(mask[i]);
+  }
+  const size_t bit_idx = bit % kBitsPerMaskWord;
+  if (bit_idx > 0) {
+    count += NumBitsSet(mask[word_idx] & ((uint64_t{1} << bit_idx) - 1));
+  }
+  return count;
+}
+
+// Inserts |recovered_packet| into the sorted |recovered_packets|. Packets
+// mostly arrive in order, so the insertion point is searched for from the
+// back. Returns false, without inserting, if |recovered_packets| already
+// contains a packet with the same sequence number.
+bool InsertSorted(
+    std::unique_ptr<ForwardErrorCorrection::RecoveredPacket> recovered_packet,
+    ForwardErrorCorrection::RecoveredPacketList* recovered_packets) {
+  auto it = recovered_packets->end();
+  while (it != recovered_packets->begin()) {
+    auto prev_it = std::prev(it);
+    if ((*prev_it)->seq_num == recovered_packet->seq_num) {
+      return false;
+    }
+    if (IsNewerSequenceNumber(recovered_packet->seq_num, (*prev_it)->seq_num)) {
+      break;
+    }
+    it = prev_it;
+  }
+  recovered_packets->insert(it, std::move(recovered_packet));
+  return true;
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : length(0), data(), ref_count_(0) {}
@@ -46,6 +109,10 @@ int32_t ForwardErrorCorrection::Packet::Release() {
   return ref_count;
 }
 
+bool ForwardErrorCorrection::Packet::HasOneRef() const {
+  return ref_count_ == 1;
+}
+
 // This comparator is used to compare std::unique_ptr's pointing to
 // subclasses of SortablePackets. It needs to be parametric since
 // the std::unique_ptr's are not covariant w.r.t. the types that
@@ -66,7 +133,8 @@ ForwardErrorCorrection::RecoveredPacket::~RecoveredPacket() = default;
 ForwardErrorCorrection::ProtectedPacket::ProtectedPacket() = default;
 ForwardErrorCorrection::ProtectedPacket::~ProtectedPacket() = default;
 
-ForwardErrorCorrection::ReceivedFecPacket::ReceivedFecPacket() = default;
+ForwardErrorCorrection::ReceivedFecPacket::ReceivedFecPacket()
+    : protected_mask(), missing_mask() {}
 ForwardErrorCorrection::ReceivedFecPacket::~ReceivedFecPacket() = default;
 
 ForwardErrorCorrection::ForwardErrorCorrection(
@@ -75,7 +143,10 @@ ForwardErrorCorrection::ForwardErrorCorrection(
     : fec_header_reader_(std::move(fec_header_reader)),
       fec_header_writer_(std::move(fec_header_writer)),
       generated_fec_packets_(fec_header_writer_->MaxFecPackets()),
-      packet_mask_size_(0) {}
+      recovered_packet_pool_index_(0),
+      packet_mask_size_(0) {
+  recovery_queue_.reserve(fec_header_reader_->MaxFecPackets());
+}
 
 ForwardErrorCorrection::~ForwardErrorCorrection() = default;
 
@@ -144,12 +215,12 @@ int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
     fec_packets->push_back(&generated_fec_packets_[i]);
   }
 
-  const internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+  internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
   packet_mask_size_ = internal::PacketMaskSize(num_media_packets);
   memset(packet_masks_, 0, num_fec_packets * packet_mask_size_);
   internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
                                 num_important_packets, use_unequal_protection,
-                                mask_table, packet_masks_);
+                                &mask_table, packet_masks_);
 
   // Adapt packet masks to missing media packets.
   int num_mask_bits = InsertZerosInPacketMasks(media_packets, num_fec_packets);
@@ -335,15 +406,6 @@ void ForwardErrorCorrection::ResetState(
 void ForwardErrorCorrection::InsertMediaPacket(
     RecoveredPacketList* recovered_packets,
     ReceivedPacket* received_packet) {
-  // Search for duplicate packets.
-  for (const auto& recovered_packet : *recovered_packets) {
-    if (received_packet->seq_num == recovered_packet->seq_num) {
-      // Duplicate packet, no need to add to list.
-      // Delete duplicate media packet data.
-      received_packet->pkt = nullptr;
-      return;
-    }
-  }
   std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
   // This "recovered packet" was not recovered using parity packets.
   recovered_packet->was_recovered = false;
@@ -352,11 +414,13 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->seq_num = received_packet->seq_num;
   recovered_packet->pkt = received_packet->pkt;
   recovered_packet->pkt->length = received_packet->pkt->length;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
   RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
+  if (!InsertSorted(std::move(recovered_packet), recovered_packets)) {
+    // Duplicate packet, no need to add to list.
+    // Delete duplicate media packet data.
+    received_packet->pkt = nullptr;
+    return;
+  }
   UpdateCoveringFecPackets(*recovered_packet_ptr);
 }
 
@@ -364,13 +428,19 @@ void ForwardErrorCorrection::UpdateCoveringFecPackets(
     const RecoveredPacket& packet) {
   for (auto& fec_packet : received_fec_packets_) {
     // Is this FEC packet protecting the media packet |packet|?
-    auto protected_it = std::lower_bound(fec_packet->protected_packets.begin(),
-                                         fec_packet->protected_packets.end(),
-                                         &packet, SortablePacket::LessThan());
-    if (protected_it != fec_packet->protected_packets.end() &&
-        (*protected_it)->seq_num == packet.seq_num) {
-      // Found an FEC packet which is protecting |packet|.
-      (*protected_it)->pkt = packet.pkt;
+    const size_t offset =
+        static_cast<uint16_t>(packet.seq_num - fec_packet->seq_num_base);
+    if (offset >= kMaxPacketMaskBits ||
+        !IsBitSet(fec_packet->missing_mask, offset)) {
+      continue;
+    }
+    // Found an FEC packet which is protecting |packet|.
+    const size_t index = NumBitsSetBelow(fec_packet->protected_mask, offset);
+    RTC_DCHECK_LT(index, fec_packet->protected_packets.size());
+    fec_packet->protected_packets[index].pkt = packet.pkt;
+    ClearBit(fec_packet->missing_mask, offset);
+    if (NumCoveredPacketsMissing(*fec_packet) == 1) {
+      recovery_queue_.push_back(fec_packet.get());
     }
   }
 }
@@ -395,6 +465,7 @@ void ForwardErrorCorrection::InsertFecPacket(
   if (!ret) {
     return;
   }
+  RTC_DCHECK_LE(fec_packet->packet_mask_size * 8, kMaxPacketMaskBits);
   // Parse packet mask from header and represent as protected packets.
   for (uint16_t byte_idx = 0; byte_idx < fec_packet->packet_mask_size;
        ++byte_idx) {
@@ -402,16 +473,21 @@ void ForwardErrorCorrection::InsertFecPacket(
         fec_packet->pkt->data[fec_packet->packet_mask_offset + byte_idx];
     for (uint16_t bit_idx = 0; bit_idx < 8; ++bit_idx) {
       if (packet_mask & (1 << (7 - bit_idx))) {
-        std::unique_ptr<ProtectedPacket> protected_packet(
-            new ProtectedPacket());
+        const size_t offset = (byte_idx << 3) + bit_idx;
+        SetBit(fec_packet->protected_mask, offset);
+        fec_packet->protected_packets.emplace_back();
+        ProtectedPacket* protected_packet =
+            &fec_packet->protected_packets.back();
         // This wraps naturally with the sequence number.
-        protected_packet->seq_num = static_cast<uint16_t>(
-            fec_packet->seq_num_base + (byte_idx << 3) + bit_idx);
+        protected_packet->seq_num =
+            static_cast<uint16_t>(fec_packet->seq_num_base + offset);
         protected_packet->pkt = nullptr;
-        fec_packet->protected_packets.push_back(std::move(protected_packet));
       }
     }
   }
+  std::copy(std::begin(fec_packet->protected_mask),
+            std::end(fec_packet->protected_mask),
+            std::begin(fec_packet->missing_mask));
   if (fec_packet->protected_packets.empty()) {
     // All-zero packet mask; we can discard this FEC packet.
     LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
@@ -437,27 +513,20 @@ void ForwardErrorCorrection::InsertFecPacket(
 void ForwardErrorCorrection::AssignRecoveredPackets(
     const RecoveredPacketList& recovered_packets,
     ReceivedFecPacket* fec_packet) {
-  ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
-  std::vector<RecoveredPacket*> recovered_protected_packets;
-
-  // Find intersection between the (sorted) containers |protected_packets|
-  // and |recovered_packets|, i.e. all protected packets that have already
-  // been recovered. Update the corresponding protected packets to point to
-  // the recovered packets.
-  auto it_p = protected_packets->cbegin();
-  auto it_r = recovered_packets.cbegin();
-  SortablePacket::LessThan less_than;
-  while (it_p != protected_packets->end() && it_r != recovered_packets.end()) {
-    if (less_than(*it_p, *it_r)) {
-      ++it_p;
-    } else if (less_than(*it_r, *it_p)) {
-      ++it_r;
-    } else {  // *it_p == *it_r.
-      // This protected packet has already been recovered.
-      (*it_p)->pkt = (*it_r)->pkt;
-      ++it_p;
-      ++it_r;
+  // Find all protected packets that have already been recovered, by looking
+  // up each recovered packet in the packet mask. Update the corresponding
+  // protected packets to point to the recovered packets.
+  for (const auto& recovered_packet : recovered_packets) {
+    const size_t offset = static_cast<uint16_t>(recovered_packet->seq_num -
+                                                fec_packet->seq_num_base);
+    if (offset >= kMaxPacketMaskBits ||
+        !IsBitSet(fec_packet->missing_mask, offset)) {
+      continue;
     }
+    // This protected packet has already been recovered.
+    const size_t index = NumBitsSetBelow(fec_packet->protected_mask, offset);
+    fec_packet->protected_packets[index].pkt = recovered_packet->pkt;
+    ClearBit(fec_packet->missing_mask, offset);
   }
 }
 
@@ -505,9 +574,6 @@ bool ForwardErrorCorrection::StartPacketRecovery(
         << "for its own header.";
     return false;
   }
-  // Initialize recovered packet data.
-  recovered_packet->pkt = new Packet();
-  memset(recovered_packet->pkt->data, 0, IP_PACKET_SIZE);
   recovered_packet->returned = false;
   recovered_packet->was_recovered = true;
   // Copy bytes corresponding to minimum RTP header size.
@@ -585,18 +651,47 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   }
 }
 
+ForwardErrorCorrection::Packet*
+ForwardErrorCorrection::AllocateRecoveredPacket() {
+  Packet* packet = nullptr;
+  const size_t pool_size = recovered_packet_pool_.size();
+  // Start searching where the previous search ended, since the oldest
+  // recovered packets are the most likely to have been released.
+  for (size_t i = 0; i < pool_size; ++i) {
+    const size_t index = (recovered_packet_pool_index_ + i) % pool_size;
+    if (recovered_packet_pool_[index]->HasOneRef()) {
+      packet = recovered_packet_pool_[index].get();
+      recovered_packet_pool_index_ = (index + 1) % pool_size;
+      break;
+    }
+  }
+  if (!packet) {
+    packet = new Packet();
+    const size_t max_pool_size =
+        kRecoveredPacketPoolFactor * fec_header_reader_->MaxMediaPackets();
+    if (pool_size < max_pool_size) {
+      recovered_packet_pool_.push_back(packet);
+    }
+  }
+  packet->length = 0;
+  memset(packet->data, 0, IP_PACKET_SIZE);
+  return packet;
+}
+
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
                                            RecoveredPacket* recovered_packet) {
+  // Initialize recovered packet data.
+  recovered_packet->pkt = AllocateRecoveredPacket();
   if (!StartPacketRecovery(fec_packet, recovered_packet)) {
     return false;
   }
   for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
+    if (protected_packet.pkt == nullptr) {
       // This is the packet we're recovering.
-      recovered_packet->seq_num = protected_packet->seq_num;
+      recovered_packet->seq_num = protected_packet.seq_num;
     } else {
-      XorHeaders(*protected_packet->pkt, recovered_packet->pkt);
-      XorPayloads(*protected_packet->pkt, protected_packet->pkt->length,
+      XorHeaders(*protected_packet.pkt, recovered_packet->pkt);
+      XorPayloads(*protected_packet.pkt, protected_packet.pkt->length,
                   kRtpHeaderSize, recovered_packet->pkt);
     }
   }
@@ -608,60 +703,63 @@ bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
 
 void ForwardErrorCorrection::AttemptRecovery(
     RecoveredPacketList* recovered_packets) {
-  auto fec_packet_it = received_fec_packets_.begin();
-  while (fec_packet_it != received_fec_packets_.end()) {
-    // Search for each FEC packet's protected media packets.
-    int packets_missing = NumCoveredPacketsMissing(**fec_packet_it);
-
-    // We can only recover one packet with an FEC packet.
-    if (packets_missing == 1) {
-      // Recovery possible.
-      std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
-      recovered_packet->pkt = nullptr;
-      if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
-        // Can't recover using this packet, drop it.
-        fec_packet_it = received_fec_packets_.erase(fec_packet_it);
-        continue;
-      }
+  // Seed the queue with the FEC packets that can be used for recovery right
+  // away, oldest first. Every recovered packet may make more FEC packets
+  // usable; those are appended to the queue by UpdateCoveringFecPackets(),
+  // so that we never have to rescan all FEC packets after a recovery.
+  recovery_queue_.clear();
+  for (const auto& fec_packet : received_fec_packets_) {
+    if (NumCoveredPacketsMissing(*fec_packet) == 1) {
+      recovery_queue_.push_back(fec_packet.get());
+    }
+  }
+  // Note that |recovery_queue_| may grow while we iterate over it.
+  for (size_t i = 0; i < recovery_queue_.size(); ++i) {
+    ReceivedFecPacket* fec_packet = recovery_queue_[i];
+    // The missing packet may have been recovered through another FEC packet
+    // since this one was queued.
+    if (NumCoveredPacketsMissing(*fec_packet) != 1) {
+      continue;
+    }
+    // Recovery possible.
+    std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
+    recovered_packet->pkt = nullptr;
+    if (!RecoverPacket(*fec_packet, recovered_packet.get())) {
+      // Can't recover using this packet. Marking it as having no missing
+      // packets makes it get dropped below.
+      std::fill(std::begin(fec_packet->missing_mask),
+                std::end(fec_packet->missing_mask), 0);
+      continue;
+    }
 
-      auto recovered_packet_ptr = recovered_packet.get();
-      // Add recovered packet to the list of recovered packets and update any
-      // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
-      UpdateCoveringFecPackets(*recovered_packet_ptr);
-      DiscardOldRecoveredPackets(recovered_packets);
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
-
-      // A packet has been recovered. We need to check the FEC list again, as
-      // this may allow additional packets to be recovered.
-      // Restart for first FEC packet.
-      fec_packet_it = received_fec_packets_.begin();
-    } else if (packets_missing == 0) {
-      // Either all protected packets arrived or have been recovered. We can
-      // discard this FEC packet.
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
-    } else {
-      fec_packet_it++;
+    auto recovered_packet_ptr = recovered_packet.get();
+    // Add recovered packet to the list of recovered packets and update any
+    // FEC packets covering this packet with a pointer to the data.
+    if (!InsertSorted(std::move(recovered_packet), recovered_packets)) {
+      RTC_NOTREACHED();
+      continue;
     }
+    UpdateCoveringFecPackets(*recovered_packet_ptr);
+    DiscardOldRecoveredPackets(recovered_packets);
   }
+  recovery_queue_.clear();
+
+  // Either all protected packets of these FEC packets arrived or have been
+  // recovered, or the FEC packet could not be used. We can discard them.
+  received_fec_packets_.remove_if(
+      [](const std::unique_ptr<ReceivedFecPacket>& fec_packet) {
+        return NumCoveredPacketsMissing(*fec_packet) == 0;
+      });
 }
 
 int ForwardErrorCorrection::NumCoveredPacketsMissing(
     const ReceivedFecPacket& fec_packet) {
   int packets_missing = 0;
-  for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
-      ++packets_missing;
-      if (packets_missing > 1) {
-        break;  // We can't recover more than one packet.
-      }
-    }
+  for (uint64_t word : fec_packet.missing_mask) {
+    packets_missing += NumBitsSet(word);
   }
-  return packets_missing;
+  // We can't recover more than one packet.
+  return std::min(packets_missing, 2);
 }
 
 void ForwardErrorCorrection::DiscardOldRecoveredPackets(
@@ -51,6 +51,9 @@ class ForwardErrorCorrection {
     // reaches zero.
     virtual int32_t Release();
 
+    // Returns true if exactly one reference is held to this packet.
+    bool HasOneRef() const;
+
     size_t length;                 // Length of packet in bytes.
     uint8_t data[IP_PACKET_SIZE];  // Packet data.
 
@@ -117,7 +120,7 @@ class ForwardErrorCorrection {
     rtc::scoped_refptr<ForwardErrorCorrection::Packet> pkt;
   };
 
-  using ProtectedPacketList = std::list<std::unique_ptr<ProtectedPacket>>;
+  using ProtectedPacketList = std::vector<ProtectedPacket>;
 
   // Used for internal storage of received FEC packets in a list.
   //
@@ -127,8 +130,15 @@ class ForwardErrorCorrection {
     ReceivedFecPacket();
     ~ReceivedFecPacket();
 
-    // List of media packets that this FEC packet protects.
+    // List of media packets that this FEC packet protects, in the order of
+    // the packet mask.
     ProtectedPacketList protected_packets;
+    // Bitmasks over the sequence numbers covered by the packet mask, where bit
+    // i corresponds to |seq_num_base| + i. |protected_mask| has a bit set for
+    // every entry in |protected_packets|, and |missing_mask| has a bit set for
+    // every protected packet that has not yet been received or recovered.
+    uint64_t protected_mask[kFecMaxPacketMaskWords];
+    uint64_t missing_mask[kFecMaxPacketMaskWords];
     // RTP header fields.
     uint32_t ssrc;
     // FEC header fields.
@@ -232,7 +242,8 @@ class ForwardErrorCorrection {
   size_t MaxPacketOverhead() const;
 
   // Reset internal states from last frame and clear |recovered_packets|.
-  // Frees all memory allocated by this class.
+  // Frees all memory allocated by this class, except for the pooled storage
+  // of recovered packets.
   void ResetState(RecoveredPacketList* recovered_packets);
 
   // TODO(brandtr): Remove these functions when the Packet classes
@@ -278,6 +289,8 @@ class ForwardErrorCorrection {
   // Note: This reduces the complexity when we want to try to recover a packet
   // since we don't have to find the intersection between recovered packets and
   // packets covered by the FEC packet.
+  // FEC packets which are left with a single missing packet are appended to
+  // |recovery_queue_|.
   void UpdateCoveringFecPackets(const RecoveredPacket& packet);
 
   // Insert |received_packet| into internal FEC list. Deletes duplicates.
@@ -293,6 +306,10 @@ class ForwardErrorCorrection {
   // received FEC packets.
   void AttemptRecovery(RecoveredPacketList* recovered_packets);
 
+  // Returns zeroed packet storage for a packet to be recovered. The storage is
+  // reused once the caller and all FEC packets have released their references.
+  Packet* AllocateRecoveredPacket();
+
   // Initializes headers and payload before the XOR operation
   // that recovers a packet.
   static bool StartPacketRecovery(const ReceivedFecPacket& fec_packet,
@@ -317,8 +334,8 @@ class ForwardErrorCorrection {
                                    RecoveredPacket* recovered_packet);
 
   // Recover a missing packet.
-  static bool RecoverPacket(const ReceivedFecPacket& fec_packet,
-                            RecoveredPacket* recovered_packet);
+  bool RecoverPacket(const ReceivedFecPacket& fec_packet,
+                     RecoveredPacket* recovered_packet);
 
   // Get the number of missing media packets which are covered by |fec_packet|.
   // An FEC packet can recover at most one packet, and if zero packets are
@@ -336,6 +353,15 @@ class ForwardErrorCorrection {
   std::vector<Packet> generated_fec_packets_;
   ReceivedFecPacketList received_fec_packets_;
 
+  // FEC packets that have exactly one missing protected packet, and thus can
+  // be used for recovery. Only valid during AttemptRecovery().
+  std::vector<ReceivedFecPacket*> recovery_queue_;
+
+  // Storage for recovered packets. An entry is free for reuse when the pool
+  // holds the only reference to it.
+  std::vector<rtc::scoped_refptr<Packet>> recovered_packet_pool_;
+  size_t recovered_packet_pool_index_;
+
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
   // (There are never more than |kUlpfecMaxMediaPackets| FEC packets generated.)
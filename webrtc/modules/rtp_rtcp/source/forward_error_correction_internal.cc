@@ -15,13 +15,162 @@
 
 #include <algorithm>
 
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/bitbuffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/rtp_rtcp/source/fec_private_tables_bursty.h"
 #include "webrtc/modules/rtp_rtcp/source/fec_private_tables_random.h"
 
 namespace {
 using webrtc::fec_private_tables::kPacketMaskBurstyTbl;
+using webrtc::fec_private_tables::kPacketMaskBurstyTblOffsets;
 using webrtc::fec_private_tables::kPacketMaskRandomTbl;
+using webrtc::fec_private_tables::kPacketMaskRandomTblOffsets;
+using webrtc::internal::PacketMaskSize;
+
+// Each row of a compressed packet mask starts with a 2-bit code, which
+// determines how the row is obtained.
+enum RowCode {
+  // Copy of a row in the mask with one FEC packet less. Followed by the
+  // index of that row.
+  kRowCodePreviousMask = 0,
+  // Copy of an earlier row in the same mask. Followed by the index of that
+  // row.
+  kRowCodeCurrentMask = 1,
+  // Copy of any row in the masks with fewer FEC packets. Followed by the index
+  // of that row, counted from the first row of the mask with one FEC packet.
+  kRowCodeEarlierMask = 2,
+  // A bit pattern which is repeated over the row. Followed by 6 bits holding
+  // the pattern length minus one, and then the pattern.
+  kRowCodePattern = 3,
+};
+
+constexpr size_t kRowCodeBits = 2;
+constexpr size_t kPatternLengthBits = 6;
+
+// Returns the number of bits used to store an index in the range
+// [0, num_rows).
+size_t IndexBits(size_t num_rows) {
+  size_t bits = 0;
+  while ((size_t{1} << bits) < num_rows) {
+    ++bits;
+  }
+  return bits;
+}
+
+uint32_t ReadBits(rtc::BitBuffer* reader, size_t bit_count) {
+  uint32_t value = 0;
+  if (bit_count > 0) {
+    RTC_CHECK(reader->ReadBits(&value, bit_count));
+  }
+  return value;
+}
+
+// Decodes the packet masks for |num_media_packets| media packets and all
+// numbers of FEC packets from |compressed_masks|. The mask for |m| FEC packets
+// is written to |packet_masks| at row (m - 1) * m / 2, where each row is
+// PacketMaskSize(|num_media_packets|) bytes.
+void DecodePacketMasks(const uint8_t* compressed_masks,
+                       size_t compressed_size,
+                       int num_media_packets,
+                       uint8_t* packet_masks) {
+  rtc::BitBuffer reader(compressed_masks, compressed_size);
+  const size_t num_mask_bytes = PacketMaskSize(num_media_packets);
+  for (int num_fec_packets = 1; num_fec_packets <= num_media_packets;
+       ++num_fec_packets) {
+    const size_t first_row = (num_fec_packets - 1) * num_fec_packets / 2;
+    const size_t previous_first_row = first_row - (num_fec_packets - 1);
+    for (int i = 0; i < num_fec_packets; ++i) {
+      uint8_t* row = &packet_masks[(first_row + i) * num_mask_bytes];
+      size_t source_row;
+      switch (ReadBits(&reader, kRowCodeBits)) {
+        case kRowCodePreviousMask:
+          source_row = previous_first_row +
+                       ReadBits(&reader, IndexBits(num_fec_packets - 1));
+          break;
+        case kRowCodeCurrentMask:
+          source_row = first_row + ReadBits(&reader, IndexBits(i));
+          break;
+        case kRowCodeEarlierMask:
+          source_row = ReadBits(&reader, IndexBits(first_row));
+          break;
+        case kRowCodePattern: {
+          const size_t pattern_length =
+              ReadBits(&reader, kPatternLengthBits) + 1;
+          // Patterns are up to 48 bits, which is more than ReadBits() can
+          // handle at once.
+          const size_t high_bits = pattern_length / 2;
+          const size_t low_bits = pattern_length - high_bits;
+          const uint64_t pattern =
+              (static_cast<uint64_t>(ReadBits(&reader, high_bits))
+               << low_bits) |
+              ReadBits(&reader, low_bits);
+          // Repeat the pattern over the row, MSB first, and clear the bits
+          // beyond |num_media_packets|.
+          uint64_t row_bits = 0;
+          for (size_t shift = 0; shift < 64; shift += pattern_length) {
+            row_bits |= (pattern << (64 - pattern_length)) >> shift;
+          }
+          row_bits &= ~uint64_t{0} << (64 - num_media_packets);
+          for (size_t byte = 0; byte < num_mask_bytes; ++byte) {
+            row[byte] = static_cast<uint8_t>(row_bits >> (56 - 8 * byte));
+          }
+          continue;
+        }
+        default:
+          RTC_NOTREACHED();
+          return;
+      }
+      RTC_DCHECK_LT(source_row, first_row + i);
+      memcpy(row, &packet_masks[source_row * num_mask_bytes], num_mask_bytes);
+    }
+  }
+}
+
+// The decoded packet masks for each number of media packets, or null until
+// they are first used. Once published, the masks are never changed or freed,
+// so they are read without locking.
+uint8_t* volatile g_decoded_random_masks[webrtc::kUlpfecMaxMediaPackets] = {};
+uint8_t* volatile
+    g_decoded_bursty_masks[webrtc::kUlpfecMaxMediaPacketsBursty] = {};
+
+// Returns all packet masks for |num_media_packets| of type |fec_mask_type|,
+// laid out as written by DecodePacketMasks(), decoding them on first use.
+const uint8_t* GetDecodedPacketMasks(webrtc::FecMaskType fec_mask_type,
+                                     int num_media_packets) {
+  uint8_t* volatile* decoded_masks;
+  const uint8_t* compressed_masks;
+  size_t compressed_size;
+  if (fec_mask_type == webrtc::kFecMaskBursty) {
+    decoded_masks = &g_decoded_bursty_masks[num_media_packets - 1];
+    const size_t offset = kPacketMaskBurstyTblOffsets[num_media_packets - 1];
+    compressed_masks = &kPacketMaskBurstyTbl[offset];
+    compressed_size = sizeof(kPacketMaskBurstyTbl) - offset;
+  } else {
+    decoded_masks = &g_decoded_random_masks[num_media_packets - 1];
+    const size_t offset = kPacketMaskRandomTblOffsets[num_media_packets - 1];
+    compressed_masks = &kPacketMaskRandomTbl[offset];
+    compressed_size = sizeof(kPacketMaskRandomTbl) - offset;
+  }
+
+  uint8_t* packet_masks = rtc::AtomicOps::AcquireLoadPtr(decoded_masks);
+  if (packet_masks)
+    return packet_masks;
+
+  // Encoders racing for the same masks each decode them. The first to publish
+  // wins, and the others free their copy.
+  packet_masks = new uint8_t[num_media_packets * (num_media_packets + 1) / 2 *
+                             PacketMaskSize(num_media_packets)];
+  DecodePacketMasks(compressed_masks, compressed_size, num_media_packets,
+                    packet_masks);
+  uint8_t* published_masks = rtc::AtomicOps::CompareAndSwapPtr(
+      decoded_masks, static_cast<uint8_t*>(nullptr), packet_masks);
+  if (published_masks) {
+    delete[] packet_masks;
+    return published_masks;
+  }
+  return packet_masks;
+}
 
 // Allow for different modes of protection for packets in UEP case.
 enum ProtectionMode {
@@ -147,8 +296,22 @@ namespace internal {
 
 PacketMaskTable::PacketMaskTable(FecMaskType fec_mask_type,
                                  int num_media_packets)
-    : fec_mask_type_(InitMaskType(fec_mask_type, num_media_packets)),
-      fec_packet_mask_table_(InitMaskTable(fec_mask_type_)) {}
+    : fec_mask_type_(InitMaskType(fec_mask_type, num_media_packets)) {}
+
+PacketMaskTable::~PacketMaskTable() = default;
+
+const uint8_t* PacketMaskTable::LookUp(int num_media_packets,
+                                       int num_fec_packets) const {
+  RTC_DCHECK_GT(num_media_packets, 0);
+  RTC_DCHECK_GT(num_fec_packets, 0);
+  RTC_DCHECK_LE(num_fec_packets, num_media_packets);
+  RTC_DCHECK_LE(static_cast<size_t>(num_media_packets),
+                fec_mask_type_ == kFecMaskBursty ? kUlpfecMaxMediaPacketsBursty
+                                                 : kUlpfecMaxMediaPackets);
+  const size_t first_row = (num_fec_packets - 1) * num_fec_packets / 2;
+  return &GetDecodedPacketMasks(fec_mask_type_, num_media_packets)
+      [first_row * PacketMaskSize(num_media_packets)];
+}
 
 // Sets |fec_mask_type_| to the type of packet mask selected. The type of
 // packet mask selected is based on |fec_mask_type| and |num_media_packets|.
@@ -157,15 +320,13 @@ PacketMaskTable::PacketMaskTable(FecMaskType fec_mask_type,
 FecMaskType PacketMaskTable::InitMaskType(FecMaskType fec_mask_type,
                                           int num_media_packets) {
   // The mask should not be bigger than |packetMaskTbl|.
-  assert(num_media_packets <= static_cast<int>(sizeof(kPacketMaskRandomTbl) /
-                                               sizeof(*kPacketMaskRandomTbl)));
+  assert(num_media_packets <= static_cast<int>(kUlpfecMaxMediaPackets));
   switch (fec_mask_type) {
     case kFecMaskRandom: {
       return kFecMaskRandom;
     }
     case kFecMaskBursty: {
-      int max_media_packets = static_cast<int>(sizeof(kPacketMaskBurstyTbl) /
-                                               sizeof(*kPacketMaskBurstyTbl));
+      int max_media_packets = static_cast<int>(kUlpfecMaxMediaPacketsBursty);
       if (num_media_packets > max_media_packets) {
         return kFecMaskRandom;
       } else {
@@ -177,21 +338,6 @@ FecMaskType PacketMaskTable::InitMaskType(FecMaskType fec_mask_type,
   return kFecMaskRandom;
 }
 
-// Returns the pointer to the packet mask tables corresponding to type
-// |fec_mask_type|.
-const uint8_t*** PacketMaskTable::InitMaskTable(FecMaskType fec_mask_type) {
-  switch (fec_mask_type) {
-    case kFecMaskRandom: {
-      return kPacketMaskRandomTbl;
-    }
-    case kFecMaskBursty: {
-      return kPacketMaskBurstyTbl;
-    }
-  }
-  assert(false);
-  return kPacketMaskRandomTbl;
-}
-
 // Remaining protection after important (first partition) packet protection
 void RemainingPacketProtection(int num_media_packets,
                                int num_fec_remaining,
@@ -199,7 +345,7 @@ void RemainingPacketProtection(int num_media_packets,
                                int num_mask_bytes,
                                ProtectionMode mode,
                                uint8_t* packet_mask,
-                               const PacketMaskTable& mask_table) {
+                               PacketMaskTable* mask_table) {
   if (mode == kModeNoOverlap) {
     // sub_mask21
 
@@ -207,9 +353,8 @@ void RemainingPacketProtection(int num_media_packets,
         PacketMaskSize(num_media_packets - num_fec_for_imp_packets);
 
     const uint8_t* packet_mask_sub_21 =
-        mask_table.fec_packet_mask_table()[num_media_packets -
-                                           num_fec_for_imp_packets -
-                                           1][num_fec_remaining - 1];
+        mask_table->LookUp(num_media_packets - num_fec_for_imp_packets,
+                           num_fec_remaining);
 
     ShiftFitSubMask(num_mask_bytes, res_mask_bytes, num_fec_for_imp_packets,
                     (num_fec_for_imp_packets + num_fec_remaining),
@@ -219,8 +364,7 @@ void RemainingPacketProtection(int num_media_packets,
     // sub_mask22
 
     const uint8_t* packet_mask_sub_22 =
-        mask_table.fec_packet_mask_table()[num_media_packets -
-                                           1][num_fec_remaining - 1];
+        mask_table->LookUp(num_media_packets, num_fec_remaining);
 
     FitSubMask(num_mask_bytes, num_mask_bytes, num_fec_remaining,
                packet_mask_sub_22,
@@ -242,13 +386,12 @@ void ImportantPacketProtection(int num_fec_for_imp_packets,
                                int num_imp_packets,
                                int num_mask_bytes,
                                uint8_t* packet_mask,
-                               const PacketMaskTable& mask_table) {
+                               PacketMaskTable* mask_table) {
   const int num_imp_mask_bytes = PacketMaskSize(num_imp_packets);
 
   // Get sub_mask1 from table
   const uint8_t* packet_mask_sub_1 =
-      mask_table.fec_packet_mask_table()[num_imp_packets -
-                                         1][num_fec_for_imp_packets - 1];
+      mask_table->LookUp(num_imp_packets, num_fec_for_imp_packets);
 
   FitSubMask(num_mask_bytes, num_imp_mask_bytes, num_fec_for_imp_packets,
              packet_mask_sub_1, packet_mask);
@@ -328,7 +471,7 @@ void UnequalProtectionMask(int num_media_packets,
                            int num_imp_packets,
                            int num_mask_bytes,
                            uint8_t* packet_mask,
-                           const PacketMaskTable& mask_table) {
+                           PacketMaskTable* mask_table) {
   // Set Protection type and allocation
   // TODO(marpan): test/update for best mode and some combinations thereof.
 
@@ -365,7 +508,7 @@ void GeneratePacketMasks(int num_media_packets,
                          int num_fec_packets,
                          int num_imp_packets,
                          bool use_unequal_protection,
-                         const PacketMaskTable& mask_table,
+                         PacketMaskTable* mask_table,
                          uint8_t* packet_mask) {
   assert(num_media_packets > 0);
   assert(num_fec_packets <= num_media_packets && num_fec_packets > 0);
@@ -379,8 +522,7 @@ void GeneratePacketMasks(int num_media_packets,
     // Mask = (k,n-k), with protection factor = (n-k)/k,
     // where k = num_media_packets, n=total#packets, (n-k)=num_fec_packets.
     memcpy(packet_mask,
-           mask_table.fec_packet_mask_table()[num_media_packets -
-                                              1][num_fec_packets - 1],
+           mask_table->LookUp(num_media_packets, num_fec_packets),
            num_fec_packets * num_mask_bytes);
   } else {  // UEP case
     UnequalProtectionMask(num_media_packets, num_fec_packets, num_imp_packets,
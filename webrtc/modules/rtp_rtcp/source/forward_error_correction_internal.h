@@ -20,6 +20,10 @@ namespace webrtc {
 // by these packet masks.
 constexpr size_t kUlpfecMaxMediaPackets = 48;
 
+// Maximum number of media packets that can be protected by the bursty packet
+// masks. Larger frames fall back to the random packet masks.
+constexpr size_t kUlpfecMaxMediaPacketsBursty = 12;
+
 // Packet mask size in bytes (given L bit).
 constexpr size_t kUlpfecPacketMaskSizeLBitClear = 2;
 constexpr size_t kUlpfecPacketMaskSizeLBitSet = 6;
@@ -28,22 +32,29 @@ constexpr size_t kUlpfecPacketMaskSizeLBitSet = 6;
 constexpr size_t kUlpfecMinPacketMaskSize = kUlpfecPacketMaskSizeLBitClear;
 constexpr size_t kUlpfecMaxPacketMaskSize = kUlpfecPacketMaskSizeLBitSet;
 
+// Number of 64-bit words needed to hold the largest received packet mask.
+// (FlexFEC packet masks are at most 14 bytes, after the K-bits are removed.)
+constexpr size_t kFecMaxPacketMaskWords = 2;
+
 namespace internal {
 
+// Provides the packet masks of a given type. The masks are stored compressed.
+// The masks for a number of media packets are decoded on first use, and are
+// then shared, read-only, by all tables for the lifetime of the process.
 class PacketMaskTable {
  public:
   PacketMaskTable(FecMaskType fec_mask_type, int num_media_packets);
-  ~PacketMaskTable() {}
+  ~PacketMaskTable();
   FecMaskType fec_mask_type() const { return fec_mask_type_; }
-  const uint8_t*** fec_packet_mask_table() const {
-    return fec_packet_mask_table_;
-  }
+
+  // Returns the packet mask for protecting |num_media_packets| media packets
+  // with |num_fec_packets| FEC packets. The mask has |num_fec_packets| rows of
+  // PacketMaskSize(|num_media_packets|) bytes each, and is never freed.
+  const uint8_t* LookUp(int num_media_packets, int num_fec_packets) const;
 
  private:
   FecMaskType InitMaskType(FecMaskType fec_mask_type, int num_media_packets);
-  const uint8_t*** InitMaskTable(FecMaskType fec_mask_type_);
   const FecMaskType fec_mask_type_;
-  const uint8_t*** fec_packet_mask_table_;
 };
 
 // Returns an array of packet masks. The mask of a single FEC packet
@@ -62,14 +73,14 @@ class PacketMaskTable {
 //                                     more protection to the num_imp_packets.
 // \param[in]  mask_table              An instance of the |PacketMaskTable|
 //                                     class, which contains the type of FEC
-//                                     packet mask used, and a pointer to the
+//                                     packet mask used, and provides the
 //                                     corresponding packet masks.
 // \param[out] packet_mask             A pointer to hold the packet mask array,
 //                                     of size: num_fec_packets *
 //                                     "number of mask bytes".
 void GeneratePacketMasks(int num_media_packets, int num_fec_packets,
                          int num_imp_packets, bool use_unequal_protection,
-                         const PacketMaskTable& mask_table,
+                         PacketMaskTable* mask_table,
                          uint8_t* packet_mask);
 
 // Returns the required packet mask size, given the number of sequence numbers
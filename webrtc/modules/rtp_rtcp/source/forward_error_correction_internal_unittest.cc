@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "webrtc/base/md5.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/stringencode.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+// MD5 of all packet masks, for 1..max media packets and 1..num_media_packets
+// FEC packets, concatenated in that order. Computed from the uncompressed
+// tables that the compressed ones were generated from.
+constexpr char kRandomMasksMd5[] = "593205d669405edb76e297590ebfe7d2";
+constexpr char kBurstyMasksMd5[] = "67ac384f8473f66cacc1a272c8fcb9e8";
+
+std::string PacketMasksMd5(FecMaskType fec_mask_type,
+                           int max_media_packets,
+                           bool reverse_order) {
+  // Collect the masks in the canonical order, but look them up in
+  // |reverse_order| if requested, so that they are decoded in a different
+  // order.
+  std::vector<std::vector<uint8_t>> masks(max_media_packets);
+  for (int i = 0; i < max_media_packets; ++i) {
+    const int num_media_packets = reverse_order ? max_media_packets - i : i + 1;
+    const size_t num_mask_bytes = PacketMaskSize(num_media_packets);
+    std::vector<uint8_t>* masks_for_media_packets =
+        &masks[num_media_packets - 1];
+    PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+    for (int num_fec_packets = 1; num_fec_packets <= num_media_packets;
+         ++num_fec_packets) {
+      const uint8_t* packet_mask =
+          mask_table.LookUp(num_media_packets, num_fec_packets);
+      masks_for_media_packets->insert(
+          masks_for_media_packets->end(), packet_mask,
+          packet_mask + num_fec_packets * num_mask_bytes);
+    }
+  }
+
+  rtc::MD5Context context;
+  rtc::MD5Init(&context);
+  for (const auto& masks_for_media_packets : masks) {
+    rtc::MD5Update(&context, masks_for_media_packets.data(),
+                   masks_for_media_packets.size());
+  }
+  uint8_t digest[16];
+  rtc::MD5Final(&context, digest);
+  return rtc::hex_encode(reinterpret_cast<const char*>(digest),
+                         sizeof(digest));
+}
+
+// Looks up the random masks with all FEC packets for every number of media
+// packets, into the vector of pointers in |obj|.
+bool LookUpRandomMasks(void* obj) {
+  std::vector<const uint8_t*>* masks =
+      static_cast<std::vector<const uint8_t*>*>(obj);
+  for (int num_media_packets = 1;
+       num_media_packets <= static_cast<int>(kUlpfecMaxMediaPackets);
+       ++num_media_packets) {
+    PacketMaskTable mask_table(kFecMaskRandom, num_media_packets);
+    masks->push_back(mask_table.LookUp(num_media_packets, num_media_packets));
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST(PacketMaskTableTest, RandomMasksMatchReferenceTables) {
+  EXPECT_EQ(kRandomMasksMd5,
+            PacketMasksMd5(kFecMaskRandom, kUlpfecMaxMediaPackets, false));
+  EXPECT_EQ(kRandomMasksMd5,
+            PacketMasksMd5(kFecMaskRandom, kUlpfecMaxMediaPackets, true));
+}
+
+TEST(PacketMaskTableTest, BurstyMasksMatchReferenceTables) {
+  EXPECT_EQ(kBurstyMasksMd5,
+            PacketMasksMd5(kFecMaskBursty, kUlpfecMaxMediaPacketsBursty,
+                           false));
+  EXPECT_EQ(kBurstyMasksMd5,
+            PacketMasksMd5(kFecMaskBursty, kUlpfecMaxMediaPacketsBursty, true));
+}
+
+// Tables on different threads decode the masks once and share them.
+TEST(PacketMaskTableTest, ThreadsShareDecodedMasks) {
+  std::vector<const uint8_t*> masks1;
+  std::vector<const uint8_t*> masks2;
+  rtc::PlatformThread thread1(&LookUpRandomMasks, &masks1, "LookUp1");
+  rtc::PlatformThread thread2(&LookUpRandomMasks, &masks2, "LookUp2");
+  thread1.Start();
+  thread2.Start();
+  thread1.Stop();
+  thread2.Stop();
+
+  std::vector<const uint8_t*> masks;
+  LookUpRandomMasks(&masks);
+  EXPECT_EQ(masks, masks1);
+  EXPECT_EQ(masks, masks2);
+}
+
+TEST(PacketMaskTableTest, LooksUpExpectedMasks) {
+  PacketMaskTable random_table(kFecMaskRandom, 3);
+  const uint8_t kRandom3_2[] = {0xc0, 0x00, 0xa0, 0x00};
+  EXPECT_EQ(0, memcmp(kRandom3_2, random_table.LookUp(3, 2),
+                      sizeof(kRandom3_2)));
+
+  PacketMaskTable long_random_table(kFecMaskRandom, 20);
+  const uint8_t kRandom20_3[] = {0xce, 0x33, 0x80, 0x00, 0x00, 0x00,
+                                 0x55, 0x95, 0x60, 0x00, 0x00, 0x00,
+                                 0xb1, 0x6a, 0x30, 0x00, 0x00, 0x00};
+  EXPECT_EQ(0, memcmp(kRandom20_3, long_random_table.LookUp(20, 3),
+                      sizeof(kRandom20_3)));
+
+  PacketMaskTable bursty_table(kFecMaskBursty, 4);
+  const uint8_t kBursty4_2[] = {0xa0, 0x00, 0xd0, 0x00};
+  EXPECT_EQ(0, memcmp(kBursty4_2, bursty_table.LookUp(4, 2),
+                      sizeof(kBursty4_2)));
+}
+
+TEST(PacketMaskTableTest, FallsBackToRandomMasksForManyMediaPackets) {
+  const int num_media_packets = kUlpfecMaxMediaPacketsBursty + 1;
+  PacketMaskTable bursty_table(kFecMaskBursty, num_media_packets);
+  PacketMaskTable random_table(kFecMaskRandom, num_media_packets);
+  const uint8_t* bursty_mask = bursty_table.LookUp(num_media_packets, 5);
+  const uint8_t* random_mask = random_table.LookUp(num_media_packets, 5);
+  EXPECT_EQ(0, memcmp(random_mask, bursty_mask,
+                      5 * PacketMaskSize(num_media_packets)));
+}
+
+}  // namespace internal
+}  // namespace webrtc
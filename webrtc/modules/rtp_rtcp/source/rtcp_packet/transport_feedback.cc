@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/include/module_common_types.h"
@@ -25,7 +27,6 @@ namespace {
 // * 8 bytes FeedbackPacket header
 constexpr size_t kTransportFeedbackHeaderSizeBytes = 4 + 8 + 8;
 constexpr size_t kChunkSizeBytes = 2;
-constexpr size_t kRunLengthCapacity = 0x1FFF;
 // TODO(sprang): Add support for dynamic max size for easier fragmentation,
 // eg. set it to what's left in the buffer or IP_PACKET_SIZE.
 // Size constraint imposed by RTCP common header: 16bit size field interpreted
@@ -73,28 +74,97 @@ TransportFeedback::StatusSymbol DecodeSymbol(uint8_t value) {
 }  // namespace
 constexpr uint8_t TransportFeedback::kFeedbackMessageType;
 
-class TransportFeedback::PacketStatusChunk {
- public:
-  virtual ~PacketStatusChunk() {}
-  virtual uint16_t NumSymbols() const = 0;
-  virtual void AppendSymbolsTo(
-      std::vector<TransportFeedback::StatusSymbol>* vec) const = 0;
-  virtual void WriteTo(uint8_t* buffer) const = 0;
-};
+constexpr size_t TransportFeedback::LastChunk::kMaxRunLengthCapacity;
+constexpr size_t TransportFeedback::LastChunk::kMaxOneBitCapacity;
+constexpr size_t TransportFeedback::LastChunk::kMaxTwoBitCapacity;
+constexpr size_t TransportFeedback::LastChunk::kMaxVectorCapacity;
+constexpr TransportFeedback::DeltaSize TransportFeedback::LastChunk::kLarge;
 
-TransportFeedback::TransportFeedback()
-    : base_seq_(-1),
-      base_time_(-1),
-      feedback_seq_(0),
-      last_seq_(-1),
-      last_timestamp_(-1),
-      first_symbol_cardinality_(0),
-      vec_needs_two_bit_symbols_(false),
-      size_bytes_(kTransportFeedbackHeaderSizeBytes) {}
+TransportFeedback::LastChunk::LastChunk() {
+  Clear();
+}
+
+void TransportFeedback::LastChunk::Clear() {
+  size_ = 0;
+  all_same_ = true;
+  has_large_delta_ = false;
+}
+
+bool TransportFeedback::LastChunk::CanAdd(DeltaSize delta_size) const {
+  RTC_DCHECK_LE(delta_size, kLarge);
+  if (size_ < kMaxTwoBitCapacity)
+    return true;
+  if (size_ < kMaxOneBitCapacity && !has_large_delta_ && delta_size != kLarge)
+    return true;
+  if (size_ < kMaxRunLengthCapacity && all_same_ &&
+      delta_sizes_[0] == delta_size) {
+    return true;
+  }
+  return false;
+}
+
+void TransportFeedback::LastChunk::Add(DeltaSize delta_size) {
+  RTC_DCHECK(CanAdd(delta_size));
+  if (size_ < kMaxVectorCapacity)
+    delta_sizes_[size_] = delta_size;
+  ++size_;
+  all_same_ = all_same_ && delta_size == delta_sizes_[0];
+  has_large_delta_ = has_large_delta_ || delta_size == kLarge;
+}
+
+uint16_t TransportFeedback::LastChunk::Emit() {
+  if (all_same_) {
+    uint16_t chunk = EncodeRunLength();
+    Clear();
+    return chunk;
+  }
+  if (size_ == kMaxOneBitCapacity) {
+    uint16_t chunk = EncodeOneBit();
+    Clear();
+    return chunk;
+  }
+  RTC_DCHECK_GE(size_, kMaxTwoBitCapacity);
+  uint16_t chunk = EncodeTwoBit(kMaxTwoBitCapacity);
+  // Keep the symbols that did not fit in the two bit chunk.
+  size_ -= kMaxTwoBitCapacity;
+  all_same_ = true;
+  has_large_delta_ = false;
+  for (size_t i = 0; i < size_; ++i) {
+    DeltaSize delta_size = delta_sizes_[kMaxTwoBitCapacity + i];
+    delta_sizes_[i] = delta_size;
+    all_same_ = all_same_ && delta_size == delta_sizes_[0];
+    has_large_delta_ = has_large_delta_ || delta_size == kLarge;
+  }
+  return chunk;
+}
+
+uint16_t TransportFeedback::LastChunk::EncodeLast() const {
+  RTC_DCHECK_GT(size_, 0u);
+  if (all_same_)
+    return EncodeRunLength();
+  if (size_ <= kMaxTwoBitCapacity)
+    return EncodeTwoBit(size_);
+  return EncodeOneBit();
+}
 
-TransportFeedback::~TransportFeedback() {
-  for (PacketStatusChunk* chunk : status_chunks_)
-    delete chunk;
+void TransportFeedback::LastChunk::Decode(uint16_t chunk, size_t max_size) {
+  if ((chunk & 0x8000) == 0) {
+    DecodeRunLength(chunk, max_size);
+  } else if ((chunk & 0x4000) == 0) {
+    DecodeOneBit(chunk, max_size);
+  } else {
+    DecodeTwoBit(chunk, max_size);
+  }
+}
+
+void TransportFeedback::LastChunk::AppendTo(
+    std::vector<DeltaSize>* delta_sizes) const {
+  if (all_same_) {
+    delta_sizes->insert(delta_sizes->end(), size_, delta_sizes_[0]);
+  } else {
+    delta_sizes->insert(delta_sizes->end(), delta_sizes_,
+                        delta_sizes_ + size_);
+  }
 }
 
 //  One Bit Status Vector Chunk
@@ -109,66 +179,24 @@ TransportFeedback::~TransportFeedback() {
 //  S = 0
 //  symbol list = 14 entries where 0 = not received, 1 = received
 
-class OneBitVectorChunk : public TransportFeedback::PacketStatusChunk {
- public:
-  static constexpr size_t kCapacity = 14;
-
-  explicit OneBitVectorChunk(
-      std::deque<TransportFeedback::StatusSymbol>* symbols) {
-    size_t input_size = symbols->size();
-    for (size_t i = 0; i < kCapacity; ++i) {
-      if (i < input_size) {
-        symbols_[i] = symbols->front();
-        symbols->pop_front();
-      } else {
-        symbols_[i] = TransportFeedback::StatusSymbol::kNotReceived;
-      }
-    }
-  }
-
-  ~OneBitVectorChunk() override {}
-
-  uint16_t NumSymbols() const override { return kCapacity; }
-
-  void AppendSymbolsTo(
-      std::vector<TransportFeedback::StatusSymbol>* vec) const override {
-    vec->insert(vec->end(), &symbols_[0], &symbols_[kCapacity]);
-  }
-
-  void WriteTo(uint8_t* buffer) const override {
-    constexpr int kSymbolsInFirstByte = 6;
-    constexpr int kSymbolsInSecondByte = 8;
-    buffer[0] = 0x80u;
-    for (int i = 0; i < kSymbolsInFirstByte; ++i) {
-      uint8_t encoded_symbol = EncodeSymbol(symbols_[i]);
-      RTC_DCHECK_LE(encoded_symbol, 1u);
-      buffer[0] |= encoded_symbol << (kSymbolsInFirstByte - (i + 1));
-    }
-    buffer[1] = 0x00u;
-    for (int i = 0; i < kSymbolsInSecondByte; ++i) {
-      uint8_t encoded_symbol = EncodeSymbol(symbols_[i + kSymbolsInFirstByte]);
-      RTC_DCHECK_LE(encoded_symbol, 1u);
-      buffer[1] |= encoded_symbol << (kSymbolsInSecondByte - (i + 1));
-    }
-  }
-
-  static OneBitVectorChunk* ParseFrom(const uint8_t* data) {
-    OneBitVectorChunk* chunk = new OneBitVectorChunk();
-
-    size_t index = 0;
-    for (int i = 5; i >= 0; --i)  // Last 5 bits from first byte.
-      chunk->symbols_[index++] = DecodeSymbol((data[0] >> i) & 0x01);
-    for (int i = 7; i >= 0; --i)  // 8 bits from the last byte.
-      chunk->symbols_[index++] = DecodeSymbol((data[1] >> i) & 0x01);
-
-    return chunk;
-  }
-
- private:
-  OneBitVectorChunk() {}
+uint16_t TransportFeedback::LastChunk::EncodeOneBit() const {
+  RTC_DCHECK(!has_large_delta_);
+  RTC_DCHECK_LE(size_, kMaxOneBitCapacity);
+  uint16_t chunk = 0x8000;
+  for (size_t i = 0; i < size_; ++i)
+    chunk |= delta_sizes_[i] << (kMaxOneBitCapacity - 1 - i);
+  return chunk;
+}
 
-  TransportFeedback::StatusSymbol symbols_[kCapacity];
-};
+void TransportFeedback::LastChunk::DecodeOneBit(uint16_t chunk,
+                                                size_t max_size) {
+  RTC_DCHECK_EQ(chunk & 0xC000, 0x8000);
+  size_ = std::min(kMaxOneBitCapacity, max_size);
+  has_large_delta_ = false;
+  all_same_ = false;
+  for (size_t i = 0; i < size_; ++i)
+    delta_sizes_[i] = (chunk >> (kMaxOneBitCapacity - 1 - i)) & 0x01;
+}
 
 //  Two Bit Status Vector Chunk
 //
@@ -182,64 +210,27 @@ class OneBitVectorChunk : public TransportFeedback::PacketStatusChunk {
 //  S = 1
 //  symbol list = 7 entries of two bits each, see (Encode|Decode)Symbol
 
-class TwoBitVectorChunk : public TransportFeedback::PacketStatusChunk {
- public:
-  static constexpr size_t kCapacity = 7;
-
-  explicit TwoBitVectorChunk(
-      std::deque<TransportFeedback::StatusSymbol>* symbols) {
-    size_t input_size = symbols->size();
-    for (size_t i = 0; i < kCapacity; ++i) {
-      if (i < input_size) {
-        symbols_[i] = symbols->front();
-        symbols->pop_front();
-      } else {
-        symbols_[i] = TransportFeedback::StatusSymbol::kNotReceived;
-      }
-    }
-  }
-
-  ~TwoBitVectorChunk() override {}
-
-  uint16_t NumSymbols() const override { return kCapacity; }
-
-  void AppendSymbolsTo(
-      std::vector<TransportFeedback::StatusSymbol>* vec) const override {
-    vec->insert(vec->end(), &symbols_[0], &symbols_[kCapacity]);
-  }
-
-  void WriteTo(uint8_t* buffer) const override {
-    buffer[0] = 0xC0;
-    buffer[0] |= EncodeSymbol(symbols_[0]) << 4;
-    buffer[0] |= EncodeSymbol(symbols_[1]) << 2;
-    buffer[0] |= EncodeSymbol(symbols_[2]);
-    buffer[1] = EncodeSymbol(symbols_[3]) << 6;
-    buffer[1] |= EncodeSymbol(symbols_[4]) << 4;
-    buffer[1] |= EncodeSymbol(symbols_[5]) << 2;
-    buffer[1] |= EncodeSymbol(symbols_[6]);
-  }
-
-  static TwoBitVectorChunk* ParseFrom(const uint8_t* buffer) {
-    TwoBitVectorChunk* chunk = new TwoBitVectorChunk();
-
-    chunk->symbols_[0] = DecodeSymbol((buffer[0] >> 4) & 0x03);
-    chunk->symbols_[1] = DecodeSymbol((buffer[0] >> 2) & 0x03);
-    chunk->symbols_[2] = DecodeSymbol(buffer[0] & 0x03);
-    chunk->symbols_[3] = DecodeSymbol((buffer[1] >> 6) & 0x03);
-    chunk->symbols_[4] = DecodeSymbol((buffer[1] >> 4) & 0x03);
-    chunk->symbols_[5] = DecodeSymbol((buffer[1] >> 2) & 0x03);
-    chunk->symbols_[6] = DecodeSymbol(buffer[1] & 0x03);
+uint16_t TransportFeedback::LastChunk::EncodeTwoBit(size_t size) const {
+  RTC_DCHECK_LE(size, std::min(size_, kMaxTwoBitCapacity));
+  uint16_t chunk = 0xC000;
+  for (size_t i = 0; i < size; ++i)
+    chunk |= delta_sizes_[i] << 2 * (kMaxTwoBitCapacity - 1 - i);
+  return chunk;
+}
 
-    return chunk;
+void TransportFeedback::LastChunk::DecodeTwoBit(uint16_t chunk,
+                                                size_t max_size) {
+  RTC_DCHECK_EQ(chunk & 0xC000, 0xC000);
+  size_ = std::min(kMaxTwoBitCapacity, max_size);
+  has_large_delta_ = true;
+  all_same_ = false;
+  for (size_t i = 0; i < size_; ++i) {
+    delta_sizes_[i] = EncodeSymbol(
+        DecodeSymbol((chunk >> 2 * (kMaxTwoBitCapacity - 1 - i)) & 0x03));
   }
+}
 
- private:
-  TwoBitVectorChunk() {}
-
-  TransportFeedback::StatusSymbol symbols_[kCapacity];
-};
-
-//  Two Bit Status Vector Chunk
+//  Run Length Chunk
 //
 //  0                   1
 //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
@@ -251,41 +242,32 @@ class TwoBitVectorChunk : public TransportFeedback::PacketStatusChunk {
 //  S = symbol, see (Encode|Decode)Symbol
 //  Run Length = Unsigned integer denoting the run length of the symbol
 
-class RunLengthChunk : public TransportFeedback::PacketStatusChunk {
- public:
-  RunLengthChunk(TransportFeedback::StatusSymbol symbol, size_t size)
-      : symbol_(symbol), size_(size) {
-    RTC_DCHECK_LE(size, 0x1FFFu);
-  }
-
-  ~RunLengthChunk() override {}
-
-  uint16_t NumSymbols() const override { return size_; }
-
-  void AppendSymbolsTo(
-      std::vector<TransportFeedback::StatusSymbol>* vec) const override {
-    vec->insert(vec->end(), size_, symbol_);
-  }
-
-  void WriteTo(uint8_t* buffer) const override {
-    buffer[0] = EncodeSymbol(symbol_) << 5;  // Write S (T = 0 implicitly)
-    buffer[0] |= (size_ >> 8) & 0x1F;  // 5 most significant bits of run length.
-    buffer[1] = size_ & 0xFF;  // 8 least significant bits of run length.
-  }
+uint16_t TransportFeedback::LastChunk::EncodeRunLength() const {
+  RTC_DCHECK(all_same_);
+  RTC_DCHECK_LE(size_, kMaxRunLengthCapacity);
+  return (delta_sizes_[0] << 13) | static_cast<uint16_t>(size_);
+}
 
-  static RunLengthChunk* ParseFrom(const uint8_t* buffer) {
-    RTC_DCHECK_EQ(0, buffer[0] & 0x80);
-    TransportFeedback::StatusSymbol symbol =
-        DecodeSymbol((buffer[0] >> 5) & 0x03);
-    uint16_t count = (static_cast<uint16_t>(buffer[0] & 0x1F) << 8) | buffer[1];
+void TransportFeedback::LastChunk::DecodeRunLength(uint16_t chunk,
+                                                   size_t max_size) {
+  RTC_DCHECK_EQ(chunk & 0x8000, 0);
+  size_ = std::min<size_t>(chunk & kMaxRunLengthCapacity, max_size);
+  DeltaSize delta_size = EncodeSymbol(DecodeSymbol((chunk >> 13) & 0x03));
+  has_large_delta_ = delta_size == kLarge;
+  all_same_ = true;
+  // Like Add(), keep as many symbols as a vector chunk holds.
+  std::fill(delta_sizes_, delta_sizes_ + kMaxVectorCapacity, delta_size);
+}
 
-    return new RunLengthChunk(symbol, count);
-  }
+TransportFeedback::TransportFeedback()
+    : base_seq_(-1),
+      base_time_(-1),
+      feedback_seq_(0),
+      last_seq_(-1),
+      last_timestamp_(-1),
+      size_bytes_(kTransportFeedbackHeaderSizeBytes) {}
 
- private:
-  const TransportFeedback::StatusSymbol symbol_;
-  const size_t size_;
-};
+TransportFeedback::~TransportFeedback() {}
 
 // Unwrap to a larger type, for easier handling of wraps.
 int64_t TransportFeedback::Unwrap(uint16_t sequence_number) {
@@ -342,184 +324,47 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
     return false;
   }
 
-  StatusSymbol symbol;
-  if (delta >= 0 && delta <= 0xFF) {
-    symbol = StatusSymbol::kReceivedSmallDelta;
-  } else {
-    symbol = StatusSymbol::kReceivedLargeDelta;
-  }
-
-  if (!AddSymbol(symbol, seq))
-    return false;
-
-  receive_deltas_.push_back(delta);
-  last_timestamp_ += delta * kDeltaScaleFactor;
-  return true;
-}
-
-// Add a symbol for a received packet, with the given sequence number. This
-// method will add any "packet not received" symbols needed before this one.
-bool TransportFeedback::AddSymbol(StatusSymbol symbol, int64_t seq) {
+  DeltaSize delta_size = (delta >= 0 && delta <= 0xFF) ? 1 : 2;
+  // Add "packet not received" symbols for any packets missing before this one.
   while (last_seq_ < seq - 1) {
-    if (!Encode(StatusSymbol::kNotReceived))
+    if (!AddDeltaSize(0))
       return false;
     ++last_seq_;
   }
-
-  if (!Encode(symbol))
+  if (!AddDeltaSize(delta_size))
     return false;
-
   last_seq_ = seq;
+
+  receive_deltas_.push_back(delta);
+  last_timestamp_ += delta * kDeltaScaleFactor;
   return true;
 }
 
-// Append a symbol to the internal symbol vector. If the new state cannot be
-// represented using a single status chunk, a chunk will first be emitted and
-// the associated symbols removed from the internal symbol vector.
-bool TransportFeedback::Encode(StatusSymbol symbol) {
+// Add the symbol of the packet after |last_seq_|, emitting the pending
+// symbols as a chunk first if the new one can't join them.
+bool TransportFeedback::AddDeltaSize(DeltaSize delta_size) {
   if (last_seq_ - base_seq_ + 1 > 0xFFFF) {
     LOG(LS_WARNING) << "Packet status count too large ( >= 2^16 )";
     return false;
   }
 
-  bool is_two_bit = false;
-  int delta_size = -1;
-  switch (symbol) {
-    case StatusSymbol::kReceivedSmallDelta:
-      delta_size = 1;
-      is_two_bit = false;
-      break;
-    case StatusSymbol::kReceivedLargeDelta:
-      delta_size = 2;
-      is_two_bit = true;
-      break;
-    case StatusSymbol::kNotReceived:
-      is_two_bit = false;
-      delta_size = 0;
-      break;
-  }
-  RTC_DCHECK_GE(delta_size, 0);
-
-  if (symbol_vec_.empty()) {
-    if (size_bytes_ + delta_size + kChunkSizeBytes > kMaxSizeBytes)
+  size_t add_chunk_size = last_chunk_.Empty() ? kChunkSizeBytes : 0;
+  if (last_chunk_.CanAdd(delta_size)) {
+    if (size_bytes_ + delta_size + add_chunk_size > kMaxSizeBytes)
       return false;
-
-    symbol_vec_.push_back(symbol);
-    vec_needs_two_bit_symbols_ = is_two_bit;
-    first_symbol_cardinality_ = 1;
-    size_bytes_ += delta_size + kChunkSizeBytes;
+    size_bytes_ += delta_size + add_chunk_size;
+    last_chunk_.Add(delta_size);
     return true;
   }
-  if (size_bytes_ + delta_size > kMaxSizeBytes)
+  if (size_bytes_ + delta_size + kChunkSizeBytes > kMaxSizeBytes)
     return false;
 
-  // Capacity, in number of symbols, that a vector chunk could hold.
-  size_t capacity = vec_needs_two_bit_symbols_ ? TwoBitVectorChunk::kCapacity
-                                               : OneBitVectorChunk::kCapacity;
-
-  // first_symbol_cardinality_ is the number of times the first symbol in
-  // symbol_vec is repeated. So if that is equal to the size of symbol_vec,
-  // there is only one kind of symbol - we can potentially RLE encode it.
-  // If we have less than (capacity) symbols in symbol_vec, we can't know
-  // for certain this will be RLE-encoded; if a different symbol is added
-  // these symbols will be needed to emit a vector chunk instead. However,
-  // if first_symbol_cardinality_ > capacity, then we cannot encode the
-  // current state as a vector chunk - we must first emit symbol_vec as an
-  // RLE-chunk and then add the new symbol.
-  bool rle_candidate = symbol_vec_.size() == first_symbol_cardinality_ ||
-                       first_symbol_cardinality_ > capacity;
-  if (rle_candidate) {
-    if (symbol_vec_.back() == symbol) {
-      ++first_symbol_cardinality_;
-      if (first_symbol_cardinality_ <= capacity) {
-        symbol_vec_.push_back(symbol);
-      } else if (first_symbol_cardinality_ == kRunLengthCapacity) {
-        // Max length for an RLE-chunk reached.
-        EmitRunLengthChunk();
-      }
-      size_bytes_ += delta_size;
-      return true;
-    } else {
-      // New symbol does not match what's already in symbol_vec.
-      if (first_symbol_cardinality_ >= capacity) {
-        // Symbols in symbol_vec can only be RLE-encoded. Emit the RLE-chunk
-        // and re-add input. symbol_vec is then guaranteed to have room for the
-        // symbol, so recursion cannot continue.
-        EmitRunLengthChunk();
-        return Encode(symbol);
-      }
-      // Fall through and treat state as non RLE-candidate.
-    }
-  }
-
-  // If this code point is reached, symbols in symbol_vec cannot be RLE-encoded.
-
-  if (is_two_bit && !vec_needs_two_bit_symbols_) {
-    // If the symbols in symbol_vec can be encoded using a one-bit chunk but
-    // the input symbol cannot, first check if we can simply change target type.
-    vec_needs_two_bit_symbols_ = true;
-    if (symbol_vec_.size() >= TwoBitVectorChunk::kCapacity) {
-      // symbol_vec contains more symbols than we can encode in a single
-      // two-bit chunk. Emit a new vector append to the remains, if any.
-      if (size_bytes_ + delta_size + kChunkSizeBytes > kMaxSizeBytes)
-        return false;
-      EmitVectorChunk();
-      // If symbol_vec isn't empty after emitting a vector chunk, we need to
-      // account for chunk size (otherwise handled by Encode method).
-      if (!symbol_vec_.empty())
-        size_bytes_ += kChunkSizeBytes;
-      return Encode(symbol);
-    }
-    // symbol_vec symbols fit within a single two-bit vector chunk.
-    capacity = TwoBitVectorChunk::kCapacity;
-  }
-
-  symbol_vec_.push_back(symbol);
-  if (symbol_vec_.size() == capacity)
-    EmitVectorChunk();
-
-  size_bytes_ += delta_size;
+  encoded_chunks_.push_back(last_chunk_.Emit());
+  size_bytes_ += delta_size + kChunkSizeBytes;
+  last_chunk_.Add(delta_size);
   return true;
 }
 
-// Upon packet completion, emit any remaining symbols in symbol_vec that have
-// not yet been emitted in a status chunk.
-void TransportFeedback::EmitRemaining() {
-  if (symbol_vec_.empty())
-    return;
-
-  size_t capacity = vec_needs_two_bit_symbols_ ? TwoBitVectorChunk::kCapacity
-                                               : OneBitVectorChunk::kCapacity;
-  if (first_symbol_cardinality_ > capacity) {
-    EmitRunLengthChunk();
-  } else {
-    EmitVectorChunk();
-  }
-}
-
-void TransportFeedback::EmitVectorChunk() {
-  if (vec_needs_two_bit_symbols_) {
-    status_chunks_.push_back(new TwoBitVectorChunk(&symbol_vec_));
-  } else {
-    status_chunks_.push_back(new OneBitVectorChunk(&symbol_vec_));
-  }
-  // Update first symbol cardinality to match what is potentially left in in
-  // symbol_vec.
-  first_symbol_cardinality_ = 1;
-  for (size_t i = 1; i < symbol_vec_.size(); ++i) {
-    if (symbol_vec_[i] != symbol_vec_[0])
-      break;
-    ++first_symbol_cardinality_;
-  }
-}
-
-void TransportFeedback::EmitRunLengthChunk() {
-  RTC_DCHECK_GE(first_symbol_cardinality_, symbol_vec_.size());
-  status_chunks_.push_back(
-      new RunLengthChunk(symbol_vec_.front(), first_symbol_cardinality_));
-  symbol_vec_.clear();
-}
-
 size_t TransportFeedback::BlockLength() const {
   // Round size_bytes_ up to multiple of 32bits.
   return (size_bytes_ + 3) & (~static_cast<size_t>(3));
@@ -533,15 +378,32 @@ int64_t TransportFeedback::GetBaseTimeUs() const {
   return base_time_ * kBaseScaleFactor;
 }
 
+std::vector<TransportFeedback::DeltaSize> TransportFeedback::GetDeltaSizes()
+    const {
+  std::vector<DeltaSize> delta_sizes;
+  if (base_seq_ == -1)
+    return delta_sizes;
+  // Vector chunks may end with extraneous "packet not received" symbols,
+  // crop any such symbols.
+  size_t num_remaining = last_seq_ - base_seq_ + 1 - last_chunk_.size();
+  delta_sizes.reserve(num_remaining + last_chunk_.size());
+  LastChunk chunk;
+  for (uint16_t encoded_chunk : encoded_chunks_) {
+    chunk.Decode(encoded_chunk, num_remaining);
+    chunk.AppendTo(&delta_sizes);
+    num_remaining -= chunk.size();
+  }
+  last_chunk_.AppendTo(&delta_sizes);
+  return delta_sizes;
+}
+
 std::vector<TransportFeedback::StatusSymbol>
 TransportFeedback::GetStatusVector() const {
+  std::vector<DeltaSize> delta_sizes = GetDeltaSizes();
   std::vector<TransportFeedback::StatusSymbol> symbols;
-  for (PacketStatusChunk* chunk : status_chunks_)
-    chunk->AppendSymbolsTo(&symbols);
-  int64_t status_count = last_seq_ - base_seq_ + 1;
-  // If packet ends with a vector chunk, it may contain extraneous "packet not
-  // received"-symbols at the end. Crop any such symbols.
-  symbols.erase(symbols.begin() + status_count, symbols.end());
+  symbols.reserve(delta_sizes.size());
+  for (DeltaSize delta_size : delta_sizes)
+    symbols.push_back(DecodeSymbol(delta_size));
   return symbols;
 }
 
@@ -594,10 +456,13 @@ bool TransportFeedback::Create(uint8_t* packet,
 
   packet[(*position)++] = feedback_seq_;
 
-  // TODO(sprang): Get rid of this cast.
-  const_cast<TransportFeedback*>(this)->EmitRemaining();
-  for (PacketStatusChunk* chunk : status_chunks_) {
-    chunk->WriteTo(&packet[*position]);
+  for (uint16_t chunk : encoded_chunks_) {
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[*position], chunk);
+    *position += 2;
+  }
+  if (!last_chunk_.Empty()) {
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[*position],
+                                         last_chunk_.EncodeLast());
     *position += 2;
   }
 
@@ -658,7 +523,7 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     return false;
   }
   // TODO(danilchap): Make parse work correctly with not new objects.
-  RTC_DCHECK(status_chunks_.empty()) << "Parse expects object to be new.";
+  RTC_DCHECK(encoded_chunks_.empty()) << "Parse expects object to be new.";
 
   const uint8_t* const payload = packet.payload();
 
@@ -684,22 +549,28 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
       return false;
     }
 
-    PacketStatusChunk* chunk =
-        ParseChunk(&payload[index], num_packets - packets_read);
-    if (chunk == nullptr)
-      return false;
-
+    uint16_t chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[index]);
     index += 2;
-    status_chunks_.push_back(chunk);
-    packets_read += chunk->NumSymbols();
+    last_chunk_.Decode(chunk, num_packets - packets_read);
+    if ((chunk & 0x8000) == 0 &&
+        (chunk & 0x1FFF) > num_packets - packets_read) {
+      LOG(LS_WARNING) << "Header/body mismatch. "
+                         "RLE block of size " << (chunk & 0x1FFF)
+                      << " but only " << num_packets - packets_read
+                      << " left to read.";
+      return false;
+    }
+    encoded_chunks_.push_back(chunk);
+    packets_read += last_chunk_.size();
   }
+  last_chunk_.Clear();
 
-  std::vector<StatusSymbol> symbols = GetStatusVector();
+  std::vector<DeltaSize> delta_sizes = GetDeltaSizes();
 
-  RTC_DCHECK_EQ(num_packets, symbols.size());
+  RTC_DCHECK_EQ(num_packets, delta_sizes.size());
 
-  for (StatusSymbol symbol : symbols) {
-    switch (symbol) {
+  for (DeltaSize delta_size : delta_sizes) {
+    switch (DecodeSymbol(delta_size)) {
       case StatusSymbol::kReceivedSmallDelta:
         if (index + 1 > end_index) {
           LOG(LS_WARNING) << "Buffer overflow while parsing packet.";
@@ -741,31 +612,5 @@ std::unique_ptr<TransportFeedback> TransportFeedback::ParseFrom(
   return parsed;
 }
 
-TransportFeedback::PacketStatusChunk* TransportFeedback::ParseChunk(
-    const uint8_t* buffer,
-    size_t max_size) {
-  if (buffer[0] & 0x80) {
-    // First bit set => vector chunk.
-    if (buffer[0] & 0x40) {
-      // Second bit set => two bits per symbol vector.
-      return TwoBitVectorChunk::ParseFrom(buffer);
-    }
-
-    // Second bit not set => one bit per symbol vector.
-    return OneBitVectorChunk::ParseFrom(buffer);
-  }
-
-  // First bit not set => RLE chunk.
-  RunLengthChunk* rle_chunk = RunLengthChunk::ParseFrom(buffer);
-  if (rle_chunk->NumSymbols() > max_size) {
-    LOG(LS_WARNING) << "Header/body mismatch. "
-                       "RLE block of size " << rle_chunk->NumSymbols()
-                    << " but only " << max_size << " left to read.";
-    delete rle_chunk;
-    return nullptr;
-  }
-  return rle_chunk;
-}
-
 }  // namespace rtcp
 }  // namespace webrtc
@@ -11,7 +11,6 @@
 #ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_TRANSPORT_FEEDBACK_H_
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_TRANSPORT_FEEDBACK_H_
 
-#include <deque>
 #include <memory>
 #include <vector>
 
@@ -25,7 +24,6 @@ class CommonHeader;
 
 class TransportFeedback : public Rtpfb {
  public:
-  class PacketStatusChunk;
   // TODO(sprang): IANA reg?
   static constexpr uint8_t kFeedbackMessageType = 15;
   // Convert to multiples of 0.25ms.
@@ -86,29 +84,67 @@ class TransportFeedback : public Rtpfb {
   size_t BlockLength() const override;
 
  private:
-  static PacketStatusChunk* ParseChunk(const uint8_t* buffer, size_t max_size);
+  // Number of receive delta bytes a packet takes: 0 when it was not received,
+  // 1 for a small delta and 2 for a large one. Doubles as the packet's two bit
+  // status symbol.
+  using DeltaSize = uint8_t;
+
+  // The status symbols not yet encoded into a chunk. Keeps just enough of them
+  // to pick the chunk type that fits them best, so that adding a packet never
+  // allocates.
+  class LastChunk {
+   public:
+    LastChunk();
+
+    bool Empty() const { return size_ == 0; }
+    void Clear();
+    size_t size() const { return size_; }
+    // Whether |delta_size| can be added without emitting a chunk first.
+    bool CanAdd(DeltaSize delta_size) const;
+    void Add(DeltaSize delta_size);
+    // Encodes as many symbols as fit in a single chunk and removes them.
+    uint16_t Emit();
+    // Encodes all the symbols, which must fit in a single chunk.
+    uint16_t EncodeLast() const;
+    // Replaces the symbols with the first |max_size| ones in |chunk|.
+    void Decode(uint16_t chunk, size_t max_size);
+    void AppendTo(std::vector<DeltaSize>* delta_sizes) const;
+
+   private:
+    static constexpr size_t kMaxRunLengthCapacity = 0x1FFF;
+    static constexpr size_t kMaxOneBitCapacity = 14;
+    static constexpr size_t kMaxTwoBitCapacity = 7;
+    static constexpr size_t kMaxVectorCapacity = kMaxOneBitCapacity;
+    static constexpr DeltaSize kLarge = 2;
+
+    uint16_t EncodeOneBit() const;
+    uint16_t EncodeTwoBit(size_t size) const;
+    uint16_t EncodeRunLength() const;
+    void DecodeOneBit(uint16_t chunk, size_t max_size);
+    void DecodeTwoBit(uint16_t chunk, size_t max_size);
+    void DecodeRunLength(uint16_t chunk, size_t max_size);
+
+    // Only the first |kMaxVectorCapacity| symbols are kept. A longer run is
+    // all the same symbol and is encoded by its length.
+    DeltaSize delta_sizes_[kMaxVectorCapacity];
+    size_t size_;
+    bool all_same_;
+    bool has_large_delta_;
+  };
 
   int64_t Unwrap(uint16_t sequence_number);
-  bool AddSymbol(StatusSymbol symbol, int64_t seq);
-  bool Encode(StatusSymbol symbol);
-  bool HandleRleCandidate(StatusSymbol symbol,
-                          int current_capacity,
-                          int delta_size);
-  void EmitRemaining();
-  void EmitVectorChunk();
-  void EmitRunLengthChunk();
+  bool AddDeltaSize(DeltaSize delta_size);
+  std::vector<DeltaSize> GetDeltaSizes() const;
 
   int32_t base_seq_;
   int64_t base_time_;
   uint8_t feedback_seq_;
-  std::vector<PacketStatusChunk*> status_chunks_;
+  std::vector<uint16_t> encoded_chunks_;
+  LastChunk last_chunk_;
   std::vector<int16_t> receive_deltas_;
 
   int64_t last_seq_;
   int64_t last_timestamp_;
-  std::deque<StatusSymbol> symbol_vec_;
-  uint16_t first_symbol_cardinality_;
-  bool vec_needs_two_bit_symbols_;
   uint32_t size_bytes_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(TransportFeedback);
@@ -50,17 +50,10 @@ bool RtpHeaderParserImpl::Parse(const uint8_t* packet,
   RtpUtility::RtpHeaderParser rtp_parser(packet, length);
   memset(header, 0, sizeof(*header));
 
-  RtpHeaderExtensionMap map;
-  {
-    rtc::CritScope cs(&critical_section_);
-    rtp_header_extension_map_.GetCopy(&map);
-  }
-
-  const bool valid_rtpheader = rtp_parser.Parse(header, &map);
-  if (!valid_rtpheader) {
-    return false;
-  }
-  return true;
+  // Parsing with the map in place is cheaper than copying it, which allocates
+  // an entry per registered extension, for every packet.
+  rtc::CritScope cs(&critical_section_);
+  return rtp_parser.Parse(header, &rtp_header_extension_map_);
 }
 
 bool RtpHeaderParserImpl::RegisterRtpHeaderExtension(RTPExtensionType type,
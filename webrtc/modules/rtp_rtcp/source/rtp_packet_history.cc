@@ -21,11 +21,19 @@
 namespace webrtc {
 namespace {
 constexpr size_t kMinPacketRequestBytes = 50;
+
+size_t PacketBytes(const RtpPacketToSend& packet) {
+  return sizeof(packet) + packet.capacity();
+}
 }  // namespace
 constexpr size_t RtpPacketHistory::kMaxCapacity;
 
 RtpPacketHistory::RtpPacketHistory(Clock* clock)
-    : clock_(clock), store_(false), prev_index_(0) {}
+    : clock_(clock),
+      store_(false),
+      prev_index_(0),
+      stored_packet_bytes_(0),
+      memory_usage_(memory_usage::kRtpPacketHistory) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -49,6 +57,7 @@ void RtpPacketHistory::Allocate(size_t number_to_store) {
   RTC_DCHECK_LE(number_to_store, kMaxCapacity);
   store_ = true;
   stored_packets_.resize(number_to_store);
+  UpdateMemoryUsage();
 }
 
 void RtpPacketHistory::Free() {
@@ -57,6 +66,8 @@ void RtpPacketHistory::Free() {
   }
 
   stored_packets_.clear();
+  stored_packet_bytes_ = 0;
+  UpdateMemoryUsage();
 
   store_ = false;
   prev_index_ = 0;
@@ -100,7 +111,11 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
       (sent ? clock_->TimeInMilliseconds() : 0);
   stored_packets_[prev_index_].storage_type = type;
   stored_packets_[prev_index_].has_been_retransmitted = false;
+  if (stored_packets_[prev_index_].packet)
+    stored_packet_bytes_ -= PacketBytes(*stored_packets_[prev_index_].packet);
+  stored_packet_bytes_ += PacketBytes(*packet);
   stored_packets_[prev_index_].packet = std::move(packet);
+  UpdateMemoryUsage();
 
   ++prev_index_;
   if (prev_index_ >= stored_packets_.size()) {
@@ -218,4 +233,9 @@ int RtpPacketHistory::FindBestFittingPacket(size_t size) const {
   return best_index;
 }
 
+void RtpPacketHistory::UpdateMemoryUsage() {
+  memory_usage_.Set(stored_packets_.capacity() * sizeof(StoredPacket) +
+                    stored_packet_bytes_);
+}
+
 }  // namespace webrtc
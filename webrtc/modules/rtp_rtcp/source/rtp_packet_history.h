@@ -18,6 +18,7 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/system_wrappers/include/memory_usage.h"
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
@@ -72,12 +73,16 @@ class RtpPacketHistory {
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   int FindBestFittingPacket(size_t size) const
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void UpdateMemoryUsage() EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
   Clock* clock_;
   rtc::CriticalSection critsect_;
   bool store_ GUARDED_BY(critsect_);
   uint32_t prev_index_ GUARDED_BY(critsect_);
   std::vector<StoredPacket> stored_packets_ GUARDED_BY(critsect_);
+  // Bytes held by the packets in |stored_packets_|.
+  size_t stored_packet_bytes_ GUARDED_BY(critsect_);
+  memory_usage::Tracker memory_usage_ GUARDED_BY(critsect_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
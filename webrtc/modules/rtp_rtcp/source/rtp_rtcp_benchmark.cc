@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <list>
+#include <memory>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_test_helper.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kPayloadType = 100;
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr size_t kPayloadSize = 1100;
+constexpr uint8_t kTransmissionOffsetId = 1;
+constexpr uint8_t kAbsoluteSendTimeId = 2;
+constexpr uint8_t kTransportSequenceNumberId = 3;
+constexpr uint8_t kVideoOrientationId = 4;
+
+// The extensions negotiated for video by default.
+void RegisterVideoExtensions(RtpHeaderExtensionMap* extensions) {
+  extensions->Register(kRtpExtensionTransmissionTimeOffset,
+                       kTransmissionOffsetId);
+  extensions->Register(kRtpExtensionAbsoluteSendTime, kAbsoluteSendTimeId);
+  extensions->Register(kRtpExtensionTransportSequenceNumber,
+                       kTransportSequenceNumberId);
+  extensions->Register(kRtpExtensionVideoRotation, kVideoOrientationId);
+}
+
+void BuildVideoPacket(uint16_t sequence_number, RtpPacketToSend* packet) {
+  packet->SetPayloadType(kPayloadType);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetTimestamp(sequence_number * 3000u);
+  packet->SetSsrc(kSsrc);
+  packet->SetExtension<TransmissionOffset>(0x56ce);
+  packet->SetExtension<AbsoluteSendTime>(0x123456);
+  packet->SetExtension<TransportSequenceNumber>(sequence_number);
+  packet->SetExtension<VideoOrientation>(kVideoRotation_0);
+  uint8_t* payload = packet->AllocatePayload(kPayloadSize);
+  for (size_t i = 0; i < kPayloadSize; ++i)
+    payload[i] = static_cast<uint8_t>(i);
+}
+
+}  // namespace
+
+TEST(RtpRtcpBenchmark, BuildVideoPacket) {
+  RtpPacketToSend::ExtensionManager extensions;
+  RegisterVideoExtensions(&extensions);
+  RtpPacketToSend packet(&extensions);
+  uint16_t sequence_number = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "rtp_build_video_packet", test::BenchmarkOptions(), [&] {
+        packet.Clear();
+        BuildVideoPacket(sequence_number++, &packet);
+      }));
+}
+
+TEST(RtpRtcpBenchmark, ParseVideoPacket) {
+  RtpPacketToSend::ExtensionManager extensions;
+  RegisterVideoExtensions(&extensions);
+  RtpPacketToSend sent_packet(&extensions);
+  BuildVideoPacket(1, &sent_packet);
+  RtpPacketReceived packet(&extensions);
+  uint16_t transport_sequence_number = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "rtp_parse_video_packet", test::BenchmarkOptions(), [&] {
+        packet.Parse(sent_packet.data(), sent_packet.size());
+        packet.GetExtension<TransportSequenceNumber>(
+            &transport_sequence_number);
+      }));
+  EXPECT_EQ(1, transport_sequence_number);
+}
+
+TEST(RtpRtcpBenchmark, ParseVideoPacketHeader) {
+  RtpPacketToSend::ExtensionManager extensions;
+  RegisterVideoExtensions(&extensions);
+  RtpPacketToSend sent_packet(&extensions);
+  BuildVideoPacket(1, &sent_packet);
+  RTPHeader header;
+  test::ReportBenchmark(test::RunBenchmark(
+      "rtp_parse_video_packet_header", test::BenchmarkOptions(), [&] {
+        RtpUtility::RtpHeaderParser parser(sent_packet.data(),
+                                           sent_packet.size());
+        parser.Parse(&header, &extensions);
+      }));
+  EXPECT_TRUE(header.extension.hasTransportSequenceNumber);
+}
+
+// The parse done by every receive stream for each packet delivered to it.
+TEST(RtpRtcpBenchmark, ParseVideoPacketHeaderWithParser) {
+  RtpPacketToSend::ExtensionManager extensions;
+  RegisterVideoExtensions(&extensions);
+  RtpPacketToSend sent_packet(&extensions);
+  BuildVideoPacket(1, &sent_packet);
+  std::unique_ptr<RtpHeaderParser> parser(RtpHeaderParser::Create());
+  parser->RegisterRtpHeaderExtension(kRtpExtensionTransmissionTimeOffset,
+                                     kTransmissionOffsetId);
+  parser->RegisterRtpHeaderExtension(kRtpExtensionAbsoluteSendTime,
+                                     kAbsoluteSendTimeId);
+  parser->RegisterRtpHeaderExtension(kRtpExtensionTransportSequenceNumber,
+                                     kTransportSequenceNumberId);
+  parser->RegisterRtpHeaderExtension(kRtpExtensionVideoRotation,
+                                     kVideoOrientationId);
+  RTPHeader header;
+  test::ReportBenchmark(test::RunBenchmark(
+      "rtp_header_parser_parse_video_packet", test::BenchmarkOptions(), [&] {
+        parser->Parse(sent_packet.data(), sent_packet.size(), &header);
+      }));
+  EXPECT_TRUE(header.extension.hasTransportSequenceNumber);
+}
+
+class FecEncodeBenchmark : public ::testing::Test {
+ protected:
+  // A 10 packet frame, protected with 50% overhead.
+  static constexpr int kNumMediaPackets = 10;
+  static constexpr uint8_t kProtectionFactor = 128;
+
+  void Run(ForwardErrorCorrection* fec, const std::string& name) {
+    Random random(0xfec);
+    test::fec::MediaPacketGenerator media_packet_generator(
+        kPayloadSize, kPayloadSize + 100, kSsrc, &random);
+    ForwardErrorCorrection::PacketList media_packets =
+        media_packet_generator.ConstructMediaPackets(kNumMediaPackets);
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    test::ReportBenchmark(
+        test::RunBenchmark(name, test::BenchmarkOptions(), [&] {
+          fec_packets.clear();
+          fec->EncodeFec(media_packets, kProtectionFactor, 0, false,
+                         kFecMaskRandom, &fec_packets);
+        }));
+    EXPECT_FALSE(fec_packets.empty());
+  }
+};
+
+TEST_F(FecEncodeBenchmark, Ulpfec) {
+  Run(ForwardErrorCorrection::CreateUlpfec().get(), "ulpfec_encode");
+}
+
+TEST_F(FecEncodeBenchmark, Flexfec) {
+  Run(ForwardErrorCorrection::CreateFlexfec().get(), "flexfec_encode");
+}
+
+}  // namespace webrtc
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include "webrtc/base/random.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_test_helper.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 83542;
+constexpr int kNumFrames = 2000;
+// A high bitrate keyframe, protected with the largest masks.
+constexpr int kNumMediaPackets = 48;
+constexpr uint32_t kMinPacketSize = 1000;
+constexpr uint32_t kMaxPacketSize = 1200;
+// 50% overhead.
+constexpr uint8_t kProtectionFactor = 128;
+
+std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> CreateReceivedPacket(
+    const ForwardErrorCorrection::Packet& packet,
+    uint16_t seq_num,
+    bool is_fec) {
+  std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> received_packet(
+      new ForwardErrorCorrection::ReceivedPacket());
+  received_packet->pkt = new ForwardErrorCorrection::Packet();
+  received_packet->pkt->length = packet.length;
+  memcpy(received_packet->pkt->data, packet.data, packet.length);
+  received_packet->seq_num = seq_num;
+  received_packet->ssrc = kMediaSsrc;
+  received_packet->is_fec = is_fec;
+  return received_packet;
+}
+
+// Encodes |kNumFrames| frames, drops media and FEC packets independently with
+// probability |loss_rate|, and measures the time spent in DecodeFec().
+void RunDecodingTest(ForwardErrorCorrection* fec,
+                     const std::string& fec_name,
+                     float loss_rate) {
+  Random random(0xfec133700742);
+  test::fec::MediaPacketGenerator media_packet_generator(
+      kMinPacketSize, kMaxPacketSize, kMediaSsrc, &random);
+  ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+  uint16_t seq_num = 0;
+  int64_t decode_time_ns = 0;
+  size_t num_lost = 0;
+  size_t num_recovered = 0;
+
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    ForwardErrorCorrection::PacketList media_packets =
+        media_packet_generator.ConstructMediaPackets(kNumMediaPackets,
+                                                     seq_num);
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    ASSERT_EQ(0, fec->EncodeFec(media_packets, kProtectionFactor, 0, false,
+                                kFecMaskRandom, &fec_packets));
+
+    ForwardErrorCorrection::ReceivedPacketList received_packets;
+    for (const auto& media_packet : media_packets) {
+      if (random.Rand<float>() < loss_rate) {
+        ++num_lost;
+        continue;
+      }
+      received_packets.push_back(CreateReceivedPacket(
+          *media_packet,
+          ByteReader<uint16_t>::ReadBigEndian(&media_packet->data[2]), false));
+    }
+    uint16_t fec_seq_num = media_packet_generator.GetFecSeqNum();
+    for (const auto* fec_packet : fec_packets) {
+      if (random.Rand<float>() >= loss_rate) {
+        received_packets.push_back(
+            CreateReceivedPacket(*fec_packet, fec_seq_num, true));
+      }
+      ++fec_seq_num;
+    }
+    seq_num = fec_seq_num;
+    if (received_packets.empty()) {
+      continue;
+    }
+
+    const int64_t start_ns = rtc::TimeNanos();
+    ASSERT_EQ(0, fec->DecodeFec(&received_packets, &recovered_packets));
+    decode_time_ns += rtc::TimeNanos() - start_ns;
+
+    for (const auto& recovered_packet : recovered_packets) {
+      if (recovered_packet->was_recovered && !recovered_packet->returned) {
+        recovered_packet->returned = true;
+        ++num_recovered;
+      }
+    }
+  }
+
+  const std::string trace =
+      std::to_string(static_cast<int>(loss_rate * 100 + 0.5)) + "_pl";
+  test::PrintResult("fec_decode_time_per_frame", "_" + fec_name, trace,
+                    static_cast<size_t>(decode_time_ns / kNumFrames), "ns",
+                    true);
+  test::PrintResult("fec_recovered_packets", "_" + fec_name, trace,
+                    num_recovered, "packets", false);
+  test::PrintResult("fec_lost_packets", "_" + fec_name, trace, num_lost,
+                    "packets", false);
+}
+
+}  // namespace
+
+TEST(FecDecodingPerformanceTest, Ulpfec) {
+  for (float loss_rate : {0.1f, 0.2f, 0.3f}) {
+    std::unique_ptr<ForwardErrorCorrection> fec =
+        ForwardErrorCorrection::CreateUlpfec();
+    RunDecodingTest(fec.get(), "ulpfec", loss_rate);
+  }
+}
+
+TEST(FecDecodingPerformanceTest, Flexfec) {
+  for (float loss_rate : {0.1f, 0.2f, 0.3f}) {
+    std::unique_ptr<ForwardErrorCorrection> fec =
+        ForwardErrorCorrection::CreateFlexfec();
+    RunDecodingTest(fec.get(), "flexfec", loss_rate);
+  }
+}
+
+}  // namespace webrtc
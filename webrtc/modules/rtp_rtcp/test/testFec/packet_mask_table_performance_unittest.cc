@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction_internal.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Number of mask lookups measured for every combination, after the first one.
+constexpr int kNumLookUps = 1000;
+
+// Measures the latency of the first lookup of a packet mask, which decodes all
+// masks for the given number of media packets, and the average latency of
+// subsequent lookups, which read the decoded masks.
+void RunLookUpTest(FecMaskType fec_mask_type,
+                   const std::string& mask_type_name,
+                   int num_media_packets) {
+  internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+
+  int64_t start_ns = rtc::TimeNanos();
+  mask_table.LookUp(num_media_packets, num_media_packets);
+  const int64_t first_look_up_ns = rtc::TimeNanos() - start_ns;
+
+  start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumLookUps; ++i) {
+    mask_table.LookUp(num_media_packets, i % num_media_packets + 1);
+  }
+  const int64_t cached_look_up_ns =
+      (rtc::TimeNanos() - start_ns) / kNumLookUps;
+
+  const std::string trace = std::to_string(num_media_packets) + "_media";
+  test::PrintResult("packet_mask_first_look_up_time", "_" + mask_type_name,
+                    trace, static_cast<size_t>(first_look_up_ns), "ns", false);
+  test::PrintResult("packet_mask_cached_look_up_time", "_" + mask_type_name,
+                    trace, static_cast<size_t>(cached_look_up_ns), "ns", false);
+}
+
+}  // namespace
+
+// The masks are decoded once per process, so only the first run of these
+// tests measures the decoding.
+TEST(PacketMaskTablePerformanceTest, Random) {
+  for (int num_media_packets : {4, 12, 24, 48}) {
+    RunLookUpTest(kFecMaskRandom, "random", num_media_packets);
+  }
+}
+
+TEST(PacketMaskTablePerformanceTest, Bursty) {
+  for (int num_media_packets : {4, 8, 12}) {
+    RunLookUpTest(kFecMaskBursty, "bursty", num_media_packets);
+  }
+}
+
+}  // namespace webrtc
@@ -28,11 +28,7 @@
 // #define VERBOSE_OUTPUT
 
 namespace webrtc {
-namespace fec_private_tables {
-extern const uint8_t** kPacketMaskBurstyTbl[12];
-}
 namespace test {
-using fec_private_tables::kPacketMaskBurstyTbl;
 
 void ReceivePackets(
     ForwardErrorCorrection::ReceivedPacketList* to_decode_list,
@@ -102,7 +98,7 @@ TEST(FecTest, MAYBE_FecTest) {
   // Maximum number of media packets allowed for the mask type.
   const uint16_t kMaxMediaPackets[] = {
       kMaxNumberMediaPackets,
-      sizeof(kPacketMaskBurstyTbl) / sizeof(*kPacketMaskBurstyTbl)};
+      kUlpfecMaxMediaPacketsBursty};
 
   ASSERT_EQ(12, kMaxMediaPackets[1]) << "Max media packets for bursty mode not "
                                      << "equal to 12.";
@@ -182,7 +178,7 @@ TEST(FecTest, MAYBE_FecTest) {
             internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
                                           num_imp_packets,
                                           kUseUnequalProtection,
-                                          mask_table, packet_mask.get());
+                                          &mask_table, packet_mask.get());
 
 #ifdef VERBOSE_OUTPUT
             printf(
@@ -742,8 +742,7 @@ class FecPacketMaskMetricsTest : public ::testing::Test {
           num_fec_packets++) {
         memset(packet_mask.get(), 0, num_media_packets * mask_bytes_fec_packet);
         memcpy(packet_mask.get(),
-               mask_table.fec_packet_mask_table()[num_media_packets - 1]
-                                                 [num_fec_packets - 1],
+               mask_table.LookUp(num_media_packets, num_fec_packets),
                num_fec_packets * mask_bytes_fec_packet);
         // Convert to bit mask.
         GetPacketMaskConvertToBitMask(packet_mask.get(), num_media_packets,
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
+#include "webrtc/modules/video_coding/include/video_coding.h"
+#include "webrtc/test/frame_generator.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+namespace {
+
+const int kWidth = 352;
+const int kHeight = 288;
+const int kFramerate = 30;
+const int kBitrateKbps = 500;
+// Frames encoded per sample. The decoder restarts at the key frame that
+// starts every sample.
+const int kNumFrames = 100;
+
+class EncodedFrameCollector : public EncodedImageCallback {
+ public:
+  struct Frame {
+    std::vector<uint8_t> data;
+    EncodedImage image;
+  };
+
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation) override {
+    frames_.emplace_back();
+    Frame& frame = frames_.back();
+    frame.data.assign(encoded_image._buffer,
+                      encoded_image._buffer + encoded_image._length);
+    frame.image = encoded_image;
+    return Result(Result::OK, encoded_image._timeStamp);
+  }
+
+  // Returns the collected frames, with their images pointing into |data|.
+  std::vector<Frame>* frames() {
+    for (Frame& frame : frames_) {
+      frame.image._buffer = frame.data.data();
+      frame.image._size = frame.data.size();
+    }
+    return &frames_;
+  }
+
+ private:
+  std::vector<Frame> frames_;
+};
+
+class NullDecodedImageCallback : public DecodedImageCallback {
+ public:
+  int32_t Decoded(VideoFrame& decoded_image) override { return 0; }
+};
+
+class Vp8Benchmark : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    VideoCodingModule::Codec(kVideoCodecVP8, &codec_settings_);
+    codec_settings_.width = kWidth;
+    codec_settings_.height = kHeight;
+    codec_settings_.maxFramerate = kFramerate;
+    codec_settings_.startBitrate = kBitrateKbps;
+    codec_settings_.maxBitrate = kBitrateKbps;
+    frame_generator_.reset(test::FrameGenerator::CreateFromYuvFile(
+        {test::ResourcePath("foreman_cif", "yuv")}, kWidth, kHeight, 1));
+  }
+
+  // Encodes the next frame of the clip, forcing a key frame if |key_frame|.
+  void EncodeNextFrame(VideoEncoder* encoder, bool key_frame) {
+    VideoFrame* frame = frame_generator_->NextFrame();
+    frame->set_timestamp(timestamp_);
+    timestamp_ += 90000 / kFramerate;
+    const std::vector<FrameType> frame_types(
+        1, key_frame ? kVideoFrameKey : kVideoFrameDelta);
+    encoder->Encode(*frame, nullptr, &frame_types);
+  }
+
+  VideoCodec codec_settings_;
+  std::unique_ptr<test::FrameGenerator> frame_generator_;
+  uint32_t timestamp_ = 0;
+};
+
+}  // namespace
+
+// Encodes a CIF clip on one core, with a key frame every |kNumFrames| frames.
+TEST_F(Vp8Benchmark, Encode) {
+  std::unique_ptr<VideoEncoder> encoder(VP8Encoder::Create());
+  EncodedFrameCollector collector;
+  encoder->RegisterEncodeCompleteCallback(&collector);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder->InitEncode(&codec_settings_, 1, 1200));
+  test::BenchmarkOptions options;
+  options.warmup_iterations = kNumFrames;
+  options.repetitions = 10;
+  options.iterations = kNumFrames;
+  int frame_number = 0;
+  test::ReportBenchmark(test::RunBenchmark("vp8_encode_cif", options, [&] {
+    EncodeNextFrame(encoder.get(), frame_number++ % kNumFrames == 0);
+  }));
+  EXPECT_FALSE(collector.frames()->empty());
+  encoder->Release();
+}
+
+// Decodes |kNumFrames| frames of the CIF clip, starting over at the key frame
+// for every sample.
+TEST_F(Vp8Benchmark, Decode) {
+  std::unique_ptr<VideoEncoder> encoder(VP8Encoder::Create());
+  EncodedFrameCollector collector;
+  encoder->RegisterEncodeCompleteCallback(&collector);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder->InitEncode(&codec_settings_, 1, 1200));
+  for (int i = 0; i < kNumFrames; ++i)
+    EncodeNextFrame(encoder.get(), i == 0);
+  encoder->Release();
+  std::vector<EncodedFrameCollector::Frame>* frames = collector.frames();
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), frames->size());
+
+  std::unique_ptr<VideoDecoder> decoder(VP8Decoder::Create());
+  NullDecodedImageCallback decoded_callback;
+  decoder->RegisterDecodeCompleteCallback(&decoded_callback);
+  ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder->InitDecode(&codec_settings_, 1));
+  test::BenchmarkOptions options;
+  options.warmup_iterations = kNumFrames;
+  options.repetitions = 10;
+  options.iterations = kNumFrames;
+  size_t frame_index = 0;
+  bool ok = true;
+  test::ReportBenchmark(test::RunBenchmark("vp8_decode_cif", options, [&] {
+    ok &= decoder->Decode((*frames)[frame_index].image, false, nullptr) ==
+          WEBRTC_VIDEO_CODEC_OK;
+    frame_index = (frame_index + 1) % frames->size();
+  }));
+  EXPECT_TRUE(ok);
+  decoder->Release();
+}
+
+}  // namespace webrtc
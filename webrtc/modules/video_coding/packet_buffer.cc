@@ -44,11 +44,14 @@ PacketBuffer::PacketBuffer(Clock* clock,
       first_packet_received_(false),
       data_buffer_(start_buffer_size),
       sequence_buffer_(start_buffer_size),
+      memory_usage_(memory_usage::kVideoPacketBuffer),
       received_frame_callback_(received_frame_callback) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
   RTC_DCHECK((start_buffer_size & (start_buffer_size - 1)) == 0);
   RTC_DCHECK((max_buffer_size & (max_buffer_size - 1)) == 0);
+  rtc::CritScope lock(&crit_);
+  UpdateMemoryUsage();
 }
 
 PacketBuffer::~PacketBuffer() {}
@@ -133,9 +136,14 @@ bool PacketBuffer::ExpandBufferSize() {
   size_ = new_size;
   sequence_buffer_ = std::move(new_sequence_buffer);
   data_buffer_ = std::move(new_data_buffer);
+  UpdateMemoryUsage();
   return true;
 }
 
+void PacketBuffer::UpdateMemoryUsage() {
+  memory_usage_.Set(size_ * (sizeof(VCMPacket) + sizeof(ContinuityInfo)));
+}
+
 bool PacketBuffer::IsContinuous(uint16_t seq_num) const {
   size_t index = seq_num % size_;
   int prev_index = index > 0 ? index - 1 : size_ - 1;
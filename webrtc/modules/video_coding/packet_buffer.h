@@ -21,6 +21,7 @@
 #include "webrtc/modules/video_coding/packet.h"
 #include "webrtc/modules/video_coding/rtp_frame_reference_finder.h"
 #include "webrtc/modules/video_coding/sequence_number_util.h"
+#include "webrtc/system_wrappers/include/memory_usage.h"
 
 namespace webrtc {
 
@@ -93,6 +94,8 @@ class PacketBuffer {
   // Tries to expand the buffer.
   bool ExpandBufferSize() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  void UpdateMemoryUsage() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Test if all previous packets has arrived for the given sequence number.
   bool IsContinuous(uint16_t seq_num) const EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
@@ -134,6 +137,9 @@ class PacketBuffer {
   // and information needed to determine the continuity between packets.
   std::vector<ContinuityInfo> sequence_buffer_ GUARDED_BY(crit_);
 
+  // Reports the memory held by the two buffers above.
+  memory_usage::Tracker memory_usage_ GUARDED_BY(crit_);
+
   // Called when a received frame is found.
   OnReceivedFrameCallback* const received_frame_callback_;
 
@@ -9,6 +9,7 @@
  */
 #include "webrtc/modules/video_coding/utility/h264_bitstream_parser.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -27,6 +28,13 @@ namespace webrtc {
     return false;                     \
   }
 
+namespace {
+// Slice headers take a few to a few tens of bytes, while the slice data after
+// them can run to many kilobytes. Only this much of a slice is unescaped to
+// parse the header, unless the header turns out not to fit.
+const size_t kMaxSliceHeaderSize = 256;
+}  // namespace
+
 H264BitstreamParser::H264BitstreamParser() {}
 H264BitstreamParser::~H264BitstreamParser() {}
 
@@ -36,14 +44,29 @@ bool H264BitstreamParser::ParseNonParameterSetNalu(const uint8_t* source,
   RTC_CHECK(sps_);
   RTC_CHECK(pps_);
   last_slice_qp_delta_ = rtc::Optional<int32_t>();
+  uint8_t header_rbsp[kMaxSliceHeaderSize];
+  const size_t header_length = std::min(source_length, kMaxSliceHeaderSize);
+  if (ParseSliceHeader(header_rbsp,
+                       H264::ParseRbsp(source, header_length, header_rbsp),
+                       nalu_type)) {
+    return true;
+  }
+  if (header_length == source_length)
+    return false;
   std::unique_ptr<rtc::Buffer> slice_rbsp(
       H264::ParseRbsp(source, source_length));
-  rtc::BitBuffer slice_reader(slice_rbsp->data() + H264::kNaluTypeSize,
-                              slice_rbsp->size() - H264::kNaluTypeSize);
+  return ParseSliceHeader(slice_rbsp->data(), slice_rbsp->size(), nalu_type);
+}
+
+bool H264BitstreamParser::ParseSliceHeader(const uint8_t* rbsp,
+                                           size_t rbsp_length,
+                                           uint8_t nalu_type) {
+  rtc::BitBuffer slice_reader(rbsp + H264::kNaluTypeSize,
+                              rbsp_length - H264::kNaluTypeSize);
   // Check to see if this is an IDR slice, which has an extra field to parse
   // out.
-  bool is_idr = (source[0] & 0x0F) == H264::NaluType::kIdr;
-  uint8_t nal_ref_idc = (source[0] & 0x60) >> 5;
+  bool is_idr = (rbsp[0] & 0x0F) == H264::NaluType::kIdr;
+  uint8_t nal_ref_idc = (rbsp[0] & 0x60) >> 5;
   uint32_t golomb_tmp;
   uint32_t bits_tmp;
 
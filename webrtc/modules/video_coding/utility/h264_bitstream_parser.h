@@ -45,6 +45,11 @@ class H264BitstreamParser {
   bool ParseNonParameterSetNalu(const uint8_t* source,
                                 size_t source_length,
                                 uint8_t nalu_type);
+  // Parses the slice header at the start of |rbsp|, which may hold only the
+  // start of the slice.
+  bool ParseSliceHeader(const uint8_t* rbsp,
+                        size_t rbsp_length,
+                        uint8_t nalu_type);
 
   // SPS/PPS state, updated when parsing new SPS/PPS, used to parse slices.
   rtc::Optional<SpsParser::SpsState> sps_;
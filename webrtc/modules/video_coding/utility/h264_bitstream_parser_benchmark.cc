@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/buffer.h"
+#include "webrtc/base/random.h"
+#include "webrtc/common_video/h264/h264_common.h"
+#include "webrtc/modules/video_coding/utility/h264_bitstream_parser.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace webrtc {
+namespace {
+
+const uint8_t kSpsPps[] = {0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x80, 0x20,
+                           0xda, 0x01, 0x40, 0x16, 0xe8, 0x06, 0xd0, 0xa1,
+                           0x35, 0x00, 0x00, 0x00, 0x01, 0x68, 0xce, 0x06,
+                           0xe2};
+// The start of an IDR slice, up to and including its slice QP.
+const uint8_t kIdrSliceStart[] = {0x00, 0x00, 0x00, 0x01, 0x65, 0xb8,
+                                  0x40, 0xf0, 0x8c, 0x03, 0xf2, 0x75};
+const size_t kNumSlices = 4;
+// A 1080p key frame at a high bitrate.
+const size_t kSliceSize = 50000;
+
+// Builds a key frame of |kNumSlices| IDR slices of random, escaped data.
+std::vector<uint8_t> CreateKeyFrame() {
+  Random random(0x264);
+  std::vector<uint8_t> frame(kSpsPps, kSpsPps + sizeof(kSpsPps));
+  std::vector<uint8_t> slice_data(kSliceSize);
+  for (size_t i = 0; i < kNumSlices; ++i) {
+    frame.insert(frame.end(), kIdrSliceStart,
+                 kIdrSliceStart + sizeof(kIdrSliceStart));
+    for (uint8_t& byte : slice_data)
+      byte = random.Rand<uint8_t>();
+    rtc::Buffer escaped;
+    H264::WriteRbsp(slice_data.data(), slice_data.size(), &escaped);
+    frame.insert(frame.end(), escaped.data(), escaped.data() + escaped.size());
+  }
+  return frame;
+}
+
+test::BenchmarkOptions KeyFrameOptions() {
+  test::BenchmarkOptions options;
+  options.warmup_iterations = 10;
+  options.iterations = 100;
+  return options;
+}
+
+}  // namespace
+
+TEST(H264BitstreamParserBenchmark, FindNaluIndices) {
+  const std::vector<uint8_t> frame = CreateKeyFrame();
+  size_t num_nalus = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "h264_find_nalu_indices_200kb", KeyFrameOptions(), [&] {
+        num_nalus = H264::FindNaluIndices(frame.data(), frame.size()).size();
+      }));
+  EXPECT_EQ(2 + kNumSlices, num_nalus);
+}
+
+TEST(H264BitstreamParserBenchmark, ParseRbsp) {
+  const std::vector<uint8_t> frame = CreateKeyFrame();
+  const H264::NaluIndex slice =
+      H264::FindNaluIndices(frame.data(), frame.size()).back();
+  std::vector<uint8_t> rbsp(slice.payload_size);
+  size_t rbsp_length = 0;
+  test::ReportBenchmark(test::RunBenchmark(
+      "h264_parse_rbsp_50kb", KeyFrameOptions(), [&] {
+        rbsp_length = H264::ParseRbsp(&frame[slice.payload_start_offset],
+                                      slice.payload_size, rbsp.data());
+      }));
+  EXPECT_LE(rbsp_length, slice.payload_size);
+}
+
+TEST(H264BitstreamParserBenchmark, ParseBitstream) {
+  const std::vector<uint8_t> frame = CreateKeyFrame();
+  H264BitstreamParser parser;
+  test::ReportBenchmark(test::RunBenchmark(
+      "h264_bitstream_parser_key_frame_200kb", KeyFrameOptions(),
+      [&] { parser.ParseBitstream(frame.data(), frame.size()); }));
+  int qp;
+  ASSERT_TRUE(parser.GetLastSliceQp(&qp));
+  EXPECT_EQ(35, qp);
+}
+
+}  // namespace webrtc
@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/video_coding/utility/h264_bitstream_parser.h"
 
+#include <vector>
+
 #include "webrtc/test/gtest.h"
 
 namespace webrtc {
@@ -85,4 +87,24 @@ TEST(H264BitstreamParserTest, ReportsLastSliceQpForCABACImageSlices) {
   EXPECT_EQ(24, qp);
 }
 
+TEST(H264BitstreamParserTest, ReportsLastSliceQpForLongImageSlices) {
+  H264BitstreamParser h264_parser;
+  h264_parser.ParseBitstream(kH264SpsPps, sizeof(kH264SpsPps));
+  // The header is parsed from the start of the slice only, so data after it,
+  // escaped or not, makes no difference.
+  std::vector<uint8_t> slice(
+      kH264BitstreamNextImageSliceChunk,
+      kH264BitstreamNextImageSliceChunk +
+          sizeof(kH264BitstreamNextImageSliceChunk));
+  for (int i = 0; i < 1000; ++i) {
+    const uint8_t kEscapedZeros[] = {0x00, 0x00, 0x03, 0x01, 0xff};
+    slice.insert(slice.end(), kEscapedZeros,
+                 kEscapedZeros + sizeof(kEscapedZeros));
+  }
+  h264_parser.ParseBitstream(slice.data(), slice.size());
+  int qp;
+  ASSERT_TRUE(h264_parser.GetLastSliceQp(&qp));
+  EXPECT_EQ(37, qp);
+}
+
 }  // namespace webrtc
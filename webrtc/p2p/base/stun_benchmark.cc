@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+
+#include "webrtc/base/bytebuffer.h"
+#include "webrtc/p2p/base/stun.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace cricket {
+
+namespace {
+
+const char kUsername[] = "rfrag:lfrag";
+const char kPassword[] = "abcdefghijklmnopqrstuvwx";
+const char kTransactionId[] = "0123456789ab";
+
+// Builds an ICE connectivity check the way ConnectionRequest::Prepare() does
+// for the controlling side.
+void BuildConnectivityCheck(IceMessage* request) {
+  request->SetType(STUN_BINDING_REQUEST);
+  request->SetTransactionID(kTransactionId);
+  request->AddAttribute(
+      new StunByteStringAttribute(STUN_ATTR_USERNAME, kUsername));
+  request->AddAttribute(
+      new StunUInt32Attribute(STUN_ATTR_NETWORK_INFO, 0x00010000));
+  request->AddAttribute(
+      new StunUInt64Attribute(STUN_ATTR_ICE_CONTROLLING, 0x0102030405060708));
+  request->AddAttribute(new StunByteStringAttribute(STUN_ATTR_USE_CANDIDATE));
+  request->AddAttribute(
+      new StunUInt32Attribute(STUN_ATTR_PRIORITY, 0x6e7f1eff));
+  request->AddMessageIntegrity(kPassword);
+  request->AddFingerprint();
+}
+
+}  // namespace
+
+TEST(StunBenchmark, BuildConnectivityCheck) {
+  size_t size = 0;
+  webrtc::test::ReportBenchmark(webrtc::test::RunBenchmark(
+      "stun_build_connectivity_check", webrtc::test::BenchmarkOptions(), [&] {
+        IceMessage request;
+        BuildConnectivityCheck(&request);
+        rtc::ByteBufferWriter buffer;
+        request.Write(&buffer);
+        size = buffer.Length();
+      }));
+  EXPECT_GT(size, 0u);
+}
+
+// Parses and authenticates a connectivity check, as Port::GetStunMessage()
+// does for every incoming check.
+TEST(StunBenchmark, ParseConnectivityCheck) {
+  IceMessage request;
+  BuildConnectivityCheck(&request);
+  rtc::ByteBufferWriter buffer;
+  request.Write(&buffer);
+  bool ok = true;
+  webrtc::test::ReportBenchmark(webrtc::test::RunBenchmark(
+      "stun_parse_connectivity_check", webrtc::test::BenchmarkOptions(), [&] {
+        ok &= StunMessage::ValidateFingerprint(buffer.Data(), buffer.Length());
+        IceMessage parsed;
+        rtc::ByteBufferReader reader(buffer.Data(), buffer.Length());
+        ok &= parsed.Read(&reader);
+        ok &= StunMessage::ValidateMessageIntegrity(
+            buffer.Data(), buffer.Length(), kPassword);
+      }));
+  EXPECT_TRUE(ok);
+}
+
+}  // namespace cricket
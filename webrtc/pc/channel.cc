@@ -2137,6 +2137,30 @@ bool DataChannel::SendData(const SendDataParams& params,
                           payload, result));
 }
 
+size_t DataChannel::SendDataBatch(
+    const std::vector<OutgoingDataMessage>& messages,
+    SendDataResult* result) {
+  if (messages.empty()) {
+    return 0;
+  }
+  return worker_thread()->Invoke<size_t>(
+      RTC_FROM_HERE,
+      Bind(&DataChannel::SendDataBatch_w, this, &messages, result));
+}
+
+size_t DataChannel::SendDataBatch_w(
+    const std::vector<OutgoingDataMessage>* messages,
+    SendDataResult* result) {
+  size_t sent = 0;
+  for (const OutgoingDataMessage& message : *messages) {
+    if (!media_channel()->SendData(message.params, message.payload, result)) {
+      break;
+    }
+    ++sent;
+  }
+  return sent;
+}
+
 const ContentInfo* DataChannel::GetFirstContent(
     const SessionDescription* sdesc) {
   return GetFirstDataContent(sdesc);
@@ -2327,10 +2351,14 @@ void DataChannel::OnMessage(rtc::Message *pmsg) {
       break;
     }
     case MSG_DATARECEIVED: {
-      DataReceivedMessageData* data =
-          static_cast<DataReceivedMessageData*>(pmsg->pdata);
-      SignalDataReceived(this, data->params, data->payload);
-      delete data;
+      std::vector<ReceivedDataMessage> received_data;
+      {
+        rtc::CritScope cs(&received_data_crit_);
+        received_data.swap(received_data_);
+      }
+      for (const ReceivedDataMessage& data : received_data) {
+        SignalDataReceived(this, data.params, data.payload);
+      }
       break;
     }
     case MSG_CHANNEL_ERROR: {
@@ -2381,9 +2409,15 @@ void DataChannel::OnMediaMonitorUpdate(
 
 void DataChannel::OnDataReceived(
     const ReceiveDataParams& params, const char* data, size_t len) {
-  DataReceivedMessageData* msg = new DataReceivedMessageData(
-      params, data, len);
-  signaling_thread()->Post(RTC_FROM_HERE, this, MSG_DATARECEIVED, msg);
+  bool post;
+  {
+    rtc::CritScope cs(&received_data_crit_);
+    post = received_data_.empty();
+    received_data_.push_back(ReceivedDataMessage(params, data, len));
+  }
+  if (post) {
+    signaling_thread()->Post(RTC_FROM_HERE, this, MSG_DATARECEIVED);
+  }
 }
 
 void DataChannel::OnDataChannelError(uint32_t ssrc,
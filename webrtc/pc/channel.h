@@ -617,6 +617,12 @@ class DataChannel : public BaseChannel {
   virtual bool SendData(const SendDataParams& params,
                         const rtc::CopyOnWriteBuffer& payload,
                         SendDataResult* result);
+  // Sends |messages| in order with a single hop to the worker thread,
+  // stopping at the first message that fails. Returns the number of messages
+  // sent; if that is less than messages.size(), |result| describes the
+  // failure.
+  size_t SendDataBatch(const std::vector<OutgoingDataMessage>& messages,
+                       SendDataResult* result);
 
   void StartMediaMonitor(int cms);
   void StopMediaMonitor();
@@ -662,17 +668,17 @@ class DataChannel : public BaseChannel {
     bool succeeded;
   };
 
-  struct DataReceivedMessageData : public rtc::MessageData {
+  struct ReceivedDataMessage {
     // We copy the data because the data will become invalid after we
     // handle DataMediaChannel::SignalDataReceived but before we fire
     // SignalDataReceived.
-    DataReceivedMessageData(
+    ReceivedDataMessage(
         const ReceiveDataParams& params, const char* data, size_t len)
         : params(params),
           payload(data, len) {
     }
-    const ReceiveDataParams params;
-    const rtc::CopyOnWriteBuffer payload;
+    ReceiveDataParams params;
+    rtc::CopyOnWriteBuffer payload;
   };
 
   typedef rtc::TypedMessageData<bool> DataChannelReadyToSendMessageData;
@@ -710,6 +716,8 @@ class DataChannel : public BaseChannel {
   void OnDataChannelError(uint32_t ssrc, DataMediaChannel::Error error);
   void OnDataChannelReadyToSend(bool writable);
   void OnStreamClosedRemotely(uint32_t sid);
+  size_t SendDataBatch_w(const std::vector<OutgoingDataMessage>* messages,
+                         SendDataResult* result);
 
   std::unique_ptr<DataMediaMonitor> media_monitor_;
   // TODO(pthatcher): Make a separate SctpDataChannel and
@@ -723,6 +731,13 @@ class DataChannel : public BaseChannel {
   // Last DataRecvParameters sent down to the media_channel() via
   // SetRecvParameters.
   DataRecvParameters last_recv_params_;
+
+  // Messages received on the worker thread that have not been signaled on the
+  // signaling thread yet. A MSG_DATARECEIVED is posted only when this goes
+  // from empty to non-empty, so a burst of packets costs one posted message.
+  rtc::CriticalSection received_data_crit_;
+  std::vector<ReceivedDataMessage> received_data_
+      GUARDED_BY(received_data_crit_);
 };
 
 }  // namespace cricket
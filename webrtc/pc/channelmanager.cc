@@ -64,6 +64,7 @@ void ChannelManager::Construct(MediaEngineInterface* me,
   network_thread_ = network_thread;
   capturing_ = false;
   enable_rtx_ = false;
+  rtc::CritScope cs(&crypto_options_crit_);
   crypto_options_ = rtc::CryptoOptions::NoGcm();
 }
 
@@ -106,10 +107,10 @@ bool ChannelManager::SetCryptoOptions(
 
 bool ChannelManager::SetCryptoOptions_w(
     const rtc::CryptoOptions& crypto_options) {
-  if (!video_channels_.empty() || !voice_channels_.empty() ||
-      !data_channels_.empty()) {
+  if (has_channels()) {
     LOG(LS_WARNING) << "Not changing crypto options in existing channels.";
   }
+  rtc::CritScope cs(&crypto_options_crit_);
   crypto_options_ = crypto_options;
 #if defined(ENABLE_EXTERNAL_AUTH)
   if (crypto_options_.enable_gcm_crypto_suites) {
@@ -122,6 +123,11 @@ bool ChannelManager::SetCryptoOptions_w(
   return true;
 }
 
+rtc::CryptoOptions ChannelManager::crypto_options() const {
+  rtc::CritScope cs(&crypto_options_crit_);
+  return crypto_options_;
+}
+
 void ChannelManager::GetSupportedAudioSendCodecs(
     std::vector<AudioCodec>* codecs) const {
   *codecs = media_engine_->audio_send_codecs();
@@ -191,6 +197,19 @@ void ChannelManager::Terminate() {
   if (!initialized_) {
     return;
   }
+  // Video channels may be on worker threads other than |worker_thread_|, so
+  // they are destroyed from here rather than from Terminate_w, which would
+  // have to block on each of those threads.
+  while (true) {
+    VideoChannel* video_channel;
+    {
+      rtc::CritScope cs(&channels_crit_);
+      if (video_channels_.empty())
+        break;
+      video_channel = video_channels_.back();
+    }
+    DestroyVideoChannel(video_channel);
+  }
   worker_thread_->Invoke<void>(RTC_FROM_HERE,
                                Bind(&ChannelManager::Terminate_w, this));
   initialized_ = false;
@@ -203,12 +222,16 @@ void ChannelManager::DestructorDeletes_w() {
 
 void ChannelManager::Terminate_w() {
   ASSERT(worker_thread_ == rtc::Thread::Current());
-  // Need to destroy the voice/video channels
-  while (!video_channels_.empty()) {
-    DestroyVideoChannel_w(video_channels_.back());
-  }
-  while (!voice_channels_.empty()) {
-    DestroyVoiceChannel_w(voice_channels_.back());
+  // Need to destroy the voice channels, which are all on this thread.
+  while (true) {
+    VoiceChannel* voice_channel;
+    {
+      rtc::CritScope cs(&channels_crit_);
+      if (voice_channels_.empty())
+        break;
+      voice_channel = voice_channels_.back();
+    }
+    DestroyVoiceChannel_w(voice_channel);
   }
 }
 
@@ -219,6 +242,11 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     const std::string* bundle_transport_name,
     bool rtcp,
     const AudioOptions& options) {
+  if (media_controller->worker_thread() != worker_thread_) {
+    LOG(LS_ERROR) << "Voice channels can only be created on the voice "
+                  << "engine's worker thread.";
+    return nullptr;
+  }
   return worker_thread_->Invoke<VoiceChannel*>(
       RTC_FROM_HERE, Bind(&ChannelManager::CreateVoiceChannel_w, this,
                           media_controller, transport_controller, content_name,
@@ -241,13 +269,15 @@ VoiceChannel* ChannelManager::CreateVoiceChannel_w(
     return nullptr;
 
   VoiceChannel* voice_channel =
-      new VoiceChannel(worker_thread_, network_thread_, media_engine_.get(),
-                       media_channel, transport_controller, content_name, rtcp);
-  voice_channel->SetCryptoOptions(crypto_options_);
+      new VoiceChannel(worker_thread_, transport_controller->network_thread(),
+                       media_engine_.get(), media_channel, transport_controller,
+                       content_name, rtcp);
+  voice_channel->SetCryptoOptions(crypto_options());
   if (!voice_channel->Init_w(bundle_transport_name)) {
     delete voice_channel;
     return nullptr;
   }
+  rtc::CritScope cs(&channels_crit_);
   voice_channels_.push_back(voice_channel);
   return voice_channel;
 }
@@ -266,12 +296,15 @@ void ChannelManager::DestroyVoiceChannel_w(VoiceChannel* voice_channel) {
   // Destroy voice channel.
   ASSERT(initialized_);
   ASSERT(worker_thread_ == rtc::Thread::Current());
-  VoiceChannels::iterator it = std::find(voice_channels_.begin(),
-      voice_channels_.end(), voice_channel);
-  ASSERT(it != voice_channels_.end());
-  if (it == voice_channels_.end())
-    return;
-  voice_channels_.erase(it);
+  {
+    rtc::CritScope cs(&channels_crit_);
+    VoiceChannels::iterator it = std::find(voice_channels_.begin(),
+        voice_channels_.end(), voice_channel);
+    ASSERT(it != voice_channels_.end());
+    if (it == voice_channels_.end())
+      return;
+    voice_channels_.erase(it);
+  }
   delete voice_channel;
 }
 
@@ -282,7 +315,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     const std::string* bundle_transport_name,
     bool rtcp,
     const VideoOptions& options) {
-  return worker_thread_->Invoke<VideoChannel*>(
+  return media_controller->worker_thread()->Invoke<VideoChannel*>(
       RTC_FROM_HERE, Bind(&ChannelManager::CreateVideoChannel_w, this,
                           media_controller, transport_controller, content_name,
                           bundle_transport_name, rtcp, options));
@@ -296,8 +329,8 @@ VideoChannel* ChannelManager::CreateVideoChannel_w(
     bool rtcp,
     const VideoOptions& options) {
   ASSERT(initialized_);
-  ASSERT(worker_thread_ == rtc::Thread::Current());
   ASSERT(nullptr != media_controller);
+  ASSERT(media_controller->worker_thread() == rtc::Thread::Current());
   VideoMediaChannel* media_channel = media_engine_->CreateVideoChannel(
       media_controller->call_w(), media_controller->config(), options);
   if (media_channel == NULL) {
@@ -305,13 +338,15 @@ VideoChannel* ChannelManager::CreateVideoChannel_w(
   }
 
   VideoChannel* video_channel =
-      new VideoChannel(worker_thread_, network_thread_, media_channel,
+      new VideoChannel(media_controller->worker_thread(),
+                       transport_controller->network_thread(), media_channel,
                        transport_controller, content_name, rtcp);
-  video_channel->SetCryptoOptions(crypto_options_);
+  video_channel->SetCryptoOptions(crypto_options());
   if (!video_channel->Init_w(bundle_transport_name)) {
     delete video_channel;
     return NULL;
   }
+  rtc::CritScope cs(&channels_crit_);
   video_channels_.push_back(video_channel);
   return video_channel;
 }
@@ -319,7 +354,7 @@ VideoChannel* ChannelManager::CreateVideoChannel_w(
 void ChannelManager::DestroyVideoChannel(VideoChannel* video_channel) {
   TRACE_EVENT0("webrtc", "ChannelManager::DestroyVideoChannel");
   if (video_channel) {
-    worker_thread_->Invoke<void>(
+    video_channel->worker_thread()->Invoke<void>(
         RTC_FROM_HERE,
         Bind(&ChannelManager::DestroyVideoChannel_w, this, video_channel));
   }
@@ -329,30 +364,35 @@ void ChannelManager::DestroyVideoChannel_w(VideoChannel* video_channel) {
   TRACE_EVENT0("webrtc", "ChannelManager::DestroyVideoChannel_w");
   // Destroy video channel.
   ASSERT(initialized_);
-  ASSERT(worker_thread_ == rtc::Thread::Current());
-  VideoChannels::iterator it = std::find(video_channels_.begin(),
-      video_channels_.end(), video_channel);
-  ASSERT(it != video_channels_.end());
-  if (it == video_channels_.end())
-    return;
-
-  video_channels_.erase(it);
+  ASSERT(video_channel->worker_thread() == rtc::Thread::Current());
+  {
+    rtc::CritScope cs(&channels_crit_);
+    VideoChannels::iterator it = std::find(video_channels_.begin(),
+        video_channels_.end(), video_channel);
+    ASSERT(it != video_channels_.end());
+    if (it == video_channels_.end())
+      return;
+    video_channels_.erase(it);
+  }
   delete video_channel;
 }
 
 DataChannel* ChannelManager::CreateDataChannel(
+    webrtc::MediaControllerInterface* media_controller,
     TransportController* transport_controller,
     const std::string& content_name,
     const std::string* bundle_transport_name,
     bool rtcp,
     DataChannelType channel_type) {
-  return worker_thread_->Invoke<DataChannel*>(
+  return media_controller->worker_thread()->Invoke<DataChannel*>(
       RTC_FROM_HERE,
-      Bind(&ChannelManager::CreateDataChannel_w, this, transport_controller,
-           content_name, bundle_transport_name, rtcp, channel_type));
+      Bind(&ChannelManager::CreateDataChannel_w, this, media_controller,
+           transport_controller, content_name, bundle_transport_name, rtcp,
+           channel_type));
 }
 
 DataChannel* ChannelManager::CreateDataChannel_w(
+    webrtc::MediaControllerInterface* media_controller,
     TransportController* transport_controller,
     const std::string& content_name,
     const std::string* bundle_transport_name,
@@ -369,14 +409,16 @@ DataChannel* ChannelManager::CreateDataChannel_w(
   }
 
   DataChannel* data_channel =
-      new DataChannel(worker_thread_, network_thread_, media_channel,
+      new DataChannel(media_controller->worker_thread(),
+                      transport_controller->network_thread(), media_channel,
                       transport_controller, content_name, rtcp);
-  data_channel->SetCryptoOptions(crypto_options_);
+  data_channel->SetCryptoOptions(crypto_options());
   if (!data_channel->Init_w(bundle_transport_name)) {
     LOG(LS_WARNING) << "Failed to init data channel.";
     delete data_channel;
     return NULL;
   }
+  rtc::CritScope cs(&channels_crit_);
   data_channels_.push_back(data_channel);
   return data_channel;
 }
@@ -384,7 +426,7 @@ DataChannel* ChannelManager::CreateDataChannel_w(
 void ChannelManager::DestroyDataChannel(DataChannel* data_channel) {
   TRACE_EVENT0("webrtc", "ChannelManager::DestroyDataChannel");
   if (data_channel) {
-    worker_thread_->Invoke<void>(
+    data_channel->worker_thread()->Invoke<void>(
         RTC_FROM_HERE,
         Bind(&ChannelManager::DestroyDataChannel_w, this, data_channel));
   }
@@ -394,13 +436,15 @@ void ChannelManager::DestroyDataChannel_w(DataChannel* data_channel) {
   TRACE_EVENT0("webrtc", "ChannelManager::DestroyDataChannel_w");
   // Destroy data channel.
   ASSERT(initialized_);
-  DataChannels::iterator it = std::find(data_channels_.begin(),
-      data_channels_.end(), data_channel);
-  ASSERT(it != data_channels_.end());
-  if (it == data_channels_.end())
-    return;
-
-  data_channels_.erase(it);
+  {
+    rtc::CritScope cs(&channels_crit_);
+    DataChannels::iterator it = std::find(data_channels_.begin(),
+        data_channels_.end(), data_channel);
+    ASSERT(it != data_channels_.end());
+    if (it == data_channels_.end())
+      return;
+    data_channels_.erase(it);
+  }
   delete data_channel;
 }
 
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/base/criticalsection.h"
 #include "webrtc/base/fileutils.h"
 #include "webrtc/base/thread.h"
 #include "webrtc/media/base/mediaengine.h"
@@ -86,7 +87,9 @@ class ChannelManager {
   // Shuts down the media engine.
   void Terminate();
 
-  // The operations below all occur on the worker thread.
+  // The operations below all occur on the worker thread of the media
+  // controller, which for voice channels must be this ChannelManager's, since
+  // the voice engine is tied to it. Video and data channels may be on others.
   // Creates a voice channel, to be associated with the specified session.
   VoiceChannel* CreateVoiceChannel(
       webrtc::MediaControllerInterface* media_controller,
@@ -108,16 +111,19 @@ class ChannelManager {
       const VideoOptions& options);
   // Destroys a video channel created with the Create API.
   void DestroyVideoChannel(VideoChannel* video_channel);
-  DataChannel* CreateDataChannel(TransportController* transport_controller,
-                                 const std::string& content_name,
-                                 const std::string* bundle_transport_name,
-                                 bool rtcp,
-                                 DataChannelType data_channel_type);
+  DataChannel* CreateDataChannel(
+      webrtc::MediaControllerInterface* media_controller,
+      TransportController* transport_controller,
+      const std::string& content_name,
+      const std::string* bundle_transport_name,
+      bool rtcp,
+      DataChannelType data_channel_type);
   // Destroys a data channel created with the Create API.
   void DestroyDataChannel(DataChannel* data_channel);
 
   // Indicates whether any channels exist.
   bool has_channels() const {
+    rtc::CritScope cs(&channels_crit_);
     return (!voice_channels_.empty() || !video_channels_.empty());
   }
 
@@ -155,6 +161,9 @@ class ChannelManager {
   void DestructorDeletes_w();
   void Terminate_w();
   bool SetCryptoOptions_w(const rtc::CryptoOptions& crypto_options);
+  // Returns a copy of |crypto_options_| for a channel being created on any of
+  // the worker threads.
+  rtc::CryptoOptions crypto_options() const;
   VoiceChannel* CreateVoiceChannel_w(
       webrtc::MediaControllerInterface* media_controller,
       TransportController* transport_controller,
@@ -171,11 +180,13 @@ class ChannelManager {
       bool rtcp,
       const VideoOptions& options);
   void DestroyVideoChannel_w(VideoChannel* video_channel);
-  DataChannel* CreateDataChannel_w(TransportController* transport_controller,
-                                   const std::string& content_name,
-                                   const std::string* bundle_transport_name,
-                                   bool rtcp,
-                                   DataChannelType data_channel_type);
+  DataChannel* CreateDataChannel_w(
+      webrtc::MediaControllerInterface* media_controller,
+      TransportController* transport_controller,
+      const std::string& content_name,
+      const std::string* bundle_transport_name,
+      bool rtcp,
+      DataChannelType data_channel_type);
   void DestroyDataChannel_w(DataChannel* data_channel);
 
   std::unique_ptr<MediaEngineInterface> media_engine_;
@@ -185,12 +196,17 @@ class ChannelManager {
   rtc::Thread* worker_thread_;
   rtc::Thread* network_thread_;
 
-  VoiceChannels voice_channels_;
-  VideoChannels video_channels_;
-  DataChannels data_channels_;
+  // Channels are created and destroyed on the worker threads of the media
+  // controllers they belong to.
+  rtc::CriticalSection channels_crit_;
+  VoiceChannels voice_channels_ GUARDED_BY(channels_crit_);
+  VideoChannels video_channels_ GUARDED_BY(channels_crit_);
+  DataChannels data_channels_ GUARDED_BY(channels_crit_);
 
   bool enable_rtx_;
-  rtc::CryptoOptions crypto_options_;
+  // Set on |worker_thread_| and read by channels created on the others.
+  rtc::CriticalSection crypto_options_crit_;
+  rtc::CryptoOptions crypto_options_ GUARDED_BY(crypto_options_crit_);
 
   bool capturing_;
 };
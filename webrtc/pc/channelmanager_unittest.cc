@@ -9,6 +9,7 @@
  */
 
 #include "webrtc/api/fakemediacontroller.h"
+#include "webrtc/base/bind.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/thread.h"
@@ -107,8 +108,8 @@ TEST_F(ChannelManagerTest, CreateDestroyChannels) {
       VideoOptions());
   EXPECT_TRUE(video_channel != nullptr);
   cricket::DataChannel* data_channel =
-      cm_->CreateDataChannel(transport_controller_, cricket::CN_DATA, nullptr,
-                             false, cricket::DCT_RTP);
+      cm_->CreateDataChannel(&fake_mc_, transport_controller_, cricket::CN_DATA,
+                             nullptr, false, cricket::DCT_RTP);
   EXPECT_TRUE(data_channel != nullptr);
   cm_->DestroyVideoChannel(video_channel);
   cm_->DestroyVoiceChannel(voice_channel);
@@ -135,8 +136,8 @@ TEST_F(ChannelManagerTest, CreateDestroyChannelsOnThread) {
       VideoOptions());
   EXPECT_TRUE(video_channel != nullptr);
   cricket::DataChannel* data_channel =
-      cm_->CreateDataChannel(transport_controller_, cricket::CN_DATA, nullptr,
-                             false, cricket::DCT_RTP);
+      cm_->CreateDataChannel(&fake_mc_, transport_controller_, cricket::CN_DATA,
+                             nullptr, false, cricket::DCT_RTP);
   EXPECT_TRUE(data_channel != nullptr);
   cm_->DestroyVideoChannel(video_channel);
   cm_->DestroyVoiceChannel(voice_channel);
@@ -144,6 +145,62 @@ TEST_F(ChannelManagerTest, CreateDestroyChannelsOnThread) {
   cm_->Terminate();
 }
 
+// Test that video and data channels are created on the worker thread of their
+// media controller, and that voice channels can't be created on any other
+// than the channel manager's.
+TEST_F(ChannelManagerTest, CreateChannelsOnMediaControllerThread) {
+  network_.Start();
+  worker_.Start();
+  EXPECT_TRUE(cm_->Init());
+  delete transport_controller_;
+  transport_controller_ =
+      new cricket::FakeTransportController(&network_, ICEROLE_CONTROLLING);
+  cricket::FakeMediaController media_controller(cm_, &fake_call_, &worker_);
+  EXPECT_TRUE(cm_->CreateVoiceChannel(&media_controller, transport_controller_,
+                                      cricket::CN_AUDIO, nullptr, false,
+                                      AudioOptions()) == nullptr);
+  cricket::VideoChannel* video_channel = cm_->CreateVideoChannel(
+      &media_controller, transport_controller_, cricket::CN_VIDEO, nullptr,
+      false, VideoOptions());
+  ASSERT_TRUE(video_channel != nullptr);
+  EXPECT_EQ(&worker_, video_channel->worker_thread());
+  cricket::DataChannel* data_channel = cm_->CreateDataChannel(
+      &media_controller, transport_controller_, cricket::CN_DATA, nullptr,
+      false, cricket::DCT_RTP);
+  ASSERT_TRUE(data_channel != nullptr);
+  EXPECT_EQ(&worker_, data_channel->worker_thread());
+  EXPECT_TRUE(cm_->has_channels());
+  cm_->DestroyVideoChannel(video_channel);
+  cm_->DestroyDataChannel(data_channel);
+  cm_->Terminate();
+}
+
+// Test that Terminate destroys the video channels left on other worker
+// threads without the channel manager's worker thread blocking on them.
+TEST_F(ChannelManagerTest, TerminateDestroysChannelsOnOtherThreads) {
+  rtc::Thread engine_worker;
+  engine_worker.Start();
+  engine_worker.Invoke<bool>(
+      RTC_FROM_HERE, rtc::Bind(&rtc::Thread::SetAllowBlockingCalls,
+                               &engine_worker, false));
+  network_.Start();
+  worker_.Start();
+  EXPECT_TRUE(cm_->set_worker_thread(&engine_worker));
+  EXPECT_TRUE(cm_->Init());
+  delete transport_controller_;
+  transport_controller_ =
+      new cricket::FakeTransportController(&network_, ICEROLE_CONTROLLING);
+  cricket::FakeMediaController media_controller(cm_, &fake_call_, &worker_);
+  ASSERT_TRUE(cm_->CreateVideoChannel(&media_controller, transport_controller_,
+                                      cricket::CN_VIDEO, nullptr, false,
+                                      VideoOptions()) != nullptr);
+  cm_->Terminate();
+  EXPECT_FALSE(cm_->has_channels());
+  // The media engine is deleted on |engine_worker|.
+  delete cm_;
+  cm_ = nullptr;
+}
+
 // Test that we fail to create a voice/video channel if the session is unable
 // to create a cricket::TransportChannel
 TEST_F(ChannelManagerTest, NoTransportChannelTest) {
@@ -163,8 +220,8 @@ TEST_F(ChannelManagerTest, NoTransportChannelTest) {
       VideoOptions());
   EXPECT_TRUE(video_channel == nullptr);
   cricket::DataChannel* data_channel =
-      cm_->CreateDataChannel(transport_controller_, cricket::CN_DATA, nullptr,
-                             false, cricket::DCT_RTP);
+      cm_->CreateDataChannel(&fake_mc_, transport_controller_, cricket::CN_DATA,
+                             nullptr, false, cricket::DCT_RTP);
   EXPECT_TRUE(data_channel == nullptr);
   cm_->Terminate();
 }
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <string>
+
+#include "webrtc/base/byteorder.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/pc/srtpfilter.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+
+namespace {
+
+const uint8_t kTestKey[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ1234567890ab";
+const size_t kRtpHeaderSize = 12;
+// A full size video packet.
+const size_t kRtpPacketSize = 1200;
+// Room for the largest authentication tag.
+const size_t kMaxSrtpOverhead = 16;
+
+class SrtpBenchmark : public testing::Test {
+ protected:
+  void SetUp() override {
+    memset(packet_, 0, sizeof(packet_));
+    packet_[0] = 0x80;
+    packet_[1] = 100;
+    rtc::SetBE32(&packet_[8], 0x12345678);
+  }
+
+  // Benchmarks protecting a packet, and separately protecting and then
+  // unprotecting it, with the cipher suite |cs|.
+  void Run(int cs, const std::string& name) {
+    int key_len;
+    int salt_len;
+    ASSERT_TRUE(rtc::GetSrtpKeyAndSaltLengths(cs, &key_len, &salt_len));
+    ASSERT_LE(static_cast<size_t>(key_len + salt_len), sizeof(kTestKey));
+    cricket::SrtpSession sender;
+    cricket::SrtpSession receiver;
+    ASSERT_TRUE(sender.SetSend(cs, kTestKey, key_len + salt_len));
+    ASSERT_TRUE(receiver.SetRecv(cs, kTestKey, key_len + salt_len));
+
+    // libsrtp rejects reused sequence numbers, so each run of the body
+    // protects a copy of the packet with the next sequence number.
+    uint16_t sequence_number = 0;
+    uint8_t buffer[kRtpPacketSize + kMaxSrtpOverhead];
+    bool ok = true;
+    webrtc::test::ReportBenchmark(webrtc::test::RunBenchmark(
+        "srtp_protect_" + name, webrtc::test::BenchmarkOptions(), [&] {
+          memcpy(buffer, packet_, kRtpPacketSize);
+          rtc::SetBE16(&buffer[2], sequence_number++);
+          int out_len;
+          ok &= sender.ProtectRtp(buffer, kRtpPacketSize, sizeof(buffer),
+                                  &out_len);
+        }));
+    webrtc::test::ReportBenchmark(webrtc::test::RunBenchmark(
+        "srtp_protect_unprotect_" + name, webrtc::test::BenchmarkOptions(),
+        [&] {
+          memcpy(buffer, packet_, kRtpPacketSize);
+          rtc::SetBE16(&buffer[2], sequence_number++);
+          int out_len;
+          ok &= sender.ProtectRtp(buffer, kRtpPacketSize, sizeof(buffer),
+                                  &out_len);
+          ok &= receiver.UnprotectRtp(buffer, out_len, &out_len);
+        }));
+    EXPECT_TRUE(ok);
+  }
+
+  uint8_t packet_[kRtpPacketSize];
+};
+
+}  // namespace
+
+TEST_F(SrtpBenchmark, AesCm128HmacSha1_80) {
+  Run(rtc::SRTP_AES128_CM_SHA1_80, "aes_cm_128_hmac_sha1_80");
+}
+
+#if !defined(ENABLE_EXTERNAL_AUTH)
+TEST_F(SrtpBenchmark, AeadAes128Gcm) {
+  Run(rtc::SRTP_AEAD_AES_128_GCM, "aead_aes_128_gcm");
+}
+#endif  // !defined(ENABLE_EXTERNAL_AUTH)
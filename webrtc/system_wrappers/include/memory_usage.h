@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_SYSTEM_WRAPPERS_INCLUDE_MEMORY_USAGE_H_
+#define WEBRTC_SYSTEM_WRAPPERS_INCLUDE_MEMORY_USAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "webrtc/base/constructormagic.h"
+
+// Opt-in accounting of the memory held by the larger buffers in WebRTC,
+// summed per subsystem over all instances in the process.
+//
+// Accounting is off until Enable() is called. Until then, updating a Tracker
+// costs one atomic load. Buffers allocated before Enable() are counted from
+// the next time their owner updates its Tracker.
+//
+// Usage:
+//   memory_usage::Tracker tracker_(memory_usage::kRtpPacketHistory);
+//   ...
+//   tracker_.Set(buffer_.capacity() * sizeof(buffer_[0]));
+
+namespace webrtc {
+namespace memory_usage {
+
+enum Subsystem {
+  kAudioProcessing,
+  kNetEq,
+  kRtpPacketHistory,
+  kVideoFrameBuffers,
+  kVideoPacketBuffer,
+  kNumSubsystems
+};
+
+struct Usage {
+  // Bytes currently held.
+  int64_t bytes = 0;
+  // Most bytes held at the same time since Enable() or ResetPeaks().
+  int64_t peak_bytes = 0;
+};
+
+// Reports the memory held by one object to the per-subsystem counters. A
+// Tracker is not thread safe; the object owning it has to serialize calls.
+class Tracker {
+ public:
+  explicit Tracker(Subsystem subsystem);
+  // Releases the bytes reported by this tracker.
+  ~Tracker();
+
+  // Sets the number of bytes held by the owning object.
+  void Set(size_t bytes);
+
+ private:
+  const Subsystem subsystem_;
+  // Bytes added to the counters, which is zero while accounting is off.
+  int64_t reported_bytes_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(Tracker);
+};
+
+// Enables the accounting. Calling it more than once has no further effect.
+void Enable();
+
+// Returns the memory held by |subsystem|, or zeros if accounting is off.
+Usage GetUsage(Subsystem subsystem);
+
+// Returns a short name of |subsystem| for reporting, e.g. "neteq".
+const char* GetName(Subsystem subsystem);
+
+// Sets the peaks of all subsystems to their current usage.
+void ResetPeaks();
+
+}  // namespace memory_usage
+}  // namespace webrtc
+
+#endif  // WEBRTC_SYSTEM_WRAPPERS_INCLUDE_MEMORY_USAGE_H_
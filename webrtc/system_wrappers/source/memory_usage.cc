@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/system_wrappers/include/memory_usage.h"
+
+#include <algorithm>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace webrtc {
+namespace memory_usage {
+
+namespace {
+
+class Counters {
+ public:
+  Counters() {}
+
+  void Add(Subsystem subsystem, int64_t bytes) {
+    rtc::CritScope cs(&crit_);
+    Usage* usage = &usage_[subsystem];
+    usage->bytes += bytes;
+    RTC_DCHECK_GE(usage->bytes, 0);
+    usage->peak_bytes = std::max(usage->peak_bytes, usage->bytes);
+  }
+
+  Usage Get(Subsystem subsystem) const {
+    rtc::CritScope cs(&crit_);
+    return usage_[subsystem];
+  }
+
+  void ResetPeaks() {
+    rtc::CritScope cs(&crit_);
+    for (Usage& usage : usage_)
+      usage.peak_bytes = usage.bytes;
+  }
+
+ private:
+  rtc::CriticalSection crit_;
+  Usage usage_[kNumSubsystems] GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(Counters);
+};
+
+// Counters are allocated upon call to Enable(). As with the histograms in
+// metrics_default.cc, this memory is not freed by the application.
+static Counters* volatile g_counters = nullptr;
+
+Counters* GetCounters() {
+  return rtc::AtomicOps::AcquireLoadPtr(&g_counters);
+}
+
+}  // namespace
+
+Tracker::Tracker(Subsystem subsystem)
+    : subsystem_(subsystem), reported_bytes_(0) {
+  RTC_DCHECK_LT(subsystem, kNumSubsystems);
+}
+
+Tracker::~Tracker() {
+  Set(0);
+}
+
+void Tracker::Set(size_t bytes) {
+  const int64_t delta = static_cast<int64_t>(bytes) - reported_bytes_;
+  if (delta == 0)
+    return;
+  Counters* counters = GetCounters();
+  if (!counters)
+    return;
+  counters->Add(subsystem_, delta);
+  reported_bytes_ = bytes;
+}
+
+void Enable() {
+  if (GetCounters())
+    return;
+  Counters* new_counters = new Counters();
+  Counters* old_counters = rtc::AtomicOps::CompareAndSwapPtr(
+      &g_counters, static_cast<Counters*>(nullptr), new_counters);
+  if (old_counters != nullptr)
+    delete new_counters;
+}
+
+Usage GetUsage(Subsystem subsystem) {
+  RTC_DCHECK_LT(subsystem, kNumSubsystems);
+  Counters* counters = GetCounters();
+  return counters ? counters->Get(subsystem) : Usage();
+}
+
+const char* GetName(Subsystem subsystem) {
+  switch (subsystem) {
+    case kAudioProcessing:
+      return "audio_processing";
+    case kNetEq:
+      return "neteq";
+    case kRtpPacketHistory:
+      return "rtp_packet_history";
+    case kVideoFrameBuffers:
+      return "video_frame_buffers";
+    case kVideoPacketBuffer:
+      return "video_packet_buffer";
+    case kNumSubsystems:
+      break;
+  }
+  RTC_NOTREACHED();
+  return "";
+}
+
+void ResetPeaks() {
+  Counters* counters = GetCounters();
+  if (counters)
+    counters->ResetPeaks();
+}
+
+}  // namespace memory_usage
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/system_wrappers/include/memory_usage.h"
+
+#include <memory>
+
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace memory_usage {
+
+// Accounting can't be turned off once enabled, so everything is tested in
+// one test, starting from the disabled state.
+TEST(MemoryUsageTest, TracksBytesPerSubsystemOnceEnabled) {
+  std::unique_ptr<Tracker> early_tracker(new Tracker(kNetEq));
+  early_tracker->Set(1000);
+  EXPECT_EQ(0, GetUsage(kNetEq).bytes);
+
+  Enable();
+  Enable();
+  EXPECT_EQ(0, GetUsage(kNetEq).bytes);
+
+  // Memory held since before Enable() is counted from the next update.
+  early_tracker->Set(1500);
+  EXPECT_EQ(1500, GetUsage(kNetEq).bytes);
+
+  {
+    Tracker tracker(kNetEq);
+    tracker.Set(500);
+    EXPECT_EQ(2000, GetUsage(kNetEq).bytes);
+    tracker.Set(100);
+    EXPECT_EQ(1600, GetUsage(kNetEq).bytes);
+    EXPECT_EQ(2000, GetUsage(kNetEq).peak_bytes);
+    EXPECT_EQ(0, GetUsage(kVideoPacketBuffer).bytes);
+  }
+  EXPECT_EQ(1500, GetUsage(kNetEq).bytes);
+
+  ResetPeaks();
+  EXPECT_EQ(1500, GetUsage(kNetEq).peak_bytes);
+
+  early_tracker.reset();
+  EXPECT_EQ(0, GetUsage(kNetEq).bytes);
+  EXPECT_EQ(1500, GetUsage(kNetEq).peak_bytes);
+}
+
+}  // namespace memory_usage
+}  // namespace webrtc
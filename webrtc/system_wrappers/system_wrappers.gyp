@@ -32,6 +32,7 @@
         'include/file_wrapper.h',
         'include/fix_interlocked_exchange_pointer_win.h',
         'include/logging.h',
+        'include/memory_usage.h',
         'include/metrics.h',
         'include/ntp_time.h',
         'include/rtp_to_ntp.h',
@@ -59,6 +60,7 @@
         'source/event_timer_win.h',
         'source/file_impl.cc',
         'source/logging.cc',
+        'source/memory_usage.cc',
         'source/rtp_to_ntp.cc',
         'source/rw_lock.cc',
         'source/rw_lock_posix.cc',
@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+
+#include "gflags/gflags.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/benchmark.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+DEFINE_string(benchmark_json, "",
+    "If set, the benchmark results are also written as JSON to this file.");
+DEFINE_string(benchmark_label, "",
+    "Label stored in the JSON results, e.g. the revision or build config.");
+
+// Like test_main.cc, but without logging and field trials, which would only
+// add noise to the measurements.
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  google::AllowCommandLineReparsing();
+  google::ParseCommandLineFlags(&argc, &argv, false);
+  webrtc::test::SetExecutablePath(argv[0]);
+
+  int result = RUN_ALL_TESTS();
+  if (!FLAGS_benchmark_json.empty() &&
+      !webrtc::test::WriteBenchmarkResultsJson(FLAGS_benchmark_json,
+                                               FLAGS_benchmark_label)) {
+    fprintf(stderr, "Failed to write %s\n", FLAGS_benchmark_json.c_str());
+    result = 1;
+  }
+  return result;
+}
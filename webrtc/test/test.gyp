@@ -86,6 +86,8 @@
       'sources': [
         'gmock.h',
         'gtest.h',
+        'testsupport/benchmark.cc',
+        'testsupport/benchmark.h',
         'testsupport/fileutils.cc',
         'testsupport/fileutils.h',
         'testsupport/frame_reader.cc',
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/test/testsupport/benchmark.h"
+
+#include <stdio.h>
+
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#elif defined(WEBRTC_MAC)
+#include <mach/mach.h>
+#else
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+// Returns the CPU time consumed by the calling thread, or 0 if unavailable.
+int64_t ThreadCpuTimeNanos() {
+#if defined(WEBRTC_WIN)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+                      &kernel_time, &user_time)) {
+    return 0;
+  }
+  // FILETIME is in units of 100 ns.
+  const uint64_t kernel =
+      (static_cast<uint64_t>(kernel_time.dwHighDateTime) << 32) |
+      kernel_time.dwLowDateTime;
+  const uint64_t user =
+      (static_cast<uint64_t>(user_time.dwHighDateTime) << 32) |
+      user_time.dwLowDateTime;
+  return static_cast<int64_t>(kernel + user) * 100;
+#elif defined(WEBRTC_MAC)
+  mach_port_t thread = mach_thread_self();
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  kern_return_t result = thread_info(
+      thread, THREAD_BASIC_INFO, reinterpret_cast<thread_info_t>(&info),
+      &count);
+  mach_port_deallocate(mach_task_self(), thread);
+  if (result != KERN_SUCCESS)
+    return 0;
+  return (info.user_time.seconds + info.system_time.seconds) *
+             rtc::kNumNanosecsPerSec +
+         (info.user_time.microseconds + info.system_time.microseconds) *
+             rtc::kNumNanosecsPerMicrosec;
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    return 0;
+  return ts.tv_sec * rtc::kNumNanosecsPerSec + ts.tv_nsec;
+#endif
+}
+
+// Returns the |percentile| of the sorted |values|.
+double Percentile(const std::vector<double>& values, int percentile) {
+  return values[(values.size() - 1) * percentile / 100];
+}
+
+std::vector<BenchmarkResult>* ReportedResults() {
+  static std::vector<BenchmarkResult>* const results =
+      new std::vector<BenchmarkResult>();
+  return results;
+}
+
+}  // namespace
+
+BenchmarkResult RunBenchmark(const std::string& name,
+                             const BenchmarkOptions& options,
+                             rtc::FunctionView<void()> body) {
+  RTC_DCHECK_GE(options.warmup_iterations, 0);
+  RTC_DCHECK_GT(options.repetitions, 0);
+  RTC_DCHECK_GT(options.iterations, 0);
+
+  for (int i = 0; i < options.warmup_iterations; ++i)
+    body();
+
+  std::vector<double> wall_times;
+  wall_times.reserve(options.repetitions);
+  int64_t total_cpu_time_ns = 0;
+  for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+    const int64_t cpu_start_ns = ThreadCpuTimeNanos();
+    const int64_t wall_start_ns = rtc::TimeNanos();
+    for (int i = 0; i < options.iterations; ++i)
+      body();
+    const int64_t wall_end_ns = rtc::TimeNanos();
+    total_cpu_time_ns += ThreadCpuTimeNanos() - cpu_start_ns;
+    wall_times.push_back(static_cast<double>(wall_end_ns - wall_start_ns) /
+                         options.iterations);
+  }
+  std::sort(wall_times.begin(), wall_times.end());
+
+  BenchmarkResult result;
+  result.name = name;
+  result.repetitions = options.repetitions;
+  result.iterations = options.iterations;
+  result.wall_time_min = wall_times.front();
+  double wall_time_sum = 0;
+  for (double wall_time : wall_times)
+    wall_time_sum += wall_time;
+  result.wall_time_mean = wall_time_sum / wall_times.size();
+  result.wall_time_p50 = Percentile(wall_times, 50);
+  result.wall_time_p90 = Percentile(wall_times, 90);
+  result.wall_time_p99 = Percentile(wall_times, 99);
+  result.cpu_time_mean = static_cast<double>(total_cpu_time_ns) /
+                         (static_cast<int64_t>(options.repetitions) *
+                          options.iterations);
+  return result;
+}
+
+void ReportBenchmark(const BenchmarkResult& result) {
+  PrintResult(result.name, "", "wall_time_p50",
+              static_cast<size_t>(result.wall_time_p50), "ns", true);
+  PrintResult(result.name, "", "wall_time_p90",
+              static_cast<size_t>(result.wall_time_p90), "ns", false);
+  PrintResult(result.name, "", "wall_time_p99",
+              static_cast<size_t>(result.wall_time_p99), "ns", false);
+  PrintResult(result.name, "", "cpu_time",
+              static_cast<size_t>(result.cpu_time_mean), "ns", false);
+  for (const BenchmarkCounter& counter : result.counters) {
+    PrintResult(result.name, "", counter.name,
+                static_cast<size_t>(counter.value), counter.units, false);
+  }
+  ReportedResults()->push_back(result);
+}
+
+bool WriteBenchmarkResultsJson(const std::string& path,
+                               const std::string& label) {
+  FILE* file = fopen(path.c_str(), "w");
+  if (!file)
+    return false;
+  // Names and labels are plain identifiers, so no escaping is done.
+  fprintf(file, "{\n  \"label\": \"%s\",\n", label.c_str());
+  fprintf(file, "  \"unit\": \"ns\",\n  \"benchmarks\": [");
+  const std::vector<BenchmarkResult>& results = *ReportedResults();
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchmarkResult& result = results[i];
+    fprintf(file,
+            "%s\n    {\"name\": \"%s\", \"repetitions\": %d, "
+            "\"iterations\": %d, \"wall_time_min\": %.1f, "
+            "\"wall_time_mean\": %.1f, \"wall_time_p50\": %.1f, "
+            "\"wall_time_p90\": %.1f, \"wall_time_p99\": %.1f, "
+            "\"cpu_time_mean\": %.1f, \"counters\": [",
+            i == 0 ? "" : ",", result.name.c_str(), result.repetitions,
+            result.iterations, result.wall_time_min, result.wall_time_mean,
+            result.wall_time_p50, result.wall_time_p90, result.wall_time_p99,
+            result.cpu_time_mean);
+    for (size_t j = 0; j < result.counters.size(); ++j) {
+      const BenchmarkCounter& counter = result.counters[j];
+      fprintf(file, "%s{\"name\": \"%s\", \"value\": %.1f, \"units\": \"%s\"}",
+              j == 0 ? "" : ", ", counter.name.c_str(), counter.value,
+              counter.units.c_str());
+    }
+    fprintf(file, "]}");
+  }
+  fprintf(file, "\n  ]\n}\n");
+  return fclose(file) == 0;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_TEST_TESTSUPPORT_BENCHMARK_H_
+#define WEBRTC_TEST_TESTSUPPORT_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "webrtc/base/function_view.h"
+
+// Helpers for microbenchmarks of hot paths, used by webrtc_microbenchmarks.
+// Every benchmark is measured the same way, so that numbers are comparable
+// between benchmarks and, through WriteBenchmarkResultsJson(), between builds.
+//
+// Usage:
+//   TEST(RtpBenchmark, ParseHeader) {
+//     RtpPacketReceived packet;
+//     ReportBenchmark(RunBenchmark("rtp_parse_header", BenchmarkOptions(),
+//                                  [&] { packet.Parse(kPacket, kSize); }));
+//   }
+
+namespace webrtc {
+namespace test {
+
+struct BenchmarkOptions {
+  // Untimed runs of the body before measuring, to warm up caches, branch
+  // predictors and lazily initialized state.
+  int warmup_iterations = 100;
+  // Number of timed samples that the statistics are computed over.
+  int repetitions = 20;
+  // Runs of the body per sample. Should be large enough for a sample to take
+  // well over the resolution of the clock.
+  int iterations = 1000;
+};
+
+// A quantity a benchmark measures besides time, such as the packets a run of
+// the body sends.
+struct BenchmarkCounter {
+  std::string name;
+  double value;
+  std::string units;
+};
+
+// All times are per run of the body, in nanoseconds.
+struct BenchmarkResult {
+  std::string name;
+  int repetitions = 0;
+  int iterations = 0;
+  double wall_time_min = 0;
+  double wall_time_mean = 0;
+  double wall_time_p50 = 0;
+  double wall_time_p90 = 0;
+  double wall_time_p99 = 0;
+  // CPU time of the calling thread. Work done on other threads, e.g. by an
+  // encoder's worker threads, is not included.
+  double cpu_time_mean = 0;
+  // Filled in by the benchmark, after RunBenchmark().
+  std::vector<BenchmarkCounter> counters;
+};
+
+// Runs |body| |options.warmup_iterations| times, then measures
+// |options.repetitions| samples of |options.iterations| runs each.
+BenchmarkResult RunBenchmark(const std::string& name,
+                             const BenchmarkOptions& options,
+                             rtc::FunctionView<void()> body);
+
+// Prints |result| through PrintResult() and keeps it for
+// WriteBenchmarkResultsJson(). Must be called on the test thread.
+void ReportBenchmark(const BenchmarkResult& result);
+
+// Writes all reported results to |path| as JSON, along with |label| to tell
+// builds apart. Returns false if the file can't be written.
+bool WriteBenchmarkResultsJson(const std::string& path,
+                               const std::string& label);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // WEBRTC_TEST_TESTSUPPORT_BENCHMARK_H_
@@ -32,7 +32,7 @@ ReceiveStatisticsProxy::ReceiveStatisticsProxy(
       render_pixel_tracker_(100, 10u) {
   stats_.ssrc = config_.rtp.remote_ssrc;
   for (auto it : config_.rtp.rtx)
-    rtx_stats_[it.second.ssrc] = StreamDataCounters();
+    rtx_stats_[it.second.ssrc].reset(new RtpStatsSlot());
 }
 
 ReceiveStatisticsProxy::~ReceiveStatisticsProxy() {
@@ -102,10 +102,10 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
   if (e2e_delay_ms != -1)
     RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.EndToEndDelayInMs", e2e_delay_ms);
 
-  StreamDataCounters rtp = stats_.rtp_stats;
+  StreamDataCounters rtp = LatestRtpStats(rtp_stats_);
   StreamDataCounters rtx;
-  for (auto it : rtx_stats_)
-    rtx.Add(it.second);
+  for (const auto& it : rtx_stats_)
+    rtx.Add(LatestRtpStats(*it.second));
   StreamDataCounters rtp_rtx = rtp;
   rtp_rtx.Add(rtx);
   int64_t elapsed_sec =
@@ -152,7 +152,15 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
 
 VideoReceiveStream::Stats ReceiveStatisticsProxy::GetStats() const {
   rtc::CritScope lock(&crit_);
-  return stats_;
+  VideoReceiveStream::Stats stats = stats_;
+  stats.rtp_stats = LatestRtpStats(rtp_stats_);
+  return stats;
+}
+
+StreamDataCounters ReceiveStatisticsProxy::LatestRtpStats(
+    const RtpStatsSlot& slot) {
+  const StreamDataCounters* counters = slot.snapshot.Read();
+  return counters ? *counters : StreamDataCounters();
 }
 
 void ReceiveStatisticsProxy::OnIncomingPayloadType(int payload_type) {
@@ -230,17 +238,17 @@ void ReceiveStatisticsProxy::CNameChanged(const char* cname, uint32_t ssrc) {
 void ReceiveStatisticsProxy::DataCountersUpdated(
     const webrtc::StreamDataCounters& counters,
     uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  if (ssrc == stats_.ssrc) {
-    stats_.rtp_stats = counters;
-  } else {
+  RtpStatsSlot* slot = &rtp_stats_;
+  if (ssrc != config_.rtp.remote_ssrc) {
     auto it = rtx_stats_.find(ssrc);
-    if (it != rtx_stats_.end()) {
-      it->second = counters;
-    } else {
+    if (it == rtx_stats_.end()) {
       RTC_NOTREACHED() << "Unexpected stream ssrc: " << ssrc;
+      return;
     }
+    slot = it->second.get();
   }
+  rtc::CritScope lock(&slot->write_crit);
+  slot->snapshot.Publish(counters);
 }
 
 void ReceiveStatisticsProxy::OnDecodedFrame() {
@@ -12,6 +12,7 @@
 #define WEBRTC_VIDEO_RECEIVE_STATISTICS_PROXY_H_
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "webrtc/base/criticalsection.h"
@@ -22,6 +23,7 @@
 #include "webrtc/common_video/include/frame_callback.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
 #include "webrtc/video/report_block_stats.h"
+#include "webrtc/video/stats_snapshot.h"
 #include "webrtc/video/video_stream_decoder.h"
 #include "webrtc/video_receive_stream.h"
 
@@ -92,6 +94,15 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   struct QpCounters {
     SampleCounter vp8;
   };
+  // RTP counters of one stream. They are updated for every received packet,
+  // so they are published to |snapshot| instead of being stored under |crit_|.
+  struct RtpStatsSlot {
+    rtc::CriticalSection write_crit;
+    // Read with |crit_| held.
+    StatsSnapshot<StreamDataCounters> snapshot;
+  };
+
+  static StreamDataCounters LatestRtpStats(const RtpStatsSlot& slot);
 
   void UpdateHistograms() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
@@ -123,7 +134,9 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   SampleCounter e2e_delay_counter_ GUARDED_BY(crit_);
   ReportBlockStats report_block_stats_ GUARDED_BY(crit_);
   QpCounters qp_counters_;  // Only accessed on the decoding thread.
-  std::map<uint32_t, StreamDataCounters> rtx_stats_ GUARDED_BY(crit_);
+  RtpStatsSlot rtp_stats_;
+  // Not modified after construction.
+  std::map<uint32_t, std::unique_ptr<RtpStatsSlot>> rtx_stats_;
 };
 
 }  // namespace webrtc
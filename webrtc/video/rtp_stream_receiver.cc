@@ -273,13 +273,6 @@ bool RtpStreamReceiver::DeliverRtp(const uint8_t* rtp_packet,
                                    size_t rtp_packet_length,
                                    const PacketTime& packet_time) {
   RTC_DCHECK(remote_bitrate_estimator_);
-  {
-    rtc::CritScope lock(&receive_cs_);
-    if (!receiving_) {
-      return false;
-    }
-  }
-
   RTPHeader header;
   if (!rtp_header_parser_->Parse(rtp_packet, rtp_packet_length,
                                  &header)) {
@@ -294,8 +287,12 @@ bool RtpStreamReceiver::DeliverRtp(const uint8_t* rtp_packet,
     arrival_time_ms = now_ms;
 
   {
-    // Periodically log the RTP header of incoming packets.
+    // Taken once per packet, for both the receiving state and the periodic
+    // log of the RTP header of incoming packets.
     rtc::CritScope lock(&receive_cs_);
+    if (!receiving_) {
+      return false;
+    }
     if (now_ms - last_packet_log_ms_ > kPacketLogIntervalMs) {
       std::stringstream ss;
       ss << "Packet received on SSRC: " << header.ssrc << " with payload type: "
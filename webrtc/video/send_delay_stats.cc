@@ -10,8 +10,9 @@
 
 #include "webrtc/video/send_delay_stats.h"
 
-#include <utility>
+#include <algorithm>
 
+#include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 
@@ -21,6 +22,10 @@ namespace {
 // Set to larger than max histogram delay which is 10000.
 const int64_t kMaxSentPacketDelayMs = 11000;
 const size_t kMaxPacketMapSize = 2000;
+// Number of consecutive sequence numbers that can be tracked. Packets that
+// fall this far behind the newest one are dropped as old. Must be a power of
+// two.
+const int64_t kPacketRingSize = 4096;
 
 // Limit for the maximum number of streams to calculate stats for.
 const size_t kMaxSsrcMapSize = 50;
@@ -28,7 +33,13 @@ const int kMinRequiredPeriodicSamples = 5;
 }  // namespace
 
 SendDelayStats::SendDelayStats(Clock* clock)
-    : clock_(clock), num_old_packets_(0), num_skipped_packets_(0) {}
+    : clock_(clock),
+      packets_(kPacketRingSize),
+      window_start_(0),
+      window_end_(0),
+      num_packets_(0),
+      num_old_packets_(0),
+      num_skipped_packets_(0) {}
 
 SendDelayStats::~SendDelayStats() {
   if (num_old_packets_ > 0 || num_skipped_packets_ > 0) {
@@ -67,6 +78,17 @@ AvgCounter* SendDelayStats::GetSendDelayCounter(uint32_t ssrc) {
   return counter;
 }
 
+int64_t SendDelayStats::Unwrap(uint16_t packet_id) const {
+  const int64_t newest_id = window_end_ - 1;
+  return newest_id + static_cast<int16_t>(static_cast<uint16_t>(
+                         packet_id - static_cast<uint16_t>(newest_id)));
+}
+
+SendDelayStats::Packet* SendDelayStats::GetPacket(int64_t unwrapped_id) {
+  RTC_DCHECK_GE(unwrapped_id, window_end_ - kPacketRingSize);
+  return &packets_[unwrapped_id & (kPacketRingSize - 1)];
+}
+
 void SendDelayStats::OnSendPacket(uint16_t packet_id,
                                   int64_t capture_time_ms,
                                   uint32_t ssrc) {
@@ -76,14 +98,46 @@ void SendDelayStats::OnSendPacket(uint16_t packet_id,
     return;
 
   int64_t now = clock_->TimeInMilliseconds();
-  RemoveOld(now, &packets_);
+  RemoveOld(now);
 
-  if (packets_.size() > kMaxPacketMapSize) {
+  if (num_packets_ > kMaxPacketMapSize) {
     ++num_skipped_packets_;
     return;
   }
-  packets_.insert(
-      std::make_pair(packet_id, Packet(ssrc, capture_time_ms, now)));
+
+  int64_t id;
+  if (num_packets_ == 0) {
+    // Restart the window at the packet, offset so that reordered ids older
+    // than it still unwrap to positive values.
+    id = (1 << 16) + packet_id;
+    window_start_ = id;
+    window_end_ = id + 1;
+  } else {
+    id = Unwrap(packet_id);
+    if (id >= window_end_) {
+      if (id - window_start_ >= kPacketRingSize)
+        MoveWindowStart(id - kPacketRingSize + 1);
+      window_end_ = id + 1;
+    } else if (id < window_start_) {
+      // Reordered packet that is older than all tracked ones. Like the
+      // packets that the window moved past, it is old if it is too far
+      // behind the newest one to fit in the ring.
+      if (id < window_end_ - kPacketRingSize) {
+        ++num_old_packets_;
+        return;
+      }
+      window_start_ = id;
+    }
+  }
+
+  Packet* packet = GetPacket(id);
+  if (packet->in_use)
+    return;
+  packet->in_use = true;
+  packet->ssrc = ssrc;
+  packet->capture_time_ms = capture_time_ms;
+  packet->send_time_ms = now;
+  ++num_packets_;
 }
 
 bool SendDelayStats::OnSentPacket(int packet_id, int64_t time_ms) {
@@ -92,26 +146,51 @@ bool SendDelayStats::OnSentPacket(int packet_id, int64_t time_ms) {
     return false;
 
   rtc::CritScope lock(&crit_);
-  auto it = packets_.find(packet_id);
-  if (it == packets_.end())
+  if (num_packets_ == 0)
+    return false;
+
+  const int64_t id = Unwrap(static_cast<uint16_t>(packet_id));
+  if (id < window_start_ || id >= window_end_)
+    return false;
+
+  Packet* packet = GetPacket(id);
+  if (!packet->in_use)
     return false;
 
   // TODO(asapersson): Remove SendSideDelayUpdated(), use capture -> sent.
   // Elapsed time from send (to transport) -> sent (leaving socket).
-  int diff_ms = time_ms - it->second.send_time_ms;
-  GetSendDelayCounter(it->second.ssrc)->Add(diff_ms);
-  packets_.erase(it);
+  int diff_ms = time_ms - packet->send_time_ms;
+  GetSendDelayCounter(packet->ssrc)->Add(diff_ms);
+  packet->in_use = false;
+  --num_packets_;
   return true;
 }
 
-void SendDelayStats::RemoveOld(int64_t now, PacketMap* packets) {
-  while (!packets->empty()) {
-    auto it = packets->begin();
-    if (now - it->second.capture_time_ms < kMaxSentPacketDelayMs)
-      break;
+void SendDelayStats::RemoveOld(int64_t now) {
+  while (window_start_ < window_end_) {
+    Packet* packet = GetPacket(window_start_);
+    if (packet->in_use) {
+      if (now - packet->capture_time_ms < kMaxSentPacketDelayMs)
+        break;
+      packet->in_use = false;
+      --num_packets_;
+      ++num_old_packets_;
+    }
+    ++window_start_;
+  }
+}
 
-    packets->erase(it);
-    ++num_old_packets_;
+void SendDelayStats::MoveWindowStart(int64_t unwrapped_id) {
+  // Visiting the last |kPacketRingSize| ids covers every slot of the ring.
+  window_start_ = std::max(window_start_, unwrapped_id - kPacketRingSize);
+  while (window_start_ < unwrapped_id) {
+    Packet* packet = GetPacket(window_start_);
+    if (packet->in_use) {
+      packet->in_use = false;
+      --num_packets_;
+      ++num_old_packets_;
+    }
+    ++window_start_;
   }
 }
 
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
@@ -45,33 +46,33 @@ class SendDelayStats : public SendPacketObserver {
                     uint32_t ssrc) override;
 
  private:
-  // Map holding sent packets (mapped by sequence number).
-  struct SequenceNumberOlderThan {
-    bool operator()(uint16_t seq1, uint16_t seq2) const {
-      return IsNewerSequenceNumber(seq2, seq1);
-    }
-  };
   struct Packet {
-    Packet(uint32_t ssrc, int64_t capture_time_ms, int64_t send_time_ms)
-        : ssrc(ssrc),
-          capture_time_ms(capture_time_ms),
-          send_time_ms(send_time_ms) {}
-    uint32_t ssrc;
-    int64_t capture_time_ms;
-    int64_t send_time_ms;
+    bool in_use = false;
+    uint32_t ssrc = 0;
+    int64_t capture_time_ms = 0;
+    int64_t send_time_ms = 0;
   };
-  typedef std::map<uint16_t, Packet, SequenceNumberOlderThan> PacketMap;
 
   void UpdateHistograms();
-  void RemoveOld(int64_t now, PacketMap* packets)
-      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns |packet_id| unwrapped relative to the newest tracked packet.
+  int64_t Unwrap(uint16_t packet_id) const EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  Packet* GetPacket(int64_t unwrapped_id) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Removes packets from the start of the window that are too old.
+  void RemoveOld(int64_t now) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Makes the window start at |unwrapped_id|, dropping older packets.
+  void MoveWindowStart(int64_t unwrapped_id) EXCLUSIVE_LOCKS_REQUIRED(crit_);
   AvgCounter* GetSendDelayCounter(uint32_t ssrc)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   Clock* const clock_;
   rtc::CriticalSection crit_;
 
-  PacketMap packets_ GUARDED_BY(crit_);
+  // Sent packets, indexed by their unwrapped sequence number modulo the ring
+  // size. Only the ids in [|window_start_|, |window_end_|) may be in use.
+  std::vector<Packet> packets_ GUARDED_BY(crit_);
+  int64_t window_start_ GUARDED_BY(crit_);
+  int64_t window_end_ GUARDED_BY(crit_);
+  size_t num_packets_ GUARDED_BY(crit_);
   size_t num_old_packets_ GUARDED_BY(crit_);
   size_t num_skipped_packets_ GUARDED_BY(crit_);
 
@@ -102,6 +102,25 @@ TEST_F(SendDelayStatsTest, OldPacketsRemoved) {
   EXPECT_TRUE(OnSentPacket(2u));
 }
 
+TEST_F(SendDelayStatsTest, SentPacketFoundAcrossWrapAround) {
+  OnSendPacket(0xfffeu, kSsrc1);
+  OnSendPacket(0xffffu, kSsrc1);
+  OnSendPacket(0u, kSsrc1);
+  OnSendPacket(1u, kSsrc1);
+  EXPECT_TRUE(OnSentPacket(0u));
+  EXPECT_TRUE(OnSentPacket(0xffffu));
+  EXPECT_TRUE(OnSentPacket(1u));
+  EXPECT_TRUE(OnSentPacket(0xfffeu));
+  EXPECT_FALSE(OnSentPacket(0xfffeu));
+}
+
+TEST_F(SendDelayStatsTest, ReorderedPacketFound) {
+  OnSendPacket(kPacketId + 1, kSsrc1);
+  OnSendPacket(kPacketId, kSsrc2);  // Older than all tracked packets.
+  EXPECT_TRUE(OnSentPacket(kPacketId + 1));
+  EXPECT_TRUE(OnSentPacket(kPacketId));
+}
+
 TEST_F(SendDelayStatsTest, HistogramsAreUpdated) {
   metrics::Reset();
   const int64_t kDelayMs1 = 5;
@@ -83,10 +83,15 @@ SendStatisticsProxy::SendStatisticsProxy(
       encode_time_(kEncodeTimeWeigthFactor),
       uma_container_(
           new UmaSamplesContainer(GetUmaPrefix(content_type_), stats_, clock)) {
+  for (uint32_t ssrc : rtp_config_.ssrcs)
+    substreams_[ssrc].reset(new Substream());
+  for (uint32_t ssrc : rtp_config_.rtx.ssrcs)
+    substreams_[ssrc].reset(new Substream());
 }
 
 SendStatisticsProxy::~SendStatisticsProxy() {
   rtc::CritScope lock(&crit_);
+  UpdatePacketStats();
   uma_container_->UpdateHistograms(rtp_config_, stats_);
 
   int64_t elapsed_sec = (clock_->TimeInMilliseconds() - start_ms_) / 1000;
@@ -103,6 +108,7 @@ SendStatisticsProxy::UmaSamplesContainer::UmaSamplesContainer(
     Clock* const clock)
     : uma_prefix_(prefix),
       clock_(clock),
+      start_ms_(clock->TimeInMilliseconds()),
       max_sent_width_per_timestamp_(0),
       max_sent_height_per_timestamp_(0),
       input_frame_rate_tracker_(100, 10u),
@@ -346,6 +352,7 @@ void SendStatisticsProxy::OnEncoderReconfigured(
   stats_.preferred_media_bitrate_bps = preferred_bitrate_bps;
 
   if (content_type_ != config.content_type) {
+    UpdatePacketStats();
     uma_container_->UpdateHistograms(rtp_config_, stats_);
     uma_container_.reset(new UmaSamplesContainer(
         GetUmaPrefix(config.content_type), stats_, clock_));
@@ -377,6 +384,7 @@ void SendStatisticsProxy::OnSuspendChange(bool is_suspended) {
 
 VideoSendStream::Stats SendStatisticsProxy::GetStats() {
   rtc::CritScope lock(&crit_);
+  UpdatePacketStats();
   PurgeOldStats();
   stats_.input_frame_rate =
       round(uma_container_->input_frame_rate_tracker_.ComputeRate());
@@ -420,16 +428,69 @@ VideoSendStream::StreamStats* SendStatisticsProxy::GetStatsEntry(
   return entry;
 }
 
+SendStatisticsProxy::Substream* SendStatisticsProxy::GetSubstream(
+    uint32_t ssrc) const {
+  auto it = substreams_.find(ssrc);
+  return it != substreams_.end() ? it->second.get() : nullptr;
+}
+
+void SendStatisticsProxy::UpdatePacketStats() {
+  for (const auto& it : substreams_) {
+    Substream* substream = it.second.get();
+    const PacketStats* packet_stats = substream->snapshot.Read();
+    if (!packet_stats)
+      continue;
+
+    VideoSendStream::StreamStats* stats = GetStatsEntry(it.first);
+    RTC_DCHECK(stats);
+    stats->rtp_stats = packet_stats->rtp_stats;
+    stats->total_bitrate_bps = packet_stats->total_bitrate_bps;
+    stats->retransmit_bitrate_bps = packet_stats->retransmit_bitrate_bps;
+    stats->avg_delay_ms = packet_stats->avg_delay_ms;
+    stats->max_delay_ms = packet_stats->max_delay_ms;
+    stats->frame_counts = packet_stats->frame_counts;
+
+    if (packet_stats->first_rtp_stats_time_ms != -1) {
+      // Packets sent before the UMA samples were last reset don't count.
+      int64_t first_rtp_stats_time_ms =
+          std::max(packet_stats->first_rtp_stats_time_ms,
+                   uma_container_->start_ms_);
+      if (uma_container_->first_rtp_stats_time_ms_ == -1 ||
+          first_rtp_stats_time_ms < uma_container_->first_rtp_stats_time_ms_) {
+        uma_container_->first_rtp_stats_time_ms_ = first_rtp_stats_time_ms;
+      }
+    }
+
+    uma_container_->delay_counter_.AddSamples(
+        static_cast<int>(packet_stats->avg_delay_sum_ms -
+                         substream->merged_avg_delay_sum_ms),
+        packet_stats->num_delays - substream->merged_num_delays);
+    uma_container_->max_delay_counter_.AddSamples(
+        static_cast<int>(packet_stats->max_delay_sum_ms -
+                         substream->merged_max_delay_sum_ms),
+        packet_stats->num_delays - substream->merged_num_delays);
+    substream->merged_avg_delay_sum_ms = packet_stats->avg_delay_sum_ms;
+    substream->merged_max_delay_sum_ms = packet_stats->max_delay_sum_ms;
+    substream->merged_num_delays = packet_stats->num_delays;
+  }
+}
+
 void SendStatisticsProxy::OnInactiveSsrc(uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
-    return;
+  {
+    rtc::CritScope lock(&crit_);
+    VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
+    if (!stats)
+      return;
+
+    stats->height = 0;
+    stats->width = 0;
+  }
 
-  stats->total_bitrate_bps = 0;
-  stats->retransmit_bitrate_bps = 0;
-  stats->height = 0;
-  stats->width = 0;
+  Substream* substream = GetSubstream(ssrc);
+  rtc::CritScope lock(&substream->write_crit);
+  substream->packet_stats.total_bitrate_bps = 0;
+  substream->packet_stats.retransmit_bitrate_bps = 0;
+  substream->snapshot.Publish(substream->packet_stats);
 }
 
 void SendStatisticsProxy::OnSetEncoderTargetRate(uint32_t bitrate_bps) {
@@ -571,50 +632,60 @@ void SendStatisticsProxy::CNameChanged(const char* cname, uint32_t ssrc) {}
 void SendStatisticsProxy::DataCountersUpdated(
     const StreamDataCounters& counters,
     uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  RTC_DCHECK(stats) << "DataCountersUpdated reported for unknown ssrc: "
-                    << ssrc;
+  Substream* substream = GetSubstream(ssrc);
+  RTC_DCHECK(substream) << "DataCountersUpdated reported for unknown ssrc: "
+                        << ssrc;
+  if (!substream)
+    return;
 
-  stats->rtp_stats = counters;
-  if (uma_container_->first_rtp_stats_time_ms_ == -1)
-    uma_container_->first_rtp_stats_time_ms_ = clock_->TimeInMilliseconds();
+  rtc::CritScope lock(&substream->write_crit);
+  substream->packet_stats.rtp_stats = counters;
+  if (substream->packet_stats.first_rtp_stats_time_ms == -1) {
+    substream->packet_stats.first_rtp_stats_time_ms =
+        clock_->TimeInMilliseconds();
+  }
+  substream->snapshot.Publish(substream->packet_stats);
 }
 
 void SendStatisticsProxy::Notify(uint32_t total_bitrate_bps,
                                  uint32_t retransmit_bitrate_bps,
                                  uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
+  Substream* substream = GetSubstream(ssrc);
+  if (!substream)
     return;
 
-  stats->total_bitrate_bps = total_bitrate_bps;
-  stats->retransmit_bitrate_bps = retransmit_bitrate_bps;
+  rtc::CritScope lock(&substream->write_crit);
+  substream->packet_stats.total_bitrate_bps = total_bitrate_bps;
+  substream->packet_stats.retransmit_bitrate_bps = retransmit_bitrate_bps;
+  substream->snapshot.Publish(substream->packet_stats);
 }
 
 void SendStatisticsProxy::FrameCountUpdated(const FrameCounts& frame_counts,
                                             uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
+  Substream* substream = GetSubstream(ssrc);
+  if (!substream)
     return;
 
-  stats->frame_counts = frame_counts;
+  rtc::CritScope lock(&substream->write_crit);
+  substream->packet_stats.frame_counts = frame_counts;
+  substream->snapshot.Publish(substream->packet_stats);
 }
 
 void SendStatisticsProxy::SendSideDelayUpdated(int avg_delay_ms,
                                                int max_delay_ms,
                                                uint32_t ssrc) {
-  rtc::CritScope lock(&crit_);
-  VideoSendStream::StreamStats* stats = GetStatsEntry(ssrc);
-  if (!stats)
+  Substream* substream = GetSubstream(ssrc);
+  if (!substream)
     return;
-  stats->avg_delay_ms = avg_delay_ms;
-  stats->max_delay_ms = max_delay_ms;
 
-  uma_container_->delay_counter_.Add(avg_delay_ms);
-  uma_container_->max_delay_counter_.Add(max_delay_ms);
+  rtc::CritScope lock(&substream->write_crit);
+  PacketStats* packet_stats = &substream->packet_stats;
+  packet_stats->avg_delay_ms = avg_delay_ms;
+  packet_stats->max_delay_ms = max_delay_ms;
+  packet_stats->avg_delay_sum_ms += avg_delay_ms;
+  packet_stats->max_delay_sum_ms += max_delay_ms;
+  ++packet_stats->num_delays;
+  substream->snapshot.Publish(*packet_stats);
 }
 
 void SendStatisticsProxy::SampleCounter::Add(int sample) {
@@ -622,6 +693,12 @@ void SendStatisticsProxy::SampleCounter::Add(int sample) {
   ++num_samples;
 }
 
+void SendStatisticsProxy::SampleCounter::AddSamples(int samples_sum,
+                                                    int samples_count) {
+  sum += samples_sum;
+  num_samples += samples_count;
+}
+
 int SendStatisticsProxy::SampleCounter::Avg(int min_required_samples) const {
   if (num_samples < min_required_samples || num_samples == 0)
     return -1;
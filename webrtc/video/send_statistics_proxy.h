@@ -26,6 +26,7 @@
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/video/overuse_frame_detector.h"
 #include "webrtc/video/report_block_stats.h"
+#include "webrtc/video/stats_snapshot.h"
 #include "webrtc/video/vie_encoder.h"
 #include "webrtc/video_send_stream.h"
 
@@ -103,6 +104,7 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
     SampleCounter() : sum(0), num_samples(0) {}
     ~SampleCounter() {}
     void Add(int sample);
+    void AddSamples(int samples_sum, int samples_count);
     int Avg(int min_required_samples) const;
 
    private:
@@ -131,9 +133,43 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
     SampleCounter vp8;  // QP range: 0-127
     SampleCounter vp9;  // QP range: 0-255
   };
+  // Stats of a substream that are updated for every sent packet or frame, on
+  // the pacer and encoder threads.
+  struct PacketStats {
+    StreamDataCounters rtp_stats;
+    int64_t first_rtp_stats_time_ms = -1;
+    int total_bitrate_bps = 0;
+    int retransmit_bitrate_bps = 0;
+    int avg_delay_ms = 0;
+    int max_delay_ms = 0;
+    FrameCounts frame_counts;
+    // Sums of all reported delays, for the UMA histograms.
+    int64_t avg_delay_sum_ms = 0;
+    int64_t max_delay_sum_ms = 0;
+    int num_delays = 0;
+  };
+  // The packet path updates |packet_stats| and publishes it to |snapshot|
+  // without taking |crit_|, so it is never blocked by GetStats(). The
+  // snapshot is folded into |stats_| by UpdatePacketStats().
+  struct Substream {
+    rtc::CriticalSection write_crit;
+    PacketStats packet_stats GUARDED_BY(write_crit);
+    StatsSnapshot<PacketStats> snapshot;
+    // Delay samples already added to |uma_container_|. Accessed with |crit_|
+    // held.
+    int64_t merged_avg_delay_sum_ms = 0;
+    int64_t merged_max_delay_sum_ms = 0;
+    int merged_num_delays = 0;
+  };
+
   void PurgeOldStats() EXCLUSIVE_LOCKS_REQUIRED(crit_);
   VideoSendStream::StreamStats* GetStatsEntry(uint32_t ssrc)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns the packet path state of |ssrc|, or null if it isn't configured.
+  Substream* GetSubstream(uint32_t ssrc) const;
+  // Copies the latest published packet stats of all substreams to |stats_|
+  // and |uma_container_|.
+  void UpdatePacketStats() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   Clock* const clock_;
   const std::string payload_name_;
@@ -145,6 +181,9 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
   uint32_t last_sent_frame_timestamp_ GUARDED_BY(crit_);
   std::map<uint32_t, StatsUpdateTimes> update_times_ GUARDED_BY(crit_);
   rtc::ExpFilter encode_time_ GUARDED_BY(crit_);
+  // One entry per configured media and RTX ssrc, not modified after
+  // construction.
+  std::map<uint32_t, std::unique_ptr<Substream>> substreams_;
 
   // Contains stats used for UMA histograms. These stats will be reset if
   // content type changes between real-time video and screenshare, since these
@@ -160,6 +199,7 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
 
     const std::string uma_prefix_;
     Clock* const clock_;
+    const int64_t start_ms_;
     int max_sent_width_per_timestamp_;
     int max_sent_height_per_timestamp_;
     SampleCounter input_width_counter_;
@@ -279,6 +279,21 @@ TEST_F(SendStatisticsProxyTest, SendSideDelay) {
   ExpectEqual(expected_, stats);
 }
 
+TEST_F(SendStatisticsProxyTest, SendSideDelayHistogramCountsAllSamples) {
+  SendSideDelayObserver* observer = statistics_proxy_.get();
+  for (int i = 0; i < kMinRequiredSamples; ++i) {
+    observer->SendSideDelayUpdated(i % 2 == 0 ? 10 : 20, 30, kFirstSsrc);
+    // Reading the stats in between must neither drop nor repeat samples.
+    if (i % 7 == 0)
+      statistics_proxy_->GetStats();
+  }
+
+  statistics_proxy_.reset();
+  EXPECT_EQ(1, metrics::NumSamples("WebRTC.Video.SendSideDelayInMs"));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.SendSideDelayInMs", 15));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.SendSideDelayMaxInMs", 30));
+}
+
 TEST_F(SendStatisticsProxyTest, OnEncodedFrameTimeMeasured) {
   const int kEncodeTimeMs = 11;
   CpuOveruseMetrics metrics;
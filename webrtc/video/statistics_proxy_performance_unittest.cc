@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/arraysize.h"
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+#include "webrtc/video/receive_statistics_proxy.h"
+#include "webrtc/video/send_statistics_proxy.h"
+
+namespace webrtc {
+namespace {
+
+const int kPacketsPerThread = 200000;
+const int kPacketsPerFrame = 10;
+const uint32_t kSsrcs[] = {101, 102, 103};
+const uint32_t kRtxSsrcs[] = {201, 202, 203};
+
+// Runs |function| on its own thread once, or until Stop() when |repeat| is
+// set.
+class TestThread {
+ public:
+  TestThread(std::function<void()> function, bool repeat)
+      : function_(function),
+        repeat_(repeat),
+        thread_(&TestThread::Run, this, "TestThread") {}
+
+  void Start() { thread_.Start(); }
+  void Stop() {
+    rtc::AtomicOps::ReleaseStore(&stopping_, 1);
+    thread_.Stop();
+  }
+
+ private:
+  static bool Run(void* obj) {
+    TestThread* self = static_cast<TestThread*>(obj);
+    self->function_();
+    return self->repeat_ && !rtc::AtomicOps::AcquireLoad(&self->stopping_);
+  }
+
+  const std::function<void()> function_;
+  const bool repeat_;
+  volatile int stopping_ = 0;
+  rtc::PlatformThread thread_;
+};
+
+// Starts |threads| and a thread that polls |get_stats| until they are done,
+// and returns the time spent in total.
+int64_t RunWithStatsPoller(std::vector<std::unique_ptr<TestThread>>* threads,
+                           std::function<void()> get_stats) {
+  TestThread poller(get_stats, true);
+  poller.Start();
+  const int64_t start_ns = rtc::TimeNanos();
+  for (auto& thread : *threads)
+    thread->Start();
+  for (auto& thread : *threads)
+    thread->Stop();
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  poller.Stop();
+  return elapsed_ns;
+}
+
+}  // namespace
+
+// Simulates one pacer thread per simulcast layer reporting every sent packet,
+// an encoder thread reporting the frames of all layers and a stats poller
+// calling GetStats() continuously, and reports the time spent per packet.
+TEST(StatisticsProxyPerformanceTest, SendStatisticsProxyContention) {
+  SimulatedClock clock(1234);
+  VideoSendStream::Config config(nullptr);
+  config.rtp.ssrcs.assign(std::begin(kSsrcs), std::end(kSsrcs));
+  config.rtp.rtx.ssrcs.assign(std::begin(kRtxSsrcs), std::end(kRtxSsrcs));
+  SendStatisticsProxy proxy(&clock, config,
+                            VideoEncoderConfig::ContentType::kRealtimeVideo);
+
+  StreamDataCountersCallback* counters_observer = &proxy;
+  SendSideDelayObserver* delay_observer = &proxy;
+  std::vector<std::unique_ptr<TestThread>> threads;
+  for (uint32_t ssrc : kSsrcs) {
+    threads.emplace_back(new TestThread(
+        [counters_observer, delay_observer, ssrc]() {
+          StreamDataCounters counters;
+          counters.first_packet_time_ms = 0;
+          for (int i = 0; i < kPacketsPerThread; ++i) {
+            counters.transmitted.packets++;
+            counters.transmitted.payload_bytes += 1000;
+            counters_observer->DataCountersUpdated(counters, ssrc);
+            delay_observer->SendSideDelayUpdated(10, 20, ssrc);
+          }
+        },
+        false));
+  }
+  threads.emplace_back(new TestThread(
+      [&proxy]() {
+        EncodedImage image;
+        image._encodedWidth = 1280;
+        image._encodedHeight = 720;
+        CodecSpecificInfo codec_info;
+        codec_info.codecType = kVideoCodecVP8;
+        for (int i = 0; i < kPacketsPerThread / kPacketsPerFrame; ++i) {
+          image._timeStamp = i * 3000;
+          for (size_t layer = 0; layer < arraysize(kSsrcs); ++layer) {
+            codec_info.codecSpecific.VP8.simulcastIdx = layer;
+            proxy.OnSendEncodedImage(image, &codec_info);
+          }
+        }
+      },
+      false));
+
+  const int64_t elapsed_ns =
+      RunWithStatsPoller(&threads, [&proxy]() { proxy.GetStats(); });
+
+  VideoSendStream::Stats stats = proxy.GetStats();
+  for (uint32_t ssrc : kSsrcs) {
+    EXPECT_EQ(static_cast<uint32_t>(kPacketsPerThread),
+              stats.substreams[ssrc].rtp_stats.transmitted.packets);
+  }
+
+  test::PrintResult(
+      "statistics_proxy_time", "", "send_packet",
+      static_cast<size_t>(elapsed_ns / (kPacketsPerThread * arraysize(kSsrcs))),
+      "ns", true);
+}
+
+// Simulates the network thread reporting every received media and RTX packet
+// and a stats poller calling GetStats() continuously, and reports the time
+// spent per packet.
+TEST(StatisticsProxyPerformanceTest, ReceiveStatisticsProxyContention) {
+  SimulatedClock clock(1234);
+  VideoReceiveStream::Config config(nullptr);
+  config.rtp.remote_ssrc = kSsrcs[0];
+  config.rtp.rtx[96].ssrc = kRtxSsrcs[0];
+  ReceiveStatisticsProxy proxy(&config, &clock);
+
+  std::vector<std::unique_ptr<TestThread>> threads;
+  threads.emplace_back(new TestThread(
+      [&proxy]() {
+        StreamDataCounters counters;
+        StreamDataCounters rtx_counters;
+        for (int i = 0; i < kPacketsPerThread; ++i) {
+          counters.transmitted.packets++;
+          proxy.DataCountersUpdated(counters, kSsrcs[0]);
+          if (i % 10 == 0) {
+            rtx_counters.transmitted.packets++;
+            proxy.DataCountersUpdated(rtx_counters, kRtxSsrcs[0]);
+          }
+        }
+      },
+      false));
+
+  const int64_t elapsed_ns =
+      RunWithStatsPoller(&threads, [&proxy]() { proxy.GetStats(); });
+
+  EXPECT_EQ(static_cast<uint32_t>(kPacketsPerThread),
+            proxy.GetStats().rtp_stats.transmitted.packets);
+
+  test::PrintResult("statistics_proxy_time", "", "receive_packet",
+                    static_cast<size_t>(elapsed_ns / kPacketsPerThread), "ns",
+                    true);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_STATS_SNAPSHOT_H_
+#define WEBRTC_VIDEO_STATS_SNAPSHOT_H_
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/constructormagic.h"
+
+namespace webrtc {
+
+// Hands the latest value of a statistic from the thread that updates it to
+// the thread that reports it, without either of them ever waiting for the
+// other. The value is triple buffered: the writer fills a back buffer and
+// exchanges it with the middle one, and the reader exchanges its front buffer
+// with the middle one when that holds a newer value.
+//
+// Publish() calls must be serialized, and so must Read() calls, but a
+// Publish() may run concurrently with a Read().
+template <typename T>
+class StatsSnapshot {
+ public:
+  StatsSnapshot() {}
+
+  // Makes a copy of |value| the latest value.
+  void Publish(const T& value) {
+    buffers_[back_] = value;
+    back_ = Exchange(back_ | kNewValue) & kIndexMask;
+  }
+
+  // Returns the latest published value, or null if none has been published
+  // yet. The value stays valid until the next call.
+  const T* Read() const {
+    if (rtc::AtomicOps::AcquireLoad(&middle_) & kNewValue) {
+      front_ = Exchange(front_) & kIndexMask;
+      has_value_ = true;
+    }
+    return has_value_ ? &buffers_[front_] : nullptr;
+  }
+
+ private:
+  static const int kIndexMask = 3;
+  static const int kNewValue = 4;
+
+  // Stores |value| in |middle_| and returns the previous value.
+  int Exchange(int value) const {
+    int old_value = rtc::AtomicOps::AcquireLoad(&middle_);
+    while (true) {
+      const int previous =
+          rtc::AtomicOps::CompareAndSwap(&middle_, old_value, value);
+      if (previous == old_value)
+        return previous;
+      old_value = previous;
+    }
+  }
+
+  T buffers_[3];
+  // Index of the buffer owned by Publish().
+  int back_ = 0;
+  // Index of the buffer owned by Read(), and whether it holds a value.
+  mutable int front_ = 1;
+  mutable bool has_value_ = false;
+  // Index of the buffer in between, with kNewValue set when it holds a value
+  // that Read() hasn't seen yet.
+  mutable volatile int middle_ = 2;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(StatsSnapshot);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_STATS_SNAPSHOT_H_
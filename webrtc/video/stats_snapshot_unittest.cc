@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2016 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/stats_snapshot.h"
+
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+struct Counters {
+  int first = 0;
+  int second = 0;
+};
+
+class PublishingThread {
+ public:
+  PublishingThread(StatsSnapshot<Counters>* snapshot, int count)
+      : snapshot_(snapshot),
+        count_(count),
+        thread_(&PublishingThread::Run, this, "PublishingThread") {
+    thread_.Start();
+  }
+  ~PublishingThread() { thread_.Stop(); }
+
+ private:
+  static bool Run(void* obj) {
+    PublishingThread* self = static_cast<PublishingThread*>(obj);
+    Counters counters;
+    for (int i = 1; i <= self->count_; ++i) {
+      counters.first = i;
+      counters.second = -i;
+      self->snapshot_->Publish(counters);
+    }
+    return false;
+  }
+
+  StatsSnapshot<Counters>* const snapshot_;
+  const int count_;
+  rtc::PlatformThread thread_;
+};
+
+}  // namespace
+
+TEST(StatsSnapshotTest, ReadsLatestValue) {
+  StatsSnapshot<Counters> snapshot;
+  EXPECT_EQ(nullptr, snapshot.Read());
+
+  Counters counters;
+  counters.first = 1;
+  snapshot.Publish(counters);
+  counters.first = 2;
+  snapshot.Publish(counters);
+  ASSERT_TRUE(snapshot.Read());
+  EXPECT_EQ(2, snapshot.Read()->first);
+
+  // Without a new value, the last one is read again.
+  ASSERT_TRUE(snapshot.Read());
+  EXPECT_EQ(2, snapshot.Read()->first);
+
+  for (int i = 3; i < 10; ++i) {
+    counters.first = i;
+    snapshot.Publish(counters);
+    ASSERT_TRUE(snapshot.Read());
+    EXPECT_EQ(i, snapshot.Read()->first);
+  }
+}
+
+TEST(StatsSnapshotTest, ReadsConsistentValuesWhilePublishing) {
+  const int kCount = 100000;
+  StatsSnapshot<Counters> snapshot;
+  int last = 0;
+  {
+    PublishingThread thread(&snapshot, kCount);
+    while (last < kCount) {
+      const Counters* counters = snapshot.Read();
+      if (!counters)
+        continue;
+      // Values are never torn and never go back in time.
+      ASSERT_EQ(-counters->first, counters->second);
+      ASSERT_GE(counters->first, last);
+      last = counters->first;
+    }
+  }
+  EXPECT_EQ(kCount, last);
+}
+
+}  // namespace webrtc
@@ -91,6 +91,8 @@ class VideoSendStream : public webrtc::VideoSendStream {
 
   RtpStateMap StopPermanentlyAndGetRtpStates();
 
+  const VideoSendStream::Config& config() const { return config_; }
+
  private:
   class ConstructionTask;
   class DestructAndGetRtpStateTask;
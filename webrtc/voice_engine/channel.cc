@@ -1581,15 +1581,23 @@ int32_t Channel::ReceivedRTPPacket(const uint8_t* received_packet,
   WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::ReceivedRTPPacket()");
 
-  // Store playout timestamp for the received RTP packet
-  UpdatePlayoutTimestamp(false);
-
   RTPHeader header;
   if (!rtp_header_parser_->Parse(received_packet, length, &header)) {
     WEBRTC_TRACE(webrtc::kTraceDebug, webrtc::kTraceVoice, _channelId,
                  "Incoming packet: invalid RTP header");
     return -1;
   }
+  return ReceivedRTPPacket(received_packet, length, header, packet_time);
+}
+
+int32_t Channel::ReceivedRTPPacket(const uint8_t* received_packet,
+                                   size_t length,
+                                   const RTPHeader& parsed_header,
+                                   const PacketTime& packet_time) {
+  // Store playout timestamp for the received RTP packet
+  UpdatePlayoutTimestamp(false);
+
+  RTPHeader header = parsed_header;
   header.payload_type_frequency =
       rtp_payload_registry_->GetPayloadTypeFrequency(header.payloadType);
   if (header.payload_type_frequency < 0)
@@ -216,6 +216,12 @@ class Channel
   int32_t ReceivedRTPPacket(const uint8_t* received_packet,
                             size_t length,
                             const PacketTime& packet_time);
+  // Same as above, for a packet whose |header| has already been parsed with
+  // the header extensions registered on this channel.
+  int32_t ReceivedRTPPacket(const uint8_t* received_packet,
+                            size_t length,
+                            const RTPHeader& header,
+                            const PacketTime& packet_time);
   int32_t ReceivedRTCPPacket(const uint8_t* data, size_t length);
 
   // VoEFile
@@ -80,8 +80,11 @@ class ChannelProxy {
 
   virtual void RegisterExternalTransport(Transport* transport);
   virtual void DeRegisterExternalTransport();
+  // |header| must have been parsed with the header extensions configured on
+  // the channel.
   virtual bool ReceivedRTPPacket(const uint8_t* packet,
                                  size_t length,
+                                 const RTPHeader& header,
                                  const PacketTime& packet_time);
   virtual bool ReceivedRTCPPacket(const uint8_t* packet, size_t length);
 